@@ -0,0 +1,81 @@
+#include "bench_scheduler.hpp"
+
+#include <cstdio>
+#include <thread>
+
+namespace bench_scheduler {
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using LightCrowd = bench::Crowd<typename Light::FSM::Instance>;
+using HeavyCrowd = bench::Crowd<typename Heavy::FSM::Instance>;
+
+// each shard's machines are allocated together, next to its context
+struct Shard {
+	std::unique_ptr<LightCrowd> light;
+	std::unique_ptr<HeavyCrowd> heavy;
+};
+
+//------------------------------------------------------------------------------
+
+template <hfsm2::LongIndex NThreads>
+void
+runThreads(Scheduler& scheduler,
+		   const unsigned frames)
+{
+	if (NThreads > 1 && NThreads > std::thread::hardware_concurrency())
+		return;
+
+	hfsm2::WorkStealingExecutorT<NThreads> executor;
+	scheduler.attachExecutor(&executor);
+
+	char scenario[32];
+	snprintf(scenario, sizeof(scenario), "update %u thread(s)", (unsigned) NThreads);
+
+	bench::print("scheduler 100k", scenario, bench::measure(MACHINE_COUNT * frames, [&] {
+		for (unsigned f = 0; f < frames; ++f)
+			scheduler.updateAll();
+	}));
+
+	scheduler.attachExecutor(nullptr);
+}
+
+}
+
+//------------------------------------------------------------------------------
+
+void
+run(const bench::Settings& settings) {
+	bench::printHeader("MachineScheduler<>::updateAll() scaling");
+
+	std::unique_ptr<Scheduler> scheduler{new Scheduler};
+	std::vector<Shard> shards(SHARD_COUNT);
+
+	for (unsigned s = 0; s < SHARD_COUNT; ++s) {
+		const unsigned count = MACHINE_COUNT * (s + 1) / SHARD_COUNT - MACHINE_COUNT * s / SHARD_COUNT;
+
+		shards[s].light.reset(new LightCrowd{count - count / 2, scheduler->context(s)});
+		shards[s].heavy.reset(new HeavyCrowd{count / 2,			scheduler->context(s)});
+
+		for (unsigned i = 0; i < shards[s].light->count(); ++i)
+			scheduler->add(s, (*shards[s].light)[i]);
+
+		for (unsigned i = 0; i < shards[s].heavy->count(); ++i)
+			scheduler->add(s, (*shards[s].heavy)[i]);
+	}
+
+	// a full 'tickCount' frames of 100k machines takes a while
+	const unsigned frames = settings.tickCount / 16 ? settings.tickCount / 16 : 1;
+
+	runThreads< 1>(*scheduler, frames);
+	runThreads< 2>(*scheduler, frames);
+	runThreads< 4>(*scheduler, frames);
+	runThreads< 8>(*scheduler, frames);
+	runThreads<16>(*scheduler, frames);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
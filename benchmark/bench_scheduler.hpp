@@ -0,0 +1,25 @@
+#pragma once
+
+#include "bench_shapes.hpp"
+
+namespace bench_scheduler {
+
+////////////////////////////////////////////////////////////////////////////////
+// 100k machines of two shapes, sharded with 'MachineScheduler<>',
+// updated on 1 .. N threads of a 'WorkStealingExecutorT<>'
+
+static constexpr unsigned MACHINE_COUNT = 100000;
+static constexpr unsigned SHARD_COUNT	= 64;
+
+using Scheduler = hfsm2::MachineScheduler<bench::Context,
+										  SHARD_COUNT,
+										  (MACHINE_COUNT + SHARD_COUNT - 1) / SHARD_COUNT>;
+
+using Light = bench_shapes::Narrow;
+using Heavy = bench_shapes::Deep;
+
+void run(const bench::Settings& settings);
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
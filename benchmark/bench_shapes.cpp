@@ -0,0 +1,51 @@
+#include "bench_shapes.hpp"
+
+namespace bench_shapes {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TShape>
+void
+runShape(const bench::Settings& settings) {
+	bench::runScenarios<typename TShape::FSM>(settings,
+											  TShape::NAME,
+											  TShape::from(),
+											  TShape::to());
+
+	bench::runBatchScenarios<typename TShape::FSM>(settings,
+												   TShape::NAME,
+												   TShape::from(),
+												   TShape::to());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TShape>
+void
+runFan(const bench::Settings& settings) {
+	runShape<TShape>(settings);
+
+	bench::runScatteredScenarios<typename TShape::FSM>(settings,
+													   TShape::NAME,
+													   TShape::from(),
+													   TShape::WIDTH);
+}
+
+//------------------------------------------------------------------------------
+
+void
+run(const bench::Settings& settings) {
+	bench::printHeader("R_::update() / R_::react() dispatch");
+
+	runShape<Deep		>(settings);
+	runFan	<Narrow		>(settings);
+	runFan	<NarrowJump	>(settings);
+	runFan	<Wide		>(settings);
+	runFan	<WideJump	>(settings);
+	runShape<Ortho		>(settings);
+	runShape<Mixed		>(settings);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "shared.hpp"
+
+namespace bench_shapes {
+
+using bench::M;
+using hfsm2::StateID;
+
+////////////////////////////////////////////////////////////////////////////////
+// generic building blocks, distinguished per hierarchy by a shape tag
+
+template <typename TShape, unsigned N>
+struct Head
+	: TShape::FSM::State
+{};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TShape, unsigned N>
+struct Leaf
+	: TShape::FSM::State
+{
+	using GuardControl	= typename TShape::FSM::GuardControl;
+	using FullControl	= typename TShape::FSM::FullControl;
+
+	void entryGuard(GuardControl& control) {
+		if (control.context().cancel)
+			control.cancelPendingTransitions();
+	}
+
+	void update(FullControl& control)						{ ++control.context().work;	}
+
+	template <typename TEvent>
+	void react(const TEvent&, FullControl& control)			{ ++control.context().work;	}
+};
+
+//------------------------------------------------------------------------------
+
+template <unsigned...>
+struct Indices {};
+
+template <unsigned N, unsigned... Ns>
+struct MakeIndices
+	: MakeIndices<N - 1, N - 1, Ns...>
+{};
+
+template <unsigned... Ns>
+struct MakeIndices<0, Ns...> {
+	using Type = Indices<Ns...>;
+};
+
+//------------------------------------------------------------------------------
+// composite chain: every level holds the next level and a sibling leaf,
+// the bottom level toggles between two leaves
+
+template <typename TShape, unsigned NBase, unsigned NDepth>
+struct Chain {
+	using Type = M::Composite<Head<TShape, NBase + NDepth>,
+							  typename Chain<TShape, NBase, NDepth - 1>::Type,
+							  Leaf<TShape, NBase + NDepth + 1>>;
+
+	using Root = M::Root	 <Head<TShape, NBase + NDepth>,
+							  typename Chain<TShape, NBase, NDepth - 1>::Type,
+							  Leaf<TShape, NBase + NDepth + 1>>;
+};
+
+template <typename TShape, unsigned NBase>
+struct Chain<TShape, NBase, 0> {
+	using Type = M::Composite<Head<TShape, NBase>,
+							  Leaf<TShape, NBase>,
+							  Leaf<TShape, NBase + 1>>;
+
+	using Root = M::Root	 <Head<TShape, NBase>,
+							  Leaf<TShape, NBase>,
+							  Leaf<TShape, NBase + 1>>;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// composite of NWidth leaves
+
+template <typename TShape, unsigned NBase, typename, typename TM>
+struct FanT;
+
+template <typename TShape, unsigned NBase, unsigned... Ns, typename TM>
+struct FanT<TShape, NBase, Indices<Ns...>, TM> {
+	using Type = typename TM::template Composite<Head<TShape, NBase>,
+												 Leaf<TShape, NBase + Ns>...>;
+
+	using Root = typename TM::template Root		<Head<TShape, NBase>,
+												 Leaf<TShape, NBase + Ns>...>;
+};
+
+template <typename TShape, unsigned NBase, unsigned NWidth, typename TM = M>
+using Fan = FanT<TShape, NBase, typename MakeIndices<NWidth>::Type, TM>;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// orthogonal of NWidth two-leaf composites
+
+template <typename TShape, unsigned NBase, typename>
+struct SpreadT;
+
+template <typename TShape, unsigned NBase, unsigned... Ns>
+struct SpreadT<TShape, NBase, Indices<Ns...>> {
+	using Type = M::Orthogonal	  <Head<TShape, NBase>,
+								   typename Fan<TShape, NBase + 1 + 2 * Ns, 2>::Type...>;
+
+	using Root = M::OrthogonalRoot<Head<TShape, NBase>,
+								   typename Fan<TShape, NBase + 1 + 2 * Ns, 2>::Type...>;
+};
+
+template <typename TShape, unsigned NBase, unsigned NWidth>
+using Spread = SpreadT<TShape, NBase, typename MakeIndices<NWidth>::Type>;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Deep {
+	static constexpr unsigned DEPTH = 16;
+
+	using FSM = Chain<Deep, 0, DEPTH>::Root;
+
+	static constexpr const char* NAME = "deep composite x16";
+
+	static StateID from()	{ return FSM::stateId<Leaf<Deep, 0>>(); }
+	static StateID to()		{ return FSM::stateId<Leaf<Deep, 1>>(); }
+};
+
+//------------------------------------------------------------------------------
+
+struct Wide {
+	static constexpr unsigned WIDTH = 64;
+
+	using FSM = Fan<Wide, 0, WIDTH>::Root;
+
+	static constexpr const char* NAME = "wide composite x64";
+
+	static StateID from()	{ return FSM::stateId<Leaf<Wide, 0>>();			}
+	static StateID to()		{ return FSM::stateId<Leaf<Wide, WIDTH - 1>>(); }
+};
+
+//------------------------------------------------------------------------------
+
+struct WideJump {
+	static constexpr unsigned WIDTH = 64;
+
+	using FSM = Fan<WideJump, 0, WIDTH, bench::JumpM>::Root;
+
+	static constexpr const char* NAME = "wide composite x64 jump";
+
+	static StateID from()	{ return FSM::stateId<Leaf<WideJump, 0>>();			}
+	static StateID to()		{ return FSM::stateId<Leaf<WideJump, WIDTH - 1>>(); }
+};
+
+//------------------------------------------------------------------------------
+
+struct Narrow {
+	static constexpr unsigned WIDTH = 8;
+
+	using FSM = Fan<Narrow, 0, WIDTH>::Root;
+
+	static constexpr const char* NAME = "composite x8";
+
+	static StateID from()	{ return FSM::stateId<Leaf<Narrow, 0>>();			}
+	static StateID to()		{ return FSM::stateId<Leaf<Narrow, WIDTH - 1>>();	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct NarrowJump {
+	static constexpr unsigned WIDTH = 8;
+
+	using FSM = Fan<NarrowJump, 0, WIDTH, bench::JumpM>::Root;
+
+	static constexpr const char* NAME = "composite x8 jump";
+
+	static StateID from()	{ return FSM::stateId<Leaf<NarrowJump, 0>>();		}
+	static StateID to()		{ return FSM::stateId<Leaf<NarrowJump, WIDTH - 1>>(); }
+};
+
+//------------------------------------------------------------------------------
+
+struct Ortho {
+	static constexpr unsigned WIDTH = 32;
+
+	using FSM = Spread<Ortho, 0, WIDTH>::Root;
+
+	static constexpr const char* NAME = "wide orthogonal x32";
+
+	static StateID from()	{ return FSM::stateId<Leaf<Ortho, 1>>();		}
+	static StateID to()		{ return FSM::stateId<Leaf<Ortho, 2>>();		}
+};
+
+//------------------------------------------------------------------------------
+
+struct Mixed {
+	using FSM = M::OrthogonalRoot<Head<Mixed, 0>,
+								  Chain <Mixed, 100, 4>::Type,
+								  Fan	<Mixed, 200, 16>::Type,
+								  Spread<Mixed, 300, 4>::Type>;
+
+	static constexpr const char* NAME = "mixed";
+
+	static StateID from()	{ return FSM::stateId<Leaf<Mixed, 100>>();		}
+	static StateID to()		{ return FSM::stateId<Leaf<Mixed, 101>>();		}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void run(const bench::Settings& settings);
+
+}
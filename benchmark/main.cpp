@@ -0,0 +1,30 @@
+#include "bench_scheduler.hpp"
+#include "bench_shapes.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+//------------------------------------------------------------------------------
+
+int
+main(int argc, char* argv[]) {
+	bench::Settings settings;
+
+	if (argc > 1)
+		settings.machineCount = (unsigned) atoi(argv[1]);
+
+	if (argc > 2)
+		settings.tickCount	  = (unsigned) atoi(argv[2]);
+
+	if (settings.machineCount == 0 || settings.tickCount == 0) {
+		printf("usage: %s [machine count] [ticks per machine]\n", argv[0]);
+		return 1;
+	}
+
+	printf("%u machines x %u ticks\n", settings.machineCount, settings.tickCount);
+
+	bench_shapes::run(settings);
+	bench_scheduler::run(settings);
+
+	return 0;
+}
@@ -0,0 +1,124 @@
+#include "shared.hpp"
+
+#include <cstdio>
+
+#if defined(__linux__)
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+	#include <cstring>
+#endif
+
+namespace bench {
+
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__linux__)
+
+namespace {
+
+int
+openCounter(const uint64_t config,
+			const int groupFd)
+{
+	perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+
+	attr.size			= sizeof(attr);
+	attr.type			= PERF_TYPE_HARDWARE;
+	attr.config			= config;
+	attr.disabled		= groupFd == -1 ? 1 : 0;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv		= 1;
+
+	return (int) syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+
+uint64_t
+readCounter(const int fd) {
+	uint64_t value = 0;
+
+	return fd >= 0 && read(fd, &value, sizeof(value)) == sizeof(value) ?
+		value : 0;
+}
+
+}
+
+//------------------------------------------------------------------------------
+
+Counters::Counters()
+	: _instructions{openCounter(PERF_COUNT_HW_INSTRUCTIONS, -1)}
+{
+	if (_instructions >= 0)
+		_cacheMisses = openCounter(PERF_COUNT_HW_CACHE_MISSES, _instructions);
+}
+
+//------------------------------------------------------------------------------
+
+Counters::~Counters() {
+	if (_cacheMisses >= 0)
+		close(_cacheMisses);
+
+	if (_instructions >= 0)
+		close(_instructions);
+}
+
+//------------------------------------------------------------------------------
+
+void
+Counters::start() {
+	if (_instructions >= 0) {
+		ioctl(_instructions, PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+		ioctl(_instructions, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+void
+Counters::stop() {
+	if (_instructions >= 0) {
+		ioctl(_instructions, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+		_instructionCount = readCounter(_instructions);
+		_cacheMissCount	  = readCounter(_cacheMisses);
+	}
+}
+
+#else
+
+Counters::Counters()	{}
+Counters::~Counters()	{}
+
+void Counters::start()	{}
+void Counters::stop()	{}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+void
+printHeader(const char* const title) {
+	printf("\n%s\n", title);
+	printf("%-24s %-26s %10s %12s %12s\n", "shape", "scenario", "ns/tick", "instr/tick", "misses/tick");
+}
+
+//------------------------------------------------------------------------------
+
+void
+print(const char* const shape,
+	  const char* const scenario,
+	  const Sample& sample)
+{
+	if (sample.countersAvailable)
+		printf("%-24s %-26s %10.2f %12.1f %12.3f\n", shape, scenario, sample.nsPerTick, sample.instrPerTick, sample.missesPerTick);
+	else
+		printf("%-24s %-26s %10.2f %12s %12s\n", shape, scenario, sample.nsPerTick, "n/a", "n/a");
+
+	fflush(stdout);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
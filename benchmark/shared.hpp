@@ -0,0 +1,269 @@
+#pragma once
+
+#define HFSM_ENABLE_THREADS
+#include <hfsm2/machine.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace bench {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Settings {
+	unsigned machineCount = 1024;
+	unsigned tickCount	  = 256;
+};
+
+//------------------------------------------------------------------------------
+
+struct Context {
+	bool cancel = false;
+	uint64_t work = 0;
+};
+
+struct Event {};
+
+using Config = hfsm2::Config::ContextT<Context>;
+using M		 = hfsm2::MachineT<Config>;
+
+// same, with composites of 8+ sub-states dispatching through jump tables
+using JumpM	 = hfsm2::MachineT<Config::JumpTableN<8>>;
+
+////////////////////////////////////////////////////////////////////////////////
+// hardware counters, backed by perf_event_open() where available
+
+class Counters {
+public:
+	Counters();
+	~Counters();
+
+	bool available() const							{ return _instructions >= 0;	}
+
+	void start();
+	void stop();
+
+	uint64_t instructions() const					{ return _instructionCount;		}
+	uint64_t cacheMisses()	const					{ return _cacheMissCount;		}
+
+private:
+	int _instructions = -1;
+	int _cacheMisses  = -1;
+
+	uint64_t _instructionCount = 0;
+	uint64_t _cacheMissCount   = 0;
+};
+
+//------------------------------------------------------------------------------
+
+struct Sample {
+	double nsPerTick	   = 0.0;
+	double instrPerTick	   = 0.0;
+	double missesPerTick   = 0.0;
+	bool countersAvailable = false;
+};
+
+void printHeader(const char* const title);
+void print(const char* const shape,
+		   const char* const scenario,
+		   const Sample& sample);
+
+////////////////////////////////////////////////////////////////////////////////
+// contiguous storage for a crowd of identical machines
+
+template <typename TInstance>
+class Crowd {
+	using Storage = typename std::aligned_storage<sizeof(TInstance), alignof(TInstance)>::type;
+
+public:
+	Crowd(const unsigned count, Context& context)
+		: _storage(count)
+	{
+		for (Storage& item : _storage)
+			new (&item) TInstance{context};
+	}
+
+	~Crowd() {
+		for (Storage& item : _storage)
+			reinterpret_cast<TInstance&>(item).~TInstance();
+	}
+
+	Crowd(const Crowd&) = delete;
+	Crowd& operator = (const Crowd&) = delete;
+
+	unsigned count() const							{ return (unsigned) _storage.size();			}
+
+	TInstance& operator[] (const unsigned i)		{ return reinterpret_cast<TInstance&>(_storage[i]);	}
+
+private:
+	std::vector<Storage> _storage;
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TFunction>
+Sample measure(const unsigned ticks,
+			   TFunction&& function)
+{
+	Counters counters;
+
+	// warm up caches and branch predictors
+	function();
+
+	const auto begin = std::chrono::steady_clock::now();
+	counters.start();
+
+	function();
+
+	counters.stop();
+	const auto end = std::chrono::steady_clock::now();
+
+	const double ns = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+
+	Sample sample;
+	sample.nsPerTick		 = ns / ticks;
+	sample.countersAvailable = counters.available();
+
+	if (sample.countersAvailable) {
+		sample.instrPerTick  = (double) counters.instructions() / ticks;
+		sample.missesPerTick = (double) counters.cacheMisses()  / ticks;
+	}
+
+	return sample;
+}
+
+//------------------------------------------------------------------------------
+// idle ticks, ticks with one transition and ticks with a cancelled transition
+
+template <typename TFSM>
+void runScenarios(const Settings& settings,
+				  const char* const shape,
+				  const hfsm2::StateID from,
+				  const hfsm2::StateID to)
+{
+	using Instance = typename TFSM::Instance;
+
+	Context context;
+	Crowd<Instance> crowd{settings.machineCount, context};
+
+	const unsigned ticks = settings.machineCount * settings.tickCount;
+
+	print(shape, "update idle", measure(ticks, [&] {
+		for (unsigned t = 0; t < settings.tickCount; ++t)
+			for (unsigned i = 0; i < crowd.count(); ++i)
+				crowd[i].update();
+	}));
+
+	print(shape, "react idle", measure(ticks, [&] {
+		for (unsigned t = 0; t < settings.tickCount; ++t)
+			for (unsigned i = 0; i < crowd.count(); ++i)
+				crowd[i].react(Event{});
+	}));
+
+	print(shape, "update transition", measure(ticks, [&] {
+		for (unsigned t = 0; t < settings.tickCount; ++t)
+			for (unsigned i = 0; i < crowd.count(); ++i) {
+				crowd[i].changeTo(t & 1 ? from : to);
+				crowd[i].update();
+			}
+	}));
+
+	context.cancel = true;
+
+	print(shape, "update guard cancel", measure(ticks, [&] {
+		for (unsigned t = 0; t < settings.tickCount; ++t)
+			for (unsigned i = 0; i < crowd.count(); ++i) {
+				crowd[i].changeTo(to);
+				crowd[i].update();
+			}
+	}));
+
+	context.cancel = false;
+}
+
+//------------------------------------------------------------------------------
+// machines spread over 'width' sibling states starting at 'first',
+// so the active prong differs from one machine to the next
+
+template <typename TFSM>
+void runScatteredScenarios(const Settings& settings,
+						   const char* const shape,
+						   const hfsm2::StateID first,
+						   const unsigned width)
+{
+	using Instance = typename TFSM::Instance;
+
+	Context context;
+	Crowd<Instance> crowd{settings.machineCount, context};
+
+	uint32_t seed = 1;
+
+	for (unsigned i = 0; i < crowd.count(); ++i) {
+		seed = seed * 1664525u + 1013904223u;
+
+		crowd[i].changeTo((hfsm2::StateID) (first + (seed >> 16) % width));
+		crowd[i].update();
+	}
+
+	const unsigned ticks = settings.machineCount * settings.tickCount;
+
+	print(shape, "update scattered", measure(ticks, [&] {
+		for (unsigned t = 0; t < settings.tickCount; ++t)
+			for (unsigned i = 0; i < crowd.count(); ++i)
+				crowd[i].update();
+	}));
+
+	print(shape, "react scattered", measure(ticks, [&] {
+		for (unsigned t = 0; t < settings.tickCount; ++t)
+			for (unsigned i = 0; i < crowd.count(); ++i)
+				crowd[i].react(Event{});
+	}));
+}
+
+//------------------------------------------------------------------------------
+// same crowd, split into fixed-capacity batches
+
+template <typename TFSM>
+void runBatchScenarios(const Settings& settings,
+					   const char* const shape,
+					   const hfsm2::StateID from,
+					   const hfsm2::StateID to)
+{
+	using Batch = typename TFSM::template Batch<1024>;
+
+	Context context;
+	std::vector<std::unique_ptr<Batch>> batches;
+
+	for (unsigned i = 0; i < settings.machineCount; ++i) {
+		if (i % Batch::CAPACITY == 0)
+			batches.emplace_back(new Batch);
+
+		batches.back()->emplace(context);
+	}
+
+	const unsigned ticks = settings.machineCount * settings.tickCount;
+
+	print(shape, "batch update idle", measure(ticks, [&] {
+		for (unsigned t = 0; t < settings.tickCount; ++t)
+			for (auto& batch : batches)
+				batch->updateAll();
+	}));
+
+	print(shape, "batch update transition", measure(ticks, [&] {
+		for (unsigned t = 0; t < settings.tickCount; ++t)
+			for (auto& batch : batches) {
+				for (hfsm2::LongIndex i = 0; i < batch->count(); ++i)
+					(*batch)[i].changeTo(t & 1 ? from : to);
+
+				batch->updateAll();
+			}
+	}));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
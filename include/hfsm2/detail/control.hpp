@@ -5,31 +5,50 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifdef HFSM_ENABLE_COROUTINES
+template <typename>
+class RoutinesT;
+#endif
+
 template <typename TArgs>
-class ControlT {
+class ControlT
+	: protected ProfilerLinkT<typename TArgs::Config_::Clock, TArgs::STATE_COUNT>
+{
 	template <typename, typename, typename>
 	friend struct S_;
 
 	template <typename, typename, Strategy, typename, typename...>
 	friend struct C_;
 
-	template <typename, typename, typename, typename...>
+	template <typename, typename, Execution, typename, typename...>
 	friend struct O_;
 
 	template <typename, typename>
 	friend class R_;
 
+	HFSM_IF_COROUTINES(template <typename> friend class RoutinesT);
+
 	using Args			= TArgs;
 	using Logger		= typename Args::Logger;
 	using Context		= typename Args::Context;
+	using Utility		= typename Args::Utility;
 	using Random_		= typename Args::Random_;
 	using StateList		= typename Args::StateList;
 	using RegionList	= typename Args::RegionList;
 
+	using Recorder		= ReplayRecorderT<typename Args::Config_::Events,
+										  typename Args::Payload,
+										  Utility>;
+
+	using ProfilerLink	= ProfilerLinkT<typename Args::Config_::Clock,
+										Args::STATE_COUNT>;
+	using Profiler		= typename ProfilerLink::Profiler;
+
 public:
 	using StateRegistry	= StateRegistryT<Args>;
 
 	using PlanData		= PlanDataT<Args>;
+	using PlanStats		= typename PlanData::Stats;
 	using ConstPlan		= ConstPlanT<Args>;
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -51,8 +70,10 @@ protected:
 						 Random_& random,
 						 StateRegistry& stateRegistry,
 						 PlanData& planData,
+						 Profiler* const profiler,
 						 Logger* const HFSM_IF_LOGGER(logger))
-		: _context{context}
+		: ProfilerLink{profiler}
+		, _context{context}
 		, _random{random}
 		, _stateRegistry{stateRegistry}
 		, _planData{planData}
@@ -63,6 +84,8 @@ protected:
 	HFSM_INLINE void setRegion(const RegionID id);
 	HFSM_INLINE void resetRegion(const RegionID id);
 
+	HFSM_INLINE Utility random();
+
 public:
 	template <typename T>
 	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
@@ -104,8 +127,15 @@ protected:
 	Random_& _random;
 	StateRegistry& _stateRegistry;
 	PlanData& _planData;
+	PlanStats* _planStats = nullptr;
 	RegionID _regionId = 0;
+	Recorder* _recorder = nullptr;
+	using ProfilerLink::_profiler;
+	HFSM_IF_COROUTINES(RoutinesT<Args>* _routines = nullptr);
 	HFSM_IF_LOGGER(Logger* _logger);
+
+	// set for prongs of parallel orthogonal regions
+	SpinLock* _serial = nullptr;
 };
 
 //------------------------------------------------------------------------------
@@ -120,12 +150,14 @@ class PlanControlT
 	template <typename, typename, Strategy, typename, typename...>
 	friend struct C_;
 
-	template <typename, typename, typename, typename...>
+	template <typename, typename, Execution, typename, typename...>
 	friend struct O_;
 
 	template <typename, typename>
 	friend class R_;
 
+	HFSM_IF_COROUTINES(template <typename> friend class RoutinesT);
+
 	using Args			= TArgs;
 	using Context		= typename Args::Context;
 	using StateList		= typename Args::StateList;
@@ -197,14 +229,14 @@ public:
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE Plan plan()								{ return Plan{_planData, _regionId};					}
-	HFSM_INLINE Plan plan(const RegionID id)			{ return Plan{_planData, id};							}
+	HFSM_INLINE Plan plan()								{ return Plan{_planData, *_planStats, _regionId, _serial};			}
+	HFSM_INLINE Plan plan(const RegionID id)			{ return Plan{_planData, *_planStats, id, _serial};					}
 
 	template <typename TRegion>
-	HFSM_INLINE Plan plan()								{ return Plan{_planData, regionId<TRegion>()};			}
+	HFSM_INLINE Plan plan()								{ return Plan{_planData, *_planStats, regionId<TRegion>(), _serial};	}
 
 	template <typename TRegion>
-	HFSM_INLINE Plan plan() const						{ return Plan{_planData, regionId<TRegion>()};			}
+	HFSM_INLINE Plan plan() const						{ return Plan{_planData, *_planStats, regionId<TRegion>(), _serial};	}
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -214,7 +246,9 @@ protected:
 
 protected:
 	using Control::_planData;
+	using Control::_planStats;
 	using Control::_regionId;
+	using Control::_serial;
 	HFSM_IF_LOGGER(using Control::_logger);
 
 	StateID _originId = 0;
@@ -235,12 +269,14 @@ class FullControlT
 	template <typename, typename, Strategy, typename, typename...>
 	friend struct C_;
 
-	template <typename, typename, typename, typename...>
+	template <typename, typename, Execution, typename, typename...>
 	friend struct O_;
 
 	template <typename, typename>
 	friend class R_;
 
+	HFSM_IF_COROUTINES(template <typename> friend class RoutinesT);
+
 	using Args			= TArgs;
 	using Logger		= typename Args::Logger;
 	using Context		= typename Args::Context;
@@ -251,6 +287,7 @@ class FullControlT
 
 	using Control		= ControlT<Args>;
 	using StateRegistry	= StateRegistryT<Args>;
+	using Profiler		= ProfilerT<typename Args::Config_::Clock, Args::STATE_COUNT>;
 
 	using PlanControl	= PlanControlT<Args>;
 	using Origin		= typename PlanControl::Origin;
@@ -259,6 +296,7 @@ class FullControlT
 
 	using Request		= RequestT <Payload>;
 	using Requests		= RequestsT<Payload, Args::COMPO_REGIONS>;
+	using PayloadPool	= PayloadPoolT<Payload, Args::PAYLOAD_CAPACITY>;
 
 protected:
 
@@ -279,11 +317,22 @@ protected:
 							 StateRegistry& stateRegistry,
 							 PlanData& planData,
 							 Requests& requests,
+							 PayloadPool& payloadPool,
+							 Profiler* const profiler,
 							 Logger* const logger)
-		: PlanControl{context, random, stateRegistry, planData, logger}
+		: PlanControl{context, random, stateRegistry, planData, profiler, logger}
 		, _requests{requests}
+		, _payloadPool{payloadPool}
 	{}
 
+	// control of one prong of a parallel region, collecting its own requests
+	HFSM_INLINE FullControlT(FullControlT& parent,
+							 Requests& requests,
+							 SpinLock& serial);
+
+	template <typename TPayload>
+	HFSM_INLINE ShortIndex stagePayload(TPayload&& payload);
+
 	template <typename TState>
 	Status updatePlan(TState& headState, const Status subStatus);
 
@@ -307,25 +356,30 @@ public:
 	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-	// TODO: test payload versions
 
 	HFSM_INLINE void changeTo (const StateID id);
 	HFSM_INLINE void changeTo (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void changeTo (const StateID stateId, Payload&& payload);
 
 	HFSM_INLINE void restart  (const StateID id);
 	HFSM_INLINE void restart  (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void restart  (const StateID stateId, Payload&& payload);
 
 	HFSM_INLINE void resume	  (const StateID id);
 	HFSM_INLINE void resume   (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void resume   (const StateID stateId, Payload&& payload);
 
 	HFSM_INLINE void utilize  (const StateID id);
 	HFSM_INLINE void utilize  (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void utilize  (const StateID stateId, Payload&& payload);
 
 	HFSM_INLINE void randomize(const StateID id);
 	HFSM_INLINE void randomize(const StateID stateId, const Payload& payload);
+	HFSM_INLINE void randomize(const StateID stateId, Payload&& payload);
 
 	HFSM_INLINE void schedule (const StateID id);
 	HFSM_INLINE void schedule (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void schedule (const StateID stateId, Payload&& payload);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -335,36 +389,54 @@ public:
 	template <typename TState>
 	HFSM_INLINE void changeTo (const Payload& payload)			{ changeTo (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void changeTo (Payload&& payload)				{ changeTo (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void restart  ()								{ restart  (stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void restart  (const Payload& payload)			{ restart  (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void restart  (Payload&& payload)				{ restart  (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void resume   ()								{ resume   (stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void resume	  (const Payload& payload)			{ resume   (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void resume	  (Payload&& payload)				{ resume   (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void utilize  ()								{ utilize  (stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void utilize  (const Payload& payload)			{ utilize  (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void utilize  (Payload&& payload)				{ utilize  (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void randomize()								{ randomize(stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void randomize(const Payload& payload)			{ randomize(stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void randomize(Payload&& payload)				{ randomize(stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void schedule ()								{ schedule (stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void schedule (const Payload& payload)			{ schedule (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void schedule (Payload&& payload)				{ schedule (stateId<TState>(), std::move(payload));	}
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	HFSM_INLINE void succeed();
@@ -374,6 +446,7 @@ public:
 
 protected:
 	using PlanControl::_planData;
+	using PlanControl::_planStats;
 	using PlanControl::_originId;
 	using PlanControl::_regionId;
 	using PlanControl::_regionIndex;
@@ -381,8 +454,18 @@ protected:
 	using PlanControl::_status;
 	HFSM_IF_LOGGER(using Control::_logger);
 
+	using Control::_context;
+	using Control::_random;
+	using Control::_stateRegistry;
+	using Control::_recorder;
+	using Control::_profiler;
+	HFSM_IF_COROUTINES(using Control::_routines);
+	using Control::_serial;
+
 	Requests& _requests;
+	PayloadPool& _payloadPool;
 	bool _locked = false;
+	ExecutorInterface* _executor = nullptr;
 };
 
 //------------------------------------------------------------------------------
@@ -407,13 +490,17 @@ class GuardControlT
 
 	using Control		= ControlT<Args>;
 	using StateRegistry	= StateRegistryT<Args>;
+	using Profiler		= ProfilerT<typename Args::Config_::Clock, Args::STATE_COUNT>;
 
 	using PlanControl	= PlanControlT<Args>;
 	using PlanData		= PlanDataT<Args>;
 
 	using FullControl	= FullControlT<Args>;
 
+	using PayloadPool	= PayloadPoolT<Payload, Args::PAYLOAD_CAPACITY>;
+
 public:
+	using Request		= RequestT <Payload>;
 	using Requests		= RequestsT<Payload, Args::COMPO_REGIONS>;
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -425,8 +512,10 @@ private:
 							  PlanData& planData,
 							  Requests& requests,
 							  const Requests& pendingChanges,
+							  PayloadPool& payloadPool,
+							  Profiler* const profiler,
 							  Logger* const logger)
-		: FullControl{context, random, stateRegistry, planData, requests, logger}
+		: FullControl{context, random, stateRegistry, planData, requests, payloadPool, profiler, logger}
 		, _pending{pendingChanges}
 	{}
 
@@ -471,8 +560,12 @@ public:
 
 	HFSM_INLINE const Requests& pendingTransitions() const		{ return _pending;								}
 
+	// payload passed with a pending transition, nullptr if there was none
+	HFSM_INLINE const Payload* pendingPayload(const Request& request) const;
+
 private:
 	using FullControl::_stateRegistry;
+	using FullControl::_payloadPool;
 	using FullControl::_originId;
 	HFSM_IF_LOGGER(using FullControl::_logger);
 
@@ -39,6 +39,18 @@ ControlT<TA>::resetRegion(const RegionID id) { //-V524
 	_regionId = id;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+typename ControlT<TA>::Utility
+ControlT<TA>::random() {
+	// prongs of parallel regions share the generator and the recorder,
+	// the order of their draws is not deterministic
+	SpinGuard guard{_serial};
+
+	return _recorder ? _recorder->draw(_random) : _random.next();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 template <typename TA>
@@ -137,6 +149,43 @@ PlanControlT<TA>::resetRegion(const RegionID id, //-V524
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename TA>
+FullControlT<TA>::FullControlT(FullControlT& parent,
+							   Requests& requests,
+							   SpinLock& serial)
+	: PlanControl{parent._context,
+				  parent._random,
+				  parent._stateRegistry,
+				  parent._planData,
+				  parent._profiler,
+				  HFSM_LOGGER_OR(parent._logger, nullptr)}
+	, _requests{requests}
+	, _payloadPool{parent._payloadPool}
+	, _locked{parent._locked}
+{
+	_serial		 = &serial;
+	_planStats	 = parent._planStats;
+	_recorder	 = parent._recorder;
+	_originId	 = parent._originId;
+	_regionId	 = parent._regionId;
+	_regionIndex = parent._regionIndex;
+	_regionSize	 = parent._regionSize;
+	HFSM_IF_COROUTINES(_routines = parent._routines);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+template <typename TPayload>
+ShortIndex
+FullControlT<TA>::stagePayload(TPayload&& payload) {
+	SpinGuard guard{_serial};
+
+	return _payloadPool.stage(std::forward<TPayload>(payload));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 template <typename TA>
 FullControlT<TA>::Lock::Lock(FullControlT& control_)
 	: control(!control_._locked ? &control_ : nullptr)
@@ -175,7 +224,16 @@ FullControlT<TA>::updatePlan(TState& headState,
 
 		return buildPlanStatus<State>();
 	} else if (subStatus.result == Status::SUCCESS) {
-		if (Plan p = plan(_regionId)) {
+		bool planned;
+
+		{
+			// other prongs of a parallel region may be reporting task statuses
+			// or editing their own plans, the plan here doesn't lock again
+			SpinGuard guard{_serial};
+
+			Plan p{_planData, *_planStats, _regionId, nullptr};
+			planned = (bool) p;
+
 			for (auto it = p.first(); it; ++it) {
 				if (isActive(it->origin) &&
 					_planData.tasksSuccesses.get(it->origin))
@@ -188,9 +246,11 @@ FullControlT<TA>::updatePlan(TState& headState,
 				} else
 					break;
 			}
+		}
 
+		if (planned)
 			return Status{};
-		} else {
+		else {
 			_status.result = Status::SUCCESS;
 			headState.wrapPlanSucceeded(*this);
 
@@ -209,6 +269,8 @@ FullControlT<TA>::buildPlanStatus() {
 	using State = TState;
 	static constexpr StateID STATE_ID = State::STATE_ID;
 
+	SpinGuard guard{_serial};
+
 	switch (_status.result) {
 	case Status::NONE:
 		HFSM_BREAK();
@@ -257,7 +319,25 @@ FullControlT<TA>::changeTo(const StateID stateId,
 						   const Payload& payload)
 {
 	if (!_locked) {
-		const Request request{Request::Type::CHANGE, stateId, payload};
+		const Request request{Request::Type::CHANGE, stateId, stagePayload(payload)};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::CHANGE, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+FullControlT<TA>::changeTo(const StateID stateId,
+						   Payload&& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::CHANGE, stateId, stagePayload(std::move(payload))};
 		_requests << request;
 
 		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
@@ -291,7 +371,25 @@ FullControlT<TA>::restart(const StateID stateId,
 						  const Payload& payload)
 {
 	if (!_locked) {
-		const Request request{Request::Type::RESTART, stateId, payload};
+		const Request request{Request::Type::RESTART, stateId, stagePayload(payload)};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::RESTART, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+FullControlT<TA>::restart(const StateID stateId,
+						  Payload&& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::RESTART, stateId, stagePayload(std::move(payload))};
 		_requests << request;
 
 		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
@@ -325,7 +423,25 @@ FullControlT<TA>::resume(const StateID stateId,
 						 const Payload& payload)
 {
 	if (!_locked) {
-		const Request request{Request::Type::RESUME, stateId, payload};
+		const Request request{Request::Type::RESUME, stateId, stagePayload(payload)};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::RESUME, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+FullControlT<TA>::resume(const StateID stateId,
+						 Payload&& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::RESUME, stateId, stagePayload(std::move(payload))};
 		_requests << request;
 
 		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
@@ -359,7 +475,25 @@ FullControlT<TA>::utilize(const StateID stateId,
 						  const Payload& payload)
 {
 	if (!_locked) {
-		const Request request{Request::Type::UTILIZE, stateId, payload};
+		const Request request{Request::Type::UTILIZE, stateId, stagePayload(payload)};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::UTILIZE, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+FullControlT<TA>::utilize(const StateID stateId,
+						  Payload&& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::UTILIZE, stateId, stagePayload(std::move(payload))};
 		_requests << request;
 
 		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
@@ -393,7 +527,25 @@ FullControlT<TA>::randomize(const StateID stateId,
 							const Payload& payload)
 {
 	if (!_locked) {
-		const Request request{Request::Type::RANDOMIZE, stateId, payload};
+		const Request request{Request::Type::RANDOMIZE, stateId, stagePayload(payload)};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::RANDOMIZE, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+FullControlT<TA>::randomize(const StateID stateId,
+							Payload&& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::RANDOMIZE, stateId, stagePayload(std::move(payload))};
 		_requests << request;
 
 		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
@@ -421,7 +573,20 @@ void
 FullControlT<TA>::schedule(const StateID stateId,
 						   const Payload& payload)
 {
-	const Request transition{Request::Type::SCHEDULE, stateId, payload};
+	const Request transition{Request::Type::SCHEDULE, stateId, stagePayload(payload)};
+	_requests << transition;
+
+	HFSM_LOG_TRANSITION(_originId, Transition::SCHEDULE, stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+FullControlT<TA>::schedule(const StateID stateId,
+						   Payload&& payload)
+{
+	const Request transition{Request::Type::SCHEDULE, stateId, stagePayload(std::move(payload))};
 	_requests << transition;
 
 	HFSM_LOG_TRANSITION(_originId, Transition::SCHEDULE, stateId);
@@ -434,6 +599,8 @@ void
 FullControlT<TA>::succeed() {
 	_status.result = Status::SUCCESS;
 
+	SpinGuard guard{_serial};
+
 	_planData.tasksSuccesses.set(_originId);
 
 	// TODO: promote taskSuccess all the way up for all regions without plans
@@ -453,6 +620,8 @@ void
 FullControlT<TA>::fail() {
 	_status.result = Status::FAILURE;
 
+	SpinGuard guard{_serial};
+
 	_planData.tasksFailures.set(_originId);
 
 	// TODO: promote taskFailure all the way up for all regions without plans
@@ -475,6 +644,15 @@ GuardControlT<TA>::cancelPendingTransitions() {
 	HFSM_LOG_CANCELLED_PENDING(_originId);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+const typename GuardControlT<TA>::Payload*
+GuardControlT<TA>::pendingPayload(const Request& request) const {
+	return request.payload != INVALID_SHORT_INDEX ?
+		&_payloadPool[request.payload] : nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 }
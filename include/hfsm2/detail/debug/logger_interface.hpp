@@ -49,6 +49,54 @@ struct LoggerInterfaceT {
 
 using LoggerInterface = LoggerInterfaceT<float>;
 
+//------------------------------------------------------------------------------
+// statically dispatched counterpart of 'LoggerInterfaceT<>', plugged in with
+// 'Config::LoggerT<>': derived loggers hide the methods they need,
+// calls to the rest are inlined into nothing
+
+template <typename TUtilty = float>
+struct StaticLoggerT {
+	using Utilty	  = TUtilty;
+
+	using Method	  = ::hfsm2::Method;
+	using StateID	  = ::hfsm2::StateID;
+	using RegionID	  = ::hfsm2::RegionID;
+	using Transition  = ::hfsm2::Transition;
+	using StatusEvent = ::hfsm2::StatusEvent;
+
+	HFSM_INLINE void recordMethod(const StateID /*origin*/,
+								  const Method /*method*/)
+	{}
+
+	HFSM_INLINE void recordTransition(const StateID /*origin*/,
+									  const Transition /*transition*/,
+									  const StateID /*target*/)
+	{}
+
+	HFSM_INLINE void recordTaskStatus(const RegionID /*region*/,
+									  const StateID /*origin*/,
+									  const StatusEvent /*event*/)
+	{}
+
+	HFSM_INLINE void recordPlanStatus(const RegionID /*region*/,
+									  const StatusEvent /*event*/)
+	{}
+
+	HFSM_INLINE void recordCancelledPending(const StateID /*origin*/) {}
+
+	HFSM_INLINE void recordUtilityResolution(const StateID /*head*/,
+											 const StateID /*prong*/,
+											 const Utilty /*utilty*/)
+	{}
+
+	HFSM_INLINE void recordRandomResolution(const StateID /*head*/,
+											const StateID /*prong*/,
+											const Utilty /*utilty*/)
+	{}
+};
+
+using StaticLogger = StaticLoggerT<float>;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 }
@@ -60,6 +108,9 @@ namespace hfsm2 {
 template <typename = float>
 using LoggerInterfaceT = void;
 
+template <typename = float>
+using StaticLoggerT = void;
+
 }
 
 #endif
@@ -0,0 +1,147 @@
+#pragma once
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+// default clock for 'Config::ProfilerT<>', in CPU cycles where available
+
+struct CycleClock {
+	static HFSM_INLINE uint64_t now() {
+	#if defined _MSC_VER && (defined _M_X64 || defined _M_IX86)
+		return __rdtsc();
+	#elif defined __GNUC__ && (defined __x86_64__ || defined __i386__)
+		return __builtin_ia32_rdtsc();
+	#else
+		return (uint64_t) std::chrono::steady_clock::now().time_since_epoch().count();
+	#endif
+	}
+};
+
+//------------------------------------------------------------------------------
+
+struct MethodProfile {
+	uint64_t calls = 0;
+	uint64_t ticks = 0;
+};
+
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+// per-state, per-method call counts and cumulative time;
+// with no clock in the config, samples are empty and compile away
+
+template <typename TClock,
+		  LongIndex NStateCount>
+class ProfilerT final {
+	static constexpr ShortIndex METHOD_COUNT = (ShortIndex) Method::COUNT;
+
+public:
+	using Clock = TClock;
+
+	static constexpr LongIndex STATE_COUNT = NStateCount;
+
+	class Sample {
+	public:
+		HFSM_INLINE Sample(ProfilerT* const profiler,
+						   const StateID stateId,
+						   const Method method)
+			: _profiler{profiler}
+			, _stateId{stateId}
+			, _method{method}
+			, _start{Clock::now()}
+		{}
+
+		HFSM_INLINE ~Sample();
+
+	private:
+		ProfilerT* const _profiler;
+		const StateID _stateId;
+		const Method _method;
+		const uint64_t _start;
+	};
+
+public:
+	HFSM_INLINE ProfilerT()												{ clear();	}
+
+	HFSM_INLINE void clear();
+
+	HFSM_INLINE const MethodProfile& get(const StateID stateId,
+										 const Method method) const;
+
+	// calls 'receiver(stateId, method, profile)' for every method called
+	template <typename TReceiver>
+	void report(TReceiver& receiver) const;
+
+private:
+	MethodProfile _profiles[STATE_COUNT][METHOD_COUNT];
+};
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NStateCount>
+class ProfilerT<void, NStateCount> final {
+public:
+	struct Sample {
+		HFSM_INLINE Sample(ProfilerT* const, const StateID, const Method)	{}
+	};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// profiler pointer carried by controls,
+// with no clock in the config it takes no space
+
+template <typename TClock,
+		  LongIndex NStateCount>
+class ProfilerLinkT {
+protected:
+	using Profiler = ProfilerT<TClock, NStateCount>;
+
+	HFSM_INLINE ProfilerLinkT(Profiler* const profiler)
+		: _profiler{profiler}
+	{}
+
+	Profiler* const _profiler;
+};
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NStateCount>
+class ProfilerLinkT<void, NStateCount> {
+protected:
+	using Profiler = ProfilerT<void, NStateCount>;
+
+	HFSM_INLINE ProfilerLinkT(Profiler* const)							{}
+
+	static constexpr Profiler* _profiler = nullptr;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// profiler owned by the root, same as above
+
+template <typename TClock,
+		  LongIndex NStateCount>
+class ProfilerHostT {
+protected:
+	using Profiler = ProfilerT<TClock, NStateCount>;
+
+	HFSM_INLINE Profiler* profiler()									{ return &_profiler;	}
+
+	Profiler _profiler;
+};
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NStateCount>
+class ProfilerHostT<void, NStateCount> {
+protected:
+	using Profiler = ProfilerT<void, NStateCount>;
+
+	static HFSM_INLINE Profiler* profiler()								{ return nullptr;		}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "profiler.inl"
@@ -0,0 +1,53 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TC, LongIndex NS>
+ProfilerT<TC, NS>::Sample::~Sample() {
+	if (_profiler) {
+		MethodProfile& profile = _profiler->_profiles[_stateId][(ShortIndex) _method];
+
+		++profile.calls;
+		profile.ticks += Clock::now() - _start;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, LongIndex NS>
+void
+ProfilerT<TC, NS>::clear() {
+	for (auto& state : _profiles)
+		for (auto& profile : state)
+			profile = MethodProfile{};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, LongIndex NS>
+const MethodProfile&
+ProfilerT<TC, NS>::get(const StateID stateId,
+					   const Method method) const
+{
+	HFSM_ASSERT(stateId < STATE_COUNT && method < Method::COUNT);
+
+	return _profiles[stateId][(ShortIndex) method];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, LongIndex NS>
+template <typename TReceiver>
+void
+ProfilerT<TC, NS>::report(TReceiver& receiver) const {
+	for (StateID s = 0; s < STATE_COUNT; ++s)
+		for (ShortIndex m = 0; m < METHOD_COUNT; ++m)
+			if (_profiles[s][m].calls)
+				receiver(s, (Method) m, _profiles[s][m]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+// ring buffer of the calls made into a machine - update(), react(), queue(),
+// flush(), external transitions - and of the random draws they led to;
+// replay() feeds the recording into another machine, substituting the recorded
+// draws, and checks the active states after every call against the original
+
+template <typename TEvents,
+		  typename TPayload,
+		  typename TUtility>
+class ReplayRecorderT;
+
+template <typename... TEvents,
+		  typename TPayload,
+		  typename TUtility>
+class ReplayRecorderT<TL_<TEvents...>, TPayload, TUtility> {
+	template <typename, typename>
+	friend class R_;
+
+	template <typename>
+	friend class ControlT;
+
+	using Events	= ITL_<TEvents...>;
+	using Payload	= TPayload;
+	using Utility	= TUtility;
+
+	static constexpr LongIndex SIZE		 = MaxT<sizeof (Payload), sizeof (Utility), sizeof (TEvents)...>::VALUE;
+	static constexpr LongIndex ALIGNMENT = MaxT<alignof(Payload), alignof(Utility), alignof(TEvents)...>::VALUE;
+
+	template <typename TReceiver>
+	using Thunk = void (*)(TReceiver&, const void*);
+
+	// move-only payloads are not recorded
+	template <typename T>
+	using Storable = std::integral_constant<bool, std::is_copy_constructible<T>::value &&
+												  std::is_trivially_destructible<T>::value>;
+
+public:
+	enum class Kind : ShortIndex {
+		UPDATE,
+		REACT,
+		QUEUE,
+		FLUSH,
+		TRANSITION,
+		PAYLOAD_TRANSITION,
+		RANDOM,
+	};
+
+	// 'type' is the event index in 'Config::EventsT<>' or a 'Transition',
+	// INVALID_SHORT_INDEX for events that could not be recorded
+	struct Record {
+		Kind kind;
+		ShortIndex type;
+		StateID stateId;
+		uint32_t check;
+
+		alignas(ALIGNMENT) unsigned char bytes[SIZE];
+	};
+
+protected:
+	HFSM_INLINE ReplayRecorderT(Record* const records,
+								const LongIndex capacity)
+		: _records{records}
+		, _capacity{capacity}
+	{}
+
+public:
+	ReplayRecorderT(const ReplayRecorderT&) = delete;
+	ReplayRecorderT& operator = (const ReplayRecorderT&) = delete;
+
+	// to replay a trimmed log, start from a snapshot saved when it was cleared
+	HFSM_INLINE void clear()							{ _head = 0; _count = 0; _dropped = 0;	}
+
+	HFSM_INLINE LongIndex count()	const				{ return _count;						}
+	HFSM_INLINE uint32_t  dropped() const				{ return _dropped;						}
+
+	HFSM_INLINE const Record& operator[] (const LongIndex i) const;
+
+	// returns the number of records reproduced faithfully,
+	// equal to count() if the replay matched the recording
+	template <typename TMachine>
+	LongIndex replay(TMachine& machine);
+
+	template <typename TStates>
+	static HFSM_INLINE uint32_t checksum(const TStates& states);
+
+private:
+	HFSM_INLINE Record* recordUpdate()											{ return record(Kind::UPDATE);	}
+	HFSM_INLINE Record* recordFlush()											{ return record(Kind::FLUSH);	}
+
+	template <typename TEvent>
+	HFSM_INLINE Record* recordEvent(const Kind kind, const TEvent& event);
+
+	HFSM_INLINE void recordTransition(const Transition transition, const StateID stateId);
+	HFSM_INLINE void recordTransition(const Transition transition, const StateID stateId, const Payload& payload);
+
+	template <typename TStates>
+	HFSM_INLINE void seal(Record* const record, const TStates& states);
+
+	template <typename TRandom>
+	HFSM_INLINE Utility draw(TRandom& random);
+
+	HFSM_INLINE Record* record(const Kind kind);
+
+	template <typename T>
+	static HFSM_INLINE
+	typename std::enable_if< Storable<T>::value, bool>::type
+	store(Record& record, const T& value)				{ new (&record.bytes) T(value); return true;	}
+
+	template <typename T>
+	static HFSM_INLINE
+	typename std::enable_if<!Storable<T>::value, bool>::type
+	store(Record&, const T&)							{ return false;									}
+
+	template <typename TEvent>
+	static HFSM_INLINE
+	typename std::enable_if< Events::template contains<TEvent>(), ShortIndex>::type
+	storeEvent(Record& record, const TEvent& event)		{ return store(record, event) ? (ShortIndex) Events::template index<TEvent>() : INVALID_SHORT_INDEX;	}
+
+	template <typename TEvent>
+	static HFSM_INLINE
+	typename std::enable_if<!Events::template contains<TEvent>(), ShortIndex>::type
+	storeEvent(Record&, const TEvent&)					{ return INVALID_SHORT_INDEX;					}
+
+	template <typename T>
+	static HFSM_INLINE const T& load(const Record& record)		{ return *reinterpret_cast<const T*>(&record.bytes);	}
+
+	template <typename TMachine>
+	static void replayTransition(TMachine& machine, const Record& record);
+
+	template <typename TReceiver, typename TEvent>
+	static void thunk(TReceiver& receiver, const void* const event)		{ receiver(*static_cast<const TEvent*>(event));	}
+
+	template <typename TMachine>
+	struct Reactor {
+		template <typename TEvent>
+		HFSM_INLINE void operator () (const TEvent& event)				{ machine.react(event);	}
+
+		TMachine& machine;
+	};
+
+	template <typename TMachine>
+	struct Queuer {
+		template <typename TEvent>
+		HFSM_INLINE void operator () (const TEvent& event)				{ machine.queue(event);	}
+
+		TMachine& machine;
+	};
+
+private:
+	Record* const _records;
+	const LongIndex _capacity;
+
+	LongIndex _head  = 0;
+	LongIndex _count = 0;
+	uint32_t _dropped = 0;
+
+	bool _replaying = false;
+	bool _diverged	= false;
+	LongIndex _cursor = 0;
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TEvents,
+		  typename TPayload,
+		  typename TUtility,
+		  LongIndex NCapacity>
+class ReplayLogT final
+	: public ReplayRecorderT<TEvents, TPayload, TUtility>
+{
+	using Recorder = ReplayRecorderT<TEvents, TPayload, TUtility>;
+	using Record   = typename Recorder::Record;
+
+public:
+	static constexpr LongIndex CAPACITY = NCapacity;
+
+	static_assert(CAPACITY > 0 && CAPACITY < INVALID_LONG_INDEX, "Invalid replay log capacity");
+
+	HFSM_INLINE ReplayLogT()
+		: Recorder{_storage, CAPACITY}
+	{}
+
+private:
+	Record _storage[CAPACITY];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "replay_log.inl"
@@ -0,0 +1,260 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename... TE, typename TP, typename TU>
+const typename ReplayRecorderT<TL_<TE...>, TP, TU>::Record&
+ReplayRecorderT<TL_<TE...>, TP, TU>::operator[] (const LongIndex i) const {
+	HFSM_ASSERT(i < _count);
+
+	const LongIndex first = _count < _capacity ? 0 : _head;
+
+	return _records[first + i < _capacity ? first + i : first + i - _capacity];
+}
+
+//------------------------------------------------------------------------------
+
+template <typename... TE, typename TP, typename TU>
+template <typename TMachine>
+LongIndex
+ReplayRecorderT<TL_<TE...>, TP, TU>::replay(TMachine& machine) {
+	static const Thunk<Reactor<TMachine>> REACTORS[] = { &thunk<Reactor<TMachine>, TE>..., nullptr };
+	static const Thunk<Queuer <TMachine>> QUEUERS [] = { &thunk<Queuer <TMachine>, TE>..., nullptr };
+
+	if (_dropped)
+		return 0;
+
+	Reactor<TMachine> reactor{machine};
+	Queuer <TMachine> queuer {machine};
+
+	_replaying = true;
+	_diverged  = false;
+	machine.attachRecorder(this);
+
+	LongIndex replayed = 0;
+
+	for (_cursor = 0; _cursor < _count && !_diverged; ) {
+		const Record& record = (*this)[_cursor++];
+
+		switch (record.kind) {
+		case Kind::UPDATE:
+			machine.update();
+			break;
+
+		case Kind::REACT:
+			if (record.type < Events::SIZE)
+				REACTORS[record.type](reactor, &record.bytes);
+			else
+				_diverged = true;
+			break;
+
+		case Kind::QUEUE:
+			if (record.type < Events::SIZE)
+				QUEUERS[record.type](queuer, &record.bytes);
+			else
+				_diverged = true;
+			break;
+
+		case Kind::FLUSH:
+			machine.flush();
+			break;
+
+		case Kind::TRANSITION:
+		case Kind::PAYLOAD_TRANSITION:
+			if (record.type < (ShortIndex) Transition::COUNT)
+				replayTransition(machine, record);
+			else
+				_diverged = true;
+			break;
+
+		default:
+			// a draw the replayed machine never asked for
+			_diverged = true;
+		}
+
+		if (record.kind != Kind::TRANSITION &&
+			record.kind != Kind::PAYLOAD_TRANSITION)
+		{
+			typename TMachine::ActiveStates states;
+			machine.copyActiveStates(states);
+
+			_diverged |= record.check != checksum(states);
+		}
+
+		if (!_diverged)
+			replayed = _cursor;
+	}
+
+	machine.attachRecorder(nullptr);
+	_replaying = false;
+
+	return replayed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename... TE, typename TP, typename TU>
+template <typename TStates>
+uint32_t
+ReplayRecorderT<TL_<TE...>, TP, TU>::checksum(const TStates& states) {
+	uint32_t hash = 2166136261u;
+
+	for (LongIndex i = states.first(); i < TStates::CAPACITY; i = states.next(i))
+		hash = (hash ^ i) * 16777619u;
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename... TE, typename TP, typename TU>
+template <typename TEvent>
+typename ReplayRecorderT<TL_<TE...>, TP, TU>::Record*
+ReplayRecorderT<TL_<TE...>, TP, TU>::recordEvent(const Kind kind,
+												 const TEvent& event)
+{
+	Record* const record = this->record(kind);
+
+	if (record)
+		record->type = storeEvent(*record, event);
+
+	return record;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename... TE, typename TP, typename TU>
+void
+ReplayRecorderT<TL_<TE...>, TP, TU>::recordTransition(const Transition transition,
+													  const StateID stateId)
+{
+	if (Record* const record = this->record(Kind::TRANSITION)) {
+		record->type	= (ShortIndex) transition;
+		record->stateId = stateId;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename... TE, typename TP, typename TU>
+void
+ReplayRecorderT<TL_<TE...>, TP, TU>::recordTransition(const Transition transition,
+													  const StateID stateId,
+													  const Payload& payload)
+{
+	if (Record* const record = this->record(Kind::PAYLOAD_TRANSITION)) {
+		record->type	= store(*record, payload) ? (ShortIndex) transition : INVALID_SHORT_INDEX;
+		record->stateId = stateId;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename... TE, typename TP, typename TU>
+template <typename TStates>
+void
+ReplayRecorderT<TL_<TE...>, TP, TU>::seal(Record* const record,
+										  const TStates& states)
+{
+	if (record)
+		record->check = checksum(states);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename... TE, typename TP, typename TU>
+template <typename TRandom>
+typename ReplayRecorderT<TL_<TE...>, TP, TU>::Utility
+ReplayRecorderT<TL_<TE...>, TP, TU>::draw(TRandom& random) {
+	if (_replaying) {
+		if (_cursor < _count) {
+			const Record& record = (*this)[_cursor];
+
+			if (record.kind == Kind::RANDOM) {
+				++_cursor;
+
+				return load<Utility>(record);
+			}
+		}
+
+		_diverged = true;
+
+		return random.next();
+	} else {
+		const Utility value = random.next();
+
+		if (Record* const record = this->record(Kind::RANDOM))
+			store(*record, value);
+
+		return value;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename... TE, typename TP, typename TU>
+typename ReplayRecorderT<TL_<TE...>, TP, TU>::Record*
+ReplayRecorderT<TL_<TE...>, TP, TU>::record(const Kind kind) {
+	if (_replaying)
+		return nullptr;
+
+	Record& record = _records[_head];
+	_head = _head + 1 < _capacity ? _head + 1 : 0;
+
+	if (_count < _capacity)
+		++_count;
+	else
+		++_dropped;
+
+	record.kind	   = kind;
+	record.type	   = INVALID_SHORT_INDEX;
+	record.stateId = INVALID_STATE_ID;
+	record.check   = 0;
+
+	return &record;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename... TE, typename TP, typename TU>
+template <typename TMachine>
+void
+ReplayRecorderT<TL_<TE...>, TP, TU>::replayTransition(TMachine& machine,
+													  const Record& record)
+{
+	const StateID stateId = record.stateId;
+
+	if (record.kind == Kind::TRANSITION)
+		switch ((Transition) record.type) {
+		case Transition::CHANGE:	machine.changeTo (stateId);	break;
+		case Transition::RESTART:	machine.restart	 (stateId);	break;
+		case Transition::RESUME:	machine.resume	 (stateId);	break;
+		case Transition::UTILIZE:	machine.utilize	 (stateId);	break;
+		case Transition::RANDOMIZE:	machine.randomize(stateId);	break;
+		case Transition::SCHEDULE:	machine.schedule (stateId);	break;
+
+		default:
+			HFSM_BREAK();
+		}
+	else {
+		const Payload& payload = load<Payload>(record);
+
+		switch ((Transition) record.type) {
+		case Transition::CHANGE:	machine.changeTo (stateId, payload);	break;
+		case Transition::RESTART:	machine.restart	 (stateId, payload);	break;
+		case Transition::RESUME:	machine.resume	 (stateId, payload);	break;
+		case Transition::UTILIZE:	machine.utilize	 (stateId, payload);	break;
+		case Transition::RANDOMIZE:	machine.randomize(stateId, payload);	break;
+		case Transition::SCHEDULE:	machine.schedule (stateId, payload);	break;
+
+		default:
+			HFSM_BREAK();
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+// fixed-size binary trace entry, decoded offline by 'tools/decode_trace.py';
+// for task and plan statuses 'target' holds the region
+
+struct TraceRecord {
+	enum class Kind : uint8_t {
+		METHOD,
+		TRANSITION,
+		TASK_STATUS,
+		PLAN_STATUS,
+		CANCELLED_PENDING,
+		UTILITY_RESOLUTION,
+		RANDOM_RESOLUTION,
+	};
+
+	uint64_t timestamp;
+	uint16_t machineId;
+	StateID stateId;
+	StateID target;
+	Kind kind;
+	uint8_t code;		// 'Method', 'Transition' or 'StatusEvent'
+};
+
+static_assert(sizeof(TraceRecord) == 16, "TraceRecord must stay 16 bytes to match the decoder");
+
+//------------------------------------------------------------------------------
+// single-producer / single-consumer ring of trace records, one per thread:
+// machines updated on the thread share it through 'Config::LoggerT<>' and
+// select() their id before each call, another thread drains the records;
+// records are dropped, not blocked on, when the ring is full
+
+template <LongIndex NCapacity,
+		  typename TClock = CycleClock,
+		  typename TUtilty = float>
+class TraceLoggerT
+	: public StaticLoggerT<TUtilty>
+{
+	using Base = StaticLoggerT<TUtilty>;
+
+public:
+	using Clock		  = TClock;
+	using Index		  = std::size_t;
+
+	using typename Base::Utilty;
+	using typename Base::Method;
+	using typename Base::StateID;
+	using typename Base::RegionID;
+	using typename Base::Transition;
+	using typename Base::StatusEvent;
+
+	using Kind		  = TraceRecord::Kind;
+
+	static constexpr LongIndex CAPACITY = NCapacity;
+
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "Trace capacity must be a power of 2");
+
+public:
+	TraceLoggerT()
+		: _head{0}
+		, _tail{0}
+		, _dropped{0}
+	{}
+
+	TraceLoggerT(const TraceLoggerT&) = delete;
+	TraceLoggerT& operator = (const TraceLoggerT&) = delete;
+
+	// producer
+
+	HFSM_INLINE void select(const uint16_t machineId)					{ _machineId = machineId;	}
+
+	HFSM_INLINE void recordMethod(const StateID origin,
+								  const Method method)
+	{
+		push(Kind::METHOD, origin, INVALID_STATE_ID, (uint8_t) method);
+	}
+
+	HFSM_INLINE void recordTransition(const StateID origin,
+									  const Transition transition,
+									  const StateID target)
+	{
+		push(Kind::TRANSITION, origin, target, (uint8_t) transition);
+	}
+
+	HFSM_INLINE void recordTaskStatus(const RegionID region,
+									  const StateID origin,
+									  const StatusEvent event)
+	{
+		push(Kind::TASK_STATUS, origin, region, (uint8_t) event);
+	}
+
+	HFSM_INLINE void recordPlanStatus(const RegionID region,
+									  const StatusEvent event)
+	{
+		push(Kind::PLAN_STATUS, INVALID_STATE_ID, region, (uint8_t) event);
+	}
+
+	HFSM_INLINE void recordCancelledPending(const StateID origin) {
+		push(Kind::CANCELLED_PENDING, origin, INVALID_STATE_ID, 0);
+	}
+
+	HFSM_INLINE void recordUtilityResolution(const StateID head,
+											 const StateID prong,
+											 const Utilty /*utilty*/)
+	{
+		push(Kind::UTILITY_RESOLUTION, head, prong, 0);
+	}
+
+	HFSM_INLINE void recordRandomResolution(const StateID head,
+											const StateID prong,
+											const Utilty /*utilty*/)
+	{
+		push(Kind::RANDOM_RESOLUTION, head, prong, 0);
+	}
+
+	// consumer
+
+	bool pop(TraceRecord& record);
+
+	// calls 'receiver(record)' for up to CAPACITY records, returns their count
+	template <typename TReceiver>
+	LongIndex drain(TReceiver& receiver);
+
+	HFSM_INLINE uint32_t dropped() const								{ return _dropped.load(std::memory_order_relaxed);	}
+
+private:
+	HFSM_INLINE void push(const Kind kind,
+						  const StateID stateId,
+						  const StateID target,
+						  const uint8_t code);
+
+private:
+	static constexpr Index MASK = CAPACITY - 1;
+
+	alignas(64) std::atomic<Index> _head;
+
+	alignas(64) std::atomic<Index> _tail;
+	Index _cachedHead = 0;
+	uint16_t _machineId = 0;
+	std::atomic<uint32_t> _dropped;
+
+	alignas(64) TraceRecord _records[CAPACITY];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#include "trace_logger.inl"
+
+#endif
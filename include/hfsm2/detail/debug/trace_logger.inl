@@ -0,0 +1,72 @@
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NC, typename TC, typename TU>
+bool
+TraceLoggerT<NC, TC, TU>::pop(TraceRecord& record) {
+	const Index head = _head.load(std::memory_order_relaxed);
+
+	if (head == _tail.load(std::memory_order_acquire))
+		return false;
+
+	record = _records[head & MASK];
+	_head.store(head + 1, std::memory_order_release);
+
+	return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename TC, typename TU>
+template <typename TReceiver>
+LongIndex
+TraceLoggerT<NC, TC, TU>::drain(TReceiver& receiver) {
+	const Index head = _head.load(std::memory_order_relaxed);
+	const Index tail = _tail.load(std::memory_order_acquire);
+
+	const LongIndex count = (LongIndex) (tail - head);
+
+	for (Index i = head; i != tail; ++i)
+		receiver(_records[i & MASK]);
+
+	_head.store(tail, std::memory_order_release);
+
+	return count;
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NC, typename TC, typename TU>
+void
+TraceLoggerT<NC, TC, TU>::push(const Kind kind,
+							   const StateID stateId,
+							   const StateID target,
+							   const uint8_t code)
+{
+	const Index tail = _tail.load(std::memory_order_relaxed);
+
+	if (tail - _cachedHead == CAPACITY) {
+		_cachedHead = _head.load(std::memory_order_acquire);
+
+		if (tail - _cachedHead == CAPACITY) {
+			_dropped.fetch_add(1, std::memory_order_relaxed);
+
+			return;
+		}
+	}
+
+	TraceRecord& record = _records[tail & MASK];
+	record.timestamp = Clock::now();
+	record.machineId = _machineId;
+	record.stateId	 = stateId;
+	record.target	 = target;
+	record.kind		 = kind;
+	record.code		 = code;
+
+	_tail.store(tail + 1, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -25,6 +25,11 @@ protected:
 	using FullControl	= FullControlT <TArgs>;
 	using GuardControl	= GuardControlT<TArgs>;
 
+#ifdef HFSM_ENABLE_COROUTINES
+	using RoutineControl = RoutineControlT<TArgs>;
+	using Routine		= RoutineT<TArgs>;
+#endif
+
 public:
 	HFSM_INLINE void preEntryGuard(Context&)									{}
 
@@ -127,6 +127,7 @@ class PlanT {
 
 public:
 	using PlanData		= PlanDataT<Args>;
+	using PlanStats		= typename PlanData::Stats;
 	using TaskLinks		= typename PlanData::TaskLinks;
 	using TaskIndex		= typename TaskLinks::Index;
 
@@ -158,7 +159,9 @@ public:
 
 private:
 	HFSM_INLINE PlanT(PlanData& planData,
-					  const RegionID regionId);
+					  PlanStats& planStats,
+					  const RegionID regionId,
+					  SpinLock* const serial);
 
 	template <typename T>
 	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
@@ -233,8 +236,12 @@ private:
 
 private:
 	PlanData& _planData;
+	PlanStats& _planStats;
 	const RegionID _regionId;
 	Bounds& _bounds;
+
+	// task storage is shared by the prongs of parallel regions
+	SpinLock* const _serial;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
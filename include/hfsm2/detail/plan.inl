@@ -140,11 +140,15 @@ PlanT<TArgs>::Iterator::next() const {
 
 template <typename TArgs>
 PlanT<TArgs>::PlanT(PlanData& planData,
-					const RegionID regionId)
+					PlanStats& planStats,
+					const RegionID regionId,
+					SpinLock* const serial)
 
 	: _planData{planData}
+	, _planStats{planStats}
 	, _regionId{regionId}
 	, _bounds{planData.tasksBounds[regionId]}
+	, _serial{serial}
 {}
 
 //------------------------------------------------------------------------------
@@ -168,11 +172,26 @@ PlanT<TArgs>::append(const Transition transition,
 					 const StateID origin,
 					 const StateID destination)
 {
-	_planData.planExists.set(_regionId);
+	SpinGuard guard{_serial};
 
 	const TaskIndex index = _planData.taskLinks.emplace(transition, origin, destination);
-	if (index == TaskLinks::INVALID)
+	if (index == TaskLinks::INVALID) {
+		// counted, not a fault: raise 'ConfigT<>::TaskCapacityN<>' above 'taskHighWater()'
+		++_planStats.overflows;
+
 		return false;
+	}
+
+	_planData.planExists.set(_regionId);
+
+	LongIndex& count = _planData.taskCounts[_regionId];
+	++count;
+
+	if (_planStats.highWaters[_regionId] < count)
+		_planStats.highWaters[_regionId] = count;
+
+	if (_planStats.highWater < _planData.taskLinks.count())
+		_planStats.highWater = _planData.taskLinks.count();
 
 	if (_bounds.first < TaskLinks::CAPACITY) {
 		HFSM_ASSERT(_bounds.last < TaskLinks::CAPACITY);
@@ -200,6 +219,8 @@ PlanT<TArgs>::append(const Transition transition,
 template <typename TArgs>
 void
 PlanT<TArgs>::clear() {
+	SpinGuard guard{_serial};
+
 	if (_bounds.first < TaskLinks::CAPACITY) {
 		HFSM_ASSERT(_bounds.last < TaskLinks::CAPACITY);
 
@@ -223,6 +244,8 @@ PlanT<TArgs>::clear() {
 
 		_bounds.first = INVALID_LONG_INDEX;
 		_bounds.last  = INVALID_LONG_INDEX;
+
+		_planData.taskCounts[_regionId] = 0;
 	} else
 		HFSM_ASSERT(_bounds.first == INVALID_LONG_INDEX &&
 			   _bounds.last  == INVALID_LONG_INDEX);
@@ -233,6 +256,8 @@ PlanT<TArgs>::clear() {
 template <typename TArgs>
 void
 PlanT<TArgs>::remove(const LongIndex task) {
+	SpinGuard guard{_serial};
+
 	HFSM_ASSERT(_planData.planExists.get(_regionId) &&
 				_bounds.first < TaskLinks::CAPACITY &&
 				_bounds.last  < TaskLinks::CAPACITY);
@@ -258,6 +283,9 @@ PlanT<TArgs>::remove(const LongIndex task) {
 	}
 
 	_planData.taskLinks.remove(task);
+
+	HFSM_ASSERT(_planData.taskCounts[_regionId] > 0);
+	--_planData.taskCounts[_regionId];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
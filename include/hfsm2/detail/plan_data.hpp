@@ -43,7 +43,8 @@ template <typename,
 		  LongIndex,
 		  LongIndex,
 		  typename,
-		  LongIndex>
+		  LongIndex,
+		  typename>
 struct ArgsT;
 
 template <typename>
@@ -59,7 +60,8 @@ template <typename TContext,
 		  LongIndex NOrthoCount,
 		  LongIndex NOrthoUnits,
 		  typename TPayload,
-		  LongIndex NTaskCapacity>
+		  LongIndex NTaskCapacity,
+		  typename TApex>
 struct PlanDataT<ArgsT<TContext,
 					   TConfig,
 					   TStateList,
@@ -68,18 +70,28 @@ struct PlanDataT<ArgsT<TContext,
 					   NOrthoCount,
 					   NOrthoUnits,
 					   TPayload,
-					   NTaskCapacity>>
+					   NTaskCapacity,
+					   TApex>>
 {
 	using StateList		= TStateList;
 	using RegionList	= TRegionList;
 
 	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
-	static constexpr ShortIndex TASK_CAPACITY = NTaskCapacity;
+	static constexpr LongIndex  TASK_CAPACITY = NTaskCapacity;
 
 	using TaskLinks		= List<TaskLink, TASK_CAPACITY>;
 	using TasksBounds	= Array<Bounds, RegionList::SIZE>;
 	using TasksBits		= BitArray<StateID, StateList::SIZE>;
 	using RegionBits	= BitArray<RegionID, RegionList::SIZE>;
+	using TaskCounts	= StaticArray<LongIndex, RegionList::SIZE>;
+
+	// usage of 'taskLinks', kept by the machine outside of its snapshots,
+	// see 'ConfigT<>::TaskCapacityN<>'
+	struct Stats {
+		TaskCounts highWaters{0};	// most tasks planned at once, per region
+		LongIndex highWater = 0;	// .. and in total
+		LongIndex overflows = 0;	// tasks dropped because 'taskLinks' was full
+	};
 
 	TaskLinks taskLinks;
 	TasksBounds tasksBounds;
@@ -87,6 +99,24 @@ struct PlanDataT<ArgsT<TContext,
 	TasksBits tasksFailures;
 	RegionBits planExists;
 
+	TaskCounts taskCounts{0};
+
+	// snapshot wire format: plan bits, then every region's task count
+	// and tasks in plan order, ids little-endian
+	static constexpr std::size_t TASK_WIRE_SIZE = 5;
+
+	static constexpr std::size_t WIRE_CAPACITY = bitsSize<RegionBits>()
+											   + bitsSize<TasksBits>() * 2
+											   + REGION_COUNT * 2
+											   + TASK_CAPACITY * TASK_WIRE_SIZE;
+
+	HFSM_INLINE std::size_t wireSize() const	{ return WIRE_CAPACITY - (TASK_CAPACITY - taskLinks.count()) * TASK_WIRE_SIZE;	}
+
+	void write(unsigned char*& cursor) const;
+
+	// into empty plans, false if tasks don't fit or refer to unknown states
+	bool read(const unsigned char*& cursor, const unsigned char* const end);
+
 #ifdef HFSM_ENABLE_ASSERT
 	void verifyPlans() const;
 	LongIndex verifyPlan(const RegionID stateId) const;
@@ -102,7 +132,8 @@ template <typename TContext,
 		  LongIndex NOrthoCount,
 		  LongIndex NOrthoUnits,
 		  typename TPayload,
-		  LongIndex NTaskCapacity>
+		  LongIndex NTaskCapacity,
+		  typename TApex>
 struct PlanDataT<ArgsT<TContext,
 					   TConfig,
 					   TStateList,
@@ -111,8 +142,18 @@ struct PlanDataT<ArgsT<TContext,
 					   NOrthoCount,
 					   NOrthoUnits,
 					   TPayload,
-					   NTaskCapacity>>
+					   NTaskCapacity,
+					   TApex>>
 {
+	struct Stats {};
+
+	static constexpr std::size_t WIRE_CAPACITY = 0;
+
+	HFSM_INLINE std::size_t wireSize() const									{ return 0;		}
+
+	HFSM_INLINE void write(unsigned char*&) const								{}
+	HFSM_INLINE bool read(const unsigned char*&, const unsigned char* const)	{ return true;	}
+
 #ifdef HFSM_ENABLE_ASSERT
 	void verifyPlans() const													{}
 	LongIndex verifyPlan(const RegionID) const					{ return 0;		}
@@ -3,11 +3,101 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+void
+PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::write(unsigned char*& cursor) const {
+	writeBits(cursor, planExists);
+	writeBits(cursor, tasksSuccesses);
+	writeBits(cursor, tasksFailures);
+
+	for (RegionID id = 0; id < REGION_COUNT; ++id) {
+		*cursor++ = (unsigned char) (taskCounts[id]);
+		*cursor++ = (unsigned char) (taskCounts[id] >> 8);
+
+		for (LongIndex index = tasksBounds[id].first;
+			 index < TASK_CAPACITY;
+			 index = taskLinks[index].next)
+		{
+			const TaskLink& task = taskLinks[index];
+
+			*cursor++ = (unsigned char) task.transition;
+			*cursor++ = (unsigned char) (task.origin);
+			*cursor++ = (unsigned char) (task.origin >> 8);
+			*cursor++ = (unsigned char) (task.destination);
+			*cursor++ = (unsigned char) (task.destination >> 8);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+bool
+PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::read(const unsigned char*& cursor,
+																	   const unsigned char* const end)
+{
+	HFSM_ASSERT(taskLinks.count() == 0);
+
+	if ((std::size_t) (end - cursor) < WIRE_CAPACITY - TASK_CAPACITY * TASK_WIRE_SIZE ||
+		!readBits(cursor, planExists) ||
+		!readBits(cursor, tasksSuccesses) ||
+		!readBits(cursor, tasksFailures))
+	{
+		return false;
+	}
+
+	for (RegionID id = 0; id < REGION_COUNT; ++id) {
+		if (end - cursor < 2)
+			return false;
+
+		const LongIndex count = (LongIndex) (cursor[0] | cursor[1] << 8);
+		cursor += 2;
+
+		if (count > TASK_CAPACITY - taskLinks.count() ||
+			(std::size_t) (end - cursor) < count * TASK_WIRE_SIZE)
+		{
+			return false;
+		}
+
+		Bounds& bounds = tasksBounds[id];
+
+		for (LongIndex t = 0; t < count; ++t) {
+			const ShortIndex transition	 = cursor[0];
+			const StateID origin		 = (StateID) (cursor[1] | cursor[2] << 8);
+			const StateID destination	 = (StateID) (cursor[3] | cursor[4] << 8);
+			cursor += TASK_WIRE_SIZE;
+
+			if (transition  >= (ShortIndex) Transition::COUNT ||
+				origin		>= StateList::SIZE ||
+				destination >= StateList::SIZE)
+			{
+				return false;
+			}
+
+			const LongIndex index = taskLinks.emplace((Transition) transition, origin, destination);
+
+			if (bounds.last < TASK_CAPACITY) {
+				taskLinks[bounds.last].next = index;
+				taskLinks[index].prev = bounds.last;
+			} else
+				bounds.first = index;
+
+			bounds.last = index;
+		}
+
+		taskCounts[id] = count;
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 #ifdef HFSM_ENABLE_ASSERT
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
 void
-PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::verifyPlans() const {
+PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::verifyPlans() const {
 	LongIndex planCount = 0;
 	for (RegionID id = 0; id < REGION_COUNT; ++id)
 		planCount += verifyPlan(id);
@@ -17,9 +107,9 @@ PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::verifyPlans() const
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
 LongIndex
-PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::verifyPlan(const RegionID regionId) const {
+PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::verifyPlan(const RegionID regionId) const {
 	LongIndex length = 0;
 	const Bounds& bounds = tasksBounds[regionId];
 
@@ -54,6 +144,8 @@ PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::verifyPlan(const Re
 	} else
 		HFSM_ASSERT(bounds.last == INVALID_LONG_INDEX);
 
+	HFSM_ASSERT(taskCounts[regionId] == length);
+
 	return length;
 }
 
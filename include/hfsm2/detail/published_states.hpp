@@ -0,0 +1,80 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+// copy of the machine's active and resumable states, safe to query from other
+// threads while the owning thread runs transitions;
+// the machine writes the older of two buffers after every transition pass,
+// then makes it the latest one; single state queries are one atomic load,
+// full copies are retried only if the machine publishes twice during one
+
+template <typename TArgs>
+class PublishedStatesT final {
+	template <typename, typename>
+	friend class R_;
+
+	using Args				= TArgs;
+	using StateRegistry		= StateRegistryT<Args>;
+	using StateList			= typename StateRegistry::StateList;
+	using Topology			= typename StateRegistry::Topology;
+
+	static constexpr LongIndex  STATE_COUNT	  = StateRegistry::STATE_COUNT;
+	static constexpr ShortIndex COMPO_REGIONS = StateRegistry::COMPO_REGIONS;
+
+public:
+	using ActiveStates		= typename StateRegistry::ActiveStates;
+
+private:
+	using Word				= typename ActiveStates::Word;
+
+	static constexpr LongIndex ACTIVE_WORDS	   = ActiveStates::WORD_COUNT;
+
+	// resumable prongs of composite regions, one byte each
+	static constexpr LongIndex RESUMABLE_WORDS = (COMPO_REGIONS + sizeof(Word) - 1) / sizeof(Word);
+
+	struct Buffer {
+		// odd while being written
+		std::atomic<uint32_t> sequence;
+
+		std::atomic<Word> active[ACTIVE_WORDS];
+		std::atomic<Word> resumable[RESUMABLE_WORDS];
+	};
+
+public:
+	PublishedStatesT();
+
+	PublishedStatesT(const PublishedStatesT&) = delete;
+	PublishedStatesT& operator = (const PublishedStatesT&) = delete;
+
+	template <typename T>
+	static constexpr StateID stateId()							{ return StateList::template index<T>();	}
+
+	HFSM_INLINE bool isActive   (const StateID stateId) const;
+	HFSM_INLINE bool isResumable(const StateID stateId) const;
+
+	template <typename TState>
+	HFSM_INLINE bool isActive   () const						{ return isActive	(stateId<TState>());	}
+
+	template <typename TState>
+	HFSM_INLINE bool isResumable() const						{ return isResumable(stateId<TState>());	}
+
+	// all states from the same transition pass
+	void copyActiveStates(ActiveStates& states) const;
+
+private:
+	// called by the owning machine only
+	void publish(const StateRegistry& stateRegistry);
+
+	HFSM_INLINE const Buffer& latest() const	{ return _buffers[_latest.load(std::memory_order_acquire)];	}
+
+private:
+	Buffer _buffers[2];
+	std::atomic<ShortIndex> _latest;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "published_states.inl"
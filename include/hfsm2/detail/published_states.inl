@@ -0,0 +1,109 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TA>
+PublishedStatesT<TA>::PublishedStatesT() {
+	for (Buffer& buffer : _buffers) {
+		buffer.sequence.store(0, std::memory_order_relaxed);
+
+		for (auto& word : buffer.active)
+			word.store(0, std::memory_order_relaxed);
+
+		for (auto& word : buffer.resumable)
+			word.store(~Word{0}, std::memory_order_relaxed);
+	}
+
+	_latest.store(0, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+bool
+PublishedStatesT<TA>::isActive(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
+		const Word word = latest().active[stateId / ActiveStates::WORD_BITS].load(std::memory_order_relaxed);
+
+		return (word >> (stateId % ActiveStates::WORD_BITS) & 1) != 0;
+	}
+
+	return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+bool
+PublishedStatesT<TA>::isResumable(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (const Parent parent = Topology::STATE_COMPOS[stateId]) {
+			const LongIndex compo = parent.forkId - 1;
+			const Word word = latest().resumable[compo / sizeof(Word)].load(std::memory_order_relaxed);
+
+			return parent.prong == (ShortIndex) (word >> compo % sizeof(Word) * 8);
+		}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+void
+PublishedStatesT<TA>::copyActiveStates(ActiveStates& states) const {
+	for (;;) {
+		const Buffer& buffer = latest();
+
+		const uint32_t sequence = buffer.sequence.load(std::memory_order_acquire);
+		if (sequence & 1)
+			continue;
+
+		for (LongIndex i = 0; i < ACTIVE_WORDS; ++i)
+			states.setWord(i, buffer.active[i].load(std::memory_order_relaxed));
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (buffer.sequence.load(std::memory_order_relaxed) == sequence)
+			return;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+void
+PublishedStatesT<TA>::publish(const StateRegistry& stateRegistry) {
+	const ShortIndex next = _latest.load(std::memory_order_relaxed) ^ 1;
+	Buffer& buffer = _buffers[next];
+
+	const uint32_t sequence = buffer.sequence.load(std::memory_order_relaxed);
+	buffer.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	for (LongIndex i = 0; i < ACTIVE_WORDS; ++i)
+		buffer.active[i].store(stateRegistry.activeStates.word(i), std::memory_order_relaxed);
+
+	for (LongIndex i = 0; i < RESUMABLE_WORDS; ++i) {
+		Word word = 0;
+
+		for (LongIndex b = 0; b < sizeof(Word); ++b) {
+			const LongIndex compo = i * sizeof(Word) + b;
+			const ShortIndex prong = compo < COMPO_REGIONS ?
+				stateRegistry.resumable.compo[compo] : INVALID_SHORT_INDEX;
+
+			word |= (Word) prong << b * 8;
+		}
+
+		buffer.resumable[i].store(word, std::memory_order_relaxed);
+	}
+
+	buffer.sequence.store(sequence + 2, std::memory_order_release);
+	_latest.store(next, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -0,0 +1,334 @@
+#ifdef HFSM_ENABLE_COROUTINES
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+// coroutine frames are prefixed with the allocator they came from,
+// so they can be released from the promise's 'operator delete';
+// the machine scopes its allocator around calls to 'routine()'
+
+class RoutineAllocator {
+public:
+	static constexpr std::size_t HEADER = alignof(std::max_align_t);
+
+	struct Scope {
+		HFSM_INLINE Scope(RoutineAllocator& allocator)
+			: previous{current()}
+		{
+			current() = &allocator;
+		}
+
+		HFSM_INLINE ~Scope()									{ current() = previous;	}
+
+		RoutineAllocator* const previous;
+	};
+
+	static void* acquire(const std::size_t size) {
+		RoutineAllocator* const allocator = current();
+		HFSM_ASSERT(allocator);
+
+		return allocator ? allocator->allocate(size) : nullptr;
+	}
+
+	static void release(void* const frame) {
+		unsigned char* const header = static_cast<unsigned char*>(frame) - HEADER;
+
+		(*reinterpret_cast<RoutineAllocator**>(header))->deallocate(frame);
+	}
+
+protected:
+	virtual void* allocate(const std::size_t size) = 0;
+	virtual void deallocate(void* const frame) = 0;
+
+private:
+	static RoutineAllocator*& current() {
+		static thread_local RoutineAllocator* allocator = nullptr;
+
+		return allocator;
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// fixed number of fixed-size frames, no heap allocations
+
+template <LongIndex NCapacity, LongIndex NFrameSize>
+class RoutineArenaT final
+	: public RoutineAllocator
+{
+public:
+	static constexpr LongIndex CAPACITY	  = NCapacity > 0 ? NCapacity : 1;
+	static constexpr LongIndex FRAME_SIZE = NFrameSize;
+
+private:
+	static constexpr std::size_t STRIDE = HEADER + (FRAME_SIZE + HEADER - 1) / HEADER * HEADER;
+
+	using Used = BitArray<LongIndex, CAPACITY>;
+
+public:
+	HFSM_INLINE LongIndex count() const						{ return _used.count();	}
+
+protected:
+	// nullptr if the frame doesn't fit, see 'ConfigT<>::RoutineFrameSizeN<>'
+	void* allocate(const std::size_t size) override;
+	void deallocate(void* const frame) override;
+
+private:
+	alignas(HEADER) unsigned char _storage[CAPACITY * STRIDE];
+	Used _used;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// unique address per event type, to match awaited events without RTTI
+template <typename TEvent>
+struct EventTag {
+	static constexpr char ID = 0;
+};
+
+//------------------------------------------------------------------------------
+
+template <typename>
+class RoutineT;
+
+template <typename>
+class RoutinesT;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// handed to the state's 'routine()', outlives the coroutine;
+// control() is only valid while the routine runs, i.e. between two co_await's
+
+template <typename TArgs>
+class RoutineControlT final {
+	template <typename>
+	friend class RoutinesT;
+
+	using Args			= TArgs;
+	using Context		= typename Args::Context;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
+
+	using FullControl	= FullControlT<Args>;
+	using Plan			= PlanT<Args>;
+
+	enum class Wait : ShortIndex {
+		FRAMES,
+		EVENT,
+		PLAN,
+	};
+
+public:
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct Frames {
+		HFSM_INLINE bool await_ready() const noexcept						{ return count == 0;		}
+		HFSM_INLINE void await_suspend(std::coroutine_handle<>) noexcept	{ routine.waitFrames(count);	}
+		HFSM_INLINE void await_resume() const noexcept						{}
+
+		RoutineControlT& routine;
+		const LongIndex count;
+	};
+
+	template <typename TEvent>
+	struct Event {
+		HFSM_INLINE bool await_ready() const noexcept						{ return false;				}
+		HFSM_INLINE void await_suspend(std::coroutine_handle<>) noexcept	{ routine.waitEvent(&EventTag<TEvent>::ID);	}
+		HFSM_INLINE const TEvent& await_resume() const noexcept				{ return *static_cast<const TEvent*>(routine._event);	}
+
+		RoutineControlT& routine;
+	};
+
+	struct PlanCompletion {
+		HFSM_INLINE bool await_ready() noexcept								{ return !routine.plan();	}
+		HFSM_INLINE void await_suspend(std::coroutine_handle<>) noexcept	{ routine._wait = Wait::PLAN;	}
+		HFSM_INLINE void await_resume() const noexcept						{}
+
+		RoutineControlT& routine;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	template <typename T>
+	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
+
+	template <typename T>
+	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
+
+	HFSM_INLINE FullControl& control()					{ HFSM_ASSERT(_control); return *_control;				}
+
+	HFSM_INLINE Context& _()							{ return control()._();									}
+	HFSM_INLINE Context& context()						{ return control().context();							}
+
+	// plan of the region the routine's state is in
+	HFSM_INLINE Plan plan()								{ return control().plan();								}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	// resumes on the next update()
+	HFSM_INLINE Frames nextFrame()						{ return Frames{*this, 1};								}
+
+	// resumes on the 'count'-th update() from now
+	HFSM_INLINE Frames frames(const LongIndex count)	{ return Frames{*this, count};							}
+
+	// resumes on the next react() to 'TEvent', returns the event
+	template <typename TEvent>
+	HFSM_INLINE Event<TEvent> event()					{ return Event<TEvent>{*this};							}
+
+	// resumes on the first update() without a plan in the routine's region
+	HFSM_INLINE PlanCompletion planCompletion()			{ return PlanCompletion{*this};							}
+
+private:
+	HFSM_INLINE void waitFrames(const LongIndex count)	{ _wait = Wait::FRAMES; _frames = count;				}
+	HFSM_INLINE void waitEvent (const char* const type)	{ _wait = Wait::EVENT;  _eventType = type;				}
+
+private:
+	FullControl* _control = nullptr;
+	std::coroutine_handle<> _handle;
+
+	Wait _wait = Wait::FRAMES;
+	LongIndex _frames = 0;
+	const char* _eventType = nullptr;
+	const void* _event = nullptr;
+
+	StateID _stateId = INVALID_STATE_ID;
+};
+
+//------------------------------------------------------------------------------
+// return type of state routines:
+//
+//	Routine routine(RoutineControl& routine) {
+//		co_await routine.frames(3);
+//		routine.control().changeTo<Next>();
+//	}
+//
+// started suspended after the state's enter(), first resumed on the next
+// update(), destroyed before its exit(); frames come from the machine's arena
+
+template <typename TArgs>
+class RoutineT final {
+	template <typename>
+	friend class RoutinesT;
+
+public:
+	struct promise_type {
+		static void* operator new(const std::size_t size) noexcept	{ return RoutineAllocator::acquire(size);		}
+		static void operator delete(void* const frame) noexcept		{ RoutineAllocator::release(frame);				}
+
+		static RoutineT get_return_object_on_allocation_failure() noexcept	{ return RoutineT{};					}
+
+		RoutineT get_return_object() noexcept						{ return RoutineT{Handle::from_promise(*this)};	}
+
+		std::suspend_always initial_suspend() const noexcept		{ return {};									}
+		std::suspend_always final_suspend() const noexcept			{ return {};									}
+
+		void return_void() const noexcept							{}
+		void unhandled_exception() const noexcept					{ std::terminate();								}
+	};
+
+	using Handle = std::coroutine_handle<promise_type>;
+
+	HFSM_INLINE RoutineT() = default;
+
+	HFSM_INLINE RoutineT(RoutineT&& other) noexcept
+		: _handle{other._handle}
+	{
+		other._handle = nullptr;
+	}
+
+	RoutineT(const RoutineT&) = delete;
+	RoutineT& operator = (const RoutineT&) = delete;
+
+	HFSM_INLINE ~RoutineT()										{ if (_handle) _handle.destroy();				}
+
+	// false if the frame didn't fit into the arena
+	HFSM_INLINE explicit operator bool() const					{ return (bool) _handle;						}
+
+private:
+	HFSM_INLINE explicit RoutineT(const Handle handle)
+		: _handle{handle}
+	{}
+
+private:
+	Handle _handle;
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TState, typename TRoutineControl, typename = void>
+struct HasRoutine
+	: std::false_type
+{};
+
+template <typename TState, typename TRoutineControl>
+struct HasRoutine<TState,
+				  TRoutineControl,
+				  decltype((void) std::declval<TState&>().routine(std::declval<TRoutineControl&>()))>
+	: std::true_type
+{};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TArgs, typename TStateList>
+struct RoutineCountT;
+
+template <typename TArgs, typename... TStates>
+struct RoutineCountT<TArgs, ITL_<TStates...>> {
+	static constexpr LongIndex VALUE = (0 + ... + (LongIndex) HasRoutine<TStates, RoutineControlT<TArgs>>::value);
+};
+
+//------------------------------------------------------------------------------
+// routines of the active states, owned by the machine;
+// each one is resumed from its state's update() / react()
+
+template <typename TArgs>
+class RoutinesT final {
+	using Args				= TArgs;
+	using StateList			= typename Args::StateList;
+
+	static constexpr LongIndex STATE_COUNT = Args::STATE_COUNT;
+
+	using FullControl		= FullControlT<Args>;
+	using RoutineControl	= RoutineControlT<Args>;
+	using Routine			= RoutineT<Args>;
+
+public:
+	static constexpr LongIndex CAPACITY	= RoutineCountT<Args, StateList>::VALUE;
+
+	using Arena				= RoutineArenaT<CAPACITY, Args::Config_::ROUTINE_FRAME_SIZE>;
+
+public:
+	RoutinesT();
+	~RoutinesT();
+
+	RoutinesT(const RoutinesT&) = delete;
+	RoutinesT& operator = (const RoutinesT&) = delete;
+
+	// frames in use
+	HFSM_INLINE LongIndex count() const							{ return _arena.count();	}
+
+	// calls 'state.routine()' with the frame allocated from the arena
+	template <typename TState>
+	void start(const StateID stateId, TState& state);
+	void stop (const StateID stateId);
+
+	void update(const StateID stateId, FullControl& control);
+
+	template <typename TEvent>
+	void react(const StateID stateId, FullControl& control, const TEvent& event);
+
+private:
+	void resume(RoutineControl& routine, FullControl& control);
+
+private:
+	RoutineControl _controls[STATE_COUNT];
+	Arena _arena;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "routine.inl"
+
+#endif
@@ -0,0 +1,153 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NC, LongIndex NF>
+void*
+RoutineArenaT<NC, NF>::allocate(const std::size_t size) {
+	if (size <= FRAME_SIZE)
+		for (LongIndex i = 0; i < CAPACITY; ++i)
+			if (!_used.get(i)) {
+				_used.set(i);
+
+				unsigned char* const header = _storage + i * STRIDE;
+				*reinterpret_cast<RoutineAllocator**>(header) = this;
+
+				return header + HEADER;
+			}
+
+	HFSM_BREAK();
+
+	return nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, LongIndex NF>
+void
+RoutineArenaT<NC, NF>::deallocate(void* const frame) {
+	const std::size_t offset = static_cast<unsigned char*>(frame) - HEADER - _storage;
+	HFSM_ASSERT(offset % STRIDE == 0 && offset / STRIDE < CAPACITY);
+
+	_used.reset((LongIndex) (offset / STRIDE));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TA>
+RoutinesT<TA>::RoutinesT() {
+	for (StateID i = 0; i < STATE_COUNT; ++i)
+		_controls[i]._stateId = i;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+RoutinesT<TA>::~RoutinesT() {
+	for (StateID i = 0; i < STATE_COUNT; ++i)
+		stop(i);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+template <typename TState>
+void
+RoutinesT<TA>::start(const StateID stateId,
+					 TState& state)
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+	RoutineControl& target = _controls[stateId];
+	HFSM_ASSERT(!target._handle);
+
+	RoutineAllocator::Scope scope{_arena};
+	Routine routine = state.routine(target);
+
+	if (routine) {
+		target._handle	= routine._handle;
+		routine._handle	= nullptr;
+
+		target.waitFrames(1);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+RoutinesT<TA>::stop(const StateID stateId) {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+	RoutineControl& target = _controls[stateId];
+
+	if (target._handle) {
+		target._handle.destroy();
+		target._handle = nullptr;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+void
+RoutinesT<TA>::update(const StateID stateId,
+					  FullControl& control)
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+	RoutineControl& routine = _controls[stateId];
+
+	if (routine._handle &&
+		(routine._wait == RoutineControl::Wait::FRAMES ?
+			--routine._frames == 0 :
+		 routine._wait == RoutineControl::Wait::PLAN &&
+			!control.plan()))
+	{
+		resume(routine, control);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+template <typename TEvent>
+void
+RoutinesT<TA>::react(const StateID stateId,
+					 FullControl& control,
+					 const TEvent& event)
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+	RoutineControl& routine = _controls[stateId];
+
+	if (routine._handle &&
+		routine._wait == RoutineControl::Wait::EVENT &&
+		routine._eventType == &EventTag<TEvent>::ID)
+	{
+		routine._event = &event;
+		resume(routine, control);
+		routine._event = nullptr;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+void
+RoutinesT<TA>::resume(RoutineControl& routine,
+					  FullControl& control)
+{
+	routine._control = &control;
+	routine._handle.resume();
+	routine._control = nullptr;
+
+	// prongs of parallel regions share the arena
+	if (routine._handle.done()) {
+		SpinGuard guard{control._serial};
+
+		stop(routine._stateId);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
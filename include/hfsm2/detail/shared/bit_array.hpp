@@ -4,6 +4,7 @@ namespace hfsm2 {
 namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
+// 'width' bits, starting at 8-bit aligned 'unit'
 
 struct Units {
 	ShortIndex unit;
@@ -12,24 +13,29 @@ struct Units {
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 class BitArray final {
 public:
 	using Index	= TIndex;
-	using Unit	= unsigned char;
+	using Word	= uint64_t;
 
-	static constexpr Index CAPACITY	= NCapacity;
+	static constexpr LongIndex	CAPACITY   = NCapacity;
+	static constexpr ShortIndex	UNIT_BITS  = 8;
+	static constexpr ShortIndex	WORD_BITS  = sizeof(Word) * 8;
+	static constexpr LongIndex	WORD_COUNT = (CAPACITY + WORD_BITS - 1) / WORD_BITS;
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	class Bits {
-		template <typename, ShortIndex>
+		template <typename, LongIndex>
 		friend class BitArray;
 
 	private:
-		HFSM_INLINE explicit Bits(Unit* const storage,
+		HFSM_INLINE explicit Bits(Word* const storage,
+								  const LongIndex offset,
 								  const Index width)
 			: _storage{storage}
+			, _offset{offset}
 			, _width{width}
 		{}
 
@@ -39,33 +45,36 @@ public:
 		HFSM_INLINE void clear();
 
 		template <ShortIndex NIndex>
-		HFSM_INLINE bool get() const;
+		HFSM_INLINE bool get() const									{ return get  (NIndex);	}
 
 		template <ShortIndex NIndex>
-		HFSM_INLINE void set();
+		HFSM_INLINE void set()											{		 set  (NIndex);	}
 
 		template <ShortIndex NIndex>
-		HFSM_INLINE void reset();
+		HFSM_INLINE void reset()										{		 reset(NIndex);	}
 
 		HFSM_INLINE bool get  (const Index index) const;
 		HFSM_INLINE void set  (const Index index);
 		HFSM_INLINE void reset(const Index index);
 
 	private:
-		Unit* const _storage;
+		Word* const _storage;
+		const LongIndex _offset;
 		const Index _width;
 	};
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	class ConstBits {
-		template <typename, ShortIndex>
+		template <typename, LongIndex>
 		friend class BitArray;
 
 	private:
-		HFSM_INLINE explicit ConstBits(const Unit* const storage,
+		HFSM_INLINE explicit ConstBits(const Word* const storage,
+									   const LongIndex offset,
 									   const Index width)
 			: _storage{storage}
+			, _offset{offset}
 			, _width{width}
 		{}
 
@@ -73,12 +82,13 @@ public:
 		HFSM_INLINE explicit operator bool() const;
 
 		template <ShortIndex NIndex>
-		HFSM_INLINE bool get() const;
+		HFSM_INLINE bool get() const									{ return get(NIndex);	}
 
 		HFSM_INLINE bool get(const Index index) const;
 
 	private:
-		const Unit* const _storage;
+		const Word* const _storage;
+		const LongIndex _offset;
 		const Index _width;
 	};
 
@@ -89,8 +99,18 @@ public:
 		clear();
 	}
 
+	HFSM_INLINE explicit operator bool() const;
+
 	HFSM_INLINE void clear();
 
+	HFSM_INLINE LongIndex count() const;
+
+	HFSM_INLINE BitArray& operator ^= (const BitArray& other);
+
+	// set bit iteration, returns CAPACITY past the last set bit
+	HFSM_INLINE LongIndex first() const									{ return find(0);			}
+	HFSM_INLINE LongIndex next(const LongIndex index) const				{ return find(index + 1);	}
+
 	template <ShortIndex NIndex>
 	HFSM_INLINE bool get() const;
 
@@ -110,12 +130,23 @@ public:
 	template <ShortIndex NUnit, ShortIndex NWidth>
 	HFSM_INLINE ConstBits bits() const;
 
-
 	HFSM_INLINE		 Bits bits(const Units& units);
 	HFSM_INLINE ConstBits bits(const Units& units) const;
 
+	// raw storage, for copying through atomics
+	HFSM_INLINE Word word(const LongIndex index) const					{ return _storage[index];	}
+	HFSM_INLINE void setWord(const LongIndex index, const Word word)	{ _storage[index] = word;	}
+
 private:
-	Unit _storage[CAPACITY];
+	HFSM_INLINE LongIndex find(const LongIndex from) const;
+
+	static HFSM_INLINE Word mask(const LongIndex begin, const LongIndex end);
+
+	static HFSM_INLINE bool any	   (const Word* const storage, const LongIndex begin, const LongIndex end);
+	static HFSM_INLINE void clear  (	  Word* const storage, const LongIndex begin, const LongIndex end);
+
+private:
+	Word _storage[WORD_COUNT];
 };
 
 //------------------------------------------------------------------------------
@@ -123,9 +154,43 @@ private:
 template <typename TIndex>
 class BitArray<TIndex, 0> final {
 public:
-	HFSM_INLINE void clear() {}
+	using Word	= uint64_t;
+
+	static constexpr LongIndex CAPACITY	  = 0;
+	static constexpr LongIndex WORD_COUNT = 0;
+
+	HFSM_INLINE explicit operator bool() const							{ return false;	}
+
+	HFSM_INLINE void clear()											{}
+
+	HFSM_INLINE LongIndex count() const									{ return 0;		}
+
+	HFSM_INLINE BitArray& operator ^= (const BitArray&)					{ return *this;	}
+
+	HFSM_INLINE LongIndex first() const									{ return 0;		}
+	HFSM_INLINE LongIndex next(const LongIndex) const					{ return 0;		}
+
+	HFSM_INLINE Word word(const LongIndex) const						{ return 0;		}
+	HFSM_INLINE void setWord(const LongIndex, const Word)				{}
 };
 
+//------------------------------------------------------------------------------
+// wire format of bit arrays: a bit per element, little-endian,
+// padded to whole bytes
+
+template <typename TBits>
+constexpr std::size_t
+bitsSize() {
+	return (TBits::CAPACITY + 7) / 8;
+}
+
+template <typename TBits>
+void writeBits(unsigned char*& cursor, const TBits& bits);
+
+// rejects bits set past the capacity
+template <typename TBits>
+bool readBits(const unsigned char*& cursor, TBits& bits);
+
 ////////////////////////////////////////////////////////////////////////////////
 
 }
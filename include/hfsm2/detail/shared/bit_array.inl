@@ -3,312 +3,331 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 BitArray<TIndex, NCapacity>::Bits::operator bool() const {
-	const ShortIndex fullUnits = _width / (sizeof(Unit) * 8);
-
-	for (Index i = 0; i < fullUnits; ++i)
-		if (_storage[i])
-			return true;
-
-	const ShortIndex bit = _width % (sizeof(Unit) * 8);
-	const Unit mask = (1 << bit) - 1;
-	const Unit& u = _storage[fullUnits];
-
-	return (u & mask) != 0;
+	return any(_storage, _offset, _offset + _width);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 void
 BitArray<TIndex, NCapacity>::Bits::clear() {
-	const Index count = (_width + 7) / (sizeof(Unit) * 8);
-
-	for (Index i = 0; i < count; ++i)
-		_storage[i] = Unit{0};
+	BitArray::clear(_storage, _offset, _offset + _width);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
-template <ShortIndex NIndex>
+template <typename TIndex, LongIndex NCapacity>
 bool
-BitArray<TIndex, NCapacity>::Bits::get() const {
-	constexpr Index INDEX = NIndex;
-	HFSM_ASSERT(INDEX < _width);
+BitArray<TIndex, NCapacity>::Bits::get(const Index index) const {
+	HFSM_ASSERT(index < _width);
 
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
+	const LongIndex bit = _offset + index;
 
-	return (_storage[BIT_UNIT] & MASK) != 0;
+	return (_storage[bit / WORD_BITS] & (Word{1} << bit % WORD_BITS)) != 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
-template <ShortIndex NIndex>
+template <typename TIndex, LongIndex NCapacity>
 void
-BitArray<TIndex, NCapacity>::Bits::set() {
-	constexpr Index INDEX = NIndex;
-	HFSM_ASSERT(INDEX < _width);
+BitArray<TIndex, NCapacity>::Bits::set(const Index index) {
+	HFSM_ASSERT(index < _width);
 
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
+	const LongIndex bit = _offset + index;
 
-	_storage[BIT_UNIT] |= MASK;
+	_storage[bit / WORD_BITS] |= Word{1} << bit % WORD_BITS;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
-template <ShortIndex NIndex>
+template <typename TIndex, LongIndex NCapacity>
 void
-BitArray<TIndex, NCapacity>::Bits::reset() {
-	constexpr Index INDEX = NIndex;
-	HFSM_ASSERT(INDEX < _width);
-
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
-
-	_storage[BIT_UNIT] &= ~MASK;
-}
-
-//------------------------------------------------------------------------------
-
-template <typename TIndex, ShortIndex NCapacity>
-bool
-BitArray<TIndex, NCapacity>::Bits::get(const Index index) const {
+BitArray<TIndex, NCapacity>::Bits::reset(const Index index) {
 	HFSM_ASSERT(index < _width);
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
+	const LongIndex bit = _offset + index;
 
-	return (_storage[unit] & mask) != 0;
+	_storage[bit / WORD_BITS] &= ~(Word{1} << bit % WORD_BITS);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-template <typename TIndex, ShortIndex NCapacity>
-void
-BitArray<TIndex, NCapacity>::Bits::set(const Index index) {
-	HFSM_ASSERT(index < _width);
-
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
+////////////////////////////////////////////////////////////////////////////////
 
-	_storage[unit] |= mask;
+template <typename TIndex, LongIndex NCapacity>
+BitArray<TIndex, NCapacity>::ConstBits::operator bool() const {
+	return any(_storage, _offset, _offset + _width);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
-void
-BitArray<TIndex, NCapacity>::Bits::reset(const Index index) {
+template <typename TIndex, LongIndex NCapacity>
+bool
+BitArray<TIndex, NCapacity>::ConstBits::get(const Index index) const {
 	HFSM_ASSERT(index < _width);
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
+	const LongIndex bit = _offset + index;
 
-	_storage[unit] &= ~mask;
+	return (_storage[bit / WORD_BITS] & (Word{1} << bit % WORD_BITS)) != 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TIndex, ShortIndex NCapacity>
-BitArray<TIndex, NCapacity>::ConstBits::operator bool() const {
-	const ShortIndex fullUnits = _width / (sizeof(Unit) * 8);
-
-	for (Index i = 0; i < fullUnits; ++i)
-		if (_storage[i])
+template <typename TIndex, LongIndex NCapacity>
+BitArray<TIndex, NCapacity>::operator bool() const {
+	for (const Word& word : _storage)
+		if (word)
 			return true;
 
-	const ShortIndex bit = _width % (sizeof(Unit) * 8);
-	const Unit mask = (1 << bit) - 1;
-	const Unit& u = _storage[fullUnits];
-
-	return (u & mask) != 0;
+	return false;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
-template <ShortIndex NIndex>
-bool
-BitArray<TIndex, NCapacity>::ConstBits::get() const {
-	constexpr Index INDEX = NIndex;
-	static_assert(INDEX < _width, "");
-
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
-
-	return (_storage[BIT_UNIT] & MASK) != 0;
+template <typename TIndex, LongIndex NCapacity>
+void
+BitArray<TIndex, NCapacity>::clear() {
+	for (Word& word : _storage)
+		word = Word{0};
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
-bool
-BitArray<TIndex, NCapacity>::ConstBits::get(const Index index) const {
-	HFSM_ASSERT(index < _width);
+template <typename TIndex, LongIndex NCapacity>
+LongIndex
+BitArray<TIndex, NCapacity>::count() const {
+	LongIndex result = 0;
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
+	for (const Word& word : _storage)
+		result += (LongIndex) popCount(word);
 
-	return (_storage[unit] & mask) != 0;
+	return result;
 }
 
-////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
-void
-BitArray<TIndex, NCapacity>::clear() {
-	for (Unit& unit: _storage)
-		unit = Unit{0};
+template <typename TIndex, LongIndex NCapacity>
+BitArray<TIndex, NCapacity>&
+BitArray<TIndex, NCapacity>::operator ^= (const BitArray& other) {
+	for (LongIndex i = 0; i < WORD_COUNT; ++i)
+		_storage[i] ^= other._storage[i];
+
+	return *this;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 template <ShortIndex NIndex>
 bool
 BitArray<TIndex, NCapacity>::get() const {
-	constexpr Index INDEX = NIndex;
+	constexpr LongIndex INDEX = NIndex;
 	static_assert(INDEX < CAPACITY, "");
 
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
+	constexpr Word MASK = Word{1} << INDEX % WORD_BITS;
 
-	return (_storage[BIT_UNIT] & MASK) != 0;
+	return (_storage[INDEX / WORD_BITS] & MASK) != 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 template <ShortIndex NIndex>
 void
 BitArray<TIndex, NCapacity>::set() {
-	constexpr Index INDEX = NIndex;
+	constexpr LongIndex INDEX = NIndex;
 	static_assert(INDEX < CAPACITY, "");
 
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
+	constexpr Word MASK = Word{1} << INDEX % WORD_BITS;
 
-	_storage[BIT_UNIT] |= MASK;
+	_storage[INDEX / WORD_BITS] |= MASK;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 template <ShortIndex NIndex>
 void
 BitArray<TIndex, NCapacity>::reset() {
-	constexpr Index INDEX = NIndex;
+	constexpr LongIndex INDEX = NIndex;
 	static_assert(INDEX < CAPACITY, "");
 
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
+	constexpr Word MASK = Word{1} << INDEX % WORD_BITS;
 
-	_storage[BIT_UNIT] &= ~MASK;
+	_storage[INDEX / WORD_BITS] &= ~MASK;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 bool
 BitArray<TIndex, NCapacity>::get(const Index index) const {
 	HFSM_ASSERT(index < CAPACITY);
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
-
-	return (_storage[unit] & mask) != 0;
+	return (_storage[index / WORD_BITS] & (Word{1} << index % WORD_BITS)) != 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 void
 BitArray<TIndex, NCapacity>::set(const Index index) {
 	HFSM_ASSERT(index < CAPACITY);
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
-
-	_storage[unit] |= mask;
+	_storage[index / WORD_BITS] |= Word{1} << index % WORD_BITS;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 void
 BitArray<TIndex, NCapacity>::reset(const Index index) {
 	HFSM_ASSERT(index < CAPACITY);
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
-
-	_storage[unit] &= ~mask;
+	_storage[index / WORD_BITS] &= ~(Word{1} << index % WORD_BITS);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 template <ShortIndex NUnit, ShortIndex NWidth>
 typename BitArray<TIndex, NCapacity>::Bits
 BitArray<TIndex, NCapacity>::bits() {
-	constexpr ShortIndex UNIT  = NUnit;
-	constexpr ShortIndex WIDTH = NWidth;
-	static_assert(UNIT + (WIDTH + 7) / (sizeof(Unit) * 8) <= CAPACITY, "");
+	constexpr LongIndex OFFSET = NUnit * UNIT_BITS;
+	constexpr LongIndex WIDTH  = NWidth;
+	static_assert(OFFSET + WIDTH <= CAPACITY, "");
 
-	return Bits{_storage + UNIT, WIDTH};
+	return Bits{_storage, OFFSET, WIDTH};
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 template <ShortIndex NUnit, ShortIndex NWidth>
 typename BitArray<TIndex, NCapacity>::ConstBits
 BitArray<TIndex, NCapacity>::bits() const {
-	constexpr ShortIndex UNIT  = NUnit;
-	constexpr ShortIndex WIDTH = NWidth;
-	static_assert(UNIT + (WIDTH + 7) / (sizeof(Unit) * 8) <= CAPACITY, "");
+	constexpr LongIndex OFFSET = NUnit * UNIT_BITS;
+	constexpr LongIndex WIDTH  = NWidth;
+	static_assert(OFFSET + WIDTH <= CAPACITY, "");
 
-	return ConstBits{_storage + UNIT, WIDTH};
+	return ConstBits{_storage, OFFSET, WIDTH};
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 typename BitArray<TIndex, NCapacity>::Bits
 BitArray<TIndex, NCapacity>::bits(const Units& units) {
-	HFSM_ASSERT(units.unit + (units.width + 7) / (sizeof(Unit) * 8) <= CAPACITY);
+	HFSM_ASSERT(units.unit * UNIT_BITS + units.width <= CAPACITY);
 
-	return Bits{_storage + units.unit, units.width};
+	return Bits{_storage, (LongIndex) (units.unit * UNIT_BITS), units.width};
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 typename BitArray<TIndex, NCapacity>::ConstBits
 BitArray<TIndex, NCapacity>::bits(const Units& units) const {
-	HFSM_ASSERT(units.unit + (units.width + 7) / (sizeof(Unit) * 8) <= CAPACITY);
+	HFSM_ASSERT(units.unit * UNIT_BITS + units.width <= CAPACITY);
+
+	return ConstBits{_storage, (LongIndex) (units.unit * UNIT_BITS), units.width};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TIndex, LongIndex NCapacity>
+LongIndex
+BitArray<TIndex, NCapacity>::find(const LongIndex from) const {
+	if (from >= CAPACITY)
+		return CAPACITY;
+
+	LongIndex word = from / WORD_BITS;
+	Word bits = _storage[word] & (~Word{0} << from % WORD_BITS);
+
+	while (!bits)
+		if (++word < WORD_COUNT)
+			bits = _storage[word];
+		else
+			return CAPACITY;
+
+	return (LongIndex) (word * WORD_BITS + lowestBit(bits));
+}
+
+//------------------------------------------------------------------------------
+// bits of [begin, end) that fall into the word holding 'begin'
+
+template <typename TIndex, LongIndex NCapacity>
+typename BitArray<TIndex, NCapacity>::Word
+BitArray<TIndex, NCapacity>::mask(const LongIndex begin,
+								  const LongIndex end)
+{
+	const LongIndex shift = begin % WORD_BITS;
+	const LongIndex width = end - begin < WORD_BITS - shift ?
+								end - begin : WORD_BITS - shift;
+
+	return width < WORD_BITS ?
+		((Word{1} << width) - 1) << shift : ~Word{0};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TIndex, LongIndex NCapacity>
+bool
+BitArray<TIndex, NCapacity>::any(const Word* const storage,
+								 const LongIndex begin,
+								 const LongIndex end)
+{
+	for (LongIndex bit = begin; bit < end; bit = (bit / WORD_BITS + 1) * WORD_BITS)
+		if (storage[bit / WORD_BITS] & mask(bit, end))
+			return true;
+
+	return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TIndex, LongIndex NCapacity>
+void
+BitArray<TIndex, NCapacity>::clear(Word* const storage,
+								   const LongIndex begin,
+								   const LongIndex end)
+{
+	for (LongIndex bit = begin; bit < end; bit = (bit / WORD_BITS + 1) * WORD_BITS)
+		storage[bit / WORD_BITS] &= ~mask(bit, end);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TBits>
+void
+writeBits(unsigned char*& cursor,
+		  const TBits& bits)
+{
+	using Word = typename TBits::Word;
+
+	for (LongIndex b = 0; b < bitsSize<TBits>(); ++b)
+		*cursor++ = (unsigned char) (bits.word(b / sizeof(Word)) >> b % sizeof(Word) * 8);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TBits>
+bool
+readBits(const unsigned char*& cursor,
+		 TBits& bits)
+{
+	using Word = typename TBits::Word;
+
+	bits.clear();
+
+	for (LongIndex b = 0; b < bitsSize<TBits>(); ++b) {
+		const LongIndex w = b / sizeof(Word);
+
+		bits.setWord(w, bits.word(w) | (Word) *cursor++ << b % sizeof(Word) * 8);
+	}
 
-	return ConstBits{_storage + units.unit, units.width};
+	return TBits::CAPACITY % 8 == 0 ||
+		   cursor[-1] >> TBits::CAPACITY % 8 == 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
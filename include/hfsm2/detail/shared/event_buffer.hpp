@@ -0,0 +1,89 @@
+#pragma once
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex...>
+struct MaxT;
+
+template <LongIndex N, LongIndex... Ns>
+struct MaxT<N, Ns...> {
+	static constexpr LongIndex VALUE = N > MaxT<Ns...>::VALUE ? N : MaxT<Ns...>::VALUE;
+};
+
+template <>
+struct MaxT<> {
+	static constexpr LongIndex VALUE = 1;
+};
+
+//------------------------------------------------------------------------------
+// fixed-capacity FIFO of events from a closed type list,
+// stored as tagged variants and dispatched through a per-receiver jump table
+
+template <typename TEvents,
+		  LongIndex NCapacity>
+class EventBufferT;
+
+template <typename... TEvents,
+		  LongIndex NCapacity>
+class EventBufferT<TL_<TEvents...>, NCapacity> final {
+	using Events = ITL_<TEvents...>;
+
+	static constexpr LongIndex SIZE		 = MaxT<sizeof (TEvents)...>::VALUE;
+	static constexpr LongIndex ALIGNMENT = MaxT<alignof(TEvents)...>::VALUE;
+
+	struct Slot {
+		ShortIndex type;
+
+		alignas(ALIGNMENT) unsigned char bytes[SIZE];
+	};
+
+	template <typename TReceiver>
+	using Thunk = void (*)(TReceiver&, const void*);
+
+	using Destructor = void (*)(void*);
+
+public:
+	static constexpr LongIndex CAPACITY	  = NCapacity;
+	static constexpr LongIndex TYPE_COUNT = Events::SIZE;
+
+	static_assert(TYPE_COUNT > 0, "Declare event types with 'Config::EventsT<>'");
+	static_assert(TYPE_COUNT < (ShortIndex) -1, "Too many event types. Change 'ShortIndex' type.");
+
+public:
+	EventBufferT() = default;
+	~EventBufferT()														{ clear();			}
+
+	EventBufferT(const EventBufferT&) = delete;
+	EventBufferT& operator = (const EventBufferT&) = delete;
+
+	template <typename TEvent>
+	bool push(const TEvent& event);
+
+	void clear();
+
+	HFSM_INLINE LongIndex count() const									{ return _count;	}
+
+	template <typename TReceiver>
+	void dispatch(TReceiver& receiver) const;
+
+private:
+	template <typename TReceiver, typename TEvent>
+	static void thunk(TReceiver& receiver, const void* const event)		{ receiver(*static_cast<const TEvent*>(event));	}
+
+	template <typename TEvent>
+	static void destroy(void* const event)								{ static_cast<TEvent*>(event)->~TEvent();		}
+
+private:
+	LongIndex _count = 0;
+	Slot _slots[CAPACITY];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "event_buffer.inl"
@@ -0,0 +1,50 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename... TE, LongIndex NC>
+template <typename TEvent>
+bool
+EventBufferT<TL_<TE...>, NC>::push(const TEvent& event) {
+	static_assert(Events::template contains<TEvent>(), "Event type is missing from 'Config::EventsT<>'");
+
+	if (_count == CAPACITY)
+		return false;
+
+	Slot& slot = _slots[_count++];
+	slot.type = (ShortIndex) Events::template index<TEvent>();
+	new (&slot.bytes) TEvent(event);
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename... TE, LongIndex NC>
+void
+EventBufferT<TL_<TE...>, NC>::clear() {
+	static const Destructor DESTRUCTORS[] = { &destroy<TE>... };
+
+	for (LongIndex i = 0; i < _count; ++i)
+		DESTRUCTORS[_slots[i].type](&_slots[i].bytes);
+
+	_count = 0;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename... TE, LongIndex NC>
+template <typename TReceiver>
+void
+EventBufferT<TL_<TE...>, NC>::dispatch(TReceiver& receiver) const {
+	static const Thunk<TReceiver> THUNKS[] = { &thunk<TReceiver, TE>... };
+
+	for (LongIndex i = 0; i < _count; ++i)
+		THUNKS[_slots[i].type](receiver, &_slots[i].bytes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
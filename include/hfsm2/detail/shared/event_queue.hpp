@@ -0,0 +1,55 @@
+#pragma once
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+// bounded lock-free multi-producer / single-consumer queue,
+// post() from any thread, drain() on the thread owning the machine
+
+template <typename TEvent,
+		  LongIndex NCapacity>
+class EventQueueT final {
+public:
+	using Event		= TEvent;
+	using Index		= std::size_t;
+
+	static constexpr LongIndex CAPACITY = NCapacity;
+
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "Event queue capacity must be a power of 2");
+
+public:
+	EventQueueT();
+	~EventQueueT();
+
+	EventQueueT(const EventQueueT&) = delete;
+	EventQueueT& operator = (const EventQueueT&) = delete;
+
+	bool post(const Event& event);
+
+	template <typename TMachine>
+	LongIndex drain(TMachine& machine);
+
+private:
+	struct Cell {
+		std::atomic<Index> sequence;
+
+		alignas(Event) unsigned char bytes[sizeof(Event)];
+
+		HFSM_INLINE Event& event()										{ return reinterpret_cast<Event&>(bytes);	}
+	};
+
+	static constexpr Index MASK = CAPACITY - 1;
+
+	alignas(64) std::atomic<Index> _tail;
+	alignas(64) Index _head = 0;
+
+	Cell _cells[CAPACITY];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "event_queue.inl"
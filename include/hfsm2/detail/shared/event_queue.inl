@@ -0,0 +1,85 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TE, LongIndex NC>
+EventQueueT<TE, NC>::EventQueueT()
+	: _tail{0}
+{
+	for (Index i = 0; i < CAPACITY; ++i)
+		_cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TE, LongIndex NC>
+EventQueueT<TE, NC>::~EventQueueT() {
+	for (;; ++_head) {
+		Cell& cell = _cells[_head & MASK];
+
+		if (cell.sequence.load(std::memory_order_acquire) != _head + 1)
+			break;
+
+		cell.event().~Event();
+		cell.sequence.store(_head + CAPACITY, std::memory_order_relaxed);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TE, LongIndex NC>
+bool
+EventQueueT<TE, NC>::post(const Event& event) {
+	Index position = _tail.load(std::memory_order_relaxed);
+
+	for (;;) {
+		Cell& cell = _cells[position & MASK];
+		const Index sequence = cell.sequence.load(std::memory_order_acquire);
+
+		if (sequence == position) {
+			if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				new (&cell.bytes) Event(event);
+				cell.sequence.store(position + 1, std::memory_order_release);
+
+				return true;
+			}
+		} else if ((std::ptrdiff_t) (sequence - position) < 0) {
+			// full
+			return false;
+		} else
+			position = _tail.load(std::memory_order_relaxed);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TE, LongIndex NC>
+template <typename TMachine>
+LongIndex
+EventQueueT<TE, NC>::drain(TMachine& machine) {
+	LongIndex count = 0;
+
+	// at most CAPACITY events per call, busy producers can't stall the owner
+	for (; count < CAPACITY; ++count, ++_head) {
+		Cell& cell = _cells[_head & MASK];
+
+		if (cell.sequence.load(std::memory_order_acquire) != _head + 1)
+			break;
+
+		{
+			const Event event(std::move(cell.event()));
+			cell.event().~Event();
+			cell.sequence.store(_head + CAPACITY, std::memory_order_release);
+
+			machine.react(event);
+		}
+	}
+
+	return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
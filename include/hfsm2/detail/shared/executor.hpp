@@ -0,0 +1,136 @@
+#pragma once
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+// runs 'task(context, 0 .. count - 1)', returning once every call completed;
+// machines hand the prongs of their parallel orthogonal regions to it
+
+struct ExecutorInterface {
+	using Task = void (*)(void* const context, const LongIndex index);
+
+	virtual ~ExecutorInterface() = default;
+
+	virtual void run(const LongIndex count,
+					 const Task task,
+					 void* const context) = 0;
+};
+
+namespace detail {
+
+//------------------------------------------------------------------------------
+// serializes the few shared writes prongs of a parallel region make
+
+class SpinLock final {
+public:
+	HFSM_INLINE void lock()								{ while (_flag.test_and_set(std::memory_order_acquire)) {}	}
+	HFSM_INLINE void unlock()							{ _flag.clear(std::memory_order_release);					}
+
+private:
+	std::atomic_flag _flag = ATOMIC_FLAG_INIT;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class SpinGuard final {
+public:
+	HFSM_INLINE explicit SpinGuard(SpinLock* const lock)
+		: _lock{lock}
+	{
+		if (_lock)
+			_lock->lock();
+	}
+
+	HFSM_INLINE ~SpinGuard() {
+		if (_lock)
+			_lock->unlock();
+	}
+
+	SpinGuard(const SpinGuard&) = delete;
+	SpinGuard& operator = (const SpinGuard&) = delete;
+
+private:
+	SpinLock* const _lock;
+};
+
+}
+
+#ifdef HFSM_ENABLE_THREADS
+
+////////////////////////////////////////////////////////////////////////////////
+// fork-join pool of 'NThreads' - 1 workers and the calling thread;
+// run() splits the indices into one contiguous range per thread,
+// threads that drain their own range steal the back half of another's
+
+template <LongIndex NThreads>
+class WorkStealingExecutorT final
+	: public ExecutorInterface
+{
+	// task index range [begin, end), tagged with the run() it belongs to
+	using Range = uint64_t;
+
+	// keeps threads' ranges on separate cache lines
+	struct alignas(64) Slot {
+		std::atomic<Range> range{0};
+	};
+
+	static_assert(sizeof(Slot) == 64, "");
+
+public:
+	static constexpr LongIndex THREAD_COUNT = NThreads;
+
+	static_assert(THREAD_COUNT > 0, "The calling thread is one of 'NThreads'");
+
+	WorkStealingExecutorT();
+	~WorkStealingExecutorT();
+
+	WorkStealingExecutorT(const WorkStealingExecutorT&) = delete;
+	WorkStealingExecutorT& operator = (const WorkStealingExecutorT&) = delete;
+
+	void run(const LongIndex count,
+			 const Task task,
+			 void* const context) override;
+
+	// tasks a thread took from another's range since construction
+	HFSM_INLINE uint32_t stolen() const						{ return _stolen.load(std::memory_order_relaxed);	}
+
+private:
+	static HFSM_INLINE Range pack(const uint32_t generation,
+								  const LongIndex begin,
+								  const LongIndex end)		{ return (Range) generation << 32 | (Range) begin << 16 | end;	}
+
+	static HFSM_INLINE uint32_t  generation(const Range range)	{ return (uint32_t)	 (range >> 32);				}
+	static HFSM_INLINE LongIndex begin	   (const Range range)	{ return (LongIndex) (range >> 16);				}
+	static HFSM_INLINE LongIndex end	   (const Range range)	{ return (LongIndex)  range;					}
+
+	void work(const LongIndex thread);
+	void execute(const LongIndex thread, const uint32_t generation);
+
+	bool pop  (const LongIndex thread, const uint32_t generation, LongIndex& index);
+	bool steal(const LongIndex thread, const uint32_t generation, LongIndex& index);
+
+private:
+	Slot _slots[THREAD_COUNT];
+
+	// '_threads[0]' is the calling thread and stays empty
+	std::thread _threads[THREAD_COUNT];
+
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	uint32_t _generation = 0;
+	bool _stop = false;
+
+	Task _task = nullptr;
+	void* _context = nullptr;
+
+	std::atomic<LongIndex> _pending{0};
+	std::atomic<uint32_t> _stolen{0};
+};
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#include "executor.inl"
@@ -0,0 +1,168 @@
+#ifdef HFSM_ENABLE_THREADS
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NT>
+WorkStealingExecutorT<NT>::WorkStealingExecutorT() {
+	for (LongIndex thread = 1; thread < THREAD_COUNT; ++thread)
+		_threads[thread] = std::thread{&WorkStealingExecutorT::work, this, thread};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NT>
+WorkStealingExecutorT<NT>::~WorkStealingExecutorT() {
+	{
+		std::lock_guard<std::mutex> lock{_mutex};
+		_stop = true;
+	}
+	_wake.notify_all();
+
+	for (LongIndex thread = 1; thread < THREAD_COUNT; ++thread)
+		_threads[thread].join();
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NT>
+void
+WorkStealingExecutorT<NT>::run(const LongIndex count,
+							   const Task task,
+							   void* const context)
+{
+	if (count == 0)
+		return;
+
+	uint32_t current;
+
+	{
+		std::lock_guard<std::mutex> lock{_mutex};
+
+		_task	 = task;
+		_context = context;
+		_pending.store(count, std::memory_order_relaxed);
+
+		current = ++_generation;
+
+		for (LongIndex thread = 0; thread < THREAD_COUNT; ++thread)
+			_slots[thread].range.store(pack(current,
+											(LongIndex) ((uint32_t) count *  thread		 / THREAD_COUNT),
+											(LongIndex) ((uint32_t) count * (thread + 1) / THREAD_COUNT)),
+									   std::memory_order_release);
+	}
+	_wake.notify_all();
+
+	execute(0, current);
+
+	while (_pending.load(std::memory_order_acquire))
+		std::this_thread::yield();
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NT>
+void
+WorkStealingExecutorT<NT>::work(const LongIndex thread) {
+	uint32_t seen = 0;
+
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock{_mutex};
+			_wake.wait(lock, [&] { return _stop || _generation != seen; });
+
+			if (_stop)
+				return;
+
+			seen = _generation;
+		}
+
+		execute(thread, seen);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NT>
+void
+WorkStealingExecutorT<NT>::execute(const LongIndex thread,
+								   const uint32_t current)
+{
+	LongIndex index;
+
+	while (pop(thread, current, index) || steal(thread, current, index)) {
+		_task(_context, index);
+
+		_pending.fetch_sub(1, std::memory_order_acq_rel);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NT>
+bool
+WorkStealingExecutorT<NT>::pop(const LongIndex thread,
+							   const uint32_t current,
+							   LongIndex& index)
+{
+	std::atomic<Range>& own = _slots[thread].range;
+
+	for (Range range = own.load(std::memory_order_acquire);
+		 generation(range) == current && begin(range) < end(range); )
+	{
+		if (own.compare_exchange_weak(range,
+									  pack(current, begin(range) + 1, end(range)),
+									  std::memory_order_acq_rel,
+									  std::memory_order_acquire))
+		{
+			index = begin(range);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NT>
+bool
+WorkStealingExecutorT<NT>::steal(const LongIndex thread,
+								 const uint32_t current,
+								 LongIndex& index)
+{
+	for (LongIndex offset = 1; offset < THREAD_COUNT; ++offset) {
+		std::atomic<Range>& victim = _slots[(thread + offset) % THREAD_COUNT].range;
+
+		for (Range range = victim.load(std::memory_order_acquire);
+			 generation(range) == current && begin(range) < end(range); )
+		{
+			const LongIndex middle = begin(range) + (end(range) - begin(range)) / 2;
+
+			if (victim.compare_exchange_weak(range,
+											 pack(current, begin(range), middle),
+											 std::memory_order_acq_rel,
+											 std::memory_order_acquire))
+			{
+				// the first stolen task runs now, the rest can be stolen back
+				_slots[thread].range.store(pack(current, middle + 1, end(range)),
+										   std::memory_order_release);
+				_stolen.fetch_add(end(range) - middle, std::memory_order_relaxed);
+
+				index = middle;
+
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
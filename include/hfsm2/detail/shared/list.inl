@@ -47,11 +47,10 @@ List<TItem, NCapacity>::emplace(TArgs... args) {
 
 		return result;
 	} else {
-		// full
+		// full, left for the caller to handle
 		HFSM_ASSERT(_vacantHead == INVALID);
 		HFSM_ASSERT(_vacantTail == INVALID);
 		HFSM_ASSERT(_count == CAPACITY);
-		HFSM_BREAK();
 
 		return INVALID;
 	}
@@ -0,0 +1,84 @@
+#pragma once
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+// fixed-capacity slab of payloads addressed by 1-byte handles,
+// payloads are only copied if the pool itself is;
+// state data is held until released, transition payloads are staged
+// for the requests in flight and released together once they are processed
+
+template <typename TPayload,
+		  LongIndex NCapacity>
+class PayloadPoolT final {
+	struct alignas(alignof(TPayload)) Slot {
+		unsigned char bytes[sizeof(TPayload)];
+	};
+
+public:
+	using Payload = TPayload;
+	using Handle  = ShortIndex;
+
+	static constexpr LongIndex CAPACITY = NCapacity;
+
+	static_assert(CAPACITY > 0, "Payload pool capacity must be positive");
+	static_assert(CAPACITY < INVALID_SHORT_INDEX, "Too many payload slots. Change 'ShortIndex' type.");
+
+	using Slots = BitArray<LongIndex, CAPACITY>;
+
+public:
+	PayloadPoolT();
+	PayloadPoolT(const PayloadPoolT& other);
+	~PayloadPoolT()													{ clear();					}
+
+	PayloadPoolT& operator = (const PayloadPoolT& other);
+
+	// INVALID_SHORT_INDEX if the pool is exhausted
+	HFSM_INLINE Handle hold (const Payload&	payload)				{ return acquire(payload, false);				}
+	HFSM_INLINE Handle hold (	  Payload&& payload)				{ return acquire(std::move(payload), false);	}
+
+	HFSM_INLINE Handle stage(const Payload&	payload)				{ return acquire(payload, true);				}
+	HFSM_INLINE Handle stage(	  Payload&& payload)				{ return acquire(std::move(payload), true);		}
+
+	HFSM_INLINE void release(const Handle handle);
+
+	HFSM_INLINE void releaseStaged();
+
+	void clear();
+
+	HFSM_INLINE		  Payload& operator[] (const Handle handle);
+	HFSM_INLINE const Payload& operator[] (const Handle handle) const;
+
+	HFSM_INLINE LongIndex count() const								{ return _count;			}
+
+	// most slots used at once, to size 'Config::PayloadCapacityN<>',
+	// and payloads dropped for lack of slots; neither is copied with the pool
+	HFSM_INLINE LongIndex peak() const								{ return _peak;				}
+	HFSM_INLINE LongIndex overflows() const							{ return _overflows;		}
+
+private:
+	template <typename T>
+	Handle acquire(T&& payload, const bool staged);
+
+	void rebuild(const PayloadPoolT& other);
+
+private:
+	Slot _slots[CAPACITY];
+	Handle _next[CAPACITY];
+
+	Slots _used;
+	Slots _staged;
+
+	Handle _vacant = 0;
+	LongIndex _count = 0;
+	LongIndex _peak = 0;
+	LongIndex _overflows = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "payload_pool.inl"
@@ -0,0 +1,146 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TP, LongIndex NC>
+PayloadPoolT<TP, NC>::PayloadPoolT() {
+	for (LongIndex i = 0; i < CAPACITY; ++i)
+		_next[i] = (Handle) (i + 1 < CAPACITY ? i + 1 : INVALID_SHORT_INDEX);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TP, LongIndex NC>
+PayloadPoolT<TP, NC>::PayloadPoolT(const PayloadPoolT& other) {
+	rebuild(other);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TP, LongIndex NC>
+PayloadPoolT<TP, NC>&
+PayloadPoolT<TP, NC>::operator = (const PayloadPoolT& other) {
+	if (this != &other) {
+		clear();
+		rebuild(other);
+	}
+
+	return *this;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TP, LongIndex NC>
+void
+PayloadPoolT<TP, NC>::release(const Handle handle) {
+	HFSM_ASSERT(handle < CAPACITY && _used.get(handle));
+
+	if (handle < CAPACITY && _used.get(handle)) {
+		(*this)[handle].~Payload();
+
+		_used  .reset(handle);
+		_staged.reset(handle);
+
+		_next[handle] = _vacant;
+		_vacant = handle;
+		--_count;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TP, LongIndex NC>
+void
+PayloadPoolT<TP, NC>::releaseStaged() {
+	for (LongIndex i = _staged.first(); i < CAPACITY; i = _staged.next(i))
+		release((Handle) i);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TP, LongIndex NC>
+void
+PayloadPoolT<TP, NC>::clear() {
+	for (LongIndex i = _used.first(); i < CAPACITY; i = _used.next(i))
+		release((Handle) i);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TP, LongIndex NC>
+TP&
+PayloadPoolT<TP, NC>::operator[] (const Handle handle) {
+	HFSM_ASSERT(handle < CAPACITY && _used.get(handle));
+
+	return *reinterpret_cast<Payload*>(&_slots[handle].bytes);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TP, LongIndex NC>
+const TP&
+PayloadPoolT<TP, NC>::operator[] (const Handle handle) const {
+	HFSM_ASSERT(handle < CAPACITY && _used.get(handle));
+
+	return *reinterpret_cast<const Payload*>(&_slots[handle].bytes);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TP, LongIndex NC>
+template <typename T>
+typename PayloadPoolT<TP, NC>::Handle
+PayloadPoolT<TP, NC>::acquire(T&& payload,
+							  const bool staged)
+{
+	if (_vacant < CAPACITY) {
+		const Handle handle = _vacant;
+		_vacant = _next[handle];
+
+		new (&_slots[handle].bytes) Payload(std::forward<T>(payload));
+
+		_used.set(handle);
+		if (staged)
+			_staged.set(handle);
+
+		if (_peak < ++_count)
+			_peak = _count;
+
+		return handle;
+	} else {
+		// counted, not a fault: raise 'Config::PayloadCapacityN<>' above 'payloadPeak()'
+		++_overflows;
+
+		return INVALID_SHORT_INDEX;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// keeps the handles, so copies of requests and per-state slots stay valid
+
+template <typename TP, LongIndex NC>
+void
+PayloadPoolT<TP, NC>::rebuild(const PayloadPoolT& other) {
+	_vacant = INVALID_SHORT_INDEX;
+
+	for (LongIndex i = CAPACITY; i-- > 0; )
+		if (other._used.get(i))
+			new (&_slots[i].bytes) Payload(other[(Handle) i]);
+		else {
+			_next[i] = _vacant;
+			_vacant = (Handle) i;
+		}
+
+	_used	= other._used;
+	_staged = other._staged;
+	_count	= other._count;
+
+	if (_peak < _count)
+		_peak = _count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -33,7 +33,7 @@
 #ifdef HFSM_ENABLE_ASSERT
 	#define HFSM_IF_ASSERT(...)					__VA_ARGS__
 	#define HFSM_CHECKED(x)						(!!(x) || (HFSM_BREAK(), 0))
-	#define HFSM_ASSERT(x)						(!!(x) || (HFSM_BREAK(), 0))
+	#define HFSM_ASSERT(x)						((void) (!!(x) || (HFSM_BREAK(), 0)))
 	#define HFSM_ASSERT_OR(y, n)				y
 #else
 	#define HFSM_IF_ASSERT(...)
@@ -115,6 +115,14 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+#ifdef HFSM_ENABLE_COROUTINES
+	#define HFSM_IF_COROUTINES(...)									  __VA_ARGS__
+#else
+	#define HFSM_IF_COROUTINES(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 #if defined _MSC_VER || defined __clang_major__ && __clang_major__ >= 7
 	#define HFSM_EXPLICIT_MEMBER_SPECIALIZATION									1
 #else
@@ -188,6 +196,42 @@ end(const T(& a)[NCapacity]) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+inline
+unsigned
+popCount(uint64_t bits) {
+#ifdef __GNUC__
+	return (unsigned) __builtin_popcountll(bits);
+#else
+	unsigned count = 0;
+
+	for (; bits; bits &= bits - 1)
+		++count;
+
+	return count;
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+inline
+unsigned
+lowestBit(const uint64_t bits) {
+	HFSM_ASSERT(bits);
+
+#ifdef __GNUC__
+	return (unsigned) __builtin_ctzll(bits);
+#else
+	unsigned index = 0;
+
+	for (uint64_t mask = 1; (bits & mask) == 0; mask <<= 1)
+		++index;
+
+	return index;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 template <int N1, int N2>
 struct Min {
 	static constexpr auto VALUE = N1 < N2 ? N1 : N2;
@@ -12,6 +12,12 @@ enum Strategy {
 	RandomUtil,
 };
 
+// how orthogonal regions run their prongs' update()
+enum Execution {
+	Sequential,
+	Parallel,
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #pragma pack(push, 1)
@@ -19,17 +25,17 @@ enum Strategy {
 struct alignas(2 * sizeof(ShortIndex)) Parent {
 	HFSM_INLINE Parent() = default;
 
-	HFSM_INLINE Parent(const ForkID forkId_)
+	HFSM_INLINE constexpr Parent(const ForkID forkId_)
 		: forkId{forkId_}
 	{}
 
-	HFSM_INLINE Parent(const ForkID forkId_,
-					   const ShortIndex prong_)
+	HFSM_INLINE constexpr Parent(const ForkID forkId_,
+								 const ShortIndex prong_)
 		: forkId{forkId_}
 		, prong{prong_}
 	{}
 
-	HFSM_INLINE explicit operator bool() const {
+	HFSM_INLINE constexpr explicit operator bool() const {
 		return forkId != INVALID_FORK_ID &&
 			   prong  != INVALID_SHORT_INDEX;
 	}
@@ -42,11 +48,14 @@ struct alignas(2 * sizeof(ShortIndex)) Parent {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// 'payload' is a handle into the machine's 'PayloadPoolT<>',
+// INVALID_SHORT_INDEX for transitions without one
+
 template <typename TPayload>
 struct RequestT {
 	using Payload = TPayload;
 
-	enum Type {
+	enum Type : ShortIndex {
 		REMAIN,
 		CHANGE,
 		RESTART,
@@ -60,32 +69,49 @@ struct RequestT {
 
 	HFSM_INLINE RequestT() = default;
 
-	HFSM_INLINE RequestT(const Type type_,
-						 const StateID stateId_)
-		: type{type_}
-		, stateId{stateId_}
-	{
-		HFSM_ASSERT(type_ < Type::COUNT);
-	}
-
 	HFSM_INLINE RequestT(const Type type_,
 						 const StateID stateId_,
-						 const Payload& payload_)
+						 const ShortIndex payload_ = INVALID_SHORT_INDEX)
 		: type{type_}
-		, stateId{stateId_}
 		, payload{payload_}
+		, stateId{stateId_}
 	{
 		HFSM_ASSERT(type_ < Type::COUNT);
 	}
 
 	Type type = CHANGE;
+	ShortIndex payload = INVALID_SHORT_INDEX;
 	StateID stateId = INVALID_STATE_ID;
-	Payload payload;
 };
 
 template <typename TPayload, ShortIndex NCount>
 using RequestsT = Array<RequestT<TPayload>, NCount>;
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// the batch being collected and the one before it, for guards to inspect
+// while their own requests are collected; swapped by index, never copied
+
+template <typename TPayload, ShortIndex NCount>
+class RequestBuffersT final {
+public:
+	using Requests = RequestsT<TPayload, NCount>;
+
+	HFSM_INLINE		  Requests& current()						{ return _buffers[_current];		}
+	HFSM_INLINE const Requests& current() const					{ return _buffers[_current];		}
+
+	HFSM_INLINE const Requests& previous() const				{ return _buffers[_current ^ 1];	}
+
+	// the current batch becomes the previous one, a new empty batch is started
+	HFSM_INLINE void advance()									{ _current ^= 1; _buffers[_current].clear();	}
+
+	// drops the current batch, making the previous one current again
+	HFSM_INLINE void restore()									{ _current ^= 1;					}
+
+private:
+	Requests _buffers[2];
+	ShortIndex _current = 0;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 
 template <LongIndex NCompoCount, LongIndex NOrthoCount, LongIndex NOrthoUnits>
@@ -95,7 +121,7 @@ struct AllForksT {
 	static constexpr ShortIndex ORTHO_UNITS	  = NOrthoUnits;
 
 	using Compo = StaticArray<ShortIndex, COMPO_REGIONS>;
-	using Ortho = BitArray<ShortIndex, ORTHO_REGIONS>;
+	using Ortho = BitArray<ShortIndex, ORTHO_UNITS * 8>;
 
 	Compo compo{INVALID_SHORT_INDEX};
 	Ortho ortho;
@@ -113,9 +139,72 @@ template <typename,
 		  LongIndex,
 		  LongIndex,
 		  typename,
-		  LongIndex>
+		  LongIndex,
+		  typename>
 struct ArgsT;
 
+//------------------------------------------------------------------------------
+// parent tables, generated from the apex info at compile time
+// (each table ends with a spare entry, so none of them are empty)
+
+template <typename TApex>
+constexpr Parent
+nearestCompo(const Parent parent) {
+	return !parent || parent.forkId > 0 ?
+		parent : nearestCompo<TApex>(TApex::orthoParent(-parent.forkId - 1, 0, 0, Parent{}));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TApex, typename, typename, typename>
+struct TopologyT;
+
+template <typename TApex,
+		  LongIndex... NStates,
+		  LongIndex... NCompos,
+		  LongIndex... NOrthos>
+struct TopologyT<TApex,
+				 IndexSequence<NStates...>,
+				 IndexSequence<NCompos...>,
+				 IndexSequence<NOrthos...>>
+{
+	using Apex = TApex;
+
+	static constexpr Parent STATE_PARENTS[sizeof...(NStates) + 1] = {
+		Apex::stateParent(NStates, 0, 0, 0, Parent{})..., Parent{}
+	};
+
+	static constexpr Parent STATE_COMPOS [sizeof...(NStates) + 1] = {
+		nearestCompo<Apex>(Apex::stateParent(NStates, 0, 0, 0, Parent{}))..., Parent{}
+	};
+
+	static constexpr Parent COMPO_PARENTS[sizeof...(NCompos) + 1] = {
+		Apex::compoParent(NCompos, 0, 0, Parent{})..., Parent{}
+	};
+
+	static constexpr Parent ORTHO_PARENTS[sizeof...(NOrthos) + 1] = {
+		Apex::orthoParent(NOrthos, 0, 0, Parent{})..., Parent{}
+	};
+
+	static constexpr Units  ORTHO_UNITS	 [sizeof...(NOrthos) + 1] = {
+		Apex::orthoUnits (NOrthos, 0, 0)..., Units{}
+	};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// folds a parent table into 'seed', for signatures of machine layouts
+
+constexpr uint32_t
+hashParents(const Parent* const parents,
+			const LongIndex count,
+			const uint32_t seed)
+{
+	return count == 0 ?
+		seed : hashParents(parents + 1,
+						   count - 1,
+						   (seed * 31u + (ShortIndex) parents->forkId) * 31u + parents->prong);
+}
+
 template <typename>
 struct StateRegistryT;
 
@@ -129,7 +218,8 @@ template <typename TContext,
 		  LongIndex NOrthoCount,
 		  LongIndex NOrthoUnits,
 		  typename TPayload,
-		  LongIndex NTaskCapacity>
+		  LongIndex NTaskCapacity,
+		  typename TApex>
 struct StateRegistryT<ArgsT<TContext,
 							TConfig,
 							TStateList,
@@ -138,7 +228,8 @@ struct StateRegistryT<ArgsT<TContext,
 							NOrthoCount,
 							NOrthoUnits,
 							TPayload,
-							NTaskCapacity>>
+							NTaskCapacity,
+							TApex>>
 {
 	using StateList		= TStateList;
 	using RegionList	= TRegionList;
@@ -151,24 +242,25 @@ struct StateRegistryT<ArgsT<TContext,
 	static constexpr ShortIndex ORTHO_REGIONS = NOrthoCount;
 	static constexpr ShortIndex ORTHO_UNITS	  = NOrthoUnits;
 
-	using StateParents	= StaticArray<Parent, STATE_COUNT>;
-
-	using CompoParents	= StaticArray<Parent, COMPO_REGIONS>;
-	using OrthoParents	= StaticArray<Parent, ORTHO_REGIONS>;
-	using OrthoUnits	= StaticArray<Units,  ORTHO_REGIONS>;
+	using Topology		= TopologyT<TApex,
+									MakeIndexSequence<STATE_COUNT>,
+									MakeIndexSequence<COMPO_REGIONS>,
+									MakeIndexSequence<ORTHO_REGIONS>>;
 
 	using CompoForks	= StaticArray<ShortIndex, COMPO_REGIONS>;
 	using AllForks		= AllForksT<COMPO_REGIONS, ORTHO_REGIONS, ORTHO_UNITS>;
 	using OrthoBits		= typename AllForks::Ortho::Bits;
 
 	using CompoRemains	= BitArray<ShortIndex, COMPO_REGIONS>;
+	using CompoChanges	= BitArray<ShortIndex, COMPO_REGIONS>;
+	using ActiveStates	= BitArray<StateID, STATE_COUNT>;
 
-	bool isActive		(const StateID stateId) const;
-	bool isResumable	(const StateID stateId) const;
+	HFSM_INLINE bool isActive	(const StateID stateId) const;
+	HFSM_INLINE bool isResumable(const StateID stateId) const;
 
-	bool isPendingChange(const StateID stateId) const;
-	bool isPendingEnter	(const StateID stateId) const;
-	bool isPendingExit	(const StateID stateId) const;
+	HFSM_INLINE bool isPendingChange(const StateID stateId) const;
+	HFSM_INLINE bool isPendingEnter	(const StateID stateId) const;
+	HFSM_INLINE bool isPendingExit	(const StateID stateId) const;
 
 	HFSM_INLINE const Parent&	  forkParent(const ForkID forkId) const;
 
@@ -180,16 +272,15 @@ struct StateRegistryT<ArgsT<TContext,
 
 	void clearRequests();
 
-	StateParents stateParents;
-	CompoParents compoParents;
-	OrthoParents orthoParents;
-	OrthoUnits orthoUnits;
+	ActiveStates activeStates;
 
 	CompoForks compoActive{INVALID_SHORT_INDEX};
 	AllForks resumable;
 
 	AllForks requested;
 	CompoRemains compoRemains;
+
+	CompoChanges compoChanges;
 };
 
 //------------------------------------------------------------------------------
@@ -200,7 +291,8 @@ template <typename TContext,
 		  typename TRegionList,
 		  LongIndex NCompoCount,
 		  typename TPayload,
-		  LongIndex NTaskCapacity>
+		  LongIndex NTaskCapacity,
+		  typename TApex>
 struct StateRegistryT<ArgsT<TContext,
 							TConfig,
 							TStateList,
@@ -209,7 +301,8 @@ struct StateRegistryT<ArgsT<TContext,
 							0,
 							0,
 							TPayload,
-							NTaskCapacity>>
+							NTaskCapacity,
+							TApex>>
 {
 	using StateList		= TStateList;
 	using RegionList	= TRegionList;
@@ -219,19 +312,23 @@ struct StateRegistryT<ArgsT<TContext,
 	static constexpr LongIndex  STATE_COUNT = StateList::SIZE;
 	static constexpr ShortIndex COMPO_REGIONS = NCompoCount;
 
-	using StateParents	= StaticArray<Parent, STATE_COUNT>;
-	using CompoParents	= StaticArray<Parent, COMPO_REGIONS>;
+	using Topology		= TopologyT<TApex,
+									MakeIndexSequence<STATE_COUNT>,
+									MakeIndexSequence<COMPO_REGIONS>,
+									MakeIndexSequence<0>>;
 
 	using CompoForks	= StaticArray<ShortIndex, COMPO_REGIONS>;
 	using AllForks		= AllForksT<COMPO_REGIONS, 0, 0>;
 	using CompoRemains	= BitArray<ShortIndex, COMPO_REGIONS>;
+	using CompoChanges	= BitArray<ShortIndex, COMPO_REGIONS>;
+	using ActiveStates	= BitArray<StateID, STATE_COUNT>;
 
-	bool isActive		(const StateID stateId) const;
-	bool isResumable	(const StateID stateId) const;
+	HFSM_INLINE bool isActive	(const StateID stateId) const;
+	HFSM_INLINE bool isResumable(const StateID stateId) const;
 
-	bool isPendingChange(const StateID stateId) const;
-	bool isPendingEnter	(const StateID stateId) const;
-	bool isPendingExit	(const StateID stateId) const;
+	HFSM_INLINE bool isPendingChange(const StateID stateId) const;
+	HFSM_INLINE bool isPendingEnter	(const StateID stateId) const;
+	HFSM_INLINE bool isPendingExit	(const StateID stateId) const;
 
 	HFSM_INLINE const Parent& forkParent(const ForkID forkId) const;
 
@@ -240,14 +337,15 @@ struct StateRegistryT<ArgsT<TContext,
 
 	void clearRequests();
 
-	StateParents stateParents;
-	CompoParents compoParents;
+	ActiveStates activeStates;
 
 	CompoForks compoActive{INVALID_SHORT_INDEX};
 	AllForks resumable;
 
 	AllForks requested;
 	CompoRemains compoRemains;
+
+	CompoChanges compoChanges;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -14,147 +14,126 @@ AllForksT<NCC, NOC, NOU>::clear() {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::isActive(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
+template <typename TA, LongIndex... NS, LongIndex... NC, LongIndex... NO>
+constexpr Parent TopologyT<TA, IndexSequence<NS...>, IndexSequence<NC...>, IndexSequence<NO...>>::STATE_PARENTS[];
 
-			if (parent.forkId > 0)
-				return parent.prong == compoActive[parent.forkId - 1];
-		}
+template <typename TA, LongIndex... NS, LongIndex... NC, LongIndex... NO>
+constexpr Parent TopologyT<TA, IndexSequence<NS...>, IndexSequence<NC...>, IndexSequence<NO...>>::STATE_COMPOS[];
 
-	return true;
+template <typename TA, LongIndex... NS, LongIndex... NC, LongIndex... NO>
+constexpr Parent TopologyT<TA, IndexSequence<NS...>, IndexSequence<NC...>, IndexSequence<NO...>>::COMPO_PARENTS[];
+
+template <typename TA, LongIndex... NS, LongIndex... NC, LongIndex... NO>
+constexpr Parent TopologyT<TA, IndexSequence<NS...>, IndexSequence<NC...>, IndexSequence<NO...>>::ORTHO_PARENTS[];
+
+template <typename TA, LongIndex... NS, LongIndex... NC, LongIndex... NO>
+constexpr Units  TopologyT<TA, IndexSequence<NS...>, IndexSequence<NC...>, IndexSequence<NO...>>::ORTHO_UNITS[];
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::isActive(const StateID stateId) const {
+	return HFSM_CHECKED(stateId < STATE_COUNT) &&
+		activeStates.get(stateId);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
 bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::isResumable(const StateID stateId) const {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::isResumable(const StateID stateId) const {
 	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
-
-			if (parent.forkId > 0)
-				return parent.prong == resumable.compo[parent.forkId - 1];
-		}
+		if (const Parent parent = Topology::STATE_COMPOS[stateId])
+			return parent.prong == resumable.compo[parent.forkId - 1];
 
 	return false;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
 bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::isPendingChange(const StateID stateId) const {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::isPendingChange(const StateID stateId) const {
 	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
-
-			if (parent.forkId > 0)
-				return requested.compo[parent.forkId - 1] !=
-						   compoActive[parent.forkId - 1];
-		}
+		if (const Parent parent = Topology::STATE_COMPOS[stateId])
+			return requested.compo[parent.forkId - 1] !=
+					   compoActive[parent.forkId - 1];
 
 	return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
 bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::isPendingEnter(const StateID stateId) const {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::isPendingEnter(const StateID stateId) const {
 	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
-
-			if (parent.forkId > 0)
-				return parent.prong !=	   compoActive[parent.forkId - 1] &&
-					   parent.prong == requested.compo[parent.forkId - 1];
-		}
+		if (const Parent parent = Topology::STATE_COMPOS[stateId])
+			return parent.prong !=	   compoActive[parent.forkId - 1] &&
+				   parent.prong == requested.compo[parent.forkId - 1];
 
 	return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
 bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::isPendingExit(const StateID stateId) const {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::isPendingExit(const StateID stateId) const {
 	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
-
-			if (parent.forkId > 0)
-				return parent.prong ==	   compoActive[parent.forkId - 1] &&
-					   parent.prong != requested.compo[parent.forkId - 1];
-		}
+		if (const Parent parent = Topology::STATE_COMPOS[stateId])
+			return parent.prong ==	   compoActive[parent.forkId - 1] &&
+				   parent.prong != requested.compo[parent.forkId - 1];
 
 	return true;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
 const Parent&
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::forkParent(const ForkID forkId) const {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::forkParent(const ForkID forkId) const {
 	HFSM_ASSERT(forkId != 0);
 
 	return forkId > 0 ?
-		compoParents[ forkId - 1] :
-		orthoParents[-forkId - 1];
+		Topology::COMPO_PARENTS[ forkId - 1] :
+		Topology::ORTHO_PARENTS[-forkId - 1];
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-typename StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::OrthoBits
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::resumableOrthoFork(const ForkID forkId) {
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+typename StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::OrthoBits
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::resumableOrthoFork(const ForkID forkId) {
 	HFSM_ASSERT(forkId < 0);
-	const Units& units = orthoUnits[-forkId - 1];
+	const Units& units = Topology::ORTHO_UNITS[-forkId - 1];
 
 	return resumable.ortho.bits(units);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-typename StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::OrthoBits
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::requestedOrthoFork(const ForkID forkId) {
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+typename StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::OrthoBits
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::requestedOrthoFork(const ForkID forkId) {
 	HFSM_ASSERT(forkId < 0);
-	const Units& units = orthoUnits[-forkId - 1];
+	const Units& units = Topology::ORTHO_UNITS[-forkId - 1];
 
 	return requested.ortho.bits(units);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
 bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::requestImmediate(const Request request) {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::requestImmediate(const Request request) {
 	if (request.stateId == 0)
 		return false;
 	else if (HFSM_CHECKED(request.stateId < STATE_COUNT)) {
 		Parent parent;
 
-		for (parent = stateParents[request.stateId];
+		for (parent = Topology::STATE_PARENTS[request.stateId];
 			 parent;
 			 parent = forkParent(parent.forkId))
 		{
@@ -200,15 +179,16 @@ StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::requestImmedia
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
 void
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::requestScheduled(const StateID stateId) {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::requestScheduled(const StateID stateId) {
 	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
-		const Parent parent = stateParents[stateId];
+		const Parent parent = Topology::STATE_PARENTS[stateId];
 
-		if (parent.forkId > 0)
+		if (parent.forkId > 0) {
 			resumable.compo[parent.forkId - 1] = parent.prong;
-		else if (parent.forkId < 0)
+			compoChanges.set(parent.forkId - 1);
+		} else if (parent.forkId < 0)
 			resumableOrthoFork(parent.forkId).set(parent.prong);
 		else
 			HFSM_BREAK();
@@ -217,37 +197,29 @@ StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::requestSchedul
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
 void
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::clearRequests() {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::clearRequests() {
 	compoRemains.clear();
 	requested.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
 bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isActive(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
-		if (Parent parent = stateParents[stateId]) {
-			HFSM_ASSERT(parent.forkId > 0);
-
-			return parent.prong == compoActive[parent.forkId - 1];
-		} else
-			return true;
-	}
-
-	return false;
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::isActive(const StateID stateId) const {
+	return HFSM_CHECKED(stateId < STATE_COUNT) &&
+		activeStates.get(stateId);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
 bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isResumable(const StateID stateId) const {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::isResumable(const StateID stateId) const {
 	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		if (Parent parent = stateParents[stateId]) {
+		if (Parent parent = Topology::STATE_PARENTS[stateId]) {
 			HFSM_ASSERT(parent.forkId > 0);
 
 			return parent.prong == resumable.compo[parent.forkId - 1];
@@ -258,11 +230,11 @@ StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isResumable(const
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
 bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isPendingChange(const StateID stateId) const {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::isPendingChange(const StateID stateId) const {
 	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		if (Parent parent = stateParents[stateId]) {
+		if (Parent parent = Topology::STATE_PARENTS[stateId]) {
 			HFSM_ASSERT(parent.forkId > 0);
 
 			return requested.compo[parent.forkId - 1] !=
@@ -274,11 +246,11 @@ StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isPendingChange(co
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
 bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isPendingEnter(const StateID stateId) const {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::isPendingEnter(const StateID stateId) const {
 	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		if (Parent parent = stateParents[stateId]) {
+		if (Parent parent = Topology::STATE_PARENTS[stateId]) {
 			HFSM_ASSERT(parent.forkId > 0);
 
 			return parent.prong !=	   compoActive[parent.forkId - 1] &&
@@ -290,11 +262,11 @@ StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isPendingEnter(con
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
 bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isPendingExit(const StateID stateId) const {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::isPendingExit(const StateID stateId) const {
 	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		if (Parent parent = stateParents[stateId]) {
+		if (Parent parent = Topology::STATE_PARENTS[stateId]) {
 			HFSM_ASSERT(parent.forkId > 0);
 
 			return parent.prong ==	   compoActive[parent.forkId - 1] &&
@@ -306,23 +278,23 @@ StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isPendingExit(cons
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
 const Parent&
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::forkParent(const ForkID forkId) const {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::forkParent(const ForkID forkId) const {
 	HFSM_ASSERT(forkId > 0);
 
-	return compoParents[forkId - 1];
+	return Topology::COMPO_PARENTS[forkId - 1];
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
 bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::requestImmediate(const Request request) {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::requestImmediate(const Request request) {
 	if (request.stateId == 0)
 		return false;
 	else if (HFSM_CHECKED(request.stateId < STATE_COUNT)) {
-		Parent parent = stateParents[request.stateId];
+		Parent parent = Topology::STATE_PARENTS[request.stateId];
 
 		if (HFSM_CHECKED(parent)) {
 			HFSM_ASSERT(parent.forkId > 0);
@@ -356,24 +328,26 @@ StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::requestImmediate(c
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
 void
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::requestScheduled(const StateID stateId) {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::requestScheduled(const StateID stateId) {
 	HFSM_ASSERT(stateId < STATE_COUNT);
 
 	if (stateId < STATE_COUNT) {
-		const Parent parent = stateParents[stateId];
+		const Parent parent = Topology::STATE_PARENTS[stateId];
 
-		if (HFSM_CHECKED(parent.forkId > 0))
+		if (HFSM_CHECKED(parent.forkId > 0)) {
 			resumable.compo[parent.forkId - 1] = parent.prong;
+			compoChanges.set(parent.forkId - 1);
+		}
 	}
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
 void
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::clearRequests() {
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::clearRequests() {
 	compoRemains.clear();
 	requested.clear();
 }
@@ -0,0 +1,67 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+// all instances are dispatched first, transitions are processed in a second
+// pass over the instances that made requests
+
+template <typename TInstance,
+		  LongIndex NCapacity>
+class MB_ final {
+public:
+	using Instance	= TInstance;
+	using Index		= LongIndex;
+
+	static constexpr Index CAPACITY = NCapacity;
+	static constexpr Index INVALID	= INVALID_LONG_INDEX;
+
+	static_assert(CAPACITY < INVALID, "Batch capacity is too large");
+
+public:
+	HFSM_INLINE MB_() = default;
+	HFSM_INLINE ~MB_()												{ clear();							}
+
+	MB_(const MB_&) = delete;
+	MB_& operator = (const MB_&) = delete;
+
+	template <typename... TArgs>
+	Index emplace(TArgs&&... args);
+
+	void clear();
+
+	HFSM_INLINE		  Instance& operator[] (const Index i);
+	HFSM_INLINE const Instance& operator[] (const Index i) const;
+
+	HFSM_INLINE Index count() const									{ return _count;					}
+
+	HFSM_INLINE Index pendingCount() const							{ return _pendingCount;				}
+
+	void updateAll();
+
+	template <typename TEvent>
+	void reactAll(const TEvent& event);
+
+private:
+	HFSM_INLINE		  Instance& instance(const Index i)				{ return reinterpret_cast<	   Instance&>(_storage[i]);	}
+	HFSM_INLINE const Instance& instance(const Index i) const		{ return reinterpret_cast<const Instance&>(_storage[i]);	}
+
+	HFSM_INLINE void finalizePending();
+
+private:
+	struct alignas(Instance) Cell {
+		unsigned char bytes[sizeof(Instance)];
+	};
+
+	Cell _storage[CAPACITY];
+	Index _pending[CAPACITY];
+
+	Index _count = 0;
+	Index _pendingCount = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "batch.inl"
@@ -0,0 +1,93 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TI, LongIndex NC>
+template <typename... TArgs>
+LongIndex
+MB_<TI, NC>::emplace(TArgs&&... args) {
+	if (_count < CAPACITY) {
+		new (&_storage[_count]) Instance{std::forward<TArgs>(args)...};
+
+		return _count++;
+	} else {
+		HFSM_BREAK();
+
+		return INVALID;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TI, LongIndex NC>
+void
+MB_<TI, NC>::clear() {
+	while (_count)
+		instance(--_count).~Instance();
+
+	_pendingCount = 0;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TI, LongIndex NC>
+typename MB_<TI, NC>::Instance&
+MB_<TI, NC>::operator[] (const Index i) {
+	HFSM_ASSERT(i < _count);
+
+	return instance(i);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, LongIndex NC>
+const typename MB_<TI, NC>::Instance&
+MB_<TI, NC>::operator[] (const Index i) const {
+	HFSM_ASSERT(i < _count);
+
+	return instance(i);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TI, LongIndex NC>
+void
+MB_<TI, NC>::updateAll() {
+	_pendingCount = 0;
+
+	for (Index i = 0; i < _count; ++i)
+		if (instance(i).dispatchUpdate())
+			_pending[_pendingCount++] = i;
+
+	finalizePending();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, LongIndex NC>
+template <typename TEvent>
+void
+MB_<TI, NC>::reactAll(const TEvent& event) {
+	_pendingCount = 0;
+
+	for (Index i = 0; i < _count; ++i)
+		if (instance(i).dispatchReact(event))
+			_pending[_pendingCount++] = i;
+
+	finalizePending();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TI, LongIndex NC>
+void
+MB_<TI, NC>::finalizePending() {
+	for (Index p = 0; p < _pendingCount; ++p)
+		instance(_pending[p]).finalizeRequests();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
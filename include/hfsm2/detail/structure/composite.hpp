@@ -32,7 +32,6 @@ struct C_ {
 	using RequestType	= typename Request::Type;
 
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
 
 	using Control		= ControlT<Args>;
 
@@ -61,6 +60,12 @@ struct C_ {
 	using Info			= CI_<STRATEGY, Head, TSubStates...>;
 	static constexpr ShortIndex REGION_SIZE	= Info::STATE_COUNT;
 
+	static constexpr bool JUMP_TABLE = Info::WIDTH >= Args::Config_::JUMP_TABLE_WIDTH;
+
+	using Dispatch		= typename std::conditional<JUMP_TABLE,
+													MakeIndexSequence<Info::WIDTH>,
+													std::false_type>::type;
+
 	HFSM_INLINE ShortIndex& compoActive   (StateRegistry& stateRegistry)	{ return stateRegistry.compoActive	  [COMPO_INDEX]; }
 	HFSM_INLINE ShortIndex& compoResumable(StateRegistry& stateRegistry)	{ return stateRegistry.resumable.compo[COMPO_INDEX]; }
 	HFSM_INLINE ShortIndex& compoRequested(StateRegistry& stateRegistry)	{ return stateRegistry.requested.compo[COMPO_INDEX]; }
@@ -74,8 +79,68 @@ struct C_ {
 										   const Rank	(& ranks)  [Info::WIDTH], const Rank	top);
 
 	HFSM_INLINE bool	compoRemain		  (Control& control)				{ return control._stateRegistry.compoRemains.template get<COMPO_INDEX>(); }
+	HFSM_INLINE void	compoChanged	  (Control& control)				{ control._stateRegistry.compoChanges.template set<COMPO_INDEX>();		 }
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct Enterer {
+		using Result = void;
+
+		HFSM_INLINE void operator () (SubStates& subStates, const ShortIndex prong)	{ subStates.wideEnter(control, prong);	}
+
+		template <typename TState>
+		HFSM_INLINE void operator () (TState& state)								{ state.deepEnter(control);				}
+
+		PlanControl& control;
+	};
+
+	struct Exiter {
+		using Result = void;
+
+		HFSM_INLINE void operator () (SubStates& subStates, const ShortIndex prong)	{ subStates.wideExit(control, prong);	}
+
+		template <typename TState>
+		HFSM_INLINE void operator () (TState& state)								{ state.deepExit(control);				}
+
+		PlanControl& control;
+	};
+
+	struct Updater {
+		using Result = Status;
+
+		HFSM_INLINE Status operator () (SubStates& subStates, const ShortIndex prong)	{ return subStates.wideUpdate(control, prong);	}
+
+		template <typename TState>
+		HFSM_INLINE Status operator () (TState& state)									{ return state.deepUpdate(control);				}
+
+		FullControl& control;
+	};
+
+	template <typename TEvent>
+	struct Reactor {
+		using Result = Status;
+
+		HFSM_INLINE Status operator () (SubStates& subStates, const ShortIndex prong)	{ return subStates.wideReact(control, event, prong);	}
+
+		template <typename TState>
+		HFSM_INLINE Status operator () (TState& state)									{ return state.deepReact(control, event);				}
+
+		FullControl& control;
+		const TEvent& event;
+	};
+
+	template <typename TFunctor>
+	HFSM_INLINE typename TFunctor::Result wideDispatch(TFunctor&& functor, const ShortIndex prong)		{ return wideDispatch(functor, prong, Dispatch{});	}
+
+	template <typename TFunctor>
+	HFSM_INLINE typename TFunctor::Result wideDispatch(TFunctor& functor, const ShortIndex prong, std::false_type)	{ return functor(_subStates, prong);	}
+
+	template <typename TFunctor, LongIndex... NProngs>
+	HFSM_INLINE typename TFunctor::Result wideDispatch(TFunctor& functor, const ShortIndex prong, IndexSequence<NProngs...>);
+
+	template <typename TFunctor, LongIndex NProng>
+	static typename TFunctor::Result wideDispatchProng(SubStates& subStates, TFunctor& functor)	{ return subStates.template wideVisit<(ShortIndex) NProng>(functor);	}
 
-	HFSM_INLINE void	deepRegister				  (StateRegistry& stateRegistry, const Parent parent);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -3,6 +3,24 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename TN, typename TA, Strategy TG, typename TH, typename... TS>
+template <typename TFunctor, LongIndex... NProngs>
+typename TFunctor::Result
+C_<TN, TA, TG, TH, TS...>::wideDispatch(TFunctor& functor,
+										const ShortIndex prong,
+										IndexSequence<NProngs...>)
+{
+	using Thunk = typename TFunctor::Result (*)(SubStates&, TFunctor&);
+
+	static const Thunk THUNKS[] = { &wideDispatchProng<TFunctor, NProngs>... };
+
+	HFSM_ASSERT(prong < Info::WIDTH);
+
+	return THUNKS[prong](_subStates, functor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 template <typename TN, typename TA, Strategy TG, typename TH, typename... TS>
 ShortIndex
 C_<TN, TA, TG, TH, TS...>::resolveRandom(Control& control,
@@ -11,7 +29,7 @@ C_<TN, TA, TG, TH, TS...>::resolveRandom(Control& control,
 										 const Rank(& ranks)[Info::WIDTH],
 										 const Rank top)
 {
-	const Utility random = control._random.next();
+	const Utility random = control.random();
 	HFSM_ASSERT(0.0f <= random && random < 1.0f);
 
 	Utility cursor = random * sum;
@@ -35,19 +53,6 @@ C_<TN, TA, TG, TH, TS...>::resolveRandom(Control& control,
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy TG, typename TH, typename... TS>
-void
-C_<TN, TA, TG, TH, TS...>::deepRegister(StateRegistry& stateRegistry,
-										const Parent parent)
-{
-	stateRegistry.compoParents[COMPO_INDEX] = parent;
-
-	_headState.deepRegister(stateRegistry, parent);
-	_subStates.wideRegister(stateRegistry, Parent{COMPO_ID});
-}
-
-//------------------------------------------------------------------------------
-
 template <typename TN, typename TA, Strategy TG, typename TH, typename... TS>
 bool
 C_<TN, TA, TG, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
@@ -100,8 +105,9 @@ C_<TN, TA, TG, TH, TS...>::deepEnter(PlanControl& control) {
 		resumable = INVALID_SHORT_INDEX;
 
 	requested = INVALID_SHORT_INDEX;
+	compoChanged(control);
 
-	_subStates.wideEnter(control, active);
+	wideDispatch(Enterer{control}, active);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -123,14 +129,16 @@ C_<TN, TA, TG, TH, TS...>::deepReenter(PlanControl& control) {
 	if (active == requested)
 		_subStates.wideReenter(control, active);
 	else {
-		_subStates.wideExit	  (control, active);
+		wideDispatch(Exiter {control}, active);
 
 		active	  = requested;
 
 		if (requested == resumable)
 			resumable = INVALID_SHORT_INDEX;
 
-		_subStates.wideEnter  (control, active);
+		compoChanged(control);
+
+		wideDispatch(Enterer{control}, active);
 	}
 
 	requested = INVALID_SHORT_INDEX;
@@ -148,11 +156,11 @@ C_<TN, TA, TG, TH, TS...>::deepUpdate(FullControl& control) {
 
 	if (const Status headStatus = _headState.deepUpdate(control)) {
 		ControlLock lock{control};
-		_subStates.wideUpdate(control, active);
+		wideDispatch(Updater{control}, active);
 
 		return headStatus;
 	} else {
-		const Status subStatus = _subStates.wideUpdate(control, active);
+		const Status subStatus = wideDispatch(Updater{control}, active);
 
 		if (subStatus.outerTransition)
 			return Status{Status::NONE, true};
@@ -179,11 +187,11 @@ C_<TN, TA, TG, TH, TS...>::deepReact(FullControl& control,
 
 	if (const Status headStatus = _headState.deepReact(control, event)) {
 		ControlLock lock{control};
-		_subStates.wideReact(control, event, active);
+		wideDispatch(Reactor<TEvent>{control, event}, active);
 
 		return headStatus;
 	} else {
-		const Status subStatus = _subStates.wideReact(control, event, active);
+		const Status subStatus = wideDispatch(Reactor<TEvent>{control, event}, active);
 
 		if (subStatus.outerTransition)
 			return subStatus;
@@ -235,11 +243,12 @@ C_<TN, TA, TG, TH, TS...>::deepExit(PlanControl& control) {
 
 	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
 
-	_subStates.wideExit(control, active);
+	wideDispatch(Exiter {control}, active);
 	_headState.deepExit(control);
 
 	resumable = active;
 	active	  = INVALID_SHORT_INDEX;
+	compoChanged(control);
 
 	auto plan = control.plan(REGION_ID);
 	plan.clear();
@@ -640,9 +649,10 @@ C_<TN, TA, TG, TH, TS...>::deepEnterRequested(PlanControl& control) {
 
 	active	  = requested;
 	requested = INVALID_SHORT_INDEX;
+	compoChanged(control);
 
 	_headState.deepEnter(control);
-	_subStates.wideEnter(control, active);
+	wideDispatch(Enterer{control}, active);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -659,19 +669,20 @@ C_<TN, TA, TG, TH, TS...>::deepChangeToRequested(PlanControl& control) {
 	if (requested == INVALID_SHORT_INDEX)
 		_subStates.wideChangeToRequested(control, active);
 	else if (requested != active) {
-		_subStates.wideExit	  (control, active);
+		wideDispatch(Exiter {control}, active);
 
 		resumable = active;
 		active	  = requested;
 		requested = INVALID_SHORT_INDEX;
+		compoChanged(control);
 
-		_subStates.wideEnter  (control, active);
+		wideDispatch(Enterer{control}, active);
 	} else if (compoRemain(control)) {
-		_subStates.wideExit	  (control, active);
+		wideDispatch(Exiter {control}, active);
 
 		requested = INVALID_SHORT_INDEX;
 
-		_subStates.wideEnter  (control, active);
+		wideDispatch(Enterer{control}, active);
 	} else {
 		requested = INVALID_SHORT_INDEX;
 
@@ -34,7 +34,6 @@ struct CS_ {
 	using RequestType	= typename Request::Type;
 
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
 
 	using Control		= ControlT	   <Args>;
 	using PlanControl	= PlanControlT <Args>;
@@ -68,7 +67,6 @@ struct CS_ {
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	wideRegister				  (StateRegistry& stateRegistry, const Parent parent);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -90,6 +88,17 @@ struct CS_ {
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+	template <ShortIndex NProng, typename TFunctor>
+	HFSM_INLINE typename TFunctor::Result wideVisit(TFunctor& functor)						{ return wideVisit<NProng>(functor, std::integral_constant<bool, (NProng < R_PRONG)>{});	}
+
+	template <ShortIndex NProng, typename TFunctor>
+	HFSM_INLINE typename TFunctor::Result wideVisit(TFunctor& functor, std::true_type)		{ return lHalf.template wideVisit<NProng>(functor);	}
+
+	template <ShortIndex NProng, typename TFunctor>
+	HFSM_INLINE typename TFunctor::Result wideVisit(TFunctor& functor, std::false_type)	{ return rHalf.template wideVisit<NProng>(functor);	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 	HFSM_INLINE void	wideForwardActive			  (Control& control,	 const RequestType request,	const ShortIndex prong);
 	HFSM_INLINE void	wideForwardRequest			  (Control& control,	 const RequestType request,	const ShortIndex prong);
 
@@ -186,7 +195,6 @@ struct CS_<TIndices, TArgs, TStrategy, NIndex, TState> {
 	using RequestType	= typename Request::Type;
 
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
 
 	using Control		= ControlT	   <Args>;
 	using PlanControl	= PlanControlT <Args>;
@@ -202,7 +210,6 @@ struct CS_<TIndices, TArgs, TStrategy, NIndex, TState> {
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	wideRegister				  (StateRegistry& stateRegistry, const Parent parent);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -224,6 +231,15 @@ struct CS_<TIndices, TArgs, TStrategy, NIndex, TState> {
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+	template <ShortIndex NProng, typename TFunctor>
+	HFSM_INLINE typename TFunctor::Result wideVisit(TFunctor& functor) {
+		static_assert(NProng == PRONG_INDEX, "");
+
+		return functor(state);
+	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 	HFSM_INLINE void	wideForwardActive			  (Control& control,	 const RequestType request,	const ShortIndex prong);
 	HFSM_INLINE void	wideForwardRequest			  (Control& control,	 const RequestType request,	const ShortIndex prong);
 
@@ -3,17 +3,6 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, Strategy TG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, TG, NI, TS...>::wideRegister(StateRegistry& stateRegistry,
-										 const Parent parent)
-{
-	lHalf.wideRegister(stateRegistry, Parent{parent.forkId, L_PRONG});
-	rHalf.wideRegister(stateRegistry, Parent{parent.forkId, R_PRONG});
-}
-
-//------------------------------------------------------------------------------
-
 template <typename TN, typename TA, Strategy TG, ShortIndex NI, typename... TS>
 bool
 CS_<TN, TA, TG, NI, TS...>::wideForwardEntryGuard(GuardControl& control,
@@ -3,16 +3,6 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, Strategy TG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, TG, NI, T>::wideRegister(StateRegistry& stateRegistry,
-									 const Parent parent)
-{
-	state.deepRegister(stateRegistry, Parent{parent.forkId, PRONG_INDEX});
-}
-
-//------------------------------------------------------------------------------
-
 template <typename TN, typename TA, Strategy TG, ShortIndex NI, typename T>
 bool
 CS_<TN, TA, TG, NI, T>::wideForwardEntryGuard(GuardControl& control,
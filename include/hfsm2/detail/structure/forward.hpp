@@ -24,7 +24,7 @@ struct CSI_<TInitial>;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename, typename...>
+template <Execution, typename, typename...>
 struct OI_;
 
 template <typename...>
@@ -51,9 +51,9 @@ struct WrapT<	 CI_<TG, TH, TS...>> {
 	using Type = CI_<TG, TH, TS...>;
 };
 
-template <typename... TS>
-struct WrapT<	 OI_<TS...>> {
-	using Type = OI_<TS...>;
+template <Execution TX, typename TH, typename... TS>
+struct WrapT<	 OI_<TX, TH, TS...>> {
+	using Type = OI_<TX, TH, TS...>;
 };
 
 template <typename... TS>
@@ -76,6 +76,14 @@ struct SI_ final {
 
 	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
 	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
+
+	static constexpr Parent stateParent(const StateID, const StateID, const ShortIndex, const ShortIndex, const Parent parent) {
+		return std::is_same<Head, void>::value ? Parent{} : parent;
+	}
+
+	static constexpr Parent compoParent(const ShortIndex, const ShortIndex, const ShortIndex, const Parent)	{ return Parent{};	}
+	static constexpr Parent orthoParent(const ShortIndex, const ShortIndex, const ShortIndex, const Parent)	{ return Parent{};	}
+	static constexpr Units  orthoUnits (const ShortIndex, const ShortIndex, const ShortIndex)					{ return Units{};	}
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -95,6 +103,29 @@ struct CSI_<TInitial, TRemaining...> {
 
 	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
 	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
+	static constexpr Parent stateParent(const StateID id, const StateID first, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return id < first + Initial::STATE_COUNT ?
+			Initial  ::stateParent(id, first, compo, ortho, Parent{forkId, prong}) :
+			Remaining::stateParent(id, first + Initial::STATE_COUNT, compo + Initial::COMPO_REGIONS, ortho + Initial::ORTHO_REGIONS, forkId, prong + 1);
+	}
+
+	static constexpr Parent compoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return index < compo + Initial::COMPO_REGIONS ?
+			Initial  ::compoParent(index, compo, ortho, Parent{forkId, prong}) :
+			Remaining::compoParent(index, compo + Initial::COMPO_REGIONS, ortho + Initial::ORTHO_REGIONS, forkId, prong + 1);
+	}
+
+	static constexpr Parent orthoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return index < ortho + Initial::ORTHO_REGIONS ?
+			Initial  ::orthoParent(index, compo, ortho, Parent{forkId, prong}) :
+			Remaining::orthoParent(index, compo + Initial::COMPO_REGIONS, ortho + Initial::ORTHO_REGIONS, forkId, prong + 1);
+	}
+
+	static constexpr Units orthoUnits(const ShortIndex index, const ShortIndex ortho, const ShortIndex unit) {
+		return index < ortho + Initial::ORTHO_REGIONS ?
+			Initial  ::orthoUnits(index, ortho, unit) :
+			Remaining::orthoUnits(index, ortho + Initial::ORTHO_REGIONS, unit + Initial::ORTHO_UNITS);
+	}
 };
 
 template <typename TInitial>
@@ -111,6 +142,21 @@ struct CSI_<TInitial> {
 
 	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
 	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
+	static constexpr Parent stateParent(const StateID id, const StateID first, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return Initial::stateParent(id, first, compo, ortho, Parent{forkId, prong});
+	}
+
+	static constexpr Parent compoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return Initial::compoParent(index, compo, ortho, Parent{forkId, prong});
+	}
+
+	static constexpr Parent orthoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return Initial::orthoParent(index, compo, ortho, Parent{forkId, prong});
+	}
+
+	static constexpr Units orthoUnits(const ShortIndex index, const ShortIndex ortho, const ShortIndex unit) {
+		return Initial::orthoUnits(index, ortho, unit);
+	}
 };
 
 template <Strategy TStrategy, typename THead, typename... TSubStates>
@@ -132,6 +178,25 @@ struct CI_ final {
 
 	static constexpr LongIndex	STATE_COUNT	  = StateList::SIZE;
 	static constexpr ShortIndex	REGION_COUNT  = RegionList::SIZE;
+	static constexpr Parent stateParent(const StateID id, const StateID first, const ShortIndex compo, const ShortIndex ortho, const Parent parent) {
+		return id == first ?
+			HeadInfo ::stateParent(id, first, compo, ortho, parent) :
+			SubStates::stateParent(id, first + 1, compo + 1, ortho, (ForkID) (compo + 1), 0);
+	}
+
+	static constexpr Parent compoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const Parent parent) {
+		return index == compo ?
+			parent :
+			SubStates::compoParent(index, compo + 1, ortho, (ForkID) (compo + 1), 0);
+	}
+
+	static constexpr Parent orthoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const Parent) {
+		return SubStates::orthoParent(index, compo + 1, ortho, (ForkID) (compo + 1), 0);
+	}
+
+	static constexpr Units orthoUnits(const ShortIndex index, const ShortIndex ortho, const ShortIndex unit) {
+		return SubStates::orthoUnits(index, ortho, unit);
+	}
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -148,6 +213,30 @@ struct OSI_<TInitial, TRemaining...> {
 	static constexpr LongIndex  COMPO_PRONGS  =		Initial::COMPO_PRONGS  + Remaining::COMPO_PRONGS;
 	static constexpr ShortIndex ORTHO_REGIONS =		Initial::ORTHO_REGIONS + Remaining::ORTHO_REGIONS;
 	static constexpr ShortIndex ORTHO_UNITS	  =		Initial::ORTHO_UNITS   + Remaining::ORTHO_UNITS;
+
+	static constexpr Parent stateParent(const StateID id, const StateID first, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return id < first + Initial::STATE_COUNT ?
+			Initial  ::stateParent(id, first, compo, ortho, Parent{forkId, prong}) :
+			Remaining::stateParent(id, first + Initial::STATE_COUNT, compo + Initial::COMPO_REGIONS, ortho + Initial::ORTHO_REGIONS, forkId, prong + 1);
+	}
+
+	static constexpr Parent compoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return index < compo + Initial::COMPO_REGIONS ?
+			Initial  ::compoParent(index, compo, ortho, Parent{forkId, prong}) :
+			Remaining::compoParent(index, compo + Initial::COMPO_REGIONS, ortho + Initial::ORTHO_REGIONS, forkId, prong + 1);
+	}
+
+	static constexpr Parent orthoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return index < ortho + Initial::ORTHO_REGIONS ?
+			Initial  ::orthoParent(index, compo, ortho, Parent{forkId, prong}) :
+			Remaining::orthoParent(index, compo + Initial::COMPO_REGIONS, ortho + Initial::ORTHO_REGIONS, forkId, prong + 1);
+	}
+
+	static constexpr Units orthoUnits(const ShortIndex index, const ShortIndex ortho, const ShortIndex unit) {
+		return index < ortho + Initial::ORTHO_REGIONS ?
+			Initial  ::orthoUnits(index, ortho, unit) :
+			Remaining::orthoUnits(index, ortho + Initial::ORTHO_REGIONS, unit + Initial::ORTHO_UNITS);
+	}
 };
 
 template <typename TInitial>
@@ -161,10 +250,28 @@ struct OSI_<TInitial> {
 	static constexpr LongIndex  COMPO_PRONGS  = Initial::COMPO_PRONGS;
 	static constexpr ShortIndex ORTHO_REGIONS = Initial::ORTHO_REGIONS;
 	static constexpr ShortIndex ORTHO_UNITS	  = Initial::ORTHO_UNITS;
+
+	static constexpr Parent stateParent(const StateID id, const StateID first, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return Initial::stateParent(id, first, compo, ortho, Parent{forkId, prong});
+	}
+
+	static constexpr Parent compoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return Initial::compoParent(index, compo, ortho, Parent{forkId, prong});
+	}
+
+	static constexpr Parent orthoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return Initial::orthoParent(index, compo, ortho, Parent{forkId, prong});
+	}
+
+	static constexpr Units orthoUnits(const ShortIndex index, const ShortIndex ortho, const ShortIndex unit) {
+		return Initial::orthoUnits(index, ortho, unit);
+	}
 };
 
-template <typename THead, typename... TSubStates>
+template <Execution TExecution, typename THead, typename... TSubStates>
 struct OI_ final {
+	static constexpr Execution EXECUTION = TExecution;
+
 	using Head				= THead;
 	using HeadInfo			= SI_<Head>;
 	using SubStates			= OSI_<TSubStates...>;
@@ -172,14 +279,36 @@ struct OI_ final {
 	using RegionList		= Merge<typename HeadInfo::StateList, typename SubStates::RegionList>;
 
 	static constexpr ShortIndex WIDTH		  = sizeof...(TSubStates);
+	static constexpr ShortIndex WIDTH_UNITS	  = (WIDTH + 7) / 8;
 	static constexpr LongIndex  REVERSE_DEPTH = SubStates::REVERSE_DEPTH + 1;
 	static constexpr ShortIndex COMPO_REGIONS = SubStates::COMPO_REGIONS;
 	static constexpr LongIndex  COMPO_PRONGS  = SubStates::COMPO_PRONGS;
 	static constexpr ShortIndex ORTHO_REGIONS = SubStates::ORTHO_REGIONS + 1;
-	static constexpr ShortIndex ORTHO_UNITS	  = SubStates::ORTHO_UNITS + (WIDTH + 7) / 8;
+	static constexpr ShortIndex ORTHO_UNITS	  = SubStates::ORTHO_UNITS + WIDTH_UNITS;
 
 	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
 	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
+	static constexpr Parent stateParent(const StateID id, const StateID first, const ShortIndex compo, const ShortIndex ortho, const Parent parent) {
+		return id == first ?
+			HeadInfo ::stateParent(id, first, compo, ortho, parent) :
+			SubStates::stateParent(id, first + 1, compo, ortho + 1, (ForkID) -ortho - 1, 0);
+	}
+
+	static constexpr Parent compoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const Parent) {
+		return SubStates::compoParent(index, compo, ortho + 1, (ForkID) -ortho - 1, 0);
+	}
+
+	static constexpr Parent orthoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const Parent parent) {
+		return index == ortho ?
+			parent :
+			SubStates::orthoParent(index, compo, ortho + 1, (ForkID) -ortho - 1, 0);
+	}
+
+	static constexpr Units orthoUnits(const ShortIndex index, const ShortIndex ortho, const ShortIndex unit) {
+		return index == ortho ?
+			Units{unit, WIDTH} :
+			SubStates::orthoUnits(index, ortho + 1, unit + WIDTH_UNITS);
+	}
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -192,7 +321,8 @@ template <typename TContext,
 		  LongIndex NOrthoCount,
 		  LongIndex NOrthoUnits,
 		  typename TPayload,
-		  LongIndex NTaskCapacity>
+		  LongIndex NTaskCapacity,
+		  typename TApex>
 struct ArgsT final {
 	using Context	 = TContext;
 
@@ -206,6 +336,7 @@ struct ArgsT final {
 	using StateList	 = TStateList;
 	using RegionList = TRegionList;
 	using Payload	 = TPayload;
+	using Apex		 = TApex;
 
 	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
 	static constexpr ShortIndex COMPO_REGIONS = NCompoCount;
@@ -213,6 +344,13 @@ struct ArgsT final {
 	static constexpr ShortIndex ORTHO_UNITS	  = NOrthoUnits;
 	static constexpr LongIndex  TASK_CAPACITY = NTaskCapacity;
 
+	static constexpr LongIndex  PAYLOAD_SLOTS = STATE_COUNT + COMPO_REGIONS * 2;
+
+	static constexpr LongIndex  PAYLOAD_CAPACITY = Config_::PAYLOAD_CAPACITY != INVALID_LONG_INDEX ?
+													   Config_::PAYLOAD_CAPACITY :
+												   PAYLOAD_SLOTS < INVALID_SHORT_INDEX ?
+													   PAYLOAD_SLOTS : INVALID_SHORT_INDEX - 1;
+
 	HFSM_IF_STRUCTURE(using StructureStateInfos = Array<StructureStateInfo, STATE_COUNT>);
 };
 
@@ -240,12 +378,18 @@ struct C_;
 template <typename, typename, Strategy, ShortIndex, typename...>
 struct CS_;
 
-template <typename, typename, typename, typename...>
+template <typename, typename, Execution, typename, typename...>
 struct O_;
 
 template <typename, typename>
 class RW_;
 
+template <typename, LongIndex>
+class MB_;
+
+template <typename, LongIndex, LongIndex>
+class MS_;
+
 //------------------------------------------------------------------------------
 
 template <typename, typename...>
@@ -266,14 +410,14 @@ struct MaterialT   <TN, TA, CI_<TG, TH,	TS...>> {
 	using Type = C_<TN, TA,		TG, TH,	TS...>;
 };
 
-template <typename TN, typename TA,			  typename... TS>
-struct MaterialT   <TN, TA, OI_<void,	   TS...>> {
-	using Type = O_<TN, TA,		Empty<TA>, TS...>;
+template <typename TN, typename TA, Execution TX,			 typename... TS>
+struct MaterialT   <TN, TA, OI_<TX, void,	   TS...>> {
+	using Type = O_<TN, TA,		TX, Empty<TA>, TS...>;
 };
 
-template <typename TN, typename TA, typename TH, typename... TS>
-struct MaterialT   <TN, TA, OI_<TH,	 TS...>> {
-	using Type = O_<TN, TA,		TH,	 TS...>;
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
+struct MaterialT   <TN, TA, OI_<TX, TH,	TS...>> {
+	using Type = O_<TN, TA,		TX, TH,	TS...>;
 };
 
 template <typename TN, typename... TS>
@@ -311,16 +455,27 @@ struct RF_ final {
 								ORTHO_REGIONS,
 								ORTHO_UNITS,
 								Payload,
-								TASK_CAPACITY>;
+								TASK_CAPACITY,
+								Apex>;
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	using Instance		= RW_<Config_, Apex>;
 
+	template <LongIndex NCapacity>
+	using Batch			= MB_<Instance, NCapacity>;
+
+	using Published		= PublishedStatesT<Args>;
+
 	using Control		= ControlT	   <Args>;
 	using FullControl	= FullControlT <Args>;
 	using GuardControl	= GuardControlT<Args>;
 
+#ifdef HFSM_ENABLE_COROUTINES
+	using RoutineControl = RoutineControlT<Args>;
+	using Routine		= RoutineT<Args>;
+#endif
+
 	using Injection		= InjectionT<Args>;
 
 	using State			= Empty<Args>;
@@ -375,9 +530,9 @@ struct InfoT<C_<TN, TA, TG, TH, TS...>> {
 	using Type = CI_<	   TG, TH, TS...>;
 };
 
-template <typename TN, typename TA, typename TH, typename... TS>
-struct InfoT<O_<TN, TA, TH, TS...>> {
-	using Type = OI_<			   TH, TS...>;
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
+struct InfoT<O_<TN, TA, TX, TH, TS...>> {
+	using Type = OI_<	   TX, TH, TS...>;
 };
 
 template <typename TN, typename TA, Strategy TG, ShortIndex NI, typename... TS>
@@ -5,6 +5,7 @@ namespace detail {
 
 template <typename TIndices,
 		  typename TArgs,
+		  Execution TExecution,
 		  typename THead,
 		  typename... TSubStates>
 struct O_ final {
@@ -17,6 +18,8 @@ struct O_ final {
 	static constexpr ShortIndex REGION_ID	= COMPO_INDEX + ORTHO_INDEX;
 	static constexpr ForkID		ORTHO_ID	= (ForkID) -ORTHO_INDEX - 1;
 
+	static constexpr Execution	EXECUTION	= TExecution;
+
 	using Args			= TArgs;
 	using Rank			= typename Args::Rank;
 	using Utility		= typename Args::Utility;
@@ -27,16 +30,16 @@ struct O_ final {
 
 	using Head			= THead;
 
-	using Info			= OI_<Head, TSubStates...>;
+	using Info			= OI_<EXECUTION, Head, TSubStates...>;
 	static constexpr ShortIndex WIDTH		= Info::WIDTH;
 	static constexpr ShortIndex REGION_SIZE	= Info::STATE_COUNT;
-	static constexpr ShortIndex ORTHO_UNITS	= Info::ORTHO_UNITS;
+	static constexpr ShortIndex WIDTH_UNITS	= Info::WIDTH_UNITS;
 
 	using Request		= RequestT<Payload>;
 	using RequestType	= typename Request::Type;
+	using Requests		= RequestsT<Payload, Args::COMPO_REGIONS>;
 
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
 	using OrthoForks	= typename StateRegistry::AllForks::Ortho;
 	using ProngBits		= typename OrthoForks::Bits;
 	using ProngConstBits= typename OrthoForks::ConstBits;
@@ -56,11 +59,27 @@ struct O_ final {
 	using SubStates		= OS_<I_<HEAD_ID + 1,
 								 COMPO_INDEX,
 								 ORTHO_INDEX + 1,
-								 ORTHO_UNIT + ORTHO_UNITS>,
+								 ORTHO_UNIT + WIDTH_UNITS>,
 							  Args,
 							  0,
 							  TSubStates...>;
 
+	using IsParallel	= std::integral_constant<bool, EXECUTION == Execution::Parallel>;
+
+	// requests of the prongs updated in parallel, merged in prong order after the join
+	struct Fork {
+		HFSM_INLINE Fork(O_& region_, FullControl& control_)
+			: region{region_}
+			, control{control_}
+		{}
+
+		O_& region;
+		FullControl& control;
+		SpinLock serial;
+		Requests requests[WIDTH];
+		Status statuses[WIDTH];
+	};
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	HFSM_INLINE ProngBits	   orthoRequested(		StateRegistry& stateRegistry)		{ return stateRegistry.requested.ortho.template bits<ORTHO_UNIT, WIDTH>();	}
@@ -69,7 +88,6 @@ struct O_ final {
 	HFSM_INLINE ProngBits	   orthoRequested(		Control& control)					{ return orthoRequested(control._stateRegistry);							}
 	HFSM_INLINE ProngConstBits orthoRequested(const Control& control) const				{ return orthoRequested(control._stateRegistry);							}
 
-	HFSM_INLINE void	deepRegister		 (StateRegistry& stateRegistry, const Parent parent);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -81,6 +99,11 @@ struct O_ final {
 
 	HFSM_INLINE Status	deepUpdate			 (FullControl&	control);
 
+	HFSM_INLINE Status	wideUpdate			 (FullControl&	control, std::false_type);
+	HFSM_INLINE Status	wideUpdate			 (FullControl&	control, std::true_type);
+
+	static void			updateProng			 (void* const fork, const LongIndex prong);
+
 	template <typename TEvent>
 	HFSM_INLINE Status	deepReact			 (FullControl&	control, const TEvent& event);
 
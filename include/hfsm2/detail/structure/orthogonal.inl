@@ -3,23 +3,9 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepRegister(StateRegistry& stateRegistry,
-									const Parent parent)
-{
-	stateRegistry.orthoParents[ORTHO_INDEX] = parent;
-	stateRegistry.orthoUnits[ORTHO_INDEX] = Units{ORTHO_UNIT, WIDTH};
-
-	_headState.deepRegister(stateRegistry, parent);
-	_subStates.wideRegister(stateRegistry, ORTHO_ID);
-}
-
-//------------------------------------------------------------------------------
-
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 bool
-O_<TN, TA, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
 	const ProngConstBits requested = orthoRequested(static_cast<const GuardControl&>(control));
 
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
@@ -32,9 +18,9 @@ O_<TN, TA, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 bool
-O_<TN, TA, TH, TS...>::deepEntryGuard(GuardControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepEntryGuard(GuardControl& control) {
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
 	return _headState.deepEntryGuard(control) ||
@@ -43,9 +29,9 @@ O_<TN, TA, TH, TS...>::deepEntryGuard(GuardControl& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepEnter(PlanControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepEnter(PlanControl& control) {
 	ProngBits requested = orthoRequested(control);
 	requested.clear();
 
@@ -57,9 +43,9 @@ O_<TN, TA, TH, TS...>::deepEnter(PlanControl& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepReenter(PlanControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepReenter(PlanControl& control) {
 	ProngBits requested = orthoRequested(control);
 	requested.clear();
 
@@ -71,18 +57,18 @@ O_<TN, TA, TH, TS...>::deepReenter(PlanControl& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 Status
-O_<TN, TA, TH, TS...>::deepUpdate(FullControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepUpdate(FullControl& control) {
 	ScopedRegion outer{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
 	if (const auto headStatus = _headState.deepUpdate(control)) {
 		ControlLock lock{control};
-		_subStates.wideUpdate(control);
+		wideUpdate(control, IsParallel{});
 
 		return headStatus;
 	} else {
-		const Status subStatus = _subStates.wideUpdate(control);
+		const Status subStatus = wideUpdate(control, IsParallel{});
 
 		if (subStatus.outerTransition)
 			return subStatus;
@@ -94,12 +80,61 @@ O_<TN, TA, TH, TS...>::deepUpdate(FullControl& control) {
 	}
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
+Status
+O_<TN, TA, TX, TH, TS...>::wideUpdate(FullControl& control,
+									  std::false_type)
+{
+	return _subStates.wideUpdate(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
+Status
+O_<TN, TA, TX, TH, TS...>::wideUpdate(FullControl& control,
+									  std::true_type)
+{
+	if (!control._executor)
+		return _subStates.wideUpdate(control);
+
+	Fork fork{*this, control};
+	control._executor->run(WIDTH, &updateProng, &fork);
+
+	Status status;
+
+	for (ShortIndex prong = 0; prong < WIDTH; ++prong) {
+		for (const Request& request : fork.requests[prong])
+			control._requests << request;
+
+		status = combine(status, fork.statuses[prong]);
+	}
+
+	return status;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
+void
+O_<TN, TA, TX, TH, TS...>::updateProng(void* const fork_,
+									   const LongIndex prong)
+{
+	Fork& fork = *static_cast<Fork*>(fork_);
+
+	FullControl control{fork.control, fork.requests[prong], fork.serial};
+
+	fork.statuses[prong] = fork.region._subStates.wideUpdate(control, (ShortIndex) prong);
+}
+
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 template <typename TEvent>
 Status
-O_<TN, TA, TH, TS...>::deepReact(FullControl& control,
+O_<TN, TA, TX, TH, TS...>::deepReact(FullControl& control,
 								 const TEvent& event)
 {
 	ScopedRegion outer{control, REGION_ID, HEAD_ID, REGION_SIZE};
@@ -124,9 +159,9 @@ O_<TN, TA, TH, TS...>::deepReact(FullControl& control,
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 bool
-O_<TN, TA, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
 	const ProngConstBits requested = orthoRequested(static_cast<const GuardControl&>(control));
 
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
@@ -139,9 +174,9 @@ O_<TN, TA, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 bool
-O_<TN, TA, TH, TS...>::deepExitGuard(GuardControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepExitGuard(GuardControl& control) {
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
 	return _headState.deepExitGuard(control) ||
@@ -150,18 +185,18 @@ O_<TN, TA, TH, TS...>::deepExitGuard(GuardControl& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepExit(PlanControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepExit(PlanControl& control) {
 	_subStates.wideExit(control);
 	_headState.deepExit(control);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepForwardActive(Control& control,
+O_<TN, TA, TX, TH, TS...>::deepForwardActive(Control& control,
 										 const RequestType request)
 {
 	HFSM_ASSERT(control._stateRegistry.isActive(HEAD_ID));
@@ -174,9 +209,9 @@ O_<TN, TA, TH, TS...>::deepForwardActive(Control& control,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepForwardRequest(Control& control,
+O_<TN, TA, TX, TH, TS...>::deepForwardRequest(Control& control,
 										  const RequestType request)
 {
 	const ProngConstBits requested = orthoRequested(static_cast<const Control&>(control));
@@ -189,9 +224,9 @@ O_<TN, TA, TH, TS...>::deepForwardRequest(Control& control,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequest(Control& control,
+O_<TN, TA, TX, TH, TS...>::deepRequest(Control& control,
 								   const RequestType request)
 {
 	switch (request) {
@@ -226,57 +261,57 @@ O_<TN, TA, TH, TS...>::deepRequest(Control& control,
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestChange(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepRequestChange(Control& control) {
 	_subStates.wideRequestChange(control);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestRemain(StateRegistry& stateRegistry) {
+O_<TN, TA, TX, TH, TS...>::deepRequestRemain(StateRegistry& stateRegistry) {
 	_subStates.wideRequestRemain(stateRegistry);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestRestart(StateRegistry& stateRegistry) {
+O_<TN, TA, TX, TH, TS...>::deepRequestRestart(StateRegistry& stateRegistry) {
 	_subStates.wideRequestRestart(stateRegistry);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestResume(StateRegistry& stateRegistry) {
+O_<TN, TA, TX, TH, TS...>::deepRequestResume(StateRegistry& stateRegistry) {
 	_subStates.wideRequestResume(stateRegistry);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestUtilize(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepRequestUtilize(Control& control) {
 	_subStates.wideRequestUtilize(control);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestRandomize(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepRequestRandomize(Control& control) {
 	_subStates.wideRequestRandomize(control);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 typename TA::UP
-O_<TN, TA, TH, TS...>::deepReportChange(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepReportChange(Control& control) {
 	const UP	  h = _headState.deepReportChange(control);
 	const Utility s = _subStates.wideReportChange(control);
 
@@ -292,9 +327,9 @@ O_<TN, TA, TH, TS...>::deepReportChange(Control& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 typename TA::UP
-O_<TN, TA, TH, TS...>::deepReportUtilize(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepReportUtilize(Control& control) {
 	const UP	  h = _headState.deepReportUtilize(control);
 	const Utility s = _subStates.wideReportUtilize(control);
 
@@ -310,17 +345,17 @@ O_<TN, TA, TH, TS...>::deepReportUtilize(Control& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 typename TA::Rank
-O_<TN, TA, TH, TS...>::deepReportRank(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepReportRank(Control& control) {
 	return _headState.wrapRank(control);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 typename TA::Utility
-O_<TN, TA, TH, TS...>::deepReportRandomize(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepReportRandomize(Control& control) {
 	const Utility h = _headState.wrapUtility(control);
 	const Utility s = _subStates.wideReportRandomize(control);
 
@@ -333,18 +368,18 @@ O_<TN, TA, TH, TS...>::deepReportRandomize(Control& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepEnterRequested(PlanControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepEnterRequested(PlanControl& control) {
 	_headState.deepEnter		 (control);
 	_subStates.wideEnterRequested(control);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepChangeToRequested(PlanControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepChangeToRequested(PlanControl& control) {
 	_subStates.wideChangeToRequested(control);
 }
 
@@ -352,9 +387,9 @@ O_<TN, TA, TH, TS...>::deepChangeToRequested(PlanControl& control) {
 
 #ifdef HFSM_ENABLE_STRUCTURE_REPORT
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepGetNames(const LongIndex parent,
+O_<TN, TA, TX, TH, TS...>::deepGetNames(const LongIndex parent,
 									const RegionType region,
 									const ShortIndex depth,
 									StructureStateInfos& _stateInfos) const
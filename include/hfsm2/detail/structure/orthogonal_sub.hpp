@@ -33,7 +33,6 @@ struct OS_<TIndices, TArgs, NIndex, TInitial, TRemaining...> {
 	using RequestType	= typename Request::Type;
 
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
 	using OrthoForks	= typename StateRegistry::AllForks::Ortho;
 	using ProngBits		= typename OrthoForks::Bits;
 	using ProngConstBits= typename OrthoForks::ConstBits;
@@ -62,7 +61,6 @@ struct OS_<TIndices, TArgs, NIndex, TInitial, TRemaining...> {
 
 	using Info	= OSI_<TInitial, TRemaining...>;
 
-	HFSM_INLINE void	wideRegister		 (StateRegistry& stateRegistry, const ForkID forkId);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -74,6 +72,7 @@ struct OS_<TIndices, TArgs, NIndex, TInitial, TRemaining...> {
 	HFSM_INLINE void	wideReenter			 (PlanControl& control);
 
 	HFSM_INLINE Status	wideUpdate			 (FullControl& control);
+	HFSM_INLINE Status	wideUpdate			 (FullControl& control, const ShortIndex prong);
 
 	template <typename TEvent>
 	HFSM_INLINE Status	wideReact			 (FullControl& control, const TEvent& event);
@@ -147,7 +146,6 @@ struct OS_<TIndices, TArgs, NIndex, TInitial> {
 	using RequestType	= typename Request::Type;
 
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
 	using OrthoForks	= typename StateRegistry::AllForks::Ortho;
 	using ProngBits		= typename OrthoForks::Bits;
 	using ProngConstBits= typename OrthoForks::ConstBits;
@@ -166,7 +164,6 @@ struct OS_<TIndices, TArgs, NIndex, TInitial> {
 
 	using Info	= OSI_<TInitial>;
 
-	HFSM_INLINE void	wideRegister		 (StateRegistry& stateRegistry, const ForkID forkId);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -178,6 +175,7 @@ struct OS_<TIndices, TArgs, NIndex, TInitial> {
 	HFSM_INLINE void	wideReenter			 (PlanControl& control);
 
 	HFSM_INLINE Status	wideUpdate			 (FullControl& control);
+	HFSM_INLINE Status	wideUpdate			 (FullControl& control, const ShortIndex prong);
 
 	template <typename TEvent>
 	HFSM_INLINE Status	wideReact			 (FullControl& control, const TEvent& event);
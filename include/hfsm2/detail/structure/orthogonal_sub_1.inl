@@ -3,17 +3,6 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideRegister(StateRegistry& stateRegistry,
-										 const ForkID forkId)
-{
-	initial  .deepRegister(stateRegistry, Parent{forkId, PRONG_INDEX});
-	remaining.wideRegister(stateRegistry, forkId);
-}
-
-//------------------------------------------------------------------------------
-
 template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
 bool
 OS_<TN, TA, NI, TI, TR...>::wideForwardEntryGuard(GuardControl& control,
@@ -76,6 +65,18 @@ OS_<TN, TA, NI, TI, TR...>::wideUpdate(FullControl& control) {
 	return combine(status, remaining.wideUpdate(control));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+Status
+OS_<TN, TA, NI, TI, TR...>::wideUpdate(FullControl& control,
+									   const ShortIndex prong)
+{
+	return prong == PRONG_INDEX ?
+		initial	 .deepUpdate(control) :
+		remaining.wideUpdate(control, prong);
+}
+
 //------------------------------------------------------------------------------
 
 template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
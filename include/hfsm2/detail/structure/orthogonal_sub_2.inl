@@ -3,16 +3,6 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideRegister(StateRegistry& stateRegistry,
-								  const ForkID forkId)
-{
-	initial.deepRegister(stateRegistry, Parent{forkId, PRONG_INDEX});
-}
-
-//------------------------------------------------------------------------------
-
 template <typename TN, typename TA, ShortIndex NI, typename TI>
 bool
 OS_<TN, TA, NI, TI>::wideForwardEntryGuard(GuardControl& control,
@@ -62,6 +52,18 @@ OS_<TN, TA, NI, TI>::wideUpdate(FullControl& control) {
 	return initial.deepUpdate(control);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+Status
+OS_<TN, TA, NI, TI>::wideUpdate(FullControl& control,
+								const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	return initial.deepUpdate(control);
+}
+
 //------------------------------------------------------------------------------
 
 template <typename TN, typename TA, ShortIndex NI, typename TI>
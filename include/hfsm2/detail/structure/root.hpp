@@ -5,7 +5,15 @@ namespace detail {
 
 template <typename TConfig,
 		  typename TApex>
-class R_ {
+class R_
+	: protected ProfilerHostT<typename TConfig::Clock, Wrap<TApex>::STATE_COUNT>
+{
+	template <typename, LongIndex>
+	friend class MB_;
+
+	template <typename, LongIndex, LongIndex>
+	friend class MS_;
+
 	using Config_				= TConfig;
 	using Context				= typename Config_::Context;
 	using Rank					= typename Config_::Rank;
@@ -13,6 +21,7 @@ class R_ {
 	using Random_				= typename Config_::Random_;
 	using Logger				= typename Config_::Logger;
 	using Payload				= typename Config_::Payload;
+	using Events				= typename Config_::Events;
 
 	using Apex					= TApex;
 
@@ -22,9 +31,10 @@ class R_ {
 	using RegionList			= typename Info::RegionList;
 
 	static constexpr LongIndex SUBSTITUTION_LIMIT = Info::SUBSTITUTION_LIMIT;
-	static constexpr LongIndex TASK_CAPACITY	  = Info::TASK_CAPACITY;
 
 public:
+	static constexpr LongIndex  TASK_CAPACITY	  = Info::TASK_CAPACITY;
+
 	static constexpr LongIndex  REVERSE_DEPTH	  = ApexInfo::REVERSE_DEPTH;
 	static constexpr ShortIndex COMPO_REGIONS	  = ApexInfo::COMPO_REGIONS;
 	static constexpr LongIndex  COMPO_PRONGS	  = ApexInfo::COMPO_PRONGS;
@@ -37,28 +47,50 @@ public:
 	static_assert(STATE_COUNT <  (ShortIndex) -1, "Too many states in the hierarchy. Change 'ShortIndex' type.");
 	static_assert(STATE_COUNT == (ShortIndex) StateList::SIZE, "STATE_COUNT != StateList::SIZE");
 
+	using ActiveStates			= BitArray<StateID, STATE_COUNT>;
+
+	template <LongIndex NCapacity>
+	using EventBuffer			= EventBufferT<Events, NCapacity>;
+
+	using Recorder				= ReplayRecorderT<Events, Payload, Utility>;
+
+	template <LongIndex NCapacity>
+	using ReplayLog				= ReplayLogT<Events, Payload, Utility, NCapacity>;
+
+	using Published				= PublishedStatesT<typename Info::Args>;
+
 private:
 	using Args					= typename Info::Args;
 
 	using StateRegistry			= StateRegistryT<Args>;
+	using Topology				= typename StateRegistry::Topology;
 	using AllForks				= typename StateRegistry::AllForks;
 
 	using Control				= ControlT<Args>;
 
 	using PlanControl			= PlanControlT<Args>;
 	using PlanData				= PlanDataT   <Args>;
+	using PlanStats				= typename PlanData::Stats;
 
 	using FullControl			= FullControlT<Args>;
 	using Request				= typename FullControl::Request;
 	using Requests				= typename FullControl::Requests;
+	using RequestBuffers		= RequestBuffersT<Payload, COMPO_REGIONS>;
 
 	using GuardControl			= GuardControlT<Args>;
 
-	using Payloads				= Array<Payload, STATE_COUNT>;
+	using ProfilerHost			= ProfilerHostT<typename Config_::Clock, STATE_COUNT>;
+	using Profiler				= typename ProfilerHost::Profiler;
+	using ProfilerHost::profiler;
+
+	using PayloadPool			= typename FullControl::PayloadPool;
+	using PayloadSlots			= StaticArray<ShortIndex, STATE_COUNT>;
 	using PayloadsSet			= BitArray<LongIndex, STATE_COUNT>;
 
 	using MaterialApex			= Material<I_<0, 0, 0, 0>, Args, Apex>;
 
+	HFSM_IF_COROUTINES(using Routines = RoutinesT<Args>);
+
 public:
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -78,6 +110,81 @@ public:
 #endif
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// binary image of the mutable machine state, without the constant topology,
+	// restored without calling enter() / exit(); data held by the states
+	// themselves is not included, pending requests are dropped
+	//
+	// wire format: signature and epoch, active states, active and resumable
+	// prongs, plans task by task, then the payloads held as state data;
+	// payloads are copied bytewise and have to be trivially copyable
+
+	static constexpr uint32_t SNAPSHOT_VERSION = 4;
+
+	// hashes the parent tables, machines of a different shape don't match
+	static constexpr uint32_t SNAPSHOT_SIGNATURE =
+		hashParents(Topology::ORTHO_PARENTS, ORTHO_REGIONS,
+		hashParents(Topology::COMPO_PARENTS, COMPO_REGIONS,
+		hashParents(Topology::STATE_PARENTS, STATE_COUNT,
+					((SNAPSHOT_VERSION * 31u + (uint32_t) TASK_CAPACITY) * 31u
+					  + (uint32_t) sizeof(Payload)) * 31u
+					  + (uint32_t) PayloadPool::CAPACITY)));
+
+	static constexpr std::size_t SNAPSHOT_CAPACITY =
+		sizeof(uint32_t) * 2
+		+ bitsSize<ActiveStates>()
+		+ COMPO_REGIONS * 2
+		+ bitsSize<typename AllForks::Ortho>()
+		+ PlanData::WIRE_CAPACITY
+		+ bitsSize<PayloadsSet>()
+		+ (STATE_COUNT < PayloadPool::CAPACITY ? STATE_COUNT : PayloadPool::CAPACITY) * sizeof(Payload);
+
+	// buffer large enough for any image of the machine
+	struct Snapshot {
+		std::size_t size = 0;
+		unsigned char bytes[SNAPSHOT_CAPACITY];
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// changes since the previous takeDelta(), for replicas at 'epoch';
+	// 'prongs' and 'payloads' are packed, one entry per set bit
+	// of 'compos' and 'payloadsSet & payloadSlots' respectively;
+	// plans and pending requests are not replicated
+
+	using CompoChanges			= typename StateRegistry::CompoChanges;
+
+	struct Prongs {
+		ShortIndex active;
+		ShortIndex resumable;
+	};
+
+	struct Delta {
+		uint32_t signature;
+		uint32_t epoch;
+
+		ActiveStates toggled;
+
+		CompoChanges compos;
+		StaticArray<Prongs, COMPO_REGIONS> prongs;
+
+		typename AllForks::Ortho orthoResumable;
+
+		PayloadsSet payloadSlots;
+		PayloadsSet payloadsSet;
+		StaticArray<Payload, STATE_COUNT> payloads;
+
+		// wire format: bit sets take a bit per state or region,
+		// prongs and payloads only as many entries as have changed;
+		// payloads are copied bytewise and have to be trivially copyable
+		std::size_t size() const;
+
+		// bytes used, 0 if 'capacity' is too small
+		std::size_t write(void* const buffer, const std::size_t capacity) const;
+
+		// false if 'buffer' doesn't hold exactly one well-formed delta
+		bool read(const void* const buffer, const std::size_t size);
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 public:
 	explicit R_(Context& context,
@@ -97,6 +204,26 @@ public:
 	template <typename TEvent>
 	HFSM_INLINE void react(const TEvent& event);
 
+	// deferred reactions: queue() dispatches the event right away, but the
+	// transitions it requests are processed once, on flush();
+	// the last request into each composite region wins;
+	// false if a pending request had to be dropped for lack of room
+	template <typename TEvent>
+	HFSM_INLINE bool queue(const TEvent& event);
+
+	HFSM_INLINE void flush();
+
+	// requests dropped by queue() because more than 'COMPO_REGIONS'
+	// independent ones were pending
+	HFSM_INLINE LongIndex requestOverflows() const				{ return _requestOverflows;						}
+
+	// replay a buffer of events declared with 'Config::EventsT<>', in order
+	template <LongIndex NCapacity>
+	HFSM_INLINE void react(const EventBuffer<NCapacity>& events);
+
+	template <LongIndex NCapacity>
+	HFSM_INLINE bool queue(const EventBuffer<NCapacity>& events);
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	HFSM_INLINE bool isActive   (const StateID stateId) const	{ return _stateRegistry.isActive   (stateId);	}
@@ -113,25 +240,67 @@ public:
 	template <typename TState>
 	HFSM_INLINE bool isScheduled() const						{ return isResumable<TState>();					}
 
+	HFSM_INLINE void copyActiveStates(ActiveStates& states) const	{ states = _stateRegistry.activeStates;		}
+
+	// most tasks planned at once since construction, in total and per region;
+	// a profiling run's total is a safe 'Config::TaskCapacityN<>'
+	HFSM_INLINE LongIndex taskHighWater() const					{ return _planStats.highWater;					}
+	HFSM_INLINE LongIndex taskHighWater(const RegionID regionId) const	{ return _planStats.highWaters[regionId];	}
+
+	template <typename TRegion>
+	HFSM_INLINE LongIndex taskHighWater() const					{ return taskHighWater(regionId<TRegion>());	}
+
+	// tasks dropped by plans because 'TASK_CAPACITY' was exhausted
+	HFSM_INLINE LongIndex taskOverflows() const					{ return _planStats.overflows;					}
+
+	// most payload slots used at once since construction, for
+	// 'Config::PayloadCapacityN<>', and payloads dropped for lack of slots
+	HFSM_INLINE LongIndex payloadPeak() const					{ return _payloadPool.peak();					}
+	HFSM_INLINE LongIndex payloadOverflows() const				{ return _payloadPool.overflows();				}
+
+	// bytes save() currently needs, up to 'SNAPSHOT_CAPACITY'
+	std::size_t snapshotSize() const;
+
+	// bytes used, 0 if 'capacity' is too small
+	std::size_t save(void* const buffer, const std::size_t capacity) const;
+
+	// false and nothing changed if 'buffer' doesn't hold exactly one image
+	// of this machine
+	bool load(const void* const buffer, const std::size_t size);
+
+	HFSM_INLINE void save(Snapshot& snapshot) const				{ snapshot.size = save(snapshot.bytes, SNAPSHOT_CAPACITY);	}
+	HFSM_INLINE bool load(const Snapshot& snapshot)				{ return load(snapshot.bytes, snapshot.size);				}
+
+	// replicas start from the same initial state or a snapshot
+	// saved right after takeDelta(), state methods are not called
+	void takeDelta(Delta& delta);
+	bool applyDelta(const Delta& delta);
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	HFSM_INLINE void changeTo (const StateID stateId);
-	HFSM_INLINE void changeTo (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void changeTo (const StateID stateId, const Payload& payload)	{ requestTransition(Request::Type::CHANGE, Transition::CHANGE, stateId, payload);				}
+	HFSM_INLINE void changeTo (const StateID stateId, Payload&& payload)		{ requestTransition(Request::Type::CHANGE, Transition::CHANGE, stateId, std::move(payload));	}
 
 	HFSM_INLINE void restart  (const StateID stateId);
-	HFSM_INLINE void restart  (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void restart  (const StateID stateId, const Payload& payload)	{ requestTransition(Request::Type::RESTART, Transition::RESTART, stateId, payload);				}
+	HFSM_INLINE void restart  (const StateID stateId, Payload&& payload)		{ requestTransition(Request::Type::RESTART, Transition::RESTART, stateId, std::move(payload));	}
 
 	HFSM_INLINE void resume	  (const StateID stateId);
-	HFSM_INLINE void resume   (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void resume   (const StateID stateId, const Payload& payload)	{ requestTransition(Request::Type::RESUME, Transition::RESUME, stateId, payload);				}
+	HFSM_INLINE void resume   (const StateID stateId, Payload&& payload)		{ requestTransition(Request::Type::RESUME, Transition::RESUME, stateId, std::move(payload));	}
 
 	HFSM_INLINE void utilize  (const StateID stateId);
-	HFSM_INLINE void utilize  (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void utilize  (const StateID stateId, const Payload& payload)	{ requestTransition(Request::Type::UTILIZE, Transition::UTILIZE, stateId, payload);				}
+	HFSM_INLINE void utilize  (const StateID stateId, Payload&& payload)		{ requestTransition(Request::Type::UTILIZE, Transition::UTILIZE, stateId, std::move(payload));	}
 
 	HFSM_INLINE void randomize(const StateID stateId);
-	HFSM_INLINE void randomize(const StateID stateId, const Payload& payload);
+	HFSM_INLINE void randomize(const StateID stateId, const Payload& payload)	{ requestTransition(Request::Type::RANDOMIZE, Transition::RANDOMIZE, stateId, payload);				}
+	HFSM_INLINE void randomize(const StateID stateId, Payload&& payload)		{ requestTransition(Request::Type::RANDOMIZE, Transition::RANDOMIZE, stateId, std::move(payload));	}
 
 	HFSM_INLINE void schedule (const StateID stateId);
-	HFSM_INLINE void schedule (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void schedule (const StateID stateId, const Payload& payload)	{ requestTransition(Request::Type::SCHEDULE, Transition::SCHEDULE, stateId, payload);				}
+	HFSM_INLINE void schedule (const StateID stateId, Payload&& payload)		{ requestTransition(Request::Type::SCHEDULE, Transition::SCHEDULE, stateId, std::move(payload));	}
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -141,40 +310,59 @@ public:
 	template <typename TState>
 	HFSM_INLINE void changeTo (const Payload& payload)			{ changeTo (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void changeTo (Payload&& payload)				{ changeTo (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void restart  ()								{ restart  (stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void restart  (const Payload& payload)			{ restart  (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void restart  (Payload&& payload)				{ restart  (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void resume	  ()								{ resume   (stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void resume	  (const Payload& payload)			{ resume   (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void resume	  (Payload&& payload)				{ resume   (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void utilize  ()								{ utilize  (stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void utilize  (const Payload& payload)			{ utilize  (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void utilize  (Payload&& payload)				{ utilize  (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void randomize()								{ randomize(stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void randomize(const Payload& payload)			{ randomize(stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void randomize(Payload&& payload)				{ randomize(stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void schedule ()								{ schedule (stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void schedule (const Payload& payload)			{ schedule (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void schedule (Payload&& payload)				{ schedule (stateId<TState>(), std::move(payload));	}
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	HFSM_INLINE void resetStateData(const StateID stateId);
-	HFSM_INLINE void setStateData  (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void setStateData  (const StateID stateId, const Payload& payload)	{ assignStateData(stateId, payload);				}
+	HFSM_INLINE void setStateData  (const StateID stateId, Payload&& payload)		{ assignStateData(stateId, std::move(payload));	}
 	HFSM_INLINE bool isStateDataSet(const StateID stateId) const;
 
 	HFSM_INLINE const Payload* getStateData(const StateID stateId) const;
@@ -185,6 +373,9 @@ public:
 	template <typename TState>
 	HFSM_INLINE void setStateData  (const Payload& payload)		{ setStateData  (stateId<TState>(), payload);	}
 
+	template <typename TState>
+	HFSM_INLINE void setStateData  (Payload&& payload)			{ setStateData  (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE bool isStateDataSet() const						{ return isStateDataSet(stateId<TState>());		}
 
@@ -196,16 +387,103 @@ public:
 #ifdef HFSM_ENABLE_STRUCTURE_REPORT
 	const Structure&	   structure()		 const				{ return _structure;							}
 	const ActivityHistory& activityHistory() const				{ return _activityHistory;						}
+
+	// empty for bare states, e.g. the heads of peer regions
+	const char* stateName(const StateID stateId) const			{ return _stateInfos[stateId].name;				}
 #endif
 
 #if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
 	void attachLogger(Logger* const logger)						{ _logger = logger;								}
 #endif
 
+	// per-state method statistics, with 'Config::ProfilerT<>'
+	HFSM_INLINE const MethodProfile& profile(const StateID stateId,
+											 const Method method) const	{ return this->_profiler.get(stateId, method);	}
+
+	template <typename TState>
+	HFSM_INLINE const MethodProfile& profile(const Method method) const	{ return profile(stateId<TState>(), method);	}
+
+	// calls 'receiver(stateId, method, profile)' for every method called
+	template <typename TReceiver>
+	HFSM_INLINE void reportProfile(TReceiver& receiver) const			{ this->_profiler.report(receiver);				}
+
+	HFSM_INLINE void resetProfile()										{ this->_profiler.clear();						}
+
+	// records calls into the machine for a later Recorder::replay()
+	void attachRecorder(Recorder* const recorder)				{ _recorder = recorder;							}
+
+	// runs update() of parallel orthogonal regions' prongs,
+	// nullptr updates them one after another on the calling thread
+	void attachExecutor(ExecutorInterface* const executor)		{ _executor = executor;							}
+
+	// keeps 'published' up to date after every transition pass,
+	// for other threads to query
+	void attachPublished(Published* const published)			{ _published = published; publish();			}
+
 private:
+
 	void initialEnter();
 	void processTransitions();
 
+	// batches and schedulers drive machines through these,
+	// recording happens here rather than in update() / react()
+	HFSM_INLINE bool dispatchUpdate();
+
+	template <typename TEvent>
+	HFSM_INLINE bool dispatchReact(const TEvent& event,
+								   const typename Recorder::Kind kind = Recorder::Kind::REACT);
+
+	HFSM_INLINE void finalizeRequests();
+
+	HFSM_INLINE void sealRecord();
+
+	HFSM_INLINE void recordTransition(const Transition transition, const StateID stateId);
+	HFSM_INLINE void recordTransition(const Transition transition, const StateID stateId, const Payload& payload);
+
+	// both payload overloads of the transition methods and 'setStateData()'
+	template <typename TPayload>
+	HFSM_INLINE void requestTransition(const typename Request::Type type,
+									   const Transition transition,
+									   const StateID stateId,
+									   TPayload&& payload);
+
+	template <typename TPayload>
+	HFSM_INLINE void assignStateData(const StateID stateId, TPayload&& payload);
+
+	void resetReplication();
+
+	// load() and applyDelta() deactivate states without exiting them
+	HFSM_IF_COROUTINES(void stopInactiveRoutines());
+
+	PayloadsSet heldStateData() const;
+
+	HFSM_INLINE void publish()									{ if (_published) _published->publish(_stateRegistry);	}
+
+	template <typename TPayload>
+	HFSM_INLINE void holdStateData(const StateID stateId, TPayload&& payload);
+	HFSM_INLINE void releaseStateData(const StateID stateId);
+
+	struct Reactor {
+		template <typename TEvent>
+		HFSM_INLINE void operator () (const TEvent& event)			{ machine.react(event);	}
+
+		R_& machine;
+	};
+
+	struct Queuer {
+		template <typename TEvent>
+		HFSM_INLINE void operator () (const TEvent& event)			{ kept &= machine.queue(event);	}
+
+		R_& machine;
+		bool kept;
+	};
+
+	bool coalesceRequests(const Requests& pending);
+	bool keepRequest(Requests& coalesced, const Request& request);
+	void dropRequest(const Request& request);
+	bool superseded(const Request& request, const Requests& later, const LongIndex from) const;
+	bool overrides(const StateID later, const StateID earlier) const;
+
 	bool applyRequests(Control& control);
 
 	bool cancelledByEntryGuards(const Requests& pendingChanges);
@@ -223,14 +501,27 @@ private:
 
 	StateRegistry _stateRegistry;
 	PlanData _planData;
+	PlanStats _planStats;
+
+	PayloadPool _payloadPool;
+	PayloadSlots _payloadSlots{INVALID_SHORT_INDEX};
 
-	Payloads _payloads;
-	PayloadsSet _payloadsSet;
+	uint32_t _epoch = 0;
+	ActiveStates _replicatedStates;
+	PayloadsSet _payloadChanges;
 
-	Requests _requests;
+	RequestBuffers _requests;
+	LongIndex _requestOverflows = 0;
 
 	MaterialApex _apex;
 
+	Recorder* _recorder = nullptr;
+	typename Recorder::Record* _record = nullptr;
+	ExecutorInterface* _executor = nullptr;
+	Published* _published = nullptr;
+
+	HFSM_IF_COROUTINES(Routines _routines);
+
 #ifdef HFSM_ENABLE_STRUCTURE_REPORT
 	Prefixes _prefixes;
 	StructureStateInfos _stateInfos;
@@ -263,12 +554,18 @@ template <typename TN,
 		  typename TP,
 		  LongIndex NS,
 		  LongIndex NT,
+		  typename TE,
+		  LongIndex NJ,
+		  typename TK,
+		  typename TL,
+		  LongIndex NP,
+		  LongIndex NF,
 		  typename TApex>
-class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, TR, TP, NS, NT>, TApex> final
-	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, TR, TP, NS, NT>, TApex>
+class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, TR, TP, NS, NT, TE, NJ, TK, TL, NP, NF>, TApex> final
+	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, TR, TP, NS, NT, TE, NJ, TK, TL, NP, NF>, TApex>
 	, ::hfsm2::EmptyContext
 {
-	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, TR, TP, NS, NT>;
+	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, TR, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
 	using Context	= typename Config_::Context;
 	using Random_	= typename Config_::Random_;
 	using Logger	= typename Config_::Logger;
@@ -292,12 +589,18 @@ template <typename TC,
 		  typename TP,
 		  LongIndex NS,
 		  LongIndex NT,
+		  typename TE,
+		  LongIndex NJ,
+		  typename TK,
+		  typename TL,
+		  LongIndex NP,
+		  LongIndex NF,
 		  typename TApex>
-class RW_	   <::hfsm2::ConfigT<TC, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT>, TApex> final
-	: public R_<::hfsm2::ConfigT<TC, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT>, TApex>
+class RW_	   <::hfsm2::ConfigT<TC, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT, TE, NJ, TK, TL, NP, NF>, TApex> final
+	: public R_<::hfsm2::ConfigT<TC, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT, TE, NJ, TK, TL, NP, NF>, TApex>
 	, ::hfsm2::RandomT<TU>
 {
-	using Config_	= ::hfsm2::ConfigT<TC, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT>;
+	using Config_	= ::hfsm2::ConfigT<TC, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
 	using Context	= typename Config_::Context;
 	using Random_	= typename Config_::Random_;
 	using Logger	= typename Config_::Logger;
@@ -321,13 +624,19 @@ template <typename TN,
 		  typename TP,
 		  LongIndex NS,
 		  LongIndex NT,
+		  typename TE,
+		  LongIndex NJ,
+		  typename TK,
+		  typename TL,
+		  LongIndex NP,
+		  LongIndex NF,
 		  typename TApex>
-class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT>, TApex> final
-	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT>, TApex>
+class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT, TE, NJ, TK, TL, NP, NF>, TApex> final
+	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT, TE, NJ, TK, TL, NP, NF>, TApex>
 	, ::hfsm2::EmptyContext
 	, ::hfsm2::RandomT<TU>
 {
-	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT>;
+	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
 	using Context	= typename Config_::Context;
 	using Random_	= typename Config_::Random_;
 	using Logger	= typename Config_::Logger;
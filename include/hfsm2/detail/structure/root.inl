@@ -3,6 +3,14 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename TG, typename TA>
+constexpr uint32_t R_<TG, TA>::SNAPSHOT_SIGNATURE;
+
+template <typename TG, typename TA>
+constexpr std::size_t R_<TG, TA>::SNAPSHOT_CAPACITY;
+
+//------------------------------------------------------------------------------
+
 template <typename TG, typename TA>
 R_<TG, TA>::R_(Context& context,
 			   Random_& random
@@ -11,11 +19,10 @@ R_<TG, TA>::R_(Context& context,
 	, _random{random}
 	HFSM_IF_LOGGER(, _logger{logger})
 {
-	_apex.deepRegister(_stateRegistry, Parent{});
-
 	HFSM_IF_STRUCTURE(getStateNames());
 
 	initialEnter();
+	resetReplication();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -26,7 +33,11 @@ R_<TG, TA>::~R_() {
 						_random,
 						_stateRegistry,
 						_planData,
+						profiler(),
 						HFSM_LOGGER_OR(_logger, nullptr)};
+	control._planStats = &_planStats;
+	HFSM_IF_COROUTINES(control._routines = &_routines);
+
 	_apex.deepExit(control);
 
 	HFSM_IF_ASSERT(_planData.verifyPlans());
@@ -37,20 +48,8 @@ R_<TG, TA>::~R_() {
 template <typename TG, typename TA>
 void
 R_<TG, TA>::update() {
-	FullControl control(_context,
-						_random,
-						_stateRegistry,
-						_planData,
-						_requests,
-						HFSM_LOGGER_OR(_logger, nullptr));
-	_apex.deepUpdate(control);
-
-	HFSM_IF_ASSERT(_planData.verifyPlans());
-
-	if (_requests.count())
-		processTransitions();
-
-	_requests.clear();
+	if (dispatchUpdate())
+		finalizeRequests();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -59,139 +58,468 @@ template <typename TG, typename TA>
 template <typename TEvent>
 void
 R_<TG, TA>::react(const TEvent& event) {
-	FullControl control(_context,
-						_random,
-						_stateRegistry,
-						_planData,
-						_requests,
-						HFSM_LOGGER_OR(_logger, nullptr));
-	_apex.deepReact(control, event);
+	if (dispatchReact(event))
+		finalizeRequests();
+}
 
-	HFSM_IF_ASSERT(_planData.verifyPlans());
+//------------------------------------------------------------------------------
+
+template <typename TG, typename TA>
+template <typename TEvent>
+bool
+R_<TG, TA>::queue(const TEvent& event) {
+	_requests.advance();
+
+	if (dispatchReact(event, Recorder::Kind::QUEUE)) {
+		const bool kept = coalesceRequests(_requests.previous());
+		sealRecord();
 
-	if (_requests.count())
-		processTransitions();
+		return kept;
+	} else {
+		_requests.restore();
 
-	_requests.clear();
+		return true;
+	}
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 template <typename TG, typename TA>
 void
-R_<TG, TA>::changeTo(const StateID stateId) {
-	const Request request{Request::Type::CHANGE, stateId};
-	_requests << request;
+R_<TG, TA>::flush() {
+	_record = _recorder ? _recorder->recordFlush() : nullptr;
 
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::CHANGE, stateId);
+	if (_requests.current().count())
+		finalizeRequests();
+	else
+		sealRecord();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 template <typename TG, typename TA>
+template <LongIndex NCapacity>
 void
-R_<TG, TA>::changeTo(const StateID stateId,
-					 const Payload& payload)
-{
-	const Request request{Request::Type::CHANGE, stateId, payload};
-	_requests << request;
+R_<TG, TA>::react(const EventBuffer<NCapacity>& events) {
+	Reactor reactor{*this};
+	events.dispatch(reactor);
+}
 
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::CHANGE, stateId);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+template <LongIndex NCapacity>
+bool
+R_<TG, TA>::queue(const EventBuffer<NCapacity>& events) {
+	Queuer queuer{*this, true};
+	events.dispatch(queuer);
+
+	return queuer.kept;
 }
 
 //------------------------------------------------------------------------------
 
 template <typename TG, typename TA>
-void
-R_<TG, TA>::restart(const StateID stateId) {
-	const Request request{Request::Type::RESTART, stateId};
-	_requests << request;
+std::size_t
+R_<TG, TA>::snapshotSize() const {
+	return SNAPSHOT_CAPACITY
+		 - PlanData::WIRE_CAPACITY + _planData.wireSize()
+		 - (STATE_COUNT < PayloadPool::CAPACITY ? STATE_COUNT : PayloadPool::CAPACITY) * sizeof(Payload)
+		 + heldStateData().count() * sizeof(Payload);
+}
 
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RESTART, stateId);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+std::size_t
+R_<TG, TA>::save(void* const buffer,
+				 const std::size_t capacity) const
+{
+	static_assert(std::is_trivially_copyable<Payload>::value, "save() copies payloads bytewise");
+
+	const std::size_t used = snapshotSize();
+	if (capacity < used)
+		return 0;
+
+	unsigned char* cursor = static_cast<unsigned char*>(buffer);
+
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		*cursor++ = (unsigned char) (SNAPSHOT_SIGNATURE >> b * 8);
+
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		*cursor++ = (unsigned char) (_epoch				>> b * 8);
+
+	writeBits(cursor, _stateRegistry.activeStates);
+
+	for (LongIndex i = 0; i < COMPO_REGIONS; ++i)
+		*cursor++ = _stateRegistry.compoActive[i];
+
+	for (LongIndex i = 0; i < COMPO_REGIONS; ++i)
+		*cursor++ = _stateRegistry.resumable.compo[i];
+
+	writeBits(cursor, _stateRegistry.resumable.ortho);
+
+	_planData.write(cursor);
+
+	const PayloadsSet held = heldStateData();
+	writeBits(cursor, held);
+
+	for (LongIndex i = held.first(); i < PayloadsSet::CAPACITY; i = held.next(i)) {
+		std::memcpy(cursor, &_payloadPool[_payloadSlots[i]], sizeof(Payload));
+		cursor += sizeof(Payload);
+	}
+
+	HFSM_ASSERT(cursor == static_cast<unsigned char*>(buffer) + used);
+
+	return used;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 template <typename TG, typename TA>
-void
-R_<TG, TA>::restart(const StateID stateId,
-					const Payload& payload)
+bool
+R_<TG, TA>::load(const void* const buffer,
+				 const std::size_t size)
 {
-	const Request request{Request::Type::RESTART, stateId, payload};
-	_requests << request;
+	static_assert(std::is_trivially_copyable<Payload>::value, "load() copies payloads bytewise");
 
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RESTART, stateId);
+	const std::size_t fixed = sizeof(uint32_t) * 2
+							+ bitsSize<ActiveStates>()
+							+ COMPO_REGIONS * 2
+							+ bitsSize<typename AllForks::Ortho>();
+	if (size < fixed)
+		return false;
+
+	const unsigned char* cursor = static_cast<const unsigned char*>(buffer);
+	const unsigned char* const end = cursor + size;
+
+	uint32_t signature = 0;
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		signature |= (uint32_t) *cursor++ << b * 8;
+
+	if (signature != SNAPSHOT_SIGNATURE)
+		return false;
+
+	uint32_t epoch = 0;
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		epoch	  |= (uint32_t) *cursor++ << b * 8;
+
+	// everything is decoded before any of it is applied
+	ActiveStates activeStates;
+	typename StateRegistry::CompoForks compoActive;
+	AllForks resumable;
+
+	if (!readBits(cursor, activeStates))
+		return false;
+
+	for (LongIndex i = 0; i < COMPO_REGIONS; ++i)
+		compoActive[i] = *cursor++;
+
+	for (LongIndex i = 0; i < COMPO_REGIONS; ++i)
+		resumable.compo[i] = *cursor++;
+
+	PlanData planData;
+	PayloadsSet held;
+
+	if (!readBits(cursor, resumable.ortho) ||
+		!planData.read(cursor, end) ||
+		(std::size_t) (end - cursor) < bitsSize<PayloadsSet>() ||
+		!readBits(cursor, held) ||
+		held.count() > PayloadPool::CAPACITY ||
+		(std::size_t) (end - cursor) != held.count() * sizeof(Payload))
+	{
+		return false;
+	}
+
+	_stateRegistry.activeStates = activeStates;
+	_stateRegistry.compoActive	= compoActive;
+	_stateRegistry.resumable	= resumable;
+	_stateRegistry.clearRequests();
+	HFSM_IF_COROUTINES(stopInactiveRoutines());
+
+	_planData = planData;
+
+	_requests.current().clear();
+	_payloadPool.releaseStaged();
+
+	for (StateID i = 0; i < STATE_COUNT; ++i)
+		releaseStateData(i);
+
+	for (LongIndex i = held.first(); i < PayloadsSet::CAPACITY; i = held.next(i)) {
+		Payload payload;
+		std::memcpy(&payload, cursor, sizeof(Payload));
+		cursor += sizeof(Payload);
+
+		holdStateData(i, payload);
+	}
+
+	_epoch = epoch;
+	resetReplication();
+
+	HFSM_IF_STRUCTURE(_lastTransitions.clear());
+	HFSM_IF_STRUCTURE(udpateActivity());
+
+	publish();
+
+	return true;
 }
 
 //------------------------------------------------------------------------------
 
 template <typename TG, typename TA>
 void
-R_<TG, TA>::resume(const StateID stateId) {
-	const Request request{Request::Type::RESUME, stateId};
-	_requests << request;
+R_<TG, TA>::takeDelta(Delta& delta) {
+	delta.signature	= SNAPSHOT_SIGNATURE;
+	delta.epoch		= _epoch++;
 
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RESUME, stateId);
+	delta.toggled	= _stateRegistry.activeStates;
+	delta.toggled  ^= _replicatedStates;
+
+	const CompoChanges& compos = _stateRegistry.compoChanges;
+	delta.compos	= compos;
+
+	LongIndex p = 0;
+	for (LongIndex i = compos.first(); i < CompoChanges::CAPACITY; i = compos.next(i))
+		delta.prongs[p++] = Prongs{_stateRegistry.compoActive[i],
+								   _stateRegistry.resumable.compo[i]};
+
+	delta.orthoResumable = _stateRegistry.resumable.ortho;
+
+	delta.payloadSlots	 = _payloadChanges;
+	delta.payloadsSet.clear();
+
+	p = 0;
+	for (LongIndex i = _payloadChanges.first(); i < PayloadsSet::CAPACITY; i = _payloadChanges.next(i))
+		if (_payloadSlots[i] != INVALID_SHORT_INDEX) {
+			delta.payloadsSet.set(i);
+			delta.payloads[p++] = _payloadPool[_payloadSlots[i]];
+		}
+
+	resetReplication();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 template <typename TG, typename TA>
-void
-R_<TG, TA>::resume(const StateID stateId,
-				   const Payload& payload)
+bool
+R_<TG, TA>::applyDelta(const Delta& delta) {
+	if (delta.signature != SNAPSHOT_SIGNATURE ||
+		delta.epoch		!= _epoch)
+	{
+		return false;
+	}
+
+	_stateRegistry.activeStates ^= delta.toggled;
+
+	LongIndex p = 0;
+	for (LongIndex i = delta.compos.first(); i < CompoChanges::CAPACITY; i = delta.compos.next(i)) {
+		_stateRegistry.compoActive[i]	  = delta.prongs[p].active;
+		_stateRegistry.resumable.compo[i] = delta.prongs[p].resumable;
+		++p;
+	}
+
+	_stateRegistry.resumable.ortho = delta.orthoResumable;
+	_stateRegistry.clearRequests();
+	HFSM_IF_COROUTINES(stopInactiveRoutines());
+
+	p = 0;
+	for (LongIndex i = delta.payloadSlots.first(); i < PayloadsSet::CAPACITY; i = delta.payloadSlots.next(i))
+		if (delta.payloadsSet.get(i))
+			holdStateData(i, delta.payloads[p++]);
+		else
+			releaseStateData(i);
+
+	_requests.current().clear();
+	_payloadPool.releaseStaged();
+
+	++_epoch;
+	resetReplication();
+
+	HFSM_IF_STRUCTURE(_lastTransitions.clear());
+	HFSM_IF_STRUCTURE(udpateActivity());
+
+	publish();
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TG, typename TA>
+std::size_t
+R_<TG, TA>::Delta::size() const {
+	return sizeof(signature) + sizeof(epoch)
+		 + bitsSize<ActiveStates>()
+		 + bitsSize<CompoChanges>() + compos.count() * 2
+		 + bitsSize<typename AllForks::Ortho>()
+		 + bitsSize<PayloadsSet>() * 2 + payloadsSet.count() * sizeof(Payload);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+std::size_t
+R_<TG, TA>::Delta::write(void* const buffer,
+						 const std::size_t capacity) const
 {
-	const Request request{Request::Type::RESUME, stateId, payload};
-	_requests << request;
+	static_assert(std::is_trivially_copyable<Payload>::value, "Delta::write() copies payloads bytewise");
 
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RESUME, stateId);
+	const std::size_t used = size();
+	if (capacity < used)
+		return 0;
+
+	unsigned char* cursor = static_cast<unsigned char*>(buffer);
+
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		*cursor++ = (unsigned char) (signature >> b * 8);
+
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		*cursor++ = (unsigned char) (epoch	   >> b * 8);
+
+	writeBits(cursor, toggled);
+
+	writeBits(cursor, compos);
+	for (LongIndex p = 0; p < compos.count(); ++p) {
+		*cursor++ = prongs[p].active;
+		*cursor++ = prongs[p].resumable;
+	}
+
+	writeBits(cursor, orthoResumable);
+
+	writeBits(cursor, payloadSlots);
+	writeBits(cursor, payloadsSet);
+	for (LongIndex p = 0; p < payloadsSet.count(); ++p) {
+		std::memcpy(cursor, &payloads[p], sizeof(Payload));
+		cursor += sizeof(Payload);
+	}
+
+	HFSM_ASSERT(cursor == static_cast<unsigned char*>(buffer) + used);
+
+	return used;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::Delta::read(const void* const buffer,
+						const std::size_t size_)
+{
+	static_assert(std::is_trivially_copyable<Payload>::value, "Delta::read() copies payloads bytewise");
+
+	const std::size_t fixed = sizeof(signature) + sizeof(epoch)
+							+ bitsSize<ActiveStates>()
+							+ bitsSize<CompoChanges>()
+							+ bitsSize<typename AllForks::Ortho>()
+							+ bitsSize<PayloadsSet>() * 2;
+	if (size_ < fixed)
+		return false;
+
+	const unsigned char* cursor = static_cast<const unsigned char*>(buffer);
+
+	signature = 0;
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		signature |= (uint32_t) *cursor++ << b * 8;
+
+	epoch = 0;
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		epoch	  |= (uint32_t) *cursor++ << b * 8;
+
+	if (!readBits(cursor, toggled) ||
+		!readBits(cursor, compos))
+	{
+		return false;
+	}
+
+	// prongs follow the bits they belong to
+	const unsigned char* const prongsBytes = cursor;
+	cursor += compos.count() * 2;
+
+	if (size_ < fixed + compos.count() * 2 ||
+		!readBits(cursor, orthoResumable) ||
+		!readBits(cursor, payloadSlots) ||
+		!readBits(cursor, payloadsSet))
+	{
+		return false;
+	}
+
+	for (LongIndex i = payloadsSet.first(); i < PayloadsSet::CAPACITY; i = payloadsSet.next(i))
+		if (!payloadSlots.get(i))
+			return false;
+
+	if (size_ != size())
+		return false;
+
+	for (LongIndex p = 0; p < compos.count(); ++p) {
+		prongs[p].active	= prongsBytes[p * 2];
+		prongs[p].resumable	= prongsBytes[p * 2 + 1];
+	}
+
+	for (LongIndex p = 0; p < payloadsSet.count(); ++p) {
+		std::memcpy(&payloads[p], cursor, sizeof(Payload));
+		cursor += sizeof(Payload);
+	}
+
+	return true;
 }
 
 //------------------------------------------------------------------------------
 
 template <typename TG, typename TA>
 void
-R_<TG, TA>::utilize(const StateID stateId) {
-	const Request request{Request::Type::UTILIZE, stateId};
-	_requests << request;
+R_<TG, TA>::changeTo(const StateID stateId) {
+	const Request request{Request::Type::CHANGE, stateId};
+	_requests.current() << request;
 
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::UTILIZE, stateId);
+	recordTransition(Transition::CHANGE, stateId);
+	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::CHANGE, stateId);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
 template <typename TG, typename TA>
 void
-R_<TG, TA>::utilize(const StateID stateId,
-					const Payload& payload)
-{
-	const Request request{Request::Type::UTILIZE, stateId, payload};
-	_requests << request;
+R_<TG, TA>::restart(const StateID stateId) {
+	const Request request{Request::Type::RESTART, stateId};
+	_requests.current() << request;
 
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::UTILIZE, stateId);
+	recordTransition(Transition::RESTART, stateId);
+	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RESTART, stateId);
 }
 
 //------------------------------------------------------------------------------
 
 template <typename TG, typename TA>
 void
-R_<TG, TA>::randomize(const StateID stateId) {
-	const Request request{Request::Type::RANDOMIZE, stateId};
-	_requests << request;
+R_<TG, TA>::resume(const StateID stateId) {
+	const Request request{Request::Type::RESUME, stateId};
+	_requests.current() << request;
 
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RANDOMIZE, stateId);
+	recordTransition(Transition::RESUME, stateId);
+	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RESUME, stateId);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
 template <typename TG, typename TA>
 void
-R_<TG, TA>::randomize(const StateID stateId,
-					  const Payload& payload)
-{
-	const Request request{Request::Type::RANDOMIZE, stateId, payload};
-	_requests << request;
+R_<TG, TA>::utilize(const StateID stateId) {
+	const Request request{Request::Type::UTILIZE, stateId};
+	_requests.current() << request;
+
+	recordTransition(Transition::UTILIZE, stateId);
+	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::UTILIZE, stateId);
+}
+
+//------------------------------------------------------------------------------
 
+template <typename TG, typename TA>
+void
+R_<TG, TA>::randomize(const StateID stateId) {
+	const Request request{Request::Type::RANDOMIZE, stateId};
+	_requests.current() << request;
+
+	recordTransition(Transition::RANDOMIZE, stateId);
 	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RANDOMIZE, stateId);
 }
 
@@ -201,22 +529,29 @@ template <typename TG, typename TA>
 void
 R_<TG, TA>::schedule(const StateID stateId) {
 	const Request request{Request::Type::SCHEDULE, stateId};
-	_requests << request;
+	_requests.current() << request;
 
+	recordTransition(Transition::SCHEDULE, stateId);
 	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::SCHEDULE, stateId);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 template <typename TG, typename TA>
+template <typename TPayload>
 void
-R_<TG, TA>::schedule(const StateID stateId,
-					 const Payload& payload)
+R_<TG, TA>::requestTransition(const typename Request::Type type,
+							  const Transition transition,
+							  const StateID stateId,
+							  TPayload&& payload)
 {
-	const Request request{Request::Type::SCHEDULE, stateId, payload};
-	_requests << request;
+	// recorded before the payload is moved into the pool
+	recordTransition(transition, stateId, payload);
 
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::SCHEDULE, stateId);
+	const Request request{type, stateId, _payloadPool.stage(std::forward<TPayload>(payload))};
+	_requests.current() << request;
+
+	HFSM_LOG_TRANSITION(INVALID_STATE_ID, transition, stateId);
 }
 
 //------------------------------------------------------------------------------
@@ -224,24 +559,27 @@ R_<TG, TA>::schedule(const StateID stateId,
 template <typename TG, typename TA>
 void
 R_<TG, TA>::resetStateData(const StateID stateId) {
-	HFSM_ASSERT(stateId < Payloads::CAPACITY);
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-	if (stateId < Payloads::CAPACITY)
-		_payloadsSet.reset(stateId);
+	if (stateId < STATE_COUNT) {
+		releaseStateData(stateId);
+		_payloadChanges.set(stateId);
+	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 template <typename TG, typename TA>
+template <typename TPayload>
 void
-R_<TG, TA>::setStateData(const StateID stateId,
-						 const Payload& payload)
+R_<TG, TA>::assignStateData(const StateID stateId,
+							TPayload&& payload)
 {
-	HFSM_ASSERT(stateId < Payloads::CAPACITY);
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-	if (stateId < Payloads::CAPACITY) {
-		_payloads[stateId] = payload;
-		_payloadsSet.set(stateId);
+	if (stateId < STATE_COUNT) {
+		holdStateData(stateId, std::forward<TPayload>(payload));
+		_payloadChanges.set(stateId);
 	}
 }
 
@@ -250,10 +588,10 @@ R_<TG, TA>::setStateData(const StateID stateId,
 template <typename TG, typename TA>
 bool
 R_<TG, TA>::isStateDataSet(const StateID stateId) const {
-	HFSM_ASSERT(stateId < Payloads::CAPACITY);
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-	return stateId < Payloads::CAPACITY ?
-		_payloadsSet.get(stateId) : false;
+	return stateId < STATE_COUNT ?
+		_payloadSlots[stateId] != INVALID_SHORT_INDEX : false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -261,10 +599,10 @@ R_<TG, TA>::isStateDataSet(const StateID stateId) const {
 template <typename TG, typename TA>
 const typename R_<TG, TA>::Payload*
 R_<TG, TA>::getStateData(const StateID stateId) const {
-	HFSM_ASSERT(stateId < Payloads::CAPACITY);
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-	return stateId < Payloads::CAPACITY && _payloadsSet.get(stateId) ?
-		&_payloads[stateId] : nullptr;
+	return stateId < STATE_COUNT && _payloadSlots[stateId] != INVALID_SHORT_INDEX ?
+		&_payloadPool[_payloadSlots[stateId]] : nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -276,42 +614,45 @@ R_<TG, TA>::initialEnter() {
 					_random,
 					_stateRegistry,
 					_planData,
+					profiler(),
 					HFSM_LOGGER_OR(_logger, nullptr));
 
 	AllForks undoRequested = _stateRegistry.requested;
 
 	_apex.deepRequestChange(control);
 
-	Requests lastRequests = _requests;
-	_requests.clear();
+	_requests.advance();
 
-	if (cancelledByEntryGuards(lastRequests))
+	if (cancelledByEntryGuards(_requests.previous()))
 		_stateRegistry.requested = undoRequested;
 
 	for (LongIndex i = 0;
-		 i < SUBSTITUTION_LIMIT && _requests.count();
+		 i < SUBSTITUTION_LIMIT && _requests.current().count();
 		 ++i)
 	{
 		undoRequested = _stateRegistry.requested;
 
 		if (applyRequests(control)) {
-			lastRequests = _requests;
-			_requests.clear();
+			_requests.advance();
 
-			if (cancelledByEntryGuards(lastRequests))
+			if (cancelledByEntryGuards(_requests.previous()))
 				_stateRegistry.requested = undoRequested;
 		}
 
-		_requests.clear();
+		_requests.current().clear();
 	}
-	HFSM_ASSERT(_requests.count() == 0);
+	HFSM_ASSERT(_requests.current().count() == 0);
+	_payloadPool.releaseStaged();
 
 	{
 		PlanControl planControl{_context,
 								_random,
 								_stateRegistry,
 								_planData,
+								profiler(),
 								HFSM_LOGGER_OR(_logger, nullptr)};
+		planControl._planStats = &_planStats;
+		HFSM_IF_COROUTINES(planControl._routines = &_routines);
 
 		_apex.deepEnterRequested(planControl);
 		_stateRegistry.clearRequests();
@@ -320,6 +661,8 @@ R_<TG, TA>::initialEnter() {
 	}
 
 	HFSM_IF_STRUCTURE(udpateActivity());
+
+	publish();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -327,33 +670,33 @@ R_<TG, TA>::initialEnter() {
 template <typename TG, typename TA>
 void
 R_<TG, TA>::processTransitions() {
-	HFSM_ASSERT(_requests.count());
+	HFSM_ASSERT(_requests.current().count());
 
 	HFSM_IF_STRUCTURE(_lastTransitions.clear());
 
 	AllForks undoRequested;
-	Requests lastRequests;
 
 	Control control(_context,
 					_random,
 					_stateRegistry,
 					_planData,
+					profiler(),
 					HFSM_LOGGER_OR(_logger, nullptr));
+	control._recorder = _recorder;
 
 	for (LongIndex i = 0;
-		i < SUBSTITUTION_LIMIT && _requests.count();
+		i < SUBSTITUTION_LIMIT && _requests.current().count();
 		++i)
 	{
 		undoRequested = _stateRegistry.requested;
 
 		if (applyRequests(control)) {
-			lastRequests = _requests;
-			_requests.clear();
+			_requests.advance();
 
-			if (cancelledByGuards(lastRequests))
+			if (cancelledByGuards(_requests.previous()))
 				_stateRegistry.requested = undoRequested;
 		} else
-			_requests.clear();
+			_requests.current().clear();
 	}
 
 	{
@@ -361,7 +704,10 @@ R_<TG, TA>::processTransitions() {
 								_random,
 								_stateRegistry,
 								_planData,
+								profiler(),
 								HFSM_LOGGER_OR(_logger, nullptr)};
+		planControl._planStats = &_planStats;
+		HFSM_IF_COROUTINES(planControl._routines = &_routines);
 
 		_apex.deepChangeToRequested(planControl);
 		_stateRegistry.clearRequests();
@@ -370,6 +716,286 @@ R_<TG, TA>::processTransitions() {
 	}
 
 	HFSM_IF_STRUCTURE(udpateActivity());
+
+	publish();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::dispatchUpdate() {
+	_record = _recorder ? _recorder->recordUpdate() : nullptr;
+
+	FullControl control(_context,
+						_random,
+						_stateRegistry,
+						_planData,
+						_requests.current(),
+						_payloadPool,
+						profiler(),
+						HFSM_LOGGER_OR(_logger, nullptr));
+	control._executor = _executor;
+	control._planStats = &_planStats;
+	HFSM_IF_COROUTINES(control._routines = &_routines);
+
+	_apex.deepUpdate(control);
+
+	HFSM_IF_ASSERT(_planData.verifyPlans());
+
+	if (_requests.current().count())
+		return true;
+	else {
+		sealRecord();
+
+		return false;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+template <typename TEvent>
+bool
+R_<TG, TA>::dispatchReact(const TEvent& event,
+						  const typename Recorder::Kind kind)
+{
+	_record = _recorder ? _recorder->recordEvent(kind, event) : nullptr;
+
+	FullControl control(_context,
+						_random,
+						_stateRegistry,
+						_planData,
+						_requests.current(),
+						_payloadPool,
+						profiler(),
+						HFSM_LOGGER_OR(_logger, nullptr));
+	control._planStats = &_planStats;
+	HFSM_IF_COROUTINES(control._routines = &_routines);
+
+	_apex.deepReact(control, event);
+
+	HFSM_IF_ASSERT(_planData.verifyPlans());
+
+	if (_requests.current().count())
+		return true;
+	else {
+		sealRecord();
+
+		return false;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::finalizeRequests() {
+	processTransitions();
+
+	_requests.current().clear();
+	_payloadPool.releaseStaged();
+
+	sealRecord();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// records are sealed with the states active once the call is fully processed
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::sealRecord() {
+	if (_record) {
+		_recorder->seal(_record, _stateRegistry.activeStates);
+		_record = nullptr;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::recordTransition(const Transition transition,
+							 const StateID stateId)
+{
+	if (_recorder)
+		_recorder->recordTransition(transition, stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::recordTransition(const Transition transition,
+							 const StateID stateId,
+							 const Payload& payload)
+{
+	if (_recorder)
+		_recorder->recordTransition(transition, stateId, payload);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::resetReplication() {
+	_replicatedStates = _stateRegistry.activeStates;
+	_stateRegistry.compoChanges.clear();
+	_payloadChanges.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_COROUTINES
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::stopInactiveRoutines() {
+	for (StateID i = 0; i < STATE_COUNT; ++i)
+		if (!_stateRegistry.isActive(i))
+			_routines.stop(i);
+}
+
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+typename R_<TG, TA>::PayloadsSet
+R_<TG, TA>::heldStateData() const {
+	PayloadsSet held;
+
+	for (StateID i = 0; i < STATE_COUNT; ++i)
+		if (_payloadSlots[i] != INVALID_SHORT_INDEX)
+			held.set(i);
+
+	return held;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+template <typename TPayload>
+void
+R_<TG, TA>::holdStateData(const StateID stateId,
+						  TPayload&& payload)
+{
+	ShortIndex& slot = _payloadSlots[stateId];
+
+	if (slot != INVALID_SHORT_INDEX)
+		_payloadPool[slot] = std::forward<TPayload>(payload);
+	else
+		slot = _payloadPool.hold(std::forward<TPayload>(payload));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::releaseStateData(const StateID stateId) {
+	ShortIndex& slot = _payloadSlots[stateId];
+
+	if (slot != INVALID_SHORT_INDEX) {
+		_payloadPool.release(slot);
+		slot = INVALID_SHORT_INDEX;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::coalesceRequests(const Requests& pending) {
+	Requests coalesced;
+	bool kept = true;
+
+	for (LongIndex i = 0; i < pending.count(); ++i)
+		if (!superseded(pending[i], _requests.current(), 0))
+			kept &= keepRequest(coalesced, pending[i]);
+		else
+			dropRequest(pending[i]);
+
+	for (LongIndex i = 0; i < _requests.current().count(); ++i)
+		if (!superseded(_requests.current()[i], _requests.current(), i + 1))
+			kept &= keepRequest(coalesced, _requests.current()[i]);
+		else
+			dropRequest(_requests.current()[i]);
+
+	_requests.current() = coalesced;
+
+	return kept;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// independent requests can pile up past 'COMPO_REGIONS' between flushes,
+// the newest ones are dropped, counted and reported as cancelled
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::keepRequest(Requests& coalesced,
+						const Request& request)
+{
+	if (coalesced.count() < Requests::CAPACITY) {
+		coalesced << request;
+
+		return true;
+	} else {
+		++_requestOverflows;
+		HFSM_LOG_CANCELLED_PENDING(request.stateId);
+
+		dropRequest(request);
+
+		return false;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// staged payloads are otherwise only released on flush()
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::dropRequest(const Request& request) {
+	if (request.payload != INVALID_SHORT_INDEX)
+		_payloadPool.release(request.payload);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::superseded(const Request& request,
+					   const Requests& later,
+					   const LongIndex from) const
+{
+	// schedules are only replaced by identical ones
+	for (LongIndex i = from; i < later.count(); ++i)
+		if (request.type == Request::SCHEDULE ?
+				later[i].type == Request::SCHEDULE &&
+				later[i].stateId == request.stateId :
+				later[i].type != Request::SCHEDULE &&
+				overrides(later[i].stateId, request.stateId))
+			return true;
+
+	return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// transitions into different prongs of an orthogonal region are independent,
+// anything else branching off a common composite region is replaced
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::overrides(const StateID later,
+					  const StateID earlier) const
+{
+	using Topology = typename StateRegistry::Topology;
+
+	for (Parent l = Topology::STATE_PARENTS[later]; l; l = _stateRegistry.forkParent(l.forkId))
+		for (Parent e = Topology::STATE_PARENTS[earlier]; e; e = _stateRegistry.forkParent(e.forkId))
+			if (l.forkId == e.forkId)
+				return l.forkId > 0 || l.prong == e.prong;
+
+	return false;
 }
 
 //------------------------------------------------------------------------------
@@ -379,7 +1005,7 @@ bool
 R_<TG, TA>::applyRequests(Control& control) {
 	bool changesMade = false;
 
-	for (const Request& request : _requests) {
+	for (const Request& request : _requests.current()) {
 		HFSM_IF_STRUCTURE(_lastTransitions << TransitionInfo(request, Method::UPDATE));
 
 		switch (request.type) {
@@ -417,9 +1043,12 @@ R_<TG, TA>::cancelledByEntryGuards(const Requests& pendingRequests) {
 							  _random,
 							  _stateRegistry,
 							  _planData,
-							  _requests,
+							  _requests.current(),
 							  pendingRequests,
+							  _payloadPool,
+							  profiler(),
 		HFSM_LOGGER_OR(_logger, nullptr)};
+	guardControl._planStats = &_planStats;
 
 	if (_apex.deepEntryGuard(guardControl)) {
 		HFSM_IF_STRUCTURE(recordRequestsAs(Method::ENTRY_GUARD));
@@ -438,9 +1067,12 @@ R_<TG, TA>::cancelledByGuards(const Requests& pendingRequests) {
 							  _random,
 							  _stateRegistry,
 							  _planData,
-							  _requests,
+							  _requests.current(),
 							  pendingRequests,
+							  _payloadPool,
+							  profiler(),
 							  HFSM_LOGGER_OR(_logger, nullptr)};
+	guardControl._planStats = &_planStats;
 
 	if (_apex.deepForwardExitGuard(guardControl)) {
 		HFSM_IF_STRUCTURE(recordRequestsAs(Method::EXIT_GUARD));
@@ -566,7 +1198,7 @@ R_<TG, TA>::udpateActivity() {
 template <typename TG, typename TA>
 void
 R_<TG, TA>::recordRequestsAs(const Method method) {
-	for (const auto& request : _requests)
+	for (const auto& request : _requests.current())
 		_lastTransitions << TransitionInfo(request, method);
 }
 
@@ -0,0 +1,88 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+// machines of any type, split into shards with a context of their own;
+// updateAll() hands one shard per task to the attached executor and returns
+// once all of them are done, so shard contexts can be merged right after it;
+// within a shard machines are dispatched first, transitions processed second,
+// as in 'MB_'
+
+template <typename TContext,
+		  LongIndex NShards,
+		  LongIndex NCapacity>
+class MS_ final {
+public:
+	using Context	= TContext;
+	using Index		= LongIndex;
+
+	static constexpr Index SHARD_COUNT = NShards;
+	static constexpr Index CAPACITY	   = NCapacity;
+	static constexpr Index INVALID	   = INVALID_LONG_INDEX;
+
+	static_assert(SHARD_COUNT > 0,		"Scheduler needs at least one shard");
+	static_assert(CAPACITY < INVALID,	"Shard capacity is too large");
+
+private:
+	// 'R_' of any type, called through thunks
+	struct Entry {
+		void* instance;
+		bool (*dispatch)(void* const instance);
+		void (*finalize)(void* const instance);
+	};
+
+	struct Shard {
+		Context context;
+
+		Entry entries[CAPACITY];
+		Index pending[CAPACITY];
+
+		Index count = 0;
+		Index pendingCount = 0;
+	};
+
+public:
+	HFSM_INLINE MS_() = default;
+
+	MS_(const MS_&) = delete;
+	MS_& operator = (const MS_&) = delete;
+
+	// context of the machines to be added to 'shard'
+	HFSM_INLINE		  Context& context(const Index shard);
+	HFSM_INLINE const Context& context(const Index shard) const;
+
+	// 'instance' is not owned and has to outlive its entry
+	template <typename TInstance>
+	Index add(const Index shard, TInstance& instance);
+
+	void clear();
+
+	HFSM_INLINE Index count(const Index shard) const;
+	HFSM_INLINE Index pendingCount(const Index shard) const;
+
+	// nullptr updates the shards one after another on the calling thread
+	HFSM_INLINE void attachExecutor(ExecutorInterface* const executor)		{ _executor = executor;	}
+
+	void updateAll();
+
+private:
+	static void updateShard(void* const scheduler, const Index shard);
+
+	template <typename TInstance>
+	static bool dispatch(void* const instance)		{ return static_cast<TInstance*>(instance)->dispatchUpdate();	}
+
+	template <typename TInstance>
+	static void finalize(void* const instance)		{ static_cast<TInstance*>(instance)->finalizeRequests();		}
+
+private:
+	Shard _shards[SHARD_COUNT];
+
+	ExecutorInterface* _executor = nullptr;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "scheduler.inl"
@@ -0,0 +1,116 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TC, LongIndex NS, LongIndex NC>
+typename MS_<TC, NS, NC>::Context&
+MS_<TC, NS, NC>::context(const Index shard) {
+	HFSM_ASSERT(shard < SHARD_COUNT);
+
+	return _shards[shard].context;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, LongIndex NS, LongIndex NC>
+const typename MS_<TC, NS, NC>::Context&
+MS_<TC, NS, NC>::context(const Index shard) const {
+	HFSM_ASSERT(shard < SHARD_COUNT);
+
+	return _shards[shard].context;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, LongIndex NS, LongIndex NC>
+template <typename TInstance>
+LongIndex
+MS_<TC, NS, NC>::add(const Index shard,
+					 TInstance& instance)
+{
+	HFSM_ASSERT(shard < SHARD_COUNT);
+	Shard& target = _shards[shard];
+
+	if (target.count < CAPACITY) {
+		target.entries[target.count] = Entry{&instance,
+											 &dispatch<TInstance>,
+											 &finalize<TInstance>};
+
+		return target.count++;
+	} else {
+		HFSM_BREAK();
+
+		return INVALID;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, LongIndex NS, LongIndex NC>
+void
+MS_<TC, NS, NC>::clear() {
+	for (Shard& shard : _shards) {
+		shard.count		   = 0;
+		shard.pendingCount = 0;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, LongIndex NS, LongIndex NC>
+LongIndex
+MS_<TC, NS, NC>::count(const Index shard) const {
+	HFSM_ASSERT(shard < SHARD_COUNT);
+
+	return _shards[shard].count;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, LongIndex NS, LongIndex NC>
+LongIndex
+MS_<TC, NS, NC>::pendingCount(const Index shard) const {
+	HFSM_ASSERT(shard < SHARD_COUNT);
+
+	return _shards[shard].pendingCount;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, LongIndex NS, LongIndex NC>
+void
+MS_<TC, NS, NC>::updateAll() {
+	if (_executor)
+		_executor->run(SHARD_COUNT, &updateShard, this);
+	else
+		for (Index shard = 0; shard < SHARD_COUNT; ++shard)
+			updateShard(this, shard);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, LongIndex NS, LongIndex NC>
+void
+MS_<TC, NS, NC>::updateShard(void* const scheduler,
+							 const Index index)
+{
+	Shard& shard = static_cast<MS_*>(scheduler)->_shards[index];
+
+	shard.pendingCount = 0;
+
+	for (Index i = 0; i < shard.count; ++i)
+		if (shard.entries[i].dispatch(shard.entries[i].instance))
+			shard.pending[shard.pendingCount++] = i;
+
+	for (Index p = 0; p < shard.pendingCount; ++p) {
+		const Entry& entry = shard.entries[shard.pending[p]];
+
+		entry.finalize(entry.instance);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -24,8 +24,9 @@ struct S_ {
 	using RequestType	= typename Request::Type;
 
 	using Control		= ControlT<Args>;
+	using Sample		= typename Control::Profiler::Sample;
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
+	using Topology		= typename StateRegistry::Topology;
 
 	using PlanControl	= PlanControlT<Args>;
 	using ScopedOrigin	= typename PlanControl::Origin;
@@ -35,9 +36,11 @@ struct S_ {
 
 	using Empty			= ::hfsm2::detail::Empty<Args>;
 
-	HFSM_INLINE Parent	stateParent			 (Control& control)	{ return control._stateRegistry.stateParents[STATE_ID]; }
+#ifdef HFSM_ENABLE_COROUTINES
+	using RoutineControl = RoutineControlT<Args>;
 
-	HFSM_INLINE void	deepRegister		 (StateRegistry& stateRegistry, const Parent parent);
+	static constexpr bool HAS_ROUTINE = HasRoutine<Head, RoutineControl>::value;
+#endif
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -57,6 +60,16 @@ struct S_ {
 
 	HFSM_INLINE void	deepExit			 (PlanControl&	control);
 
+#ifdef HFSM_ENABLE_COROUTINES
+	HFSM_INLINE void	startRoutine		 (PlanControl&	control);
+	HFSM_INLINE void	stopRoutine			 (PlanControl&	control);
+
+	HFSM_INLINE void	updateRoutine		 (FullControl&	control);
+
+	template <typename TEvent>
+	HFSM_INLINE void	reactRoutine		 (FullControl&	control, const TEvent& event);
+#endif
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	HFSM_INLINE void	wrapPlanSucceeded	 (FullControl&	control);
@@ -85,7 +98,7 @@ struct S_ {
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void   deepEnterRequested	(Control&)										{}
+	HFSM_INLINE void   deepEnterRequested	(Control& control)		{ control._stateRegistry.activeStates.template set<STATE_ID>();	}
 	HFSM_INLINE void   deepChangeToRequested(Control&)										{}
 
 #if defined _DEBUG || defined HFSM_ENABLE_STRUCTURE_REPORT || defined HFSM_ENABLE_LOG_INTERFACE
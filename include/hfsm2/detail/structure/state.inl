@@ -1,59 +1,13 @@
 namespace hfsm2 {
 namespace detail {
 
-//------------------------------------------------------------------------------
-
-namespace {
-
-template <StateID NS, typename TA, typename TH>
-struct RegisterT {
-	using StateParents	= StaticArray<Parent, TA::STATE_COUNT>;
-	using StateList		= typename TA::StateList;
-
-	static constexpr StateID STATE_ID = NS;
-
-	static HFSM_INLINE
-	void
-	execute(StateParents& stateParents,
-			const Parent parent)
-	{
-		static constexpr auto HEAD_ID = StateList::template index<TH>();
-		StaticAssertEquality<STATE_ID, HEAD_ID>();
-
-		stateParents[STATE_ID] = parent;
-	}
-};
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-template <StateID NS, typename TA>
-struct RegisterT<NS, TA, Empty<TA>> {
-	using StateParents	= StaticArray<Parent, TA::STATE_COUNT>;
-
-	static HFSM_INLINE
-	void
-	execute(StateParents&, const Parent) {}
-};
-
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, typename TH>
-void
-S_<TN, TA, TH>::deepRegister(StateRegistry& stateRegistry,
-							 const Parent parent)
-{
-	using Register = RegisterT<STATE_ID, TA, Head>;
-	Register::execute(stateRegistry.stateParents, parent);
-}
-
-//------------------------------------------------------------------------------
-
 template <typename TN, typename TA, typename TH>
 bool
 S_<TN, TA, TH>::deepEntryGuard(GuardControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::entryGuard, Method::ENTRY_GUARD);
+	const Sample sample{control._profiler, STATE_ID, Method::ENTRY_GUARD};
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -74,11 +28,16 @@ S_<TN, TA, TH>::deepEnter(PlanControl& control) {
 	HFSM_ASSERT(!control.planData().tasksFailures .template get<STATE_ID>());
 
 	HFSM_LOG_STATE_METHOD(&Head::enter, Method::ENTER);
+	const Sample sample{control._profiler, STATE_ID, Method::ENTER};
 
 	ScopedOrigin origin{control, STATE_ID};
 
+	control._stateRegistry.activeStates.template set<STATE_ID>();
+
 	_head.widePreEnter(control.context());
 	_head.enter(control);
+
+	HFSM_IF_COROUTINES(startRoutine(control));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -90,11 +49,16 @@ S_<TN, TA, TH>::deepReenter(PlanControl& control) {
 	HFSM_ASSERT(!control.planData().tasksFailures .template get<STATE_ID>());
 
 	HFSM_LOG_STATE_METHOD(&Head::reenter, Method::REENTER);
+	const Sample sample{control._profiler, STATE_ID, Method::REENTER};
 
 	ScopedOrigin origin{control, STATE_ID};
 
+	HFSM_IF_COROUTINES(stopRoutine(control));
+
 	_head.widePreReenter(control.context());
 	_head.reenter(control);
+
+	HFSM_IF_COROUTINES(startRoutine(control));
 }
 
 //------------------------------------------------------------------------------
@@ -103,12 +67,15 @@ template <typename TN, typename TA, typename TH>
 Status
 S_<TN, TA, TH>::deepUpdate(FullControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::update, Method::UPDATE);
+	const Sample sample{control._profiler, STATE_ID, Method::UPDATE};
 
 	ScopedOrigin origin{control, STATE_ID};
 
 	_head.widePreUpdate(control.context());
 	_head.update(control);
 
+	HFSM_IF_COROUTINES(updateRoutine(control));
+
 	return control._status;
 }
 
@@ -122,12 +89,15 @@ S_<TN, TA, TH>::deepReact(FullControl& control,
 {
 	auto reaction = static_cast<void(Head::*)(const TEvent&, FullControl&)>(&Head::react);
 	HFSM_LOG_STATE_METHOD(reaction, Method::REACT);
+	const Sample sample{control._profiler, STATE_ID, Method::REACT};
 
 	ScopedOrigin origin{control, STATE_ID};
 
 	_head.widePreReact(event, control.context());
 	(_head.*reaction)(event, control);				//_head.react(event, control);
 
+	HFSM_IF_COROUTINES(reactRoutine(control, event));
+
 	return control._status;
 }
 
@@ -137,6 +107,7 @@ template <typename TN, typename TA, typename TH>
 bool
 S_<TN, TA, TH>::deepExitGuard(GuardControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::exitGuard, Method::EXIT_GUARD);
+	const Sample sample{control._profiler, STATE_ID, Method::EXIT_GUARD};
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -154,9 +125,12 @@ template <typename TN, typename TA, typename TH>
 void
 S_<TN, TA, TH>::deepExit(PlanControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::exit, Method::EXIT);
+	const Sample sample{control._profiler, STATE_ID, Method::EXIT};
 
 	ScopedOrigin origin{control, STATE_ID};
 
+	HFSM_IF_COROUTINES(stopRoutine(control));
+
 	// if you see..
 	// VS	 - error C2039:  'exit': is not a member of 'Blah'
 	// Clang - error : no member named 'exit' in 'Blah'
@@ -165,16 +139,66 @@ S_<TN, TA, TH>::deepExit(PlanControl& control) {
 	_head.exit(control);
 	_head.widePostExit(control.context());
 
+	control._stateRegistry.activeStates.template reset<STATE_ID>();
+
 	control.planData().tasksSuccesses.template reset<STATE_ID>();
 	control.planData().tasksFailures .template reset<STATE_ID>();
 }
 
 //------------------------------------------------------------------------------
 
+#ifdef HFSM_ENABLE_COROUTINES
+
+template <typename TN, typename TA, typename TH>
+void
+S_<TN, TA, TH>::startRoutine(PlanControl& control) {
+	if constexpr (HAS_ROUTINE)
+		if (auto* const routines = control._routines)
+			routines->start(STATE_ID, _head);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, typename TH>
+void
+S_<TN, TA, TH>::stopRoutine(PlanControl& control) {
+	if constexpr (HAS_ROUTINE)
+		if (auto* const routines = control._routines)
+			routines->stop(STATE_ID);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, typename TH>
+void
+S_<TN, TA, TH>::updateRoutine(FullControl& control) {
+	if constexpr (HAS_ROUTINE)
+		if (auto* const routines = control._routines)
+			routines->update(STATE_ID, control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, typename TH>
+template <typename TEvent>
+void
+S_<TN, TA, TH>::reactRoutine(FullControl& control,
+							 const TEvent& event)
+{
+	if constexpr (HAS_ROUTINE)
+		if (auto* const routines = control._routines)
+			routines->react(STATE_ID, control, event);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
 template <typename TN, typename TA, typename TH>
 void
 S_<TN, TA, TH>::wrapPlanSucceeded(FullControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::planSucceeded, Method::PLAN_SUCCEEDED);
+	const Sample sample{control._profiler, STATE_ID, Method::PLAN_SUCCEEDED};
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -187,6 +211,7 @@ template <typename TN, typename TA, typename TH>
 void
 S_<TN, TA, TH>::wrapPlanFailed(FullControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::planFailed, Method::PLAN_FAILED);
+	const Sample sample{control._profiler, STATE_ID, Method::PLAN_FAILED};
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -199,6 +224,7 @@ template <typename TN, typename TA, typename TH>
 typename TA::Rank
 S_<TN, TA, TH>::wrapRank(Control& control) {
 	HFSM_LOG_STATE_METHOD(&Head::rank, Method::RANK);
+	const Sample sample{control._profiler, STATE_ID, Method::RANK};
 
 	return _head.rank(static_cast<const Control&>(control));
 }
@@ -209,6 +235,7 @@ template <typename TN, typename TA, typename TH>
 typename TA::Utility
 S_<TN, TA, TH>::wrapUtility(Control& control) {
 	HFSM_LOG_STATE_METHOD(&Head::utility, Method::UTILITY);
+	const Sample sample{control._profiler, STATE_ID, Method::UTILITY};
 
 	return _head.utility(static_cast<const Control&>(control));
 }
@@ -220,7 +247,7 @@ typename TA::UP
 S_<TN, TA, TH>::deepReportChange(Control& control) {
 	const Utility utility = wrapUtility(control);
 
-	const Parent parent = stateParent(control);
+	const Parent parent = Topology::STATE_PARENTS[STATE_ID];
 
 	return {utility, parent.prong};
 }
@@ -231,7 +258,7 @@ template <typename TN, typename TA, typename TH>
 typename TA::UP
 S_<TN, TA, TH>::deepReportUtilize(Control& control) {
 	const Utility utility = wrapUtility(control);
-	const Parent  parent  = stateParent(control);
+	const Parent  parent  = Topology::STATE_PARENTS[STATE_ID];
 
 	return {utility, parent.prong};
 }
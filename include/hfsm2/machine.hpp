@@ -35,15 +35,31 @@
 #endif
 
 #include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
 #include <typeindex>
 
+#ifdef HFSM_ENABLE_COROUTINES
+	#include <coroutine>	// C++20
+	#include <exception>	// std::terminate()
+#endif
+
+#ifdef HFSM_ENABLE_THREADS
+	#include <condition_variable>
+	#include <mutex>
+	#include <thread>
+#endif
+
 #if _MSC_VER == 1900
 	#include <math.h>		// @VS14: ldexpf()
 	#include <new>			// @VS14: placement new with non-default ctor
 #endif
 
-#if defined _DEBUG && _MSC_VER
-	#include <intrin.h>		// __debugbreak()
+#ifdef _MSC_VER
+	#include <intrin.h>		// __debugbreak(), __rdtsc()
 #endif
 
 #ifdef __GNUC__
@@ -89,7 +105,7 @@
 #ifdef HFSM_ENABLE_ASSERT
 	#define HFSM_IF_ASSERT(...)					__VA_ARGS__
 	#define HFSM_CHECKED(x)						(!!(x) || (HFSM_BREAK(), 0))
-	#define HFSM_ASSERT(x)						(!!(x) || (HFSM_BREAK(), 0))
+	#define HFSM_ASSERT(x)						((void) (!!(x) || (HFSM_BREAK(), 0)))
 	#define HFSM_ASSERT_OR(y, n)				y
 #else
 	#define HFSM_IF_ASSERT(...)
@@ -171,6 +187,14 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+#ifdef HFSM_ENABLE_COROUTINES
+	#define HFSM_IF_COROUTINES(...)									  __VA_ARGS__
+#else
+	#define HFSM_IF_COROUTINES(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 #if defined _MSC_VER || defined __clang_major__ && __clang_major__ >= 7
 	#define HFSM_EXPLICIT_MEMBER_SPECIALIZATION									1
 #else
@@ -244,6 +268,42 @@ end(const T(& a)[NCapacity]) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+inline
+unsigned
+popCount(uint64_t bits) {
+#ifdef __GNUC__
+	return (unsigned) __builtin_popcountll(bits);
+#else
+	unsigned count = 0;
+
+	for (; bits; bits &= bits - 1)
+		++count;
+
+	return count;
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+inline
+unsigned
+lowestBit(const uint64_t bits) {
+	HFSM_ASSERT(bits);
+
+#ifdef __GNUC__
+	return (unsigned) __builtin_ctzll(bits);
+#else
+	unsigned index = 0;
+
+	for (uint64_t mask = 1; (bits & mask) == 0; mask <<= 1)
+		++index;
+
+	return index;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 template <int N1, int N2>
 struct Min {
 	static constexpr auto VALUE = N1 < N2 ? N1 : N2;
@@ -592,6 +652,7 @@ namespace hfsm2 {
 namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
+// 'width' bits, starting at 8-bit aligned 'unit'
 
 struct Units {
 	ShortIndex unit;
@@ -600,24 +661,29 @@ struct Units {
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 class BitArray final {
 public:
 	using Index	= TIndex;
-	using Unit	= unsigned char;
+	using Word	= uint64_t;
 
-	static constexpr Index CAPACITY	= NCapacity;
+	static constexpr LongIndex	CAPACITY   = NCapacity;
+	static constexpr ShortIndex	UNIT_BITS  = 8;
+	static constexpr ShortIndex	WORD_BITS  = sizeof(Word) * 8;
+	static constexpr LongIndex	WORD_COUNT = (CAPACITY + WORD_BITS - 1) / WORD_BITS;
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	class Bits {
-		template <typename, ShortIndex>
+		template <typename, LongIndex>
 		friend class BitArray;
 
 	private:
-		HFSM_INLINE explicit Bits(Unit* const storage,
+		HFSM_INLINE explicit Bits(Word* const storage,
+								  const LongIndex offset,
 								  const Index width)
 			: _storage{storage}
+			, _offset{offset}
 			, _width{width}
 		{}
 
@@ -627,33 +693,36 @@ public:
 		HFSM_INLINE void clear();
 
 		template <ShortIndex NIndex>
-		HFSM_INLINE bool get() const;
+		HFSM_INLINE bool get() const									{ return get  (NIndex);	}
 
 		template <ShortIndex NIndex>
-		HFSM_INLINE void set();
+		HFSM_INLINE void set()											{		 set  (NIndex);	}
 
 		template <ShortIndex NIndex>
-		HFSM_INLINE void reset();
+		HFSM_INLINE void reset()										{		 reset(NIndex);	}
 
 		HFSM_INLINE bool get  (const Index index) const;
 		HFSM_INLINE void set  (const Index index);
 		HFSM_INLINE void reset(const Index index);
 
 	private:
-		Unit* const _storage;
+		Word* const _storage;
+		const LongIndex _offset;
 		const Index _width;
 	};
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	class ConstBits {
-		template <typename, ShortIndex>
+		template <typename, LongIndex>
 		friend class BitArray;
 
 	private:
-		HFSM_INLINE explicit ConstBits(const Unit* const storage,
+		HFSM_INLINE explicit ConstBits(const Word* const storage,
+									   const LongIndex offset,
 									   const Index width)
 			: _storage{storage}
+			, _offset{offset}
 			, _width{width}
 		{}
 
@@ -661,12 +730,13 @@ public:
 		HFSM_INLINE explicit operator bool() const;
 
 		template <ShortIndex NIndex>
-		HFSM_INLINE bool get() const;
+		HFSM_INLINE bool get() const									{ return get(NIndex);	}
 
 		HFSM_INLINE bool get(const Index index) const;
 
 	private:
-		const Unit* const _storage;
+		const Word* const _storage;
+		const LongIndex _offset;
 		const Index _width;
 	};
 
@@ -677,8 +747,18 @@ public:
 		clear();
 	}
 
+	HFSM_INLINE explicit operator bool() const;
+
 	HFSM_INLINE void clear();
 
+	HFSM_INLINE LongIndex count() const;
+
+	HFSM_INLINE BitArray& operator ^= (const BitArray& other);
+
+	// set bit iteration, returns CAPACITY past the last set bit
+	HFSM_INLINE LongIndex first() const									{ return find(0);			}
+	HFSM_INLINE LongIndex next(const LongIndex index) const				{ return find(index + 1);	}
+
 	template <ShortIndex NIndex>
 	HFSM_INLINE bool get() const;
 
@@ -698,12 +778,23 @@ public:
 	template <ShortIndex NUnit, ShortIndex NWidth>
 	HFSM_INLINE ConstBits bits() const;
 
-
 	HFSM_INLINE		 Bits bits(const Units& units);
 	HFSM_INLINE ConstBits bits(const Units& units) const;
 
+	// raw storage, for copying through atomics
+	HFSM_INLINE Word word(const LongIndex index) const					{ return _storage[index];	}
+	HFSM_INLINE void setWord(const LongIndex index, const Word word)	{ _storage[index] = word;	}
+
 private:
-	Unit _storage[CAPACITY];
+	HFSM_INLINE LongIndex find(const LongIndex from) const;
+
+	static HFSM_INLINE Word mask(const LongIndex begin, const LongIndex end);
+
+	static HFSM_INLINE bool any	   (const Word* const storage, const LongIndex begin, const LongIndex end);
+	static HFSM_INLINE void clear  (	  Word* const storage, const LongIndex begin, const LongIndex end);
+
+private:
+	Word _storage[WORD_COUNT];
 };
 
 //------------------------------------------------------------------------------
@@ -711,325 +802,516 @@ private:
 template <typename TIndex>
 class BitArray<TIndex, 0> final {
 public:
-	HFSM_INLINE void clear() {}
-};
-
-////////////////////////////////////////////////////////////////////////////////
+	using Word	= uint64_t;
 
-}
-}
+	static constexpr LongIndex CAPACITY	  = 0;
+	static constexpr LongIndex WORD_COUNT = 0;
 
-namespace hfsm2 {
-namespace detail {
+	HFSM_INLINE explicit operator bool() const							{ return false;	}
 
-////////////////////////////////////////////////////////////////////////////////
+	HFSM_INLINE void clear()											{}
 
-template <typename TIndex, ShortIndex NCapacity>
-BitArray<TIndex, NCapacity>::Bits::operator bool() const {
-	const ShortIndex fullUnits = _width / (sizeof(Unit) * 8);
+	HFSM_INLINE LongIndex count() const									{ return 0;		}
 
-	for (Index i = 0; i < fullUnits; ++i)
-		if (_storage[i])
-			return true;
+	HFSM_INLINE BitArray& operator ^= (const BitArray&)					{ return *this;	}
 
-	const ShortIndex bit = _width % (sizeof(Unit) * 8);
-	const Unit mask = (1 << bit) - 1;
-	const Unit& u = _storage[fullUnits];
+	HFSM_INLINE LongIndex first() const									{ return 0;		}
+	HFSM_INLINE LongIndex next(const LongIndex) const					{ return 0;		}
 
-	return (u & mask) != 0;
-}
+	HFSM_INLINE Word word(const LongIndex) const						{ return 0;		}
+	HFSM_INLINE void setWord(const LongIndex, const Word)				{}
+};
 
 //------------------------------------------------------------------------------
+// wire format of bit arrays: a bit per element, little-endian,
+// padded to whole bytes
 
-template <typename TIndex, ShortIndex NCapacity>
-void
-BitArray<TIndex, NCapacity>::Bits::clear() {
-	const Index count = (_width + 7) / (sizeof(Unit) * 8);
-
-	for (Index i = 0; i < count; ++i)
-		_storage[i] = Unit{0};
+template <typename TBits>
+constexpr std::size_t
+bitsSize() {
+	return (TBits::CAPACITY + 7) / 8;
 }
 
-//------------------------------------------------------------------------------
+template <typename TBits>
+void writeBits(unsigned char*& cursor, const TBits& bits);
 
-template <typename TIndex, ShortIndex NCapacity>
-template <ShortIndex NIndex>
-bool
-BitArray<TIndex, NCapacity>::Bits::get() const {
-	constexpr Index INDEX = NIndex;
-	HFSM_ASSERT(INDEX < _width);
+// rejects bits set past the capacity
+template <typename TBits>
+bool readBits(const unsigned char*& cursor, TBits& bits);
 
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
+////////////////////////////////////////////////////////////////////////////////
 
-	return (_storage[BIT_UNIT] & MASK) != 0;
+}
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-template <typename TIndex, ShortIndex NCapacity>
-template <ShortIndex NIndex>
-void
-BitArray<TIndex, NCapacity>::Bits::set() {
-	constexpr Index INDEX = NIndex;
-	HFSM_ASSERT(INDEX < _width);
+namespace hfsm2 {
+namespace detail {
 
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
+////////////////////////////////////////////////////////////////////////////////
 
-	_storage[BIT_UNIT] |= MASK;
+template <typename TIndex, LongIndex NCapacity>
+BitArray<TIndex, NCapacity>::Bits::operator bool() const {
+	return any(_storage, _offset, _offset + _width);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
-template <ShortIndex NIndex>
+template <typename TIndex, LongIndex NCapacity>
 void
-BitArray<TIndex, NCapacity>::Bits::reset() {
-	constexpr Index INDEX = NIndex;
-	HFSM_ASSERT(INDEX < _width);
-
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
-
-	_storage[BIT_UNIT] &= ~MASK;
+BitArray<TIndex, NCapacity>::Bits::clear() {
+	BitArray::clear(_storage, _offset, _offset + _width);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 bool
 BitArray<TIndex, NCapacity>::Bits::get(const Index index) const {
 	HFSM_ASSERT(index < _width);
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
+	const LongIndex bit = _offset + index;
 
-	return (_storage[unit] & mask) != 0;
+	return (_storage[bit / WORD_BITS] & (Word{1} << bit % WORD_BITS)) != 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 void
 BitArray<TIndex, NCapacity>::Bits::set(const Index index) {
 	HFSM_ASSERT(index < _width);
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
+	const LongIndex bit = _offset + index;
 
-	_storage[unit] |= mask;
+	_storage[bit / WORD_BITS] |= Word{1} << bit % WORD_BITS;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 void
 BitArray<TIndex, NCapacity>::Bits::reset(const Index index) {
 	HFSM_ASSERT(index < _width);
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
+	const LongIndex bit = _offset + index;
 
-	_storage[unit] &= ~mask;
+	_storage[bit / WORD_BITS] &= ~(Word{1} << bit % WORD_BITS);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 BitArray<TIndex, NCapacity>::ConstBits::operator bool() const {
-	const ShortIndex fullUnits = _width / (sizeof(Unit) * 8);
+	return any(_storage, _offset, _offset + _width);
+}
 
-	for (Index i = 0; i < fullUnits; ++i)
-		if (_storage[i])
-			return true;
+//------------------------------------------------------------------------------
+
+template <typename TIndex, LongIndex NCapacity>
+bool
+BitArray<TIndex, NCapacity>::ConstBits::get(const Index index) const {
+	HFSM_ASSERT(index < _width);
 
-	const ShortIndex bit = _width % (sizeof(Unit) * 8);
-	const Unit mask = (1 << bit) - 1;
-	const Unit& u = _storage[fullUnits];
+	const LongIndex bit = _offset + index;
 
-	return (u & mask) != 0;
+	return (_storage[bit / WORD_BITS] & (Word{1} << bit % WORD_BITS)) != 0;
 }
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TIndex, ShortIndex NCapacity>
-template <ShortIndex NIndex>
-bool
-BitArray<TIndex, NCapacity>::ConstBits::get() const {
-	constexpr Index INDEX = NIndex;
-	static_assert(INDEX < _width, "");
+template <typename TIndex, LongIndex NCapacity>
+BitArray<TIndex, NCapacity>::operator bool() const {
+	for (const Word& word : _storage)
+		if (word)
+			return true;
+
+	return false;
+}
 
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
+//------------------------------------------------------------------------------
 
-	return (_storage[BIT_UNIT] & MASK) != 0;
+template <typename TIndex, LongIndex NCapacity>
+void
+BitArray<TIndex, NCapacity>::clear() {
+	for (Word& word : _storage)
+		word = Word{0};
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
-bool
-BitArray<TIndex, NCapacity>::ConstBits::get(const Index index) const {
-	HFSM_ASSERT(index < _width);
+template <typename TIndex, LongIndex NCapacity>
+LongIndex
+BitArray<TIndex, NCapacity>::count() const {
+	LongIndex result = 0;
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
+	for (const Word& word : _storage)
+		result += (LongIndex) popCount(word);
 
-	return (_storage[unit] & mask) != 0;
+	return result;
 }
 
-////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
-void
-BitArray<TIndex, NCapacity>::clear() {
-	for (Unit& unit: _storage)
-		unit = Unit{0};
+template <typename TIndex, LongIndex NCapacity>
+BitArray<TIndex, NCapacity>&
+BitArray<TIndex, NCapacity>::operator ^= (const BitArray& other) {
+	for (LongIndex i = 0; i < WORD_COUNT; ++i)
+		_storage[i] ^= other._storage[i];
+
+	return *this;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 template <ShortIndex NIndex>
 bool
 BitArray<TIndex, NCapacity>::get() const {
-	constexpr Index INDEX = NIndex;
+	constexpr LongIndex INDEX = NIndex;
 	static_assert(INDEX < CAPACITY, "");
 
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
+	constexpr Word MASK = Word{1} << INDEX % WORD_BITS;
 
-	return (_storage[BIT_UNIT] & MASK) != 0;
+	return (_storage[INDEX / WORD_BITS] & MASK) != 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 template <ShortIndex NIndex>
 void
 BitArray<TIndex, NCapacity>::set() {
-	constexpr Index INDEX = NIndex;
+	constexpr LongIndex INDEX = NIndex;
 	static_assert(INDEX < CAPACITY, "");
 
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
+	constexpr Word MASK = Word{1} << INDEX % WORD_BITS;
 
-	_storage[BIT_UNIT] |= MASK;
+	_storage[INDEX / WORD_BITS] |= MASK;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 template <ShortIndex NIndex>
 void
 BitArray<TIndex, NCapacity>::reset() {
-	constexpr Index INDEX = NIndex;
+	constexpr LongIndex INDEX = NIndex;
 	static_assert(INDEX < CAPACITY, "");
 
-	constexpr Index BIT_UNIT  = INDEX / (sizeof(Unit) * 8);
-	constexpr Index BIT_INDEX = INDEX % (sizeof(Unit) * 8);
-	constexpr Unit MASK = 1 << BIT_INDEX;
+	constexpr Word MASK = Word{1} << INDEX % WORD_BITS;
 
-	_storage[BIT_UNIT] &= ~MASK;
+	_storage[INDEX / WORD_BITS] &= ~MASK;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 bool
 BitArray<TIndex, NCapacity>::get(const Index index) const {
 	HFSM_ASSERT(index < CAPACITY);
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
-
-	return (_storage[unit] & mask) != 0;
+	return (_storage[index / WORD_BITS] & (Word{1} << index % WORD_BITS)) != 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 void
 BitArray<TIndex, NCapacity>::set(const Index index) {
 	HFSM_ASSERT(index < CAPACITY);
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
-
-	_storage[unit] |= mask;
+	_storage[index / WORD_BITS] |= Word{1} << index % WORD_BITS;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 void
 BitArray<TIndex, NCapacity>::reset(const Index index) {
 	HFSM_ASSERT(index < CAPACITY);
 
-	const Index unit = index / (sizeof(Unit) * 8);
-	const Index bit  = index % (sizeof(Unit) * 8);
-	const Unit mask = 1 << bit;
-
-	_storage[unit] &= ~mask;
+	_storage[index / WORD_BITS] &= ~(Word{1} << index % WORD_BITS);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 template <ShortIndex NUnit, ShortIndex NWidth>
 typename BitArray<TIndex, NCapacity>::Bits
 BitArray<TIndex, NCapacity>::bits() {
-	constexpr ShortIndex UNIT  = NUnit;
-	constexpr ShortIndex WIDTH = NWidth;
-	static_assert(UNIT + (WIDTH + 7) / (sizeof(Unit) * 8) <= CAPACITY, "");
+	constexpr LongIndex OFFSET = NUnit * UNIT_BITS;
+	constexpr LongIndex WIDTH  = NWidth;
+	static_assert(OFFSET + WIDTH <= CAPACITY, "");
 
-	return Bits{_storage + UNIT, WIDTH};
+	return Bits{_storage, OFFSET, WIDTH};
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 template <ShortIndex NUnit, ShortIndex NWidth>
 typename BitArray<TIndex, NCapacity>::ConstBits
 BitArray<TIndex, NCapacity>::bits() const {
-	constexpr ShortIndex UNIT  = NUnit;
-	constexpr ShortIndex WIDTH = NWidth;
-	static_assert(UNIT + (WIDTH + 7) / (sizeof(Unit) * 8) <= CAPACITY, "");
+	constexpr LongIndex OFFSET = NUnit * UNIT_BITS;
+	constexpr LongIndex WIDTH  = NWidth;
+	static_assert(OFFSET + WIDTH <= CAPACITY, "");
 
-	return ConstBits{_storage + UNIT, WIDTH};
+	return ConstBits{_storage, OFFSET, WIDTH};
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 typename BitArray<TIndex, NCapacity>::Bits
 BitArray<TIndex, NCapacity>::bits(const Units& units) {
-	HFSM_ASSERT(units.unit + (units.width + 7) / (sizeof(Unit) * 8) <= CAPACITY);
+	HFSM_ASSERT(units.unit * UNIT_BITS + units.width <= CAPACITY);
 
-	return Bits{_storage + units.unit, units.width};
+	return Bits{_storage, (LongIndex) (units.unit * UNIT_BITS), units.width};
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndex, ShortIndex NCapacity>
+template <typename TIndex, LongIndex NCapacity>
 typename BitArray<TIndex, NCapacity>::ConstBits
 BitArray<TIndex, NCapacity>::bits(const Units& units) const {
-	HFSM_ASSERT(units.unit + (units.width + 7) / (sizeof(Unit) * 8) <= CAPACITY);
+	HFSM_ASSERT(units.unit * UNIT_BITS + units.width <= CAPACITY);
+
+	return ConstBits{_storage, (LongIndex) (units.unit * UNIT_BITS), units.width};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TIndex, LongIndex NCapacity>
+LongIndex
+BitArray<TIndex, NCapacity>::find(const LongIndex from) const {
+	if (from >= CAPACITY)
+		return CAPACITY;
+
+	LongIndex word = from / WORD_BITS;
+	Word bits = _storage[word] & (~Word{0} << from % WORD_BITS);
+
+	while (!bits)
+		if (++word < WORD_COUNT)
+			bits = _storage[word];
+		else
+			return CAPACITY;
+
+	return (LongIndex) (word * WORD_BITS + lowestBit(bits));
+}
+
+//------------------------------------------------------------------------------
+// bits of [begin, end) that fall into the word holding 'begin'
+
+template <typename TIndex, LongIndex NCapacity>
+typename BitArray<TIndex, NCapacity>::Word
+BitArray<TIndex, NCapacity>::mask(const LongIndex begin,
+								  const LongIndex end)
+{
+	const LongIndex shift = begin % WORD_BITS;
+	const LongIndex width = end - begin < WORD_BITS - shift ?
+								end - begin : WORD_BITS - shift;
+
+	return width < WORD_BITS ?
+		((Word{1} << width) - 1) << shift : ~Word{0};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	return ConstBits{_storage + units.unit, units.width};
+template <typename TIndex, LongIndex NCapacity>
+bool
+BitArray<TIndex, NCapacity>::any(const Word* const storage,
+								 const LongIndex begin,
+								 const LongIndex end)
+{
+	for (LongIndex bit = begin; bit < end; bit = (bit / WORD_BITS + 1) * WORD_BITS)
+		if (storage[bit / WORD_BITS] & mask(bit, end))
+			return true;
+
+	return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TIndex, LongIndex NCapacity>
+void
+BitArray<TIndex, NCapacity>::clear(Word* const storage,
+								   const LongIndex begin,
+								   const LongIndex end)
+{
+	for (LongIndex bit = begin; bit < end; bit = (bit / WORD_BITS + 1) * WORD_BITS)
+		storage[bit / WORD_BITS] &= ~mask(bit, end);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TBits>
+void
+writeBits(unsigned char*& cursor,
+		  const TBits& bits)
+{
+	using Word = typename TBits::Word;
+
+	for (LongIndex b = 0; b < bitsSize<TBits>(); ++b)
+		*cursor++ = (unsigned char) (bits.word(b / sizeof(Word)) >> b % sizeof(Word) * 8);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TBits>
+bool
+readBits(const unsigned char*& cursor,
+		 TBits& bits)
+{
+	using Word = typename TBits::Word;
+
+	bits.clear();
+
+	for (LongIndex b = 0; b < bitsSize<TBits>(); ++b) {
+		const LongIndex w = b / sizeof(Word);
+
+		bits.setWord(w, bits.word(w) | (Word) *cursor++ << b % sizeof(Word) * 8);
+	}
+
+	return TBits::CAPACITY % 8 == 0 ||
+		   cursor[-1] >> TBits::CAPACITY % 8 == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+// bounded lock-free multi-producer / single-consumer queue,
+// post() from any thread, drain() on the thread owning the machine
+
+template <typename TEvent,
+		  LongIndex NCapacity>
+class EventQueueT final {
+public:
+	using Event		= TEvent;
+	using Index		= std::size_t;
+
+	static constexpr LongIndex CAPACITY = NCapacity;
+
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "Event queue capacity must be a power of 2");
+
+public:
+	EventQueueT();
+	~EventQueueT();
+
+	EventQueueT(const EventQueueT&) = delete;
+	EventQueueT& operator = (const EventQueueT&) = delete;
+
+	bool post(const Event& event);
+
+	template <typename TMachine>
+	LongIndex drain(TMachine& machine);
+
+private:
+	struct Cell {
+		std::atomic<Index> sequence;
+
+		alignas(Event) unsigned char bytes[sizeof(Event)];
+
+		HFSM_INLINE Event& event()										{ return reinterpret_cast<Event&>(bytes);	}
+	};
+
+	static constexpr Index MASK = CAPACITY - 1;
+
+	alignas(64) std::atomic<Index> _tail;
+	alignas(64) Index _head = 0;
+
+	Cell _cells[CAPACITY];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TE, LongIndex NC>
+EventQueueT<TE, NC>::EventQueueT()
+	: _tail{0}
+{
+	for (Index i = 0; i < CAPACITY; ++i)
+		_cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TE, LongIndex NC>
+EventQueueT<TE, NC>::~EventQueueT() {
+	for (;; ++_head) {
+		Cell& cell = _cells[_head & MASK];
+
+		if (cell.sequence.load(std::memory_order_acquire) != _head + 1)
+			break;
+
+		cell.event().~Event();
+		cell.sequence.store(_head + CAPACITY, std::memory_order_relaxed);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TE, LongIndex NC>
+bool
+EventQueueT<TE, NC>::post(const Event& event) {
+	Index position = _tail.load(std::memory_order_relaxed);
+
+	for (;;) {
+		Cell& cell = _cells[position & MASK];
+		const Index sequence = cell.sequence.load(std::memory_order_acquire);
+
+		if (sequence == position) {
+			if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				new (&cell.bytes) Event(event);
+				cell.sequence.store(position + 1, std::memory_order_release);
+
+				return true;
+			}
+		} else if ((std::ptrdiff_t) (sequence - position) < 0) {
+			// full
+			return false;
+		} else
+			position = _tail.load(std::memory_order_relaxed);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TE, LongIndex NC>
+template <typename TMachine>
+LongIndex
+EventQueueT<TE, NC>::drain(TMachine& machine) {
+	LongIndex count = 0;
+
+	// at most CAPACITY events per call, busy producers can't stall the owner
+	for (; count < CAPACITY; ++count, ++_head) {
+		Cell& cell = _cells[_head & MASK];
+
+		if (cell.sequence.load(std::memory_order_acquire) != _head + 1)
+			break;
+
+		{
+			const Event event(std::move(cell.event()));
+			cell.event().~Event();
+			cell.sequence.store(_head + CAPACITY, std::memory_order_release);
+
+			machine.react(event);
+		}
+	}
+
+	return count;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1155,11 +1437,10 @@ List<TItem, NCapacity>::emplace(TArgs... args) {
 
 		return result;
 	} else {
-		// full
+		// full, left for the caller to handle
 		HFSM_ASSERT(_vacantHead == INVALID);
 		HFSM_ASSERT(_vacantTail == INVALID);
 		HFSM_ASSERT(_count == CAPACITY);
-		HFSM_BREAK();
 
 		return INVALID;
 	}
@@ -1848,301 +2129,217 @@ using Merge = typename MergeT<Ts...>::TypeList;
 }
 }
 
+namespace hfsm2 {
+namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-namespace hfsm2 {
+template <LongIndex...>
+struct MaxT;
 
-enum class Method : ShortIndex {
-	RANK,
-	UTILITY,
-	ENTRY_GUARD,
-	ENTER,
-	REENTER,
-	UPDATE,
-	REACT,
-	EXIT_GUARD,
-	EXIT,
-	PLAN_SUCCEEDED,
-	PLAN_FAILED,
+template <LongIndex N, LongIndex... Ns>
+struct MaxT<N, Ns...> {
+	static constexpr LongIndex VALUE = N > MaxT<Ns...>::VALUE ? N : MaxT<Ns...>::VALUE;
+};
 
-	COUNT
+template <>
+struct MaxT<> {
+	static constexpr LongIndex VALUE = 1;
 };
 
-enum class Transition : ShortIndex {
-	CHANGE,
-	RESTART,
-	RESUME,
-	UTILIZE,
-	RANDOMIZE,
-	SCHEDULE,
+//------------------------------------------------------------------------------
+// fixed-capacity FIFO of events from a closed type list,
+// stored as tagged variants and dispatched through a per-receiver jump table
 
-	COUNT
-};
+template <typename TEvents,
+		  LongIndex NCapacity>
+class EventBufferT;
 
-enum class StatusEvent : ShortIndex {
-	SUCCEEDED,
-	FAILED,
+template <typename... TEvents,
+		  LongIndex NCapacity>
+class EventBufferT<TL_<TEvents...>, NCapacity> final {
+	using Events = ITL_<TEvents...>;
 
-	COUNT
-};
+	static constexpr LongIndex SIZE		 = MaxT<sizeof (TEvents)...>::VALUE;
+	static constexpr LongIndex ALIGNMENT = MaxT<alignof(TEvents)...>::VALUE;
 
-//------------------------------------------------------------------------------
+	struct Slot {
+		ShortIndex type;
 
-static inline
-const char*
-stateName(const std::type_index stateType) {
-	const char* const raw = stateType.name();
+		alignas(ALIGNMENT) unsigned char bytes[SIZE];
+	};
 
-	#if defined(_MSC_VER)
+	template <typename TReceiver>
+	using Thunk = void (*)(TReceiver&, const void*);
 
-		auto first =
-			raw[0] == 's' ? 7 : // Struct
-			raw[0] == 'c' ? 6 : // Class
-							0;
-		return raw + first;
+	using Destructor = void (*)(void*);
 
-	#elif defined(__clang__) || defined(__GNUC__) || defined(__GNUG__)
+public:
+	static constexpr LongIndex CAPACITY	  = NCapacity;
+	static constexpr LongIndex TYPE_COUNT = Events::SIZE;
 
-		return raw;
+	static_assert(TYPE_COUNT > 0, "Declare event types with 'Config::EventsT<>'");
+	static_assert(TYPE_COUNT < (ShortIndex) -1, "Too many event types. Change 'ShortIndex' type.");
 
-	#else
+public:
+	EventBufferT() = default;
+	~EventBufferT()														{ clear();			}
 
-		return raw;
+	EventBufferT(const EventBufferT&) = delete;
+	EventBufferT& operator = (const EventBufferT&) = delete;
 
-	#endif
-}
+	template <typename TEvent>
+	bool push(const TEvent& event);
 
-//------------------------------------------------------------------------------
+	void clear();
 
-static inline
-const char*
-methodName(const Method method) {
-	switch (method) {
-		case Method::RANK:				return "rank";
-		case Method::UTILITY:			return "utility";
-		case Method::ENTRY_GUARD:		return "entryGuard";
-		case Method::ENTER:				return "enter";
-		case Method::REENTER:			return "reenter";
-		case Method::UPDATE:			return "update";
-		case Method::REACT:				return "react";
-		case Method::EXIT_GUARD:		return "exitGuard";
-		case Method::EXIT:				return "exit";
-		case Method::PLAN_SUCCEEDED:	return "planSucceeded";
-		case Method::PLAN_FAILED:		return "planFailed";
+	HFSM_INLINE LongIndex count() const									{ return _count;	}
 
-		default:
-			HFSM_BREAK();
-			return nullptr;
-	}
-}
+	template <typename TReceiver>
+	void dispatch(TReceiver& receiver) const;
 
-//------------------------------------------------------------------------------
+private:
+	template <typename TReceiver, typename TEvent>
+	static void thunk(TReceiver& receiver, const void* const event)		{ receiver(*static_cast<const TEvent*>(event));	}
 
-static inline
-const char*
-transitionName(const Transition transition) {
-	switch (transition) {
-		case Transition::CHANGE:		return "changeTo";
-		case Transition::RESTART:		return "restart";
-		case Transition::RESUME:		return "resume";
-		case Transition::UTILIZE:		return "utilize";
-		case Transition::RANDOMIZE:		return "randomize";
-		case Transition::SCHEDULE:		return "schedule";
+	template <typename TEvent>
+	static void destroy(void* const event)								{ static_cast<TEvent*>(event)->~TEvent();		}
 
-		default:
-			HFSM_BREAK();
-			return nullptr;
-	}
-}
+private:
+	LongIndex _count = 0;
+	Slot _slots[CAPACITY];
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 
 }
-
-#if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
+}
 
 namespace hfsm2 {
+namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TUtilty = float>
-struct LoggerInterfaceT {
-	using Utilty	  = TUtilty;
-
-	using Method	  = ::hfsm2::Method;
-	using StateID	  = ::hfsm2::StateID;
-	using RegionID	  = ::hfsm2::RegionID;
-	using Transition  = ::hfsm2::Transition;
-	using StatusEvent = ::hfsm2::StatusEvent;
+template <typename... TE, LongIndex NC>
+template <typename TEvent>
+bool
+EventBufferT<TL_<TE...>, NC>::push(const TEvent& event) {
+	static_assert(Events::template contains<TEvent>(), "Event type is missing from 'Config::EventsT<>'");
 
-	virtual void recordMethod(const StateID /*origin*/,
-							  const Method /*method*/)
-	{}
+	if (_count == CAPACITY)
+		return false;
 
-	virtual void recordTransition(const StateID /*origin*/,
-								  const Transition /*transition*/,
-								  const StateID /*target*/)
-	{}
+	Slot& slot = _slots[_count++];
+	slot.type = (ShortIndex) Events::template index<TEvent>();
+	new (&slot.bytes) TEvent(event);
 
-	virtual void recordTaskStatus(const RegionID /*region*/,
-								  const StateID /*origin*/,
-								  const StatusEvent /*event*/)
-	{}
+	return true;
+}
 
-	virtual void recordPlanStatus(const RegionID /*region*/,
-								  const StatusEvent /*event*/)
-	{}
+//------------------------------------------------------------------------------
 
-	virtual void recordCancelledPending(const StateID /*origin*/) {}
+template <typename... TE, LongIndex NC>
+void
+EventBufferT<TL_<TE...>, NC>::clear() {
+	static const Destructor DESTRUCTORS[] = { &destroy<TE>... };
 
-	virtual void recordUtilityResolution(const StateID /*head*/,
-										 const StateID /*prong*/,
-										 const Utilty /*utilty*/)
-	{}
+	for (LongIndex i = 0; i < _count; ++i)
+		DESTRUCTORS[_slots[i].type](&_slots[i].bytes);
 
-	virtual void recordRandomResolution(const StateID /*head*/,
-										const StateID /*prong*/,
-										const Utilty /*utilty*/)
-	{}
-};
+	_count = 0;
+}
 
-using LoggerInterface = LoggerInterfaceT<float>;
+//------------------------------------------------------------------------------
 
-////////////////////////////////////////////////////////////////////////////////
+template <typename... TE, LongIndex NC>
+template <typename TReceiver>
+void
+EventBufferT<TL_<TE...>, NC>::dispatch(TReceiver& receiver) const {
+	static const Thunk<TReceiver> THUNKS[] = { &thunk<TReceiver, TE>... };
 
+	for (LongIndex i = 0; i < _count; ++i)
+		THUNKS[_slots[i].type](receiver, &_slots[i].bytes);
 }
 
-#else
-
-namespace hfsm2 {
-
-template <typename = float>
-using LoggerInterfaceT = void;
+////////////////////////////////////////////////////////////////////////////////
 
 }
-
-#endif
+}
 
 namespace hfsm2 {
 namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
+// fixed-capacity slab of payloads addressed by 1-byte handles,
+// payloads are only copied if the pool itself is;
+// state data is held until released, transition payloads are staged
+// for the requests in flight and released together once they are processed
+
+template <typename TPayload,
+		  LongIndex NCapacity>
+class PayloadPoolT final {
+	struct alignas(alignof(TPayload)) Slot {
+		unsigned char bytes[sizeof(TPayload)];
+	};
 
-#pragma pack(push, 2)
+public:
+	using Payload = TPayload;
+	using Handle  = ShortIndex;
 
-struct TaskLink {
-	HFSM_INLINE TaskLink(const Transition transition_,
-						 const StateID origin_,
-						 const StateID destination_)
-		: transition{transition_}
-		, origin(origin_)
-		, destination(destination_)
-		, next(INVALID_LONG_INDEX)
-	{}
+	static constexpr LongIndex CAPACITY = NCapacity;
 
-	Transition transition;
-	StateID origin		= INVALID_STATE_ID;
-	StateID destination	= INVALID_STATE_ID;
-	// TODO: add paylaods
+	static_assert(CAPACITY > 0, "Payload pool capacity must be positive");
+	static_assert(CAPACITY < INVALID_SHORT_INDEX, "Too many payload slots. Change 'ShortIndex' type.");
 
-	LongIndex prev		= INVALID_LONG_INDEX;
-	LongIndex next		= INVALID_LONG_INDEX;
-};
+	using Slots = BitArray<LongIndex, CAPACITY>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+public:
+	PayloadPoolT();
+	PayloadPoolT(const PayloadPoolT& other);
+	~PayloadPoolT()													{ clear();					}
 
-struct Bounds {
-	LongIndex first		= INVALID_LONG_INDEX;
-	LongIndex last		= INVALID_LONG_INDEX;
-};
+	PayloadPoolT& operator = (const PayloadPoolT& other);
 
-#pragma pack(pop)
+	// INVALID_SHORT_INDEX if the pool is exhausted
+	HFSM_INLINE Handle hold (const Payload&	payload)				{ return acquire(payload, false);				}
+	HFSM_INLINE Handle hold (	  Payload&& payload)				{ return acquire(std::move(payload), false);	}
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE Handle stage(const Payload&	payload)				{ return acquire(payload, true);				}
+	HFSM_INLINE Handle stage(	  Payload&& payload)				{ return acquire(std::move(payload), true);		}
 
-template <typename,
-		  typename,
-		  typename,
-		  typename,
-		  LongIndex,
-		  LongIndex,
-		  LongIndex,
-		  typename,
-		  LongIndex>
-struct ArgsT;
+	HFSM_INLINE void release(const Handle handle);
 
-template <typename>
-struct PlanDataT;
+	HFSM_INLINE void releaseStaged();
 
-//------------------------------------------------------------------------------
+	void clear();
 
-template <typename TContext,
-		  typename TConfig,
-		  typename TStateList,
-		  typename TRegionList,
-		  LongIndex NCompoCount,
-		  LongIndex NOrthoCount,
-		  LongIndex NOrthoUnits,
-		  typename TPayload,
-		  LongIndex NTaskCapacity>
-struct PlanDataT<ArgsT<TContext,
-					   TConfig,
-					   TStateList,
-					   TRegionList,
-					   NCompoCount,
-					   NOrthoCount,
-					   NOrthoUnits,
-					   TPayload,
-					   NTaskCapacity>>
-{
-	using StateList		= TStateList;
-	using RegionList	= TRegionList;
+	HFSM_INLINE		  Payload& operator[] (const Handle handle);
+	HFSM_INLINE const Payload& operator[] (const Handle handle) const;
 
-	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
-	static constexpr ShortIndex TASK_CAPACITY = NTaskCapacity;
+	HFSM_INLINE LongIndex count() const								{ return _count;			}
 
-	using TaskLinks		= List<TaskLink, TASK_CAPACITY>;
-	using TasksBounds	= Array<Bounds, RegionList::SIZE>;
-	using TasksBits		= BitArray<StateID, StateList::SIZE>;
-	using RegionBits	= BitArray<RegionID, RegionList::SIZE>;
+	// most slots used at once, to size 'Config::PayloadCapacityN<>',
+	// and payloads dropped for lack of slots; neither is copied with the pool
+	HFSM_INLINE LongIndex peak() const								{ return _peak;				}
+	HFSM_INLINE LongIndex overflows() const							{ return _overflows;		}
 
-	TaskLinks taskLinks;
-	TasksBounds tasksBounds;
-	TasksBits tasksSuccesses;
-	TasksBits tasksFailures;
-	RegionBits planExists;
+private:
+	template <typename T>
+	Handle acquire(T&& payload, const bool staged);
 
-#ifdef HFSM_ENABLE_ASSERT
-	void verifyPlans() const;
-	LongIndex verifyPlan(const RegionID stateId) const;
-#endif
-};
+	void rebuild(const PayloadPoolT& other);
 
-//------------------------------------------------------------------------------
+private:
+	Slot _slots[CAPACITY];
+	Handle _next[CAPACITY];
 
-template <typename TContext,
-		  typename TConfig,
-		  typename TStateList,
-		  typename TRegionList,
-		  LongIndex NOrthoCount,
-		  LongIndex NOrthoUnits,
-		  typename TPayload,
-		  LongIndex NTaskCapacity>
-struct PlanDataT<ArgsT<TContext,
-					   TConfig,
-					   TStateList,
-					   TRegionList,
-					   0,
-					   NOrthoCount,
-					   NOrthoUnits,
-					   TPayload,
-					   NTaskCapacity>>
-{
-#ifdef HFSM_ENABLE_ASSERT
-	void verifyPlans() const													{}
-	LongIndex verifyPlan(const RegionID) const					{ return 0;		}
-#endif
+	Slots _used;
+	Slots _staged;
+
+	Handle _vacant = 0;
+	LongIndex _count = 0;
+	LongIndex _peak = 0;
+	LongIndex _overflows = 0;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2155,825 +2352,864 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#ifdef HFSM_ENABLE_ASSERT
+template <typename TP, LongIndex NC>
+PayloadPoolT<TP, NC>::PayloadPoolT() {
+	for (LongIndex i = 0; i < CAPACITY; ++i)
+		_next[i] = (Handle) (i + 1 < CAPACITY ? i + 1 : INVALID_SHORT_INDEX);
+}
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-void
-PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::verifyPlans() const {
-	LongIndex planCount = 0;
-	for (RegionID id = 0; id < REGION_COUNT; ++id)
-		planCount += verifyPlan(id);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_ASSERT(taskLinks.count() == planCount);
+template <typename TP, LongIndex NC>
+PayloadPoolT<TP, NC>::PayloadPoolT(const PayloadPoolT& other) {
+	rebuild(other);
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-LongIndex
-PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::verifyPlan(const RegionID regionId) const {
-	LongIndex length = 0;
-	const Bounds& bounds = tasksBounds[regionId];
+template <typename TP, LongIndex NC>
+PayloadPoolT<TP, NC>&
+PayloadPoolT<TP, NC>::operator = (const PayloadPoolT& other) {
+	if (this != &other) {
+		clear();
+		rebuild(other);
+	}
 
-	if (bounds.first != INVALID_LONG_INDEX) {
-		HFSM_ASSERT(bounds.last != INVALID_LONG_INDEX);
+	return *this;
+}
 
-		for (auto slow = bounds.first, fast = slow; ; ) {
-			++length;
-			const TaskLink& task = taskLinks[slow];
+//------------------------------------------------------------------------------
 
-			if (slow != bounds.last) {
-				HFSM_ASSERT(task.next != INVALID_LONG_INDEX);
-				slow = task.next;
+template <typename TP, LongIndex NC>
+void
+PayloadPoolT<TP, NC>::release(const Handle handle) {
+	HFSM_ASSERT(handle < CAPACITY && _used.get(handle));
 
-				// loop check
-				if (fast != INVALID_LONG_INDEX) {
-					fast = taskLinks[fast].next;
+	if (handle < CAPACITY && _used.get(handle)) {
+		(*this)[handle].~Payload();
 
-					if (fast != INVALID_LONG_INDEX) {
-						fast = taskLinks[fast].next;
-					}
+		_used  .reset(handle);
+		_staged.reset(handle);
 
-					if (fast != INVALID_LONG_INDEX)
-						HFSM_ASSERT(slow != fast);
-				}
-			} else {
-				HFSM_ASSERT(task.next == INVALID_LONG_INDEX);
+		_next[handle] = _vacant;
+		_vacant = handle;
+		--_count;
+	}
+}
 
-				break;
-			}
-		};
-	} else
-		HFSM_ASSERT(bounds.last == INVALID_LONG_INDEX);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	return length;
+template <typename TP, LongIndex NC>
+void
+PayloadPoolT<TP, NC>::releaseStaged() {
+	for (LongIndex i = _staged.first(); i < CAPACITY; i = _staged.next(i))
+		release((Handle) i);
 }
 
-#endif
-
-////////////////////////////////////////////////////////////////////////////////
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+template <typename TP, LongIndex NC>
+void
+PayloadPoolT<TP, NC>::clear() {
+	for (LongIndex i = _used.first(); i < CAPACITY; i = _used.next(i))
+		release((Handle) i);
 }
-}
-namespace hfsm2 {
-namespace detail {
 
-////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
 
-#pragma pack(push, 1)
+template <typename TP, LongIndex NC>
+TP&
+PayloadPoolT<TP, NC>::operator[] (const Handle handle) {
+	HFSM_ASSERT(handle < CAPACITY && _used.get(handle));
 
-struct Status {
-	enum Result {
-		NONE,
-		SUCCESS,
-		FAILURE
-	};
+	return *reinterpret_cast<Payload*>(&_slots[handle].bytes);
+}
 
-	Result result = NONE;
-	bool outerTransition = false;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	inline Status(const Result result_ = NONE,
-				  const bool outerTransition_ = false);
+template <typename TP, LongIndex NC>
+const TP&
+PayloadPoolT<TP, NC>::operator[] (const Handle handle) const {
+	HFSM_ASSERT(handle < CAPACITY && _used.get(handle));
 
-	inline explicit operator bool() const { return result || outerTransition; }
+	return *reinterpret_cast<const Payload*>(&_slots[handle].bytes);
+}
 
-	inline void clear();
-};
+//------------------------------------------------------------------------------
 
-#pragma pack(pop)
+template <typename TP, LongIndex NC>
+template <typename T>
+typename PayloadPoolT<TP, NC>::Handle
+PayloadPoolT<TP, NC>::acquire(T&& payload,
+							  const bool staged)
+{
+	if (_vacant < CAPACITY) {
+		const Handle handle = _vacant;
+		_vacant = _next[handle];
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		new (&_slots[handle].bytes) Payload(std::forward<T>(payload));
 
-inline Status
-combine(const Status lhs, const Status rhs) {
-	const Status::Result result = lhs.result > rhs.result ?
-		lhs.result : rhs.result;
+		_used.set(handle);
+		if (staged)
+			_staged.set(handle);
 
-	return {result, lhs.outerTransition || rhs.outerTransition};
-}
+		if (_peak < ++_count)
+			_peak = _count;
 
-////////////////////////////////////////////////////////////////////////////////
+		return handle;
+	} else {
+		// counted, not a fault: raise 'Config::PayloadCapacityN<>' above 'payloadPeak()'
+		++_overflows;
 
-template <typename TArgs>
-class ConstPlanT {
-	template <typename>
-	friend class ControlT;
+		return INVALID_SHORT_INDEX;
+	}
+}
 
-	template <typename>
-	friend class PlanControlT;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// keeps the handles, so copies of requests and per-state slots stay valid
 
-	template <typename>
-	friend class FullControlT;
+template <typename TP, LongIndex NC>
+void
+PayloadPoolT<TP, NC>::rebuild(const PayloadPoolT& other) {
+	_vacant = INVALID_SHORT_INDEX;
 
-	template <typename>
-	friend class GuardControlT;
+	for (LongIndex i = CAPACITY; i-- > 0; )
+		if (other._used.get(i))
+			new (&_slots[i].bytes) Payload(other[(Handle) i]);
+		else {
+			_next[i] = _vacant;
+			_vacant = (Handle) i;
+		}
 
-	using Args			= TArgs;
-	using Context		= typename Args::Context;
-	using StateList		= typename Args::StateList;
-	using RegionList	= typename Args::RegionList;
-	using Payload		= typename Args::Payload;
+	_used	= other._used;
+	_staged = other._staged;
+	_count	= other._count;
 
-	static constexpr LongIndex TASK_CAPACITY = Args::TASK_CAPACITY;
+	if (_peak < _count)
+		_peak = _count;
+}
 
-public:
-	using PlanData		= PlanDataT<Args>;
-	using TaskLinks		= typename PlanData::TaskLinks;
+////////////////////////////////////////////////////////////////////////////////
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+}
+}
 
-	struct Iterator {
-		HFSM_INLINE Iterator(const ConstPlanT& plan);
+namespace hfsm2 {
 
-		HFSM_INLINE explicit operator bool() const;
+////////////////////////////////////////////////////////////////////////////////
+// runs 'task(context, 0 .. count - 1)', returning once every call completed;
+// machines hand the prongs of their parallel orthogonal regions to it
 
-		HFSM_INLINE void operator ++();
+struct ExecutorInterface {
+	using Task = void (*)(void* const context, const LongIndex index);
 
-		HFSM_INLINE const TaskLink& operator  *() const { return  _plan._planData.taskLinks[_curr];	}
-		HFSM_INLINE const TaskLink* operator ->() const { return &_plan._planData.taskLinks[_curr];	}
+	virtual ~ExecutorInterface() = default;
 
-		HFSM_INLINE LongIndex next() const;
+	virtual void run(const LongIndex count,
+					 const Task task,
+					 void* const context) = 0;
+};
 
-		const ConstPlanT& _plan;
-		LongIndex _curr;
-		LongIndex _next;
-	};
+namespace detail {
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
+// serializes the few shared writes prongs of a parallel region make
 
-private:
-	HFSM_INLINE ConstPlanT(const PlanData& planData,
-						   const RegionID regionId);
+class SpinLock final {
+public:
+	HFSM_INLINE void lock()								{ while (_flag.test_and_set(std::memory_order_acquire)) {}	}
+	HFSM_INLINE void unlock()							{ _flag.clear(std::memory_order_release);					}
 
-	template <typename T>
-	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
+private:
+	std::atomic_flag _flag = ATOMIC_FLAG_INIT;
+};
 
-	template <typename T>
-	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+class SpinGuard final {
 public:
-	HFSM_INLINE explicit operator bool() const;
+	HFSM_INLINE explicit SpinGuard(SpinLock* const lock)
+		: _lock{lock}
+	{
+		if (_lock)
+			_lock->lock();
+	}
 
-	HFSM_INLINE Iterator first()			{ return Iterator{*this};								}
+	HFSM_INLINE ~SpinGuard() {
+		if (_lock)
+			_lock->unlock();
+	}
+
+	SpinGuard(const SpinGuard&) = delete;
+	SpinGuard& operator = (const SpinGuard&) = delete;
 
 private:
-	const PlanData& _planData;
-	const Bounds& _bounds;
+	SpinLock* const _lock;
 };
 
-////////////////////////////////////////////////////////////////////////////////
+}
 
-template <typename TArgs>
-class PlanT {
-	template <typename>
-	friend class PlanControlT;
+#ifdef HFSM_ENABLE_THREADS
 
-	template <typename>
-	friend class FullControlT;
+////////////////////////////////////////////////////////////////////////////////
+// fork-join pool of 'NThreads' - 1 workers and the calling thread;
+// run() splits the indices into one contiguous range per thread,
+// threads that drain their own range steal the back half of another's
 
-	template <typename>
-	friend class GuardControlT;
+template <LongIndex NThreads>
+class WorkStealingExecutorT final
+	: public ExecutorInterface
+{
+	// task index range [begin, end), tagged with the run() it belongs to
+	using Range = uint64_t;
 
-	using Args			= TArgs;
-	using Context		= typename Args::Context;
-	using StateList		= typename Args::StateList;
-	using RegionList	= typename Args::RegionList;
-	using Payload		= typename Args::Payload;
+	// keeps threads' ranges on separate cache lines
+	struct alignas(64) Slot {
+		std::atomic<Range> range{0};
+	};
 
-	static constexpr LongIndex  TASK_CAPACITY	= Args::TASK_CAPACITY;
+	static_assert(sizeof(Slot) == 64, "");
 
 public:
-	using PlanData		= PlanDataT<Args>;
-	using TaskLinks		= typename PlanData::TaskLinks;
-	using TaskIndex		= typename TaskLinks::Index;
-
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	static constexpr LongIndex THREAD_COUNT = NThreads;
 
-	struct Iterator {
-		HFSM_INLINE Iterator(PlanT& plan);
+	static_assert(THREAD_COUNT > 0, "The calling thread is one of 'NThreads'");
 
-		HFSM_INLINE explicit operator bool() const;
+	WorkStealingExecutorT();
+	~WorkStealingExecutorT();
 
-		HFSM_INLINE void operator ++();
+	WorkStealingExecutorT(const WorkStealingExecutorT&) = delete;
+	WorkStealingExecutorT& operator = (const WorkStealingExecutorT&) = delete;
 
-		HFSM_INLINE		  TaskLink& operator  *()	    { return  _plan._planData.taskLinks[_curr];	}
-		HFSM_INLINE const TaskLink& operator  *() const { return  _plan._planData.taskLinks[_curr];	}
+	void run(const LongIndex count,
+			 const Task task,
+			 void* const context) override;
 
-		HFSM_INLINE		  TaskLink* operator ->()	    { return &_plan._planData.taskLinks[_curr];	}
-		HFSM_INLINE const TaskLink* operator ->() const { return &_plan._planData.taskLinks[_curr];	}
+	// tasks a thread took from another's range since construction
+	HFSM_INLINE uint32_t stolen() const						{ return _stolen.load(std::memory_order_relaxed);	}
 
-		HFSM_INLINE void remove();
+private:
+	static HFSM_INLINE Range pack(const uint32_t generation,
+								  const LongIndex begin,
+								  const LongIndex end)		{ return (Range) generation << 32 | (Range) begin << 16 | end;	}
 
-		HFSM_INLINE LongIndex next() const;
+	static HFSM_INLINE uint32_t  generation(const Range range)	{ return (uint32_t)	 (range >> 32);				}
+	static HFSM_INLINE LongIndex begin	   (const Range range)	{ return (LongIndex) (range >> 16);				}
+	static HFSM_INLINE LongIndex end	   (const Range range)	{ return (LongIndex)  range;					}
 
-		PlanT& _plan;
-		LongIndex _curr;
-		LongIndex _next;
-	};
+	void work(const LongIndex thread);
+	void execute(const LongIndex thread, const uint32_t generation);
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	bool pop  (const LongIndex thread, const uint32_t generation, LongIndex& index);
+	bool steal(const LongIndex thread, const uint32_t generation, LongIndex& index);
 
 private:
-	HFSM_INLINE PlanT(PlanData& planData,
-					  const RegionID regionId);
+	Slot _slots[THREAD_COUNT];
 
-	template <typename T>
-	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
+	// '_threads[0]' is the calling thread and stays empty
+	std::thread _threads[THREAD_COUNT];
 
-	template <typename T>
-	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	uint32_t _generation = 0;
+	bool _stop = false;
 
-	bool append(const Transition transition,
-				const StateID origin,
-				const StateID destination);
+	Task _task = nullptr;
+	void* _context = nullptr;
 
-public:
-	HFSM_INLINE explicit operator bool() const;
+	std::atomic<LongIndex> _pending{0};
+	std::atomic<uint32_t> _stolen{0};
+};
 
-	HFSM_INLINE void clear();
+#endif
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+////////////////////////////////////////////////////////////////////////////////
 
-	HFSM_INLINE bool change   (const StateID origin, const StateID destination)	{ return append(Transition::CHANGE,	   origin, destination); }
-	HFSM_INLINE bool restart  (const StateID origin, const StateID destination)	{ return append(Transition::RESTART,   origin, destination); }
-	HFSM_INLINE bool resume   (const StateID origin, const StateID destination)	{ return append(Transition::RESUME,	   origin, destination); }
-	HFSM_INLINE bool utilize  (const StateID origin, const StateID destination)	{ return append(Transition::UTILIZE,   origin, destination); }
-	HFSM_INLINE bool randomize(const StateID origin, const StateID destination)	{ return append(Transition::RANDOMIZE, origin, destination); }
-	HFSM_INLINE bool schedule (const StateID origin, const StateID destination)	{ return append(Transition::SCHEDULE,  origin, destination); }
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#ifdef HFSM_ENABLE_THREADS
 
-	template <typename TOrigin>
-	HFSM_INLINE bool change   (const StateID destination)					{ return change   (stateId<TOrigin>(), destination);				}
+namespace hfsm2 {
 
-	template <typename TOrigin>
-	HFSM_INLINE bool restart  (const StateID destination)					{ return restart  (stateId<TOrigin>(), destination);				}
+////////////////////////////////////////////////////////////////////////////////
 
-	template <typename TOrigin>
-	HFSM_INLINE bool resume   (const StateID destination)					{ return resume   (stateId<TOrigin>(), destination);				}
+template <LongIndex NT>
+WorkStealingExecutorT<NT>::WorkStealingExecutorT() {
+	for (LongIndex thread = 1; thread < THREAD_COUNT; ++thread)
+		_threads[thread] = std::thread{&WorkStealingExecutorT::work, this, thread};
+}
 
-	template <typename TOrigin>
-	HFSM_INLINE bool utilize  (const StateID destination)					{ return utilize  (stateId<TOrigin>(), destination);				}
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <typename TOrigin>
-	HFSM_INLINE bool randomize(const StateID destination)					{ return randomize(stateId<TOrigin>(), destination);				}
+template <LongIndex NT>
+WorkStealingExecutorT<NT>::~WorkStealingExecutorT() {
+	{
+		std::lock_guard<std::mutex> lock{_mutex};
+		_stop = true;
+	}
+	_wake.notify_all();
 
-	template <typename TOrigin>
-	HFSM_INLINE bool schedule (const StateID destination)					{ return schedule (stateId<TOrigin>(), destination);				}
+	for (LongIndex thread = 1; thread < THREAD_COUNT; ++thread)
+		_threads[thread].join();
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-	template <typename TOrigin, typename TDestination>
-	HFSM_INLINE bool change   ()											{ return change   (stateId<TOrigin>(), stateId<TDestination>());	}
+template <LongIndex NT>
+void
+WorkStealingExecutorT<NT>::run(const LongIndex count,
+							   const Task task,
+							   void* const context)
+{
+	if (count == 0)
+		return;
 
-	template <typename TOrigin, typename TDestination>
-	HFSM_INLINE bool restart  ()											{ return restart  (stateId<TOrigin>(), stateId<TDestination>());	}
+	uint32_t current;
 
-	template <typename TOrigin, typename TDestination>
-	HFSM_INLINE bool resume   ()											{ return resume   (stateId<TOrigin>(), stateId<TDestination>());	}
+	{
+		std::lock_guard<std::mutex> lock{_mutex};
 
-	template <typename TOrigin, typename TDestination>
-	HFSM_INLINE bool utilize  ()											{ return utilize  (stateId<TOrigin>(), stateId<TDestination>());	}
+		_task	 = task;
+		_context = context;
+		_pending.store(count, std::memory_order_relaxed);
 
-	template <typename TOrigin, typename TDestination>
-	HFSM_INLINE bool randomize()											{ return randomize(stateId<TOrigin>(), stateId<TDestination>());	}
+		current = ++_generation;
 
-	template <typename TOrigin, typename TDestination>
-	HFSM_INLINE bool schedule ()											{ return schedule (stateId<TOrigin>(), stateId<TDestination>());	}
+		for (LongIndex thread = 0; thread < THREAD_COUNT; ++thread)
+			_slots[thread].range.store(pack(current,
+											(LongIndex) ((uint32_t) count *  thread		 / THREAD_COUNT),
+											(LongIndex) ((uint32_t) count * (thread + 1) / THREAD_COUNT)),
+									   std::memory_order_release);
+	}
+	_wake.notify_all();
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	execute(0, current);
 
-	HFSM_INLINE Iterator first()			{ return Iterator{*this};								}
+	while (_pending.load(std::memory_order_acquire))
+		std::this_thread::yield();
+}
 
-private:
-	void remove(const LongIndex task);
+//------------------------------------------------------------------------------
 
-private:
-	PlanData& _planData;
-	const RegionID _regionId;
-	Bounds& _bounds;
-};
+template <LongIndex NT>
+void
+WorkStealingExecutorT<NT>::work(const LongIndex thread) {
+	uint32_t seen = 0;
 
-////////////////////////////////////////////////////////////////////////////////
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock{_mutex};
+			_wake.wait(lock, [&] { return _stop || _generation != seen; });
 
-}
-}
+			if (_stop)
+				return;
 
-namespace hfsm2 {
-namespace detail {
+			seen = _generation;
+		}
 
-////////////////////////////////////////////////////////////////////////////////
+		execute(thread, seen);
+	}
+}
 
-Status::Status(const Result result_,
-			   const bool outerTransition_)
-	: result{result_}
-	, outerTransition{outerTransition_}
-{}
-
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+template <LongIndex NT>
 void
-Status::clear() {
-	result = NONE;
-	outerTransition = false;
-}
+WorkStealingExecutorT<NT>::execute(const LongIndex thread,
+								   const uint32_t current)
+{
+	LongIndex index;
 
-////////////////////////////////////////////////////////////////////////////////
+	while (pop(thread, current, index) || steal(thread, current, index)) {
+		_task(_context, index);
 
-template <typename TArgs>
-ConstPlanT<TArgs>::Iterator::Iterator(const ConstPlanT& plan)
-	: _plan{plan}
-	, _curr{plan._bounds.first}
-{
-	_next = next();
+		_pending.fetch_sub(1, std::memory_order_acq_rel);
+	}
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TArgs>
-ConstPlanT<TArgs>::Iterator::operator bool() const {
-	HFSM_ASSERT(_curr < ConstPlanT::TASK_CAPACITY || _curr == INVALID_LONG_INDEX);
+template <LongIndex NT>
+bool
+WorkStealingExecutorT<NT>::pop(const LongIndex thread,
+							   const uint32_t current,
+							   LongIndex& index)
+{
+	std::atomic<Range>& own = _slots[thread].range;
 
-	return _curr < ConstPlanT::TASK_CAPACITY;
-}
+	for (Range range = own.load(std::memory_order_acquire);
+		 generation(range) == current && begin(range) < end(range); )
+	{
+		if (own.compare_exchange_weak(range,
+									  pack(current, begin(range) + 1, end(range)),
+									  std::memory_order_acq_rel,
+									  std::memory_order_acquire))
+		{
+			index = begin(range);
 
-//------------------------------------------------------------------------------
+			return true;
+		}
+	}
 
-template <typename TArgs>
-void
-ConstPlanT<TArgs>::Iterator::operator ++() {
-	_curr = _next;
-	_next = next();
+	return false;
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TArgs>
-LongIndex
-ConstPlanT<TArgs>::Iterator::next() const {
-	if (_curr < ConstPlanT::TASK_CAPACITY) {
-		const TaskLink& task = _plan._planData.taskLinks[_curr];
+template <LongIndex NT>
+bool
+WorkStealingExecutorT<NT>::steal(const LongIndex thread,
+								 const uint32_t current,
+								 LongIndex& index)
+{
+	for (LongIndex offset = 1; offset < THREAD_COUNT; ++offset) {
+		std::atomic<Range>& victim = _slots[(thread + offset) % THREAD_COUNT].range;
 
-		return task.next;
-	} else {
-		HFSM_ASSERT(_curr == INVALID_LONG_INDEX);
+		for (Range range = victim.load(std::memory_order_acquire);
+			 generation(range) == current && begin(range) < end(range); )
+		{
+			const LongIndex middle = begin(range) + (end(range) - begin(range)) / 2;
 
-		return INVALID_LONG_INDEX;
+			if (victim.compare_exchange_weak(range,
+											 pack(current, begin(range), middle),
+											 std::memory_order_acq_rel,
+											 std::memory_order_acquire))
+			{
+				// the first stolen task runs now, the rest can be stolen back
+				_slots[thread].range.store(pack(current, middle + 1, end(range)),
+										   std::memory_order_release);
+				_stolen.fetch_add(end(range) - middle, std::memory_order_relaxed);
+
+				index = middle;
+
+				return true;
+			}
+		}
 	}
+
+	return false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TArgs>
-ConstPlanT<TArgs>::ConstPlanT(const PlanData& planData,
-							  const RegionID regionId)
-
-	: _planData{planData}
-	, _bounds{planData.tasksBounds[regionId]}
-{}
+}
 
-//------------------------------------------------------------------------------
+#endif
 
-template <typename TArgs>
-ConstPlanT<TArgs>::operator bool() const {
-	if (_bounds.first < TASK_CAPACITY) {
-		HFSM_ASSERT(_bounds.last < TASK_CAPACITY);
-		return true;
-	} else {
-		HFSM_ASSERT(_bounds.last == INVALID_LONG_INDEX);
-		return false;
-	}
-}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TArgs>
-PlanT<TArgs>::Iterator::Iterator(PlanT& plan)
-	: _plan{plan}
-	, _curr{plan._bounds.first}
-{
-	_next = next();
-}
+namespace hfsm2 {
 
-//------------------------------------------------------------------------------
+enum class Method : ShortIndex {
+	RANK,
+	UTILITY,
+	ENTRY_GUARD,
+	ENTER,
+	REENTER,
+	UPDATE,
+	REACT,
+	EXIT_GUARD,
+	EXIT,
+	PLAN_SUCCEEDED,
+	PLAN_FAILED,
 
-template <typename TArgs>
-PlanT<TArgs>::Iterator::operator bool() const {
-	HFSM_ASSERT(_curr < PlanT::TASK_CAPACITY || _curr == INVALID_LONG_INDEX);
+	COUNT
+};
 
-	return _curr < PlanT::TASK_CAPACITY;
-}
+enum class Transition : ShortIndex {
+	CHANGE,
+	RESTART,
+	RESUME,
+	UTILIZE,
+	RANDOMIZE,
+	SCHEDULE,
 
-//------------------------------------------------------------------------------
+	COUNT
+};
 
-template <typename TArgs>
-void
-PlanT<TArgs>::Iterator::operator ++() {
-	_curr = _next;
-	_next = next();
-}
+enum class StatusEvent : ShortIndex {
+	SUCCEEDED,
+	FAILED,
+
+	COUNT
+};
 
 //------------------------------------------------------------------------------
 
-template <typename TArgs>
-void
-PlanT<TArgs>::Iterator::remove() {
-	_plan.remove(_curr);
-}
+static inline
+const char*
+stateName(const std::type_index stateType) {
+	const char* const raw = stateType.name();
 
-//------------------------------------------------------------------------------
+	#if defined(_MSC_VER)
 
-template <typename TArgs>
-LongIndex
-PlanT<TArgs>::Iterator::next() const {
-	if (_curr < PlanT::TASK_CAPACITY) {
-		const TaskLink& task = _plan._planData.taskLinks[_curr];
+		auto first =
+			raw[0] == 's' ? 7 : // Struct
+			raw[0] == 'c' ? 6 : // Class
+							0;
+		return raw + first;
 
-		return task.next;
-	} else {
-		HFSM_ASSERT(_curr == INVALID_LONG_INDEX);
+	#elif defined(__clang__) || defined(__GNUC__) || defined(__GNUG__)
 
-		return INVALID_LONG_INDEX;
-	}
-}
+		return raw;
 
-////////////////////////////////////////////////////////////////////////////////
+	#else
 
-template <typename TArgs>
-PlanT<TArgs>::PlanT(PlanData& planData,
-					const RegionID regionId)
+		return raw;
 
-	: _planData{planData}
-	, _regionId{regionId}
-	, _bounds{planData.tasksBounds[regionId]}
-{}
+	#endif
+}
 
 //------------------------------------------------------------------------------
 
-template <typename TArgs>
-PlanT<TArgs>::operator bool() const {
-	if (_bounds.first < TASK_CAPACITY) {
-		HFSM_ASSERT(_bounds.last < TASK_CAPACITY);
-		return true;
-	} else {
-		HFSM_ASSERT(_bounds.last == INVALID_LONG_INDEX);
-		return false;
+static inline
+const char*
+methodName(const Method method) {
+	switch (method) {
+		case Method::RANK:				return "rank";
+		case Method::UTILITY:			return "utility";
+		case Method::ENTRY_GUARD:		return "entryGuard";
+		case Method::ENTER:				return "enter";
+		case Method::REENTER:			return "reenter";
+		case Method::UPDATE:			return "update";
+		case Method::REACT:				return "react";
+		case Method::EXIT_GUARD:		return "exitGuard";
+		case Method::EXIT:				return "exit";
+		case Method::PLAN_SUCCEEDED:	return "planSucceeded";
+		case Method::PLAN_FAILED:		return "planFailed";
+
+		default:
+			HFSM_BREAK();
+			return nullptr;
 	}
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TArgs>
-bool
-PlanT<TArgs>::append(const Transition transition,
-					 const StateID origin,
-					 const StateID destination)
-{
-	_planData.planExists.set(_regionId);
-
-	const TaskIndex index = _planData.taskLinks.emplace(transition, origin, destination);
-	if (index == TaskLinks::INVALID)
-		return false;
+static inline
+const char*
+transitionName(const Transition transition) {
+	switch (transition) {
+		case Transition::CHANGE:		return "changeTo";
+		case Transition::RESTART:		return "restart";
+		case Transition::RESUME:		return "resume";
+		case Transition::UTILIZE:		return "utilize";
+		case Transition::RANDOMIZE:		return "randomize";
+		case Transition::SCHEDULE:		return "schedule";
 
-	if (_bounds.first < TaskLinks::CAPACITY) {
-		HFSM_ASSERT(_bounds.last < TaskLinks::CAPACITY);
+		default:
+			HFSM_BREAK();
+			return nullptr;
+	}
+}
 
-		auto& last  = _planData.taskLinks[_bounds.last];
-		last.next = index;
+////////////////////////////////////////////////////////////////////////////////
 
-		auto& next = _planData.taskLinks[index];
-		next.prev  = _bounds.last;
+}
 
-		_bounds.last = index;
-	} else {
-		HFSM_ASSERT(_bounds.first == INVALID_LONG_INDEX &&
-					_bounds.last  == INVALID_LONG_INDEX);
+#if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
 
-		_bounds.first = index;
-		_bounds.last  = index;
-	}
+namespace hfsm2 {
 
-	return true;
-}
+////////////////////////////////////////////////////////////////////////////////
 
-//------------------------------------------------------------------------------
+template <typename TUtilty = float>
+struct LoggerInterfaceT {
+	using Utilty	  = TUtilty;
 
-template <typename TArgs>
-void
-PlanT<TArgs>::clear() {
-	if (_bounds.first < TaskLinks::CAPACITY) {
-		HFSM_ASSERT(_bounds.last < TaskLinks::CAPACITY);
+	using Method	  = ::hfsm2::Method;
+	using StateID	  = ::hfsm2::StateID;
+	using RegionID	  = ::hfsm2::RegionID;
+	using Transition  = ::hfsm2::Transition;
+	using StatusEvent = ::hfsm2::StatusEvent;
 
-		for (LongIndex index = _bounds.first;
-			 index != INVALID_LONG_INDEX;
-			 )
-		{
-			HFSM_ASSERT(index < TaskLinks::CAPACITY);
+	virtual void recordMethod(const StateID /*origin*/,
+							  const Method /*method*/)
+	{}
 
-			const auto& task = _planData.taskLinks[index];
-			HFSM_ASSERT(index == _bounds.first ?
-				   task.prev == INVALID_LONG_INDEX :
-				   task.prev <  TaskLinks::CAPACITY);
+	virtual void recordTransition(const StateID /*origin*/,
+								  const Transition /*transition*/,
+								  const StateID /*target*/)
+	{}
 
-			const LongIndex next = task.next;
+	virtual void recordTaskStatus(const RegionID /*region*/,
+								  const StateID /*origin*/,
+								  const StatusEvent /*event*/)
+	{}
 
-			_planData.taskLinks.remove(index);
+	virtual void recordPlanStatus(const RegionID /*region*/,
+								  const StatusEvent /*event*/)
+	{}
 
-			index = next;
-		}
+	virtual void recordCancelledPending(const StateID /*origin*/) {}
 
-		_bounds.first = INVALID_LONG_INDEX;
-		_bounds.last  = INVALID_LONG_INDEX;
-	} else
-		HFSM_ASSERT(_bounds.first == INVALID_LONG_INDEX &&
-			   _bounds.last  == INVALID_LONG_INDEX);
-}
+	virtual void recordUtilityResolution(const StateID /*head*/,
+										 const StateID /*prong*/,
+										 const Utilty /*utilty*/)
+	{}
+
+	virtual void recordRandomResolution(const StateID /*head*/,
+										const StateID /*prong*/,
+										const Utilty /*utilty*/)
+	{}
+};
+
+using LoggerInterface = LoggerInterfaceT<float>;
 
 //------------------------------------------------------------------------------
+// statically dispatched counterpart of 'LoggerInterfaceT<>', plugged in with
+// 'Config::LoggerT<>': derived loggers hide the methods they need,
+// calls to the rest are inlined into nothing
 
-template <typename TArgs>
-void
-PlanT<TArgs>::remove(const LongIndex task) {
-	HFSM_ASSERT(_planData.planExists.get(_regionId) &&
-				_bounds.first < TaskLinks::CAPACITY &&
-				_bounds.last  < TaskLinks::CAPACITY);
+template <typename TUtilty = float>
+struct StaticLoggerT {
+	using Utilty	  = TUtilty;
 
-	HFSM_ASSERT(task < TaskLinks::CAPACITY);
+	using Method	  = ::hfsm2::Method;
+	using StateID	  = ::hfsm2::StateID;
+	using RegionID	  = ::hfsm2::RegionID;
+	using Transition  = ::hfsm2::Transition;
+	using StatusEvent = ::hfsm2::StatusEvent;
 
-	const TaskLink& curr = _planData.taskLinks[task];
+	HFSM_INLINE void recordMethod(const StateID /*origin*/,
+								  const Method /*method*/)
+	{}
 
-	if (curr.prev < TaskLinks::CAPACITY) {
-		TaskLink& prev = _planData.taskLinks[curr.prev];
-		prev.next = curr.next;
-	} else {
-		HFSM_ASSERT(_bounds.first == task);
-		_bounds.first = curr.next;
-	}
+	HFSM_INLINE void recordTransition(const StateID /*origin*/,
+									  const Transition /*transition*/,
+									  const StateID /*target*/)
+	{}
 
-	if (curr.next < TaskLinks::CAPACITY) {
-		TaskLink& next = _planData.taskLinks[curr.next];
-		next.prev = curr.prev;
-	} else {
-		HFSM_ASSERT(_bounds.last == task);
-		_bounds.last = curr.prev;
-	}
+	HFSM_INLINE void recordTaskStatus(const RegionID /*region*/,
+									  const StateID /*origin*/,
+									  const StatusEvent /*event*/)
+	{}
 
-	_planData.taskLinks.remove(task);
-}
+	HFSM_INLINE void recordPlanStatus(const RegionID /*region*/,
+									  const StatusEvent /*event*/)
+	{}
+
+	HFSM_INLINE void recordCancelledPending(const StateID /*origin*/) {}
+
+	HFSM_INLINE void recordUtilityResolution(const StateID /*head*/,
+											 const StateID /*prong*/,
+											 const Utilty /*utilty*/)
+	{}
+
+	HFSM_INLINE void recordRandomResolution(const StateID /*head*/,
+											const StateID /*prong*/,
+											const Utilty /*utilty*/)
+	{}
+};
+
+using StaticLogger = StaticLoggerT<float>;
 
 ////////////////////////////////////////////////////////////////////////////////
 
 }
-}
+
+#else
 
 namespace hfsm2 {
-namespace detail {
 
-//------------------------------------------------------------------------------
+template <typename = float>
+using LoggerInterfaceT = void;
 
-enum Strategy {
-	Composite,
-	Resumable,
-	Utilitarian,
-	RandomUtil,
-};
+template <typename = float>
+using StaticLoggerT = void;
 
-////////////////////////////////////////////////////////////////////////////////
+}
 
-#pragma pack(push, 1)
+#endif
 
-struct alignas(2 * sizeof(ShortIndex)) Parent {
-	HFSM_INLINE Parent() = default;
+namespace hfsm2 {
+namespace detail {
 
-	HFSM_INLINE Parent(const ForkID forkId_)
-		: forkId{forkId_}
-	{}
+////////////////////////////////////////////////////////////////////////////////
+// ring buffer of the calls made into a machine - update(), react(), queue(),
+// flush(), external transitions - and of the random draws they led to;
+// replay() feeds the recording into another machine, substituting the recorded
+// draws, and checks the active states after every call against the original
 
-	HFSM_INLINE Parent(const ForkID forkId_,
-					   const ShortIndex prong_)
-		: forkId{forkId_}
-		, prong{prong_}
-	{}
+template <typename TEvents,
+		  typename TPayload,
+		  typename TUtility>
+class ReplayRecorderT;
 
-	HFSM_INLINE explicit operator bool() const {
-		return forkId != INVALID_FORK_ID &&
-			   prong  != INVALID_SHORT_INDEX;
-	}
+template <typename... TEvents,
+		  typename TPayload,
+		  typename TUtility>
+class ReplayRecorderT<TL_<TEvents...>, TPayload, TUtility> {
+	template <typename, typename>
+	friend class R_;
 
-	ForkID	   forkId = INVALID_FORK_ID;
-	ShortIndex prong  = INVALID_SHORT_INDEX;
-};
+	template <typename>
+	friend class ControlT;
 
-#pragma pack(pop)
+	using Events	= ITL_<TEvents...>;
+	using Payload	= TPayload;
+	using Utility	= TUtility;
 
-////////////////////////////////////////////////////////////////////////////////
+	static constexpr LongIndex SIZE		 = MaxT<sizeof (Payload), sizeof (Utility), sizeof (TEvents)...>::VALUE;
+	static constexpr LongIndex ALIGNMENT = MaxT<alignof(Payload), alignof(Utility), alignof(TEvents)...>::VALUE;
 
-template <typename TPayload>
-struct RequestT {
-	using Payload = TPayload;
+	template <typename TReceiver>
+	using Thunk = void (*)(TReceiver&, const void*);
 
-	enum Type {
-		REMAIN,
-		CHANGE,
-		RESTART,
-		RESUME,
-		UTILIZE,
-		RANDOMIZE,
-		SCHEDULE,
+	// move-only payloads are not recorded
+	template <typename T>
+	using Storable = std::integral_constant<bool, std::is_copy_constructible<T>::value &&
+												  std::is_trivially_destructible<T>::value>;
 
-		COUNT
+public:
+	enum class Kind : ShortIndex {
+		UPDATE,
+		REACT,
+		QUEUE,
+		FLUSH,
+		TRANSITION,
+		PAYLOAD_TRANSITION,
+		RANDOM,
 	};
 
-	HFSM_INLINE RequestT() = default;
-
-	HFSM_INLINE RequestT(const Type type_,
-						 const StateID stateId_)
-		: type{type_}
-		, stateId{stateId_}
-	{
-		HFSM_ASSERT(type_ < Type::COUNT);
-	}
+	// 'type' is the event index in 'Config::EventsT<>' or a 'Transition',
+	// INVALID_SHORT_INDEX for events that could not be recorded
+	struct Record {
+		Kind kind;
+		ShortIndex type;
+		StateID stateId;
+		uint32_t check;
 
-	HFSM_INLINE RequestT(const Type type_,
-						 const StateID stateId_,
-						 const Payload& payload_)
-		: type{type_}
-		, stateId{stateId_}
-		, payload{payload_}
-	{
-		HFSM_ASSERT(type_ < Type::COUNT);
-	}
+		alignas(ALIGNMENT) unsigned char bytes[SIZE];
+	};
 
-	Type type = CHANGE;
-	StateID stateId = INVALID_STATE_ID;
-	Payload payload;
-};
+protected:
+	HFSM_INLINE ReplayRecorderT(Record* const records,
+								const LongIndex capacity)
+		: _records{records}
+		, _capacity{capacity}
+	{}
 
-template <typename TPayload, ShortIndex NCount>
-using RequestsT = Array<RequestT<TPayload>, NCount>;
+public:
+	ReplayRecorderT(const ReplayRecorderT&) = delete;
+	ReplayRecorderT& operator = (const ReplayRecorderT&) = delete;
 
-////////////////////////////////////////////////////////////////////////////////
+	// to replay a trimmed log, start from a snapshot saved when it was cleared
+	HFSM_INLINE void clear()							{ _head = 0; _count = 0; _dropped = 0;	}
 
-template <LongIndex NCompoCount, LongIndex NOrthoCount, LongIndex NOrthoUnits>
-struct AllForksT {
-	static constexpr ShortIndex COMPO_REGIONS = NCompoCount;
-	static constexpr ShortIndex ORTHO_REGIONS = NOrthoCount;
-	static constexpr ShortIndex ORTHO_UNITS	  = NOrthoUnits;
+	HFSM_INLINE LongIndex count()	const				{ return _count;						}
+	HFSM_INLINE uint32_t  dropped() const				{ return _dropped;						}
 
-	using Compo = StaticArray<ShortIndex, COMPO_REGIONS>;
-	using Ortho = BitArray<ShortIndex, ORTHO_REGIONS>;
+	HFSM_INLINE const Record& operator[] (const LongIndex i) const;
 
-	Compo compo{INVALID_SHORT_INDEX};
-	Ortho ortho;
+	// returns the number of records reproduced faithfully,
+	// equal to count() if the replay matched the recording
+	template <typename TMachine>
+	LongIndex replay(TMachine& machine);
 
-	HFSM_INLINE void clear();
-};
+	template <typename TStates>
+	static HFSM_INLINE uint32_t checksum(const TStates& states);
 
-////////////////////////////////////////////////////////////////////////////////
+private:
+	HFSM_INLINE Record* recordUpdate()											{ return record(Kind::UPDATE);	}
+	HFSM_INLINE Record* recordFlush()											{ return record(Kind::FLUSH);	}
 
-template <typename,
-		  typename,
-		  typename,
-		  typename,
-		  LongIndex,
-		  LongIndex,
-		  LongIndex,
-		  typename,
-		  LongIndex>
-struct ArgsT;
+	template <typename TEvent>
+	HFSM_INLINE Record* recordEvent(const Kind kind, const TEvent& event);
 
-template <typename>
-struct StateRegistryT;
+	HFSM_INLINE void recordTransition(const Transition transition, const StateID stateId);
+	HFSM_INLINE void recordTransition(const Transition transition, const StateID stateId, const Payload& payload);
 
-//------------------------------------------------------------------------------
+	template <typename TStates>
+	HFSM_INLINE void seal(Record* const record, const TStates& states);
 
-template <typename TContext,
-		  typename TConfig,
-		  typename TStateList,
-		  typename TRegionList,
-		  LongIndex NCompoCount,
-		  LongIndex NOrthoCount,
-		  LongIndex NOrthoUnits,
-		  typename TPayload,
-		  LongIndex NTaskCapacity>
-struct StateRegistryT<ArgsT<TContext,
-							TConfig,
-							TStateList,
-							TRegionList,
-							NCompoCount,
-							NOrthoCount,
-							NOrthoUnits,
-							TPayload,
-							NTaskCapacity>>
-{
-	using StateList		= TStateList;
-	using RegionList	= TRegionList;
-	using Payload		= TPayload;
+	template <typename TRandom>
+	HFSM_INLINE Utility draw(TRandom& random);
 
-	using Request		= RequestT<Payload>;
+	HFSM_INLINE Record* record(const Kind kind);
 
-	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
-	static constexpr ShortIndex COMPO_REGIONS = NCompoCount;
-	static constexpr ShortIndex ORTHO_REGIONS = NOrthoCount;
-	static constexpr ShortIndex ORTHO_UNITS	  = NOrthoUnits;
+	template <typename T>
+	static HFSM_INLINE
+	typename std::enable_if< Storable<T>::value, bool>::type
+	store(Record& record, const T& value)				{ new (&record.bytes) T(value); return true;	}
 
-	using StateParents	= StaticArray<Parent, STATE_COUNT>;
+	template <typename T>
+	static HFSM_INLINE
+	typename std::enable_if<!Storable<T>::value, bool>::type
+	store(Record&, const T&)							{ return false;									}
 
-	using CompoParents	= StaticArray<Parent, COMPO_REGIONS>;
-	using OrthoParents	= StaticArray<Parent, ORTHO_REGIONS>;
-	using OrthoUnits	= StaticArray<Units,  ORTHO_REGIONS>;
+	template <typename TEvent>
+	static HFSM_INLINE
+	typename std::enable_if< Events::template contains<TEvent>(), ShortIndex>::type
+	storeEvent(Record& record, const TEvent& event)		{ return store(record, event) ? (ShortIndex) Events::template index<TEvent>() : INVALID_SHORT_INDEX;	}
 
-	using CompoForks	= StaticArray<ShortIndex, COMPO_REGIONS>;
-	using AllForks		= AllForksT<COMPO_REGIONS, ORTHO_REGIONS, ORTHO_UNITS>;
-	using OrthoBits		= typename AllForks::Ortho::Bits;
+	template <typename TEvent>
+	static HFSM_INLINE
+	typename std::enable_if<!Events::template contains<TEvent>(), ShortIndex>::type
+	storeEvent(Record&, const TEvent&)					{ return INVALID_SHORT_INDEX;					}
 
-	using CompoRemains	= BitArray<ShortIndex, COMPO_REGIONS>;
+	template <typename T>
+	static HFSM_INLINE const T& load(const Record& record)		{ return *reinterpret_cast<const T*>(&record.bytes);	}
 
-	bool isActive		(const StateID stateId) const;
-	bool isResumable	(const StateID stateId) const;
+	template <typename TMachine>
+	static void replayTransition(TMachine& machine, const Record& record);
 
-	bool isPendingChange(const StateID stateId) const;
-	bool isPendingEnter	(const StateID stateId) const;
-	bool isPendingExit	(const StateID stateId) const;
+	template <typename TReceiver, typename TEvent>
+	static void thunk(TReceiver& receiver, const void* const event)		{ receiver(*static_cast<const TEvent*>(event));	}
 
-	HFSM_INLINE const Parent&	  forkParent(const ForkID forkId) const;
+	template <typename TMachine>
+	struct Reactor {
+		template <typename TEvent>
+		HFSM_INLINE void operator () (const TEvent& event)				{ machine.react(event);	}
 
-	HFSM_INLINE OrthoBits resumableOrthoFork(const ForkID forkId);
-	HFSM_INLINE OrthoBits requestedOrthoFork(const ForkID forkId);
+		TMachine& machine;
+	};
 
-	bool requestImmediate(const Request request);
-	void requestScheduled(const StateID stateId);
+	template <typename TMachine>
+	struct Queuer {
+		template <typename TEvent>
+		HFSM_INLINE void operator () (const TEvent& event)				{ machine.queue(event);	}
 
-	void clearRequests();
+		TMachine& machine;
+	};
 
-	StateParents stateParents;
-	CompoParents compoParents;
-	OrthoParents orthoParents;
-	OrthoUnits orthoUnits;
+private:
+	Record* const _records;
+	const LongIndex _capacity;
 
-	CompoForks compoActive{INVALID_SHORT_INDEX};
-	AllForks resumable;
+	LongIndex _head  = 0;
+	LongIndex _count = 0;
+	uint32_t _dropped = 0;
 
-	AllForks requested;
-	CompoRemains compoRemains;
+	bool _replaying = false;
+	bool _diverged	= false;
+	LongIndex _cursor = 0;
 };
 
 //------------------------------------------------------------------------------
 
-template <typename TContext,
-		  typename TConfig,
-		  typename TStateList,
-		  typename TRegionList,
-		  LongIndex NCompoCount,
+template <typename TEvents,
 		  typename TPayload,
-		  LongIndex NTaskCapacity>
-struct StateRegistryT<ArgsT<TContext,
-							TConfig,
-							TStateList,
-							TRegionList,
-							NCompoCount,
-							0,
-							0,
-							TPayload,
-							NTaskCapacity>>
+		  typename TUtility,
+		  LongIndex NCapacity>
+class ReplayLogT final
+	: public ReplayRecorderT<TEvents, TPayload, TUtility>
 {
-	using StateList		= TStateList;
-	using RegionList	= TRegionList;
-	using Payload		= TPayload;
-	using Request		= RequestT<Payload>;
-
-	static constexpr LongIndex  STATE_COUNT = StateList::SIZE;
-	static constexpr ShortIndex COMPO_REGIONS = NCompoCount;
-
-	using StateParents	= StaticArray<Parent, STATE_COUNT>;
-	using CompoParents	= StaticArray<Parent, COMPO_REGIONS>;
-
-	using CompoForks	= StaticArray<ShortIndex, COMPO_REGIONS>;
-	using AllForks		= AllForksT<COMPO_REGIONS, 0, 0>;
-	using CompoRemains	= BitArray<ShortIndex, COMPO_REGIONS>;
-
-	bool isActive		(const StateID stateId) const;
-	bool isResumable	(const StateID stateId) const;
+	using Recorder = ReplayRecorderT<TEvents, TPayload, TUtility>;
+	using Record   = typename Recorder::Record;
 
-	bool isPendingChange(const StateID stateId) const;
-	bool isPendingEnter	(const StateID stateId) const;
-	bool isPendingExit	(const StateID stateId) const;
-
-	HFSM_INLINE const Parent& forkParent(const ForkID forkId) const;
-
-	bool requestImmediate(const Request request);
-	void requestScheduled(const StateID stateId);
-
-	void clearRequests();
+public:
+	static constexpr LongIndex CAPACITY = NCapacity;
 
-	StateParents stateParents;
-	CompoParents compoParents;
+	static_assert(CAPACITY > 0 && CAPACITY < INVALID_LONG_INDEX, "Invalid replay log capacity");
 
-	CompoForks compoActive{INVALID_SHORT_INDEX};
-	AllForks resumable;
+	HFSM_INLINE ReplayLogT()
+		: Recorder{_storage, CAPACITY}
+	{}
 
-	AllForks requested;
-	CompoRemains compoRemains;
+private:
+	Record _storage[CAPACITY];
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2981,384 +3217,405 @@ struct StateRegistryT<ArgsT<TContext,
 }
 }
 
-
 namespace hfsm2 {
 namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <LongIndex NCC, LongIndex NOC, LongIndex NOU>
-void
-AllForksT<NCC, NOC, NOU>::clear() {
-	compo.fill(INVALID_SHORT_INDEX);
-	ortho.clear();
+template <typename... TE, typename TP, typename TU>
+const typename ReplayRecorderT<TL_<TE...>, TP, TU>::Record&
+ReplayRecorderT<TL_<TE...>, TP, TU>::operator[] (const LongIndex i) const {
+	HFSM_ASSERT(i < _count);
+
+	const LongIndex first = _count < _capacity ? 0 : _head;
+
+	return _records[first + i < _capacity ? first + i : first + i - _capacity];
 }
 
-////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::isActive(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
+template <typename... TE, typename TP, typename TU>
+template <typename TMachine>
+LongIndex
+ReplayRecorderT<TL_<TE...>, TP, TU>::replay(TMachine& machine) {
+	static const Thunk<Reactor<TMachine>> REACTORS[] = { &thunk<Reactor<TMachine>, TE>..., nullptr };
+	static const Thunk<Queuer <TMachine>> QUEUERS [] = { &thunk<Queuer <TMachine>, TE>..., nullptr };
 
-			if (parent.forkId > 0)
-				return parent.prong == compoActive[parent.forkId - 1];
-		}
+	if (_dropped)
+		return 0;
 
-	return true;
-}
+	Reactor<TMachine> reactor{machine};
+	Queuer <TMachine> queuer {machine};
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	_replaying = true;
+	_diverged  = false;
+	machine.attachRecorder(this);
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::isResumable(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
+	LongIndex replayed = 0;
 
-			if (parent.forkId > 0)
-				return parent.prong == resumable.compo[parent.forkId - 1];
-		}
+	for (_cursor = 0; _cursor < _count && !_diverged; ) {
+		const Record& record = (*this)[_cursor++];
 
-	return false;
-}
+		switch (record.kind) {
+		case Kind::UPDATE:
+			machine.update();
+			break;
 
-//------------------------------------------------------------------------------
+		case Kind::REACT:
+			if (record.type < Events::SIZE)
+				REACTORS[record.type](reactor, &record.bytes);
+			else
+				_diverged = true;
+			break;
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::isPendingChange(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
+		case Kind::QUEUE:
+			if (record.type < Events::SIZE)
+				QUEUERS[record.type](queuer, &record.bytes);
+			else
+				_diverged = true;
+			break;
 
-			if (parent.forkId > 0)
-				return requested.compo[parent.forkId - 1] !=
-						   compoActive[parent.forkId - 1];
-		}
+		case Kind::FLUSH:
+			machine.flush();
+			break;
 
-	return true;
-}
+		case Kind::TRANSITION:
+		case Kind::PAYLOAD_TRANSITION:
+			if (record.type < (ShortIndex) Transition::COUNT)
+				replayTransition(machine, record);
+			else
+				_diverged = true;
+			break;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		default:
+			// a draw the replayed machine never asked for
+			_diverged = true;
+		}
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::isPendingEnter(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
+		if (record.kind != Kind::TRANSITION &&
+			record.kind != Kind::PAYLOAD_TRANSITION)
 		{
-			HFSM_ASSERT(parent.forkId != 0);
+			typename TMachine::ActiveStates states;
+			machine.copyActiveStates(states);
 
-			if (parent.forkId > 0)
-				return parent.prong !=	   compoActive[parent.forkId - 1] &&
-					   parent.prong == requested.compo[parent.forkId - 1];
+			_diverged |= record.check != checksum(states);
 		}
 
-	return true;
+		if (!_diverged)
+			replayed = _cursor;
+	}
+
+	machine.attachRecorder(nullptr);
+	_replaying = false;
+
+	return replayed;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::isPendingExit(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
+template <typename... TE, typename TP, typename TU>
+template <typename TStates>
+uint32_t
+ReplayRecorderT<TL_<TE...>, TP, TU>::checksum(const TStates& states) {
+	uint32_t hash = 2166136261u;
 
-			if (parent.forkId > 0)
-				return parent.prong ==	   compoActive[parent.forkId - 1] &&
-					   parent.prong != requested.compo[parent.forkId - 1];
-		}
+	for (LongIndex i = states.first(); i < TStates::CAPACITY; i = states.next(i))
+		hash = (hash ^ i) * 16777619u;
 
-	return true;
+	return hash;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-const Parent&
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::forkParent(const ForkID forkId) const {
-	HFSM_ASSERT(forkId != 0);
+template <typename... TE, typename TP, typename TU>
+template <typename TEvent>
+typename ReplayRecorderT<TL_<TE...>, TP, TU>::Record*
+ReplayRecorderT<TL_<TE...>, TP, TU>::recordEvent(const Kind kind,
+												 const TEvent& event)
+{
+	Record* const record = this->record(kind);
 
-	return forkId > 0 ?
-		compoParents[ forkId - 1] :
-		orthoParents[-forkId - 1];
-}
+	if (record)
+		record->type = storeEvent(*record, event);
 
-//------------------------------------------------------------------------------
+	return record;
+}
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-typename StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::OrthoBits
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::resumableOrthoFork(const ForkID forkId) {
-	HFSM_ASSERT(forkId < 0);
-	const Units& units = orthoUnits[-forkId - 1];
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	return resumable.ortho.bits(units);
+template <typename... TE, typename TP, typename TU>
+void
+ReplayRecorderT<TL_<TE...>, TP, TU>::recordTransition(const Transition transition,
+													  const StateID stateId)
+{
+	if (Record* const record = this->record(Kind::TRANSITION)) {
+		record->type	= (ShortIndex) transition;
+		record->stateId = stateId;
+	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-typename StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::OrthoBits
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::requestedOrthoFork(const ForkID forkId) {
-	HFSM_ASSERT(forkId < 0);
-	const Units& units = orthoUnits[-forkId - 1];
+template <typename... TE, typename TP, typename TU>
+void
+ReplayRecorderT<TL_<TE...>, TP, TU>::recordTransition(const Transition transition,
+													  const StateID stateId,
+													  const Payload& payload)
+{
+	if (Record* const record = this->record(Kind::PAYLOAD_TRANSITION)) {
+		record->type	= store(*record, payload) ? (ShortIndex) transition : INVALID_SHORT_INDEX;
+		record->stateId = stateId;
+	}
+}
 
-	return requested.ortho.bits(units);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename... TE, typename TP, typename TU>
+template <typename TStates>
+void
+ReplayRecorderT<TL_<TE...>, TP, TU>::seal(Record* const record,
+										  const TStates& states)
+{
+	if (record)
+		record->check = checksum(states);
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::requestImmediate(const Request request) {
-	if (request.stateId == 0)
-		return false;
-	else if (HFSM_CHECKED(request.stateId < STATE_COUNT)) {
-		Parent parent;
+template <typename... TE, typename TP, typename TU>
+template <typename TRandom>
+typename ReplayRecorderT<TL_<TE...>, TP, TU>::Utility
+ReplayRecorderT<TL_<TE...>, TP, TU>::draw(TRandom& random) {
+	if (_replaying) {
+		if (_cursor < _count) {
+			const Record& record = (*this)[_cursor];
 
-		for (parent = stateParents[request.stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			if (parent.forkId > 0) {
-				requested.compo[parent.forkId - 1] = parent.prong;
-				parent = forkParent(parent.forkId);
+			if (record.kind == Kind::RANDOM) {
+				++_cursor;
 
-				break;
-			} else if (parent.forkId < 0)
-				requestedOrthoFork(parent.forkId).set(parent.prong);
-			else
-				HFSM_BREAK();
+				return load<Utility>(record);
+			}
 		}
 
-		for (; parent; parent = forkParent(parent.forkId)) {
-			if (parent.forkId > 0) {
-				compoRemains.set(parent.forkId - 1);
+		_diverged = true;
 
-				if (	compoActive[parent.forkId - 1] != parent.prong)
-					requested.compo[parent.forkId - 1]  = parent.prong;
-				else {
-					parent = forkParent(parent.forkId);
-					break;
-				}
-			} else if (parent.forkId < 0)
-				requestedOrthoFork(parent.forkId).set(parent.prong);
-			else
-				HFSM_BREAK();
-		}
+		return random.next();
+	} else {
+		const Utility value = random.next();
 
-		for (; parent; parent = forkParent(parent.forkId)) {
-			if (parent.forkId > 0)
-				compoRemains.set(parent.forkId - 1);
-			else if (parent.forkId < 0)
-				requestedOrthoFork(parent.forkId).set(parent.prong);
-			else
-				HFSM_BREAK();
-		}
-	}
+		if (Record* const record = this->record(Kind::RANDOM))
+			store(*record, value);
 
-	return true;
+		return value;
+	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
-void
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::requestScheduled(const StateID stateId) {
-	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
-		const Parent parent = stateParents[stateId];
+template <typename... TE, typename TP, typename TU>
+typename ReplayRecorderT<TL_<TE...>, TP, TU>::Record*
+ReplayRecorderT<TL_<TE...>, TP, TU>::record(const Kind kind) {
+	if (_replaying)
+		return nullptr;
 
-		if (parent.forkId > 0)
-			resumable.compo[parent.forkId - 1] = parent.prong;
-		else if (parent.forkId < 0)
-			resumableOrthoFork(parent.forkId).set(parent.prong);
-		else
-			HFSM_BREAK();
-	}
+	Record& record = _records[_head];
+	_head = _head + 1 < _capacity ? _head + 1 : 0;
+
+	if (_count < _capacity)
+		++_count;
+	else
+		++_dropped;
+
+	record.kind	   = kind;
+	record.type	   = INVALID_SHORT_INDEX;
+	record.stateId = INVALID_STATE_ID;
+	record.check   = 0;
+
+	return &record;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC>
+template <typename... TE, typename TP, typename TU>
+template <typename TMachine>
 void
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC>>::clearRequests() {
-	compoRemains.clear();
-	requested.clear();
-}
+ReplayRecorderT<TL_<TE...>, TP, TU>::replayTransition(TMachine& machine,
+													  const Record& record)
+{
+	const StateID stateId = record.stateId;
 
-////////////////////////////////////////////////////////////////////////////////
+	if (record.kind == Kind::TRANSITION)
+		switch ((Transition) record.type) {
+		case Transition::CHANGE:	machine.changeTo (stateId);	break;
+		case Transition::RESTART:	machine.restart	 (stateId);	break;
+		case Transition::RESUME:	machine.resume	 (stateId);	break;
+		case Transition::UTILIZE:	machine.utilize	 (stateId);	break;
+		case Transition::RANDOMIZE:	machine.randomize(stateId);	break;
+		case Transition::SCHEDULE:	machine.schedule (stateId);	break;
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isActive(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
-		if (Parent parent = stateParents[stateId]) {
-			HFSM_ASSERT(parent.forkId > 0);
+		default:
+			HFSM_BREAK();
+		}
+	else {
+		const Payload& payload = load<Payload>(record);
 
-			return parent.prong == compoActive[parent.forkId - 1];
-		} else
-			return true;
-	}
+		switch ((Transition) record.type) {
+		case Transition::CHANGE:	machine.changeTo (stateId, payload);	break;
+		case Transition::RESTART:	machine.restart	 (stateId, payload);	break;
+		case Transition::RESUME:	machine.resume	 (stateId, payload);	break;
+		case Transition::UTILIZE:	machine.utilize	 (stateId, payload);	break;
+		case Transition::RANDOMIZE:	machine.randomize(stateId, payload);	break;
+		case Transition::SCHEDULE:	machine.schedule (stateId, payload);	break;
 
-	return false;
+		default:
+			HFSM_BREAK();
+		}
+	}
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isResumable(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		if (Parent parent = stateParents[stateId]) {
-			HFSM_ASSERT(parent.forkId > 0);
+}
+}
 
-			return parent.prong == resumable.compo[parent.forkId - 1];
-		}
+namespace hfsm2 {
 
-	return false;
-}
+////////////////////////////////////////////////////////////////////////////////
+// default clock for 'Config::ProfilerT<>', in CPU cycles where available
+
+struct CycleClock {
+	static HFSM_INLINE uint64_t now() {
+	#if defined _MSC_VER && (defined _M_X64 || defined _M_IX86)
+		return __rdtsc();
+	#elif defined __GNUC__ && (defined __x86_64__ || defined __i386__)
+		return __builtin_ia32_rdtsc();
+	#else
+		return (uint64_t) std::chrono::steady_clock::now().time_since_epoch().count();
+	#endif
+	}
+};
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isPendingChange(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		if (Parent parent = stateParents[stateId]) {
-			HFSM_ASSERT(parent.forkId > 0);
+struct MethodProfile {
+	uint64_t calls = 0;
+	uint64_t ticks = 0;
+};
 
-			return requested.compo[parent.forkId - 1] !=
-					   compoActive[parent.forkId - 1];
-		}
+namespace detail {
 
-	return false;
-}
+////////////////////////////////////////////////////////////////////////////////
+// per-state, per-method call counts and cumulative time;
+// with no clock in the config, samples are empty and compile away
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TClock,
+		  LongIndex NStateCount>
+class ProfilerT final {
+	static constexpr ShortIndex METHOD_COUNT = (ShortIndex) Method::COUNT;
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isPendingEnter(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		if (Parent parent = stateParents[stateId]) {
-			HFSM_ASSERT(parent.forkId > 0);
+public:
+	using Clock = TClock;
 
-			return parent.prong !=	   compoActive[parent.forkId - 1] &&
-				   parent.prong == requested.compo[parent.forkId - 1];
-		}
+	static constexpr LongIndex STATE_COUNT = NStateCount;
 
-	return false;
-}
+	class Sample {
+	public:
+		HFSM_INLINE Sample(ProfilerT* const profiler,
+						   const StateID stateId,
+						   const Method method)
+			: _profiler{profiler}
+			, _stateId{stateId}
+			, _method{method}
+			, _start{Clock::now()}
+		{}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		HFSM_INLINE ~Sample();
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::isPendingExit(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		if (Parent parent = stateParents[stateId]) {
-			HFSM_ASSERT(parent.forkId > 0);
+	private:
+		ProfilerT* const _profiler;
+		const StateID _stateId;
+		const Method _method;
+		const uint64_t _start;
+	};
 
-			return parent.prong ==	   compoActive[parent.forkId - 1] &&
-				   parent.prong != requested.compo[parent.forkId - 1];
-		}
+public:
+	HFSM_INLINE ProfilerT()												{ clear();	}
 
-	return false;
-}
+	HFSM_INLINE void clear();
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE const MethodProfile& get(const StateID stateId,
+										 const Method method) const;
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
-const Parent&
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::forkParent(const ForkID forkId) const {
-	HFSM_ASSERT(forkId > 0);
+	// calls 'receiver(stateId, method, profile)' for every method called
+	template <typename TReceiver>
+	void report(TReceiver& receiver) const;
 
-	return compoParents[forkId - 1];
-}
+private:
+	MethodProfile _profiles[STATE_COUNT][METHOD_COUNT];
+};
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
-bool
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::requestImmediate(const Request request) {
-	if (request.stateId == 0)
-		return false;
-	else if (HFSM_CHECKED(request.stateId < STATE_COUNT)) {
-		Parent parent = stateParents[request.stateId];
+template <LongIndex NStateCount>
+class ProfilerT<void, NStateCount> final {
+public:
+	struct Sample {
+		HFSM_INLINE Sample(ProfilerT* const, const StateID, const Method)	{}
+	};
+};
 
-		if (HFSM_CHECKED(parent)) {
-			HFSM_ASSERT(parent.forkId > 0);
+////////////////////////////////////////////////////////////////////////////////
+// profiler pointer carried by controls,
+// with no clock in the config it takes no space
 
-			requested.compo[parent.forkId - 1] = parent.prong;
+template <typename TClock,
+		  LongIndex NStateCount>
+class ProfilerLinkT {
+protected:
+	using Profiler = ProfilerT<TClock, NStateCount>;
 
-			for (parent = forkParent(parent.forkId);
-				 parent;
-				 parent = forkParent(parent.forkId))
-			{
-				HFSM_ASSERT(parent.forkId > 0);
-				compoRemains.set(parent.forkId - 1);
+	HFSM_INLINE ProfilerLinkT(Profiler* const profiler)
+		: _profiler{profiler}
+	{}
 
-				if (	compoActive[parent.forkId - 1] != parent.prong)
-					requested.compo[parent.forkId - 1]  = parent.prong;
-				else {
-					parent = forkParent(parent.forkId);
-					break;
-				}
-			}
+	Profiler* const _profiler;
+};
 
-			for (; parent; parent = forkParent(parent.forkId)) {
-				HFSM_ASSERT(parent.forkId > 0);
-				compoRemains.set(parent.forkId - 1);
-			}
-		}
-	}
+//------------------------------------------------------------------------------
 
-	return true;
-}
+template <LongIndex NStateCount>
+class ProfilerLinkT<void, NStateCount> {
+protected:
+	using Profiler = ProfilerT<void, NStateCount>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE ProfilerLinkT(Profiler* const)							{}
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
-void
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::requestScheduled(const StateID stateId) {
-	HFSM_ASSERT(stateId < STATE_COUNT);
+	static constexpr Profiler* _profiler = nullptr;
+};
 
-	if (stateId < STATE_COUNT) {
-		const Parent parent = stateParents[stateId];
+////////////////////////////////////////////////////////////////////////////////
+// profiler owned by the root, same as above
 
-		if (HFSM_CHECKED(parent.forkId > 0))
-			resumable.compo[parent.forkId - 1] = parent.prong;
-	}
-}
+template <typename TClock,
+		  LongIndex NStateCount>
+class ProfilerHostT {
+protected:
+	using Profiler = ProfilerT<TClock, NStateCount>;
+
+	HFSM_INLINE Profiler* profiler()									{ return &_profiler;	}
+
+	Profiler _profiler;
+};
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC>
-void
-StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC>>::clearRequests() {
-	compoRemains.clear();
-	requested.clear();
-}
+template <LongIndex NStateCount>
+class ProfilerHostT<void, NStateCount> {
+protected:
+	using Profiler = ProfilerT<void, NStateCount>;
+
+	static HFSM_INLINE Profiler* profiler()								{ return nullptr;		}
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -3370,961 +3627,3765 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TArgs>
-class ControlT {
-	template <typename, typename, typename>
-	friend struct S_;
+template <typename TC, LongIndex NS>
+ProfilerT<TC, NS>::Sample::~Sample() {
+	if (_profiler) {
+		MethodProfile& profile = _profiler->_profiles[_stateId][(ShortIndex) _method];
 
-	template <typename, typename, Strategy, typename, typename...>
-	friend struct C_;
+		++profile.calls;
+		profile.ticks += Clock::now() - _start;
+	}
+}
 
-	template <typename, typename, typename, typename...>
-	friend struct O_;
+//------------------------------------------------------------------------------
 
-	template <typename, typename>
-	friend class R_;
+template <typename TC, LongIndex NS>
+void
+ProfilerT<TC, NS>::clear() {
+	for (auto& state : _profiles)
+		for (auto& profile : state)
+			profile = MethodProfile{};
+}
 
-	using Args			= TArgs;
-	using Logger		= typename Args::Logger;
-	using Context		= typename Args::Context;
-	using Random_		= typename Args::Random_;
-	using StateList		= typename Args::StateList;
-	using RegionList	= typename Args::RegionList;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-public:
-	using StateRegistry	= StateRegistryT<Args>;
+template <typename TC, LongIndex NS>
+const MethodProfile&
+ProfilerT<TC, NS>::get(const StateID stateId,
+					   const Method method) const
+{
+	HFSM_ASSERT(stateId < STATE_COUNT && method < Method::COUNT);
 
-	using PlanData		= PlanDataT<Args>;
-	using ConstPlan		= ConstPlanT<Args>;
+	return _profiles[stateId][(ShortIndex) method];
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	struct Region {
-		HFSM_INLINE Region(ControlT& control,
-						   const RegionID id);
+template <typename TC, LongIndex NS>
+template <typename TReceiver>
+void
+ProfilerT<TC, NS>::report(TReceiver& receiver) const {
+	for (StateID s = 0; s < STATE_COUNT; ++s)
+		for (ShortIndex m = 0; m < METHOD_COUNT; ++m)
+			if (_profiles[s][m].calls)
+				receiver(s, (Method) m, _profiles[s][m]);
+}
 
-		HFSM_INLINE ~Region();
+////////////////////////////////////////////////////////////////////////////////
 
-		ControlT& control;
-		const RegionID prevId;
+}
+}
+
+#if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+// fixed-size binary trace entry, decoded offline by 'tools/decode_trace.py';
+// for task and plan statuses 'target' holds the region
+
+struct TraceRecord {
+	enum class Kind : uint8_t {
+		METHOD,
+		TRANSITION,
+		TASK_STATUS,
+		PLAN_STATUS,
+		CANCELLED_PENDING,
+		UTILITY_RESOLUTION,
+		RANDOM_RESOLUTION,
 	};
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	uint64_t timestamp;
+	uint16_t machineId;
+	StateID stateId;
+	StateID target;
+	Kind kind;
+	uint8_t code;		// 'Method', 'Transition' or 'StatusEvent'
+};
 
-protected:
-	HFSM_INLINE ControlT(Context& context,
-						 Random_& random,
-						 StateRegistry& stateRegistry,
-						 PlanData& planData,
-						 Logger* const HFSM_IF_LOGGER(logger))
-		: _context{context}
-		, _random{random}
-		, _stateRegistry{stateRegistry}
-		, _planData{planData}
-		HFSM_IF_LOGGER(, _logger{logger})
-	{}
+static_assert(sizeof(TraceRecord) == 16, "TraceRecord must stay 16 bytes to match the decoder");
 
+//------------------------------------------------------------------------------
+// single-producer / single-consumer ring of trace records, one per thread:
+// machines updated on the thread share it through 'Config::LoggerT<>' and
+// select() their id before each call, another thread drains the records;
+// records are dropped, not blocked on, when the ring is full
 
-	HFSM_INLINE void setRegion(const RegionID id);
-	HFSM_INLINE void resetRegion(const RegionID id);
+template <LongIndex NCapacity,
+		  typename TClock = CycleClock,
+		  typename TUtilty = float>
+class TraceLoggerT
+	: public StaticLoggerT<TUtilty>
+{
+	using Base = StaticLoggerT<TUtilty>;
 
 public:
-	template <typename T>
-	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
+	using Clock		  = TClock;
+	using Index		  = std::size_t;
 
-	template <typename T>
-	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
+	using typename Base::Utilty;
+	using typename Base::Method;
+	using typename Base::StateID;
+	using typename Base::RegionID;
+	using typename Base::Transition;
+	using typename Base::StatusEvent;
 
-	HFSM_INLINE Context& _()										{ return _context;							}
-	HFSM_INLINE Context& context()									{ return _context;							}
+	using Kind		  = TraceRecord::Kind;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	static constexpr LongIndex CAPACITY = NCapacity;
 
-	HFSM_INLINE bool isActive   (const StateID id) const			{ return _stateRegistry.isActive   (id);	}
-	HFSM_INLINE bool isResumable(const StateID id) const			{ return _stateRegistry.isResumable(id);	}
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "Trace capacity must be a power of 2");
 
-	HFSM_INLINE bool isScheduled(const StateID id) const			{ return isResumable(id);					}
+public:
+	TraceLoggerT()
+		: _head{0}
+		, _tail{0}
+		, _dropped{0}
+	{}
 
-	template <typename TState>
-	HFSM_INLINE bool isActive() const								{ return isActive	(stateId<TState>());	}
+	TraceLoggerT(const TraceLoggerT&) = delete;
+	TraceLoggerT& operator = (const TraceLoggerT&) = delete;
 
-	template <typename TState>
-	HFSM_INLINE bool isResumable() const							{ return isResumable(stateId<TState>());	}
+	// producer
 
-	template <typename TState>
-	HFSM_INLINE bool isScheduled() const							{ return isResumable(stateId<TState>());	}
+	HFSM_INLINE void select(const uint16_t machineId)					{ _machineId = machineId;	}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE void recordMethod(const StateID origin,
+								  const Method method)
+	{
+		push(Kind::METHOD, origin, INVALID_STATE_ID, (uint8_t) method);
+	}
 
-	HFSM_INLINE const ConstPlan plan() const						{ return ConstPlan{_planData, _regionId};	}
-	HFSM_INLINE const ConstPlan plan(const RegionID id) const		{ return ConstPlan{_planData, id};			}
+	HFSM_INLINE void recordTransition(const StateID origin,
+									  const Transition transition,
+									  const StateID target)
+	{
+		push(Kind::TRANSITION, origin, target, (uint8_t) transition);
+	}
 
-protected:
-#if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
-	HFSM_INLINE Logger* logger()									{ return _logger;							}
-#endif
+	HFSM_INLINE void recordTaskStatus(const RegionID region,
+									  const StateID origin,
+									  const StatusEvent event)
+	{
+		push(Kind::TASK_STATUS, origin, region, (uint8_t) event);
+	}
 
-protected:
-	Context& _context;
-	Random_& _random;
-	StateRegistry& _stateRegistry;
-	PlanData& _planData;
-	RegionID _regionId = 0;
-	HFSM_IF_LOGGER(Logger* _logger);
-};
+	HFSM_INLINE void recordPlanStatus(const RegionID region,
+									  const StatusEvent event)
+	{
+		push(Kind::PLAN_STATUS, INVALID_STATE_ID, region, (uint8_t) event);
+	}
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE void recordCancelledPending(const StateID origin) {
+		push(Kind::CANCELLED_PENDING, origin, INVALID_STATE_ID, 0);
+	}
 
-template <typename TArgs>
-class PlanControlT
-	: public ControlT<TArgs>
-{
-	template <typename, typename, typename>
-	friend struct S_;
+	HFSM_INLINE void recordUtilityResolution(const StateID head,
+											 const StateID prong,
+											 const Utilty /*utilty*/)
+	{
+		push(Kind::UTILITY_RESOLUTION, head, prong, 0);
+	}
 
-	template <typename, typename, Strategy, typename, typename...>
-	friend struct C_;
+	HFSM_INLINE void recordRandomResolution(const StateID head,
+											const StateID prong,
+											const Utilty /*utilty*/)
+	{
+		push(Kind::RANDOM_RESOLUTION, head, prong, 0);
+	}
 
-	template <typename, typename, typename, typename...>
-	friend struct O_;
+	// consumer
 
-	template <typename, typename>
-	friend class R_;
+	bool pop(TraceRecord& record);
 
-	using Args			= TArgs;
-	using Context		= typename Args::Context;
-	using StateList		= typename Args::StateList;
-	using RegionList	= typename Args::RegionList;
+	// calls 'receiver(record)' for up to CAPACITY records, returns their count
+	template <typename TReceiver>
+	LongIndex drain(TReceiver& receiver);
 
-	using Control		= ControlT<Args>;
-	using StateRegistry	= StateRegistryT<Args>;
+	HFSM_INLINE uint32_t dropped() const								{ return _dropped.load(std::memory_order_relaxed);	}
 
-	using PlanData		= PlanDataT<Args>;
+private:
+	HFSM_INLINE void push(const Kind kind,
+						  const StateID stateId,
+						  const StateID target,
+						  const uint8_t code);
 
-public:
-	using Plan			= PlanT<Args>;
-	using ConstPlan		= ConstPlanT<Args>;
+private:
+	static constexpr Index MASK = CAPACITY - 1;
 
-protected:
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	alignas(64) std::atomic<Index> _head;
 
-	struct Origin {
-		HFSM_INLINE Origin(PlanControlT& control_,
-						   const StateID id);
+	alignas(64) std::atomic<Index> _tail;
+	Index _cachedHead = 0;
+	uint16_t _machineId = 0;
+	std::atomic<uint32_t> _dropped;
 
-		HFSM_INLINE ~Origin();
+	alignas(64) TraceRecord _records[CAPACITY];
+};
 
-		PlanControlT& control;
-		const StateID prevId;
-	};
+////////////////////////////////////////////////////////////////////////////////
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+}
 
-	struct Region {
-		HFSM_INLINE Region(PlanControlT& control,
-						   const RegionID id,
-						   const StateID index,
-						   const LongIndex size);
+namespace hfsm2 {
 
-		HFSM_INLINE ~Region();
+////////////////////////////////////////////////////////////////////////////////
 
-		PlanControlT& control;
-		const RegionID prevId;
-		const LongIndex prevIndex;
-		const LongIndex prevSize;
-	};
+template <LongIndex NC, typename TC, typename TU>
+bool
+TraceLoggerT<NC, TC, TU>::pop(TraceRecord& record) {
+	const Index head = _head.load(std::memory_order_relaxed);
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	if (head == _tail.load(std::memory_order_acquire))
+		return false;
 
-	using Control::Control;
+	record = _records[head & MASK];
+	_head.store(head + 1, std::memory_order_release);
 
-	HFSM_INLINE void setOrigin  (const StateID id);
-	HFSM_INLINE void resetOrigin(const StateID id);
+	return true;
+}
 
-	HFSM_INLINE void setRegion  (const RegionID id, const StateID index, const LongIndex size);
-	HFSM_INLINE void resetRegion(const RegionID id, const StateID index, const LongIndex size);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-public:
-	using Control::isActive;
-	using Control::isResumable;
-	using Control::isScheduled;
+template <LongIndex NC, typename TC, typename TU>
+template <typename TReceiver>
+LongIndex
+TraceLoggerT<NC, TC, TU>::drain(TReceiver& receiver) {
+	const Index head = _head.load(std::memory_order_relaxed);
+	const Index tail = _tail.load(std::memory_order_acquire);
 
-	using Control::plan;
+	const LongIndex count = (LongIndex) (tail - head);
 
-	using Control::_;
-	using Control::context;
+	for (Index i = head; i != tail; ++i)
+		receiver(_records[i & MASK]);
 
-	template <typename T>
-	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
+	_head.store(tail, std::memory_order_release);
 
-	template <typename T>
-	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
+	return count;
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE Plan plan()								{ return Plan{_planData, _regionId};					}
-	HFSM_INLINE Plan plan(const RegionID id)			{ return Plan{_planData, id};							}
+template <LongIndex NC, typename TC, typename TU>
+void
+TraceLoggerT<NC, TC, TU>::push(const Kind kind,
+							   const StateID stateId,
+							   const StateID target,
+							   const uint8_t code)
+{
+	const Index tail = _tail.load(std::memory_order_relaxed);
 
-	template <typename TRegion>
-	HFSM_INLINE Plan plan()								{ return Plan{_planData, regionId<TRegion>()};			}
+	if (tail - _cachedHead == CAPACITY) {
+		_cachedHead = _head.load(std::memory_order_acquire);
 
-	template <typename TRegion>
-	HFSM_INLINE Plan plan() const						{ return Plan{_planData, regionId<TRegion>()};			}
+		if (tail - _cachedHead == CAPACITY) {
+			_dropped.fetch_add(1, std::memory_order_relaxed);
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+			return;
+		}
+	}
 
-protected:
-	HFSM_INLINE		  PlanData&	planData()				{ return _planData;										}
-	HFSM_INLINE const PlanData&	planData() const		{ return _planData;										}
+	TraceRecord& record = _records[tail & MASK];
+	record.timestamp = Clock::now();
+	record.machineId = _machineId;
+	record.stateId	 = stateId;
+	record.target	 = target;
+	record.kind		 = kind;
+	record.code		 = code;
 
-protected:
-	using Control::_planData;
-	using Control::_regionId;
-	HFSM_IF_LOGGER(using Control::_logger);
+	_tail.store(tail + 1, std::memory_order_release);
+}
 
-	StateID _originId = 0;
-	StateID _regionIndex = 0;
-	LongIndex _regionSize = StateList::SIZE;
-	Status _status;
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma pack(push, 2)
+
+struct TaskLink {
+	HFSM_INLINE TaskLink(const Transition transition_,
+						 const StateID origin_,
+						 const StateID destination_)
+		: transition{transition_}
+		, origin(origin_)
+		, destination(destination_)
+		, next(INVALID_LONG_INDEX)
+	{}
+
+	Transition transition;
+	StateID origin		= INVALID_STATE_ID;
+	StateID destination	= INVALID_STATE_ID;
+	// TODO: add paylaods
+
+	LongIndex prev		= INVALID_LONG_INDEX;
+	LongIndex next		= INVALID_LONG_INDEX;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Bounds {
+	LongIndex first		= INVALID_LONG_INDEX;
+	LongIndex last		= INVALID_LONG_INDEX;
 };
 
+#pragma pack(pop)
+
 //------------------------------------------------------------------------------
 
-template <typename TArgs>
-class FullControlT
-	: public PlanControlT<TArgs>
+template <typename,
+		  typename,
+		  typename,
+		  typename,
+		  LongIndex,
+		  LongIndex,
+		  LongIndex,
+		  typename,
+		  LongIndex,
+		  typename>
+struct ArgsT;
+
+template <typename>
+struct PlanDataT;
+
+//------------------------------------------------------------------------------
+
+template <typename TContext,
+		  typename TConfig,
+		  typename TStateList,
+		  typename TRegionList,
+		  LongIndex NCompoCount,
+		  LongIndex NOrthoCount,
+		  LongIndex NOrthoUnits,
+		  typename TPayload,
+		  LongIndex NTaskCapacity,
+		  typename TApex>
+struct PlanDataT<ArgsT<TContext,
+					   TConfig,
+					   TStateList,
+					   TRegionList,
+					   NCompoCount,
+					   NOrthoCount,
+					   NOrthoUnits,
+					   TPayload,
+					   NTaskCapacity,
+					   TApex>>
 {
-	template <typename, typename, typename>
-	friend struct S_;
+	using StateList		= TStateList;
+	using RegionList	= TRegionList;
 
-	template <typename, typename, Strategy, typename, typename...>
-	friend struct C_;
+	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
+	static constexpr LongIndex  TASK_CAPACITY = NTaskCapacity;
 
-	template <typename, typename, typename, typename...>
-	friend struct O_;
+	using TaskLinks		= List<TaskLink, TASK_CAPACITY>;
+	using TasksBounds	= Array<Bounds, RegionList::SIZE>;
+	using TasksBits		= BitArray<StateID, StateList::SIZE>;
+	using RegionBits	= BitArray<RegionID, RegionList::SIZE>;
+	using TaskCounts	= StaticArray<LongIndex, RegionList::SIZE>;
+
+	// usage of 'taskLinks', kept by the machine outside of its snapshots,
+	// see 'ConfigT<>::TaskCapacityN<>'
+	struct Stats {
+		TaskCounts highWaters{0};	// most tasks planned at once, per region
+		LongIndex highWater = 0;	// .. and in total
+		LongIndex overflows = 0;	// tasks dropped because 'taskLinks' was full
+	};
 
-	template <typename, typename>
-	friend class R_;
+	TaskLinks taskLinks;
+	TasksBounds tasksBounds;
+	TasksBits tasksSuccesses;
+	TasksBits tasksFailures;
+	RegionBits planExists;
 
-	using Args			= TArgs;
-	using Logger		= typename Args::Logger;
-	using Context		= typename Args::Context;
-	using Random_		= typename Args::Random_;
-	using StateList		= typename Args::StateList;
-	using RegionList	= typename Args::RegionList;
-	using Payload		= typename Args::Payload;
+	TaskCounts taskCounts{0};
 
-	using Control		= ControlT<Args>;
-	using StateRegistry	= StateRegistryT<Args>;
+	// snapshot wire format: plan bits, then every region's task count
+	// and tasks in plan order, ids little-endian
+	static constexpr std::size_t TASK_WIRE_SIZE = 5;
 
-	using PlanControl	= PlanControlT<Args>;
-	using Origin		= typename PlanControl::Origin;
-	using Plan			= typename PlanControl::Plan;
-	using PlanData		= PlanDataT<Args>;
+	static constexpr std::size_t WIRE_CAPACITY = bitsSize<RegionBits>()
+											   + bitsSize<TasksBits>() * 2
+											   + REGION_COUNT * 2
+											   + TASK_CAPACITY * TASK_WIRE_SIZE;
 
-	using Request		= RequestT <Payload>;
-	using Requests		= RequestsT<Payload, Args::COMPO_REGIONS>;
+	HFSM_INLINE std::size_t wireSize() const	{ return WIRE_CAPACITY - (TASK_CAPACITY - taskLinks.count()) * TASK_WIRE_SIZE;	}
 
-protected:
+	void write(unsigned char*& cursor) const;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// into empty plans, false if tasks don't fit or refer to unknown states
+	bool read(const unsigned char*& cursor, const unsigned char* const end);
 
-	struct Lock {
-		HFSM_INLINE Lock(FullControlT& control_);
-		HFSM_INLINE ~Lock();
+#ifdef HFSM_ENABLE_ASSERT
+	void verifyPlans() const;
+	LongIndex verifyPlan(const RegionID stateId) const;
+#endif
+};
 
-		FullControlT* const control;
-	};
+//------------------------------------------------------------------------------
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TContext,
+		  typename TConfig,
+		  typename TStateList,
+		  typename TRegionList,
+		  LongIndex NOrthoCount,
+		  LongIndex NOrthoUnits,
+		  typename TPayload,
+		  LongIndex NTaskCapacity,
+		  typename TApex>
+struct PlanDataT<ArgsT<TContext,
+					   TConfig,
+					   TStateList,
+					   TRegionList,
+					   0,
+					   NOrthoCount,
+					   NOrthoUnits,
+					   TPayload,
+					   NTaskCapacity,
+					   TApex>>
+{
+	struct Stats {};
 
-protected:
-	HFSM_INLINE FullControlT(Context& context,
-							 Random_& random,
-							 StateRegistry& stateRegistry,
-							 PlanData& planData,
-							 Requests& requests,
-							 Logger* const logger)
-		: PlanControl{context, random, stateRegistry, planData, logger}
-		, _requests{requests}
-	{}
+	static constexpr std::size_t WIRE_CAPACITY = 0;
 
-	template <typename TState>
-	Status updatePlan(TState& headState, const Status subStatus);
+	HFSM_INLINE std::size_t wireSize() const									{ return 0;		}
 
-	template <typename TState>
-	Status buildPlanStatus();
+	HFSM_INLINE void write(unsigned char*&) const								{}
+	HFSM_INLINE bool read(const unsigned char*&, const unsigned char* const)	{ return true;	}
 
-public:
-	using Control::isActive;
-	using Control::isResumable;
-	using Control::isScheduled;
+#ifdef HFSM_ENABLE_ASSERT
+	void verifyPlans() const													{}
+	LongIndex verifyPlan(const RegionID) const					{ return 0;		}
+#endif
+};
 
-	using PlanControl::plan;
+////////////////////////////////////////////////////////////////////////////////
 
-	using Control::_;
-	using Control::context;
+}
+}
 
-	template <typename T>
-	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
+namespace hfsm2 {
+namespace detail {
 
-	template <typename T>
-	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
+////////////////////////////////////////////////////////////////////////////////
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-	// TODO: test payload versions
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+void
+PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::write(unsigned char*& cursor) const {
+	writeBits(cursor, planExists);
+	writeBits(cursor, tasksSuccesses);
+	writeBits(cursor, tasksFailures);
 
-	HFSM_INLINE void changeTo (const StateID id);
-	HFSM_INLINE void changeTo (const StateID stateId, const Payload& payload);
+	for (RegionID id = 0; id < REGION_COUNT; ++id) {
+		*cursor++ = (unsigned char) (taskCounts[id]);
+		*cursor++ = (unsigned char) (taskCounts[id] >> 8);
 
-	HFSM_INLINE void restart  (const StateID id);
-	HFSM_INLINE void restart  (const StateID stateId, const Payload& payload);
+		for (LongIndex index = tasksBounds[id].first;
+			 index < TASK_CAPACITY;
+			 index = taskLinks[index].next)
+		{
+			const TaskLink& task = taskLinks[index];
 
-	HFSM_INLINE void resume	  (const StateID id);
-	HFSM_INLINE void resume   (const StateID stateId, const Payload& payload);
+			*cursor++ = (unsigned char) task.transition;
+			*cursor++ = (unsigned char) (task.origin);
+			*cursor++ = (unsigned char) (task.origin >> 8);
+			*cursor++ = (unsigned char) (task.destination);
+			*cursor++ = (unsigned char) (task.destination >> 8);
+		}
+	}
+}
 
-	HFSM_INLINE void utilize  (const StateID id);
-	HFSM_INLINE void utilize  (const StateID stateId, const Payload& payload);
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+bool
+PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::read(const unsigned char*& cursor,
+																	   const unsigned char* const end)
+{
+	HFSM_ASSERT(taskLinks.count() == 0);
+
+	if ((std::size_t) (end - cursor) < WIRE_CAPACITY - TASK_CAPACITY * TASK_WIRE_SIZE ||
+		!readBits(cursor, planExists) ||
+		!readBits(cursor, tasksSuccesses) ||
+		!readBits(cursor, tasksFailures))
+	{
+		return false;
+	}
+
+	for (RegionID id = 0; id < REGION_COUNT; ++id) {
+		if (end - cursor < 2)
+			return false;
+
+		const LongIndex count = (LongIndex) (cursor[0] | cursor[1] << 8);
+		cursor += 2;
+
+		if (count > TASK_CAPACITY - taskLinks.count() ||
+			(std::size_t) (end - cursor) < count * TASK_WIRE_SIZE)
+		{
+			return false;
+		}
+
+		Bounds& bounds = tasksBounds[id];
+
+		for (LongIndex t = 0; t < count; ++t) {
+			const ShortIndex transition	 = cursor[0];
+			const StateID origin		 = (StateID) (cursor[1] | cursor[2] << 8);
+			const StateID destination	 = (StateID) (cursor[3] | cursor[4] << 8);
+			cursor += TASK_WIRE_SIZE;
+
+			if (transition  >= (ShortIndex) Transition::COUNT ||
+				origin		>= StateList::SIZE ||
+				destination >= StateList::SIZE)
+			{
+				return false;
+			}
+
+			const LongIndex index = taskLinks.emplace((Transition) transition, origin, destination);
+
+			if (bounds.last < TASK_CAPACITY) {
+				taskLinks[bounds.last].next = index;
+				taskLinks[index].prev = bounds.last;
+			} else
+				bounds.first = index;
+
+			bounds.last = index;
+		}
+
+		taskCounts[id] = count;
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HFSM_ENABLE_ASSERT
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+void
+PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::verifyPlans() const {
+	LongIndex planCount = 0;
+	for (RegionID id = 0; id < REGION_COUNT; ++id)
+		planCount += verifyPlan(id);
+
+	HFSM_ASSERT(taskLinks.count() == planCount);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+LongIndex
+PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::verifyPlan(const RegionID regionId) const {
+	LongIndex length = 0;
+	const Bounds& bounds = tasksBounds[regionId];
+
+	if (bounds.first != INVALID_LONG_INDEX) {
+		HFSM_ASSERT(bounds.last != INVALID_LONG_INDEX);
+
+		for (auto slow = bounds.first, fast = slow; ; ) {
+			++length;
+			const TaskLink& task = taskLinks[slow];
+
+			if (slow != bounds.last) {
+				HFSM_ASSERT(task.next != INVALID_LONG_INDEX);
+				slow = task.next;
+
+				// loop check
+				if (fast != INVALID_LONG_INDEX) {
+					fast = taskLinks[fast].next;
+
+					if (fast != INVALID_LONG_INDEX) {
+						fast = taskLinks[fast].next;
+					}
+
+					if (fast != INVALID_LONG_INDEX)
+						HFSM_ASSERT(slow != fast);
+				}
+			} else {
+				HFSM_ASSERT(task.next == INVALID_LONG_INDEX);
+
+				break;
+			}
+		};
+	} else
+		HFSM_ASSERT(bounds.last == INVALID_LONG_INDEX);
+
+	HFSM_ASSERT(taskCounts[regionId] == length);
+
+	return length;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma pack(push, 1)
+
+struct Status {
+	enum Result {
+		NONE,
+		SUCCESS,
+		FAILURE
+	};
+
+	Result result = NONE;
+	bool outerTransition = false;
+
+	inline Status(const Result result_ = NONE,
+				  const bool outerTransition_ = false);
+
+	inline explicit operator bool() const { return result || outerTransition; }
+
+	inline void clear();
+};
+
+#pragma pack(pop)
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline Status
+combine(const Status lhs, const Status rhs) {
+	const Status::Result result = lhs.result > rhs.result ?
+		lhs.result : rhs.result;
+
+	return {result, lhs.outerTransition || rhs.outerTransition};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+class ConstPlanT {
+	template <typename>
+	friend class ControlT;
+
+	template <typename>
+	friend class PlanControlT;
+
+	template <typename>
+	friend class FullControlT;
+
+	template <typename>
+	friend class GuardControlT;
+
+	using Args			= TArgs;
+	using Context		= typename Args::Context;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
+	using Payload		= typename Args::Payload;
+
+	static constexpr LongIndex TASK_CAPACITY = Args::TASK_CAPACITY;
+
+public:
+	using PlanData		= PlanDataT<Args>;
+	using TaskLinks		= typename PlanData::TaskLinks;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct Iterator {
+		HFSM_INLINE Iterator(const ConstPlanT& plan);
+
+		HFSM_INLINE explicit operator bool() const;
+
+		HFSM_INLINE void operator ++();
+
+		HFSM_INLINE const TaskLink& operator  *() const { return  _plan._planData.taskLinks[_curr];	}
+		HFSM_INLINE const TaskLink* operator ->() const { return &_plan._planData.taskLinks[_curr];	}
+
+		HFSM_INLINE LongIndex next() const;
+
+		const ConstPlanT& _plan;
+		LongIndex _curr;
+		LongIndex _next;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+private:
+	HFSM_INLINE ConstPlanT(const PlanData& planData,
+						   const RegionID regionId);
+
+	template <typename T>
+	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
+
+	template <typename T>
+	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
+
+public:
+	HFSM_INLINE explicit operator bool() const;
+
+	HFSM_INLINE Iterator first()			{ return Iterator{*this};								}
+
+private:
+	const PlanData& _planData;
+	const Bounds& _bounds;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+class PlanT {
+	template <typename>
+	friend class PlanControlT;
+
+	template <typename>
+	friend class FullControlT;
+
+	template <typename>
+	friend class GuardControlT;
+
+	using Args			= TArgs;
+	using Context		= typename Args::Context;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
+	using Payload		= typename Args::Payload;
+
+	static constexpr LongIndex  TASK_CAPACITY	= Args::TASK_CAPACITY;
+
+public:
+	using PlanData		= PlanDataT<Args>;
+	using PlanStats		= typename PlanData::Stats;
+	using TaskLinks		= typename PlanData::TaskLinks;
+	using TaskIndex		= typename TaskLinks::Index;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct Iterator {
+		HFSM_INLINE Iterator(PlanT& plan);
+
+		HFSM_INLINE explicit operator bool() const;
+
+		HFSM_INLINE void operator ++();
+
+		HFSM_INLINE		  TaskLink& operator  *()	    { return  _plan._planData.taskLinks[_curr];	}
+		HFSM_INLINE const TaskLink& operator  *() const { return  _plan._planData.taskLinks[_curr];	}
+
+		HFSM_INLINE		  TaskLink* operator ->()	    { return &_plan._planData.taskLinks[_curr];	}
+		HFSM_INLINE const TaskLink* operator ->() const { return &_plan._planData.taskLinks[_curr];	}
+
+		HFSM_INLINE void remove();
+
+		HFSM_INLINE LongIndex next() const;
+
+		PlanT& _plan;
+		LongIndex _curr;
+		LongIndex _next;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+private:
+	HFSM_INLINE PlanT(PlanData& planData,
+					  PlanStats& planStats,
+					  const RegionID regionId,
+					  SpinLock* const serial);
+
+	template <typename T>
+	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
+
+	template <typename T>
+	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
+
+	bool append(const Transition transition,
+				const StateID origin,
+				const StateID destination);
+
+public:
+	HFSM_INLINE explicit operator bool() const;
+
+	HFSM_INLINE void clear();
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE bool change   (const StateID origin, const StateID destination)	{ return append(Transition::CHANGE,	   origin, destination); }
+	HFSM_INLINE bool restart  (const StateID origin, const StateID destination)	{ return append(Transition::RESTART,   origin, destination); }
+	HFSM_INLINE bool resume   (const StateID origin, const StateID destination)	{ return append(Transition::RESUME,	   origin, destination); }
+	HFSM_INLINE bool utilize  (const StateID origin, const StateID destination)	{ return append(Transition::UTILIZE,   origin, destination); }
+	HFSM_INLINE bool randomize(const StateID origin, const StateID destination)	{ return append(Transition::RANDOMIZE, origin, destination); }
+	HFSM_INLINE bool schedule (const StateID origin, const StateID destination)	{ return append(Transition::SCHEDULE,  origin, destination); }
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	template <typename TOrigin>
+	HFSM_INLINE bool change   (const StateID destination)					{ return change   (stateId<TOrigin>(), destination);				}
+
+	template <typename TOrigin>
+	HFSM_INLINE bool restart  (const StateID destination)					{ return restart  (stateId<TOrigin>(), destination);				}
+
+	template <typename TOrigin>
+	HFSM_INLINE bool resume   (const StateID destination)					{ return resume   (stateId<TOrigin>(), destination);				}
+
+	template <typename TOrigin>
+	HFSM_INLINE bool utilize  (const StateID destination)					{ return utilize  (stateId<TOrigin>(), destination);				}
+
+	template <typename TOrigin>
+	HFSM_INLINE bool randomize(const StateID destination)					{ return randomize(stateId<TOrigin>(), destination);				}
+
+	template <typename TOrigin>
+	HFSM_INLINE bool schedule (const StateID destination)					{ return schedule (stateId<TOrigin>(), destination);				}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	template <typename TOrigin, typename TDestination>
+	HFSM_INLINE bool change   ()											{ return change   (stateId<TOrigin>(), stateId<TDestination>());	}
+
+	template <typename TOrigin, typename TDestination>
+	HFSM_INLINE bool restart  ()											{ return restart  (stateId<TOrigin>(), stateId<TDestination>());	}
+
+	template <typename TOrigin, typename TDestination>
+	HFSM_INLINE bool resume   ()											{ return resume   (stateId<TOrigin>(), stateId<TDestination>());	}
+
+	template <typename TOrigin, typename TDestination>
+	HFSM_INLINE bool utilize  ()											{ return utilize  (stateId<TOrigin>(), stateId<TDestination>());	}
+
+	template <typename TOrigin, typename TDestination>
+	HFSM_INLINE bool randomize()											{ return randomize(stateId<TOrigin>(), stateId<TDestination>());	}
+
+	template <typename TOrigin, typename TDestination>
+	HFSM_INLINE bool schedule ()											{ return schedule (stateId<TOrigin>(), stateId<TDestination>());	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE Iterator first()			{ return Iterator{*this};								}
+
+private:
+	void remove(const LongIndex task);
+
+private:
+	PlanData& _planData;
+	PlanStats& _planStats;
+	const RegionID _regionId;
+	Bounds& _bounds;
+
+	// task storage is shared by the prongs of parallel regions
+	SpinLock* const _serial;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+Status::Status(const Result result_,
+			   const bool outerTransition_)
+	: result{result_}
+	, outerTransition{outerTransition_}
+{}
+
+//------------------------------------------------------------------------------
+
+void
+Status::clear() {
+	result = NONE;
+	outerTransition = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+ConstPlanT<TArgs>::Iterator::Iterator(const ConstPlanT& plan)
+	: _plan{plan}
+	, _curr{plan._bounds.first}
+{
+	_next = next();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+ConstPlanT<TArgs>::Iterator::operator bool() const {
+	HFSM_ASSERT(_curr < ConstPlanT::TASK_CAPACITY || _curr == INVALID_LONG_INDEX);
+
+	return _curr < ConstPlanT::TASK_CAPACITY;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+ConstPlanT<TArgs>::Iterator::operator ++() {
+	_curr = _next;
+	_next = next();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+LongIndex
+ConstPlanT<TArgs>::Iterator::next() const {
+	if (_curr < ConstPlanT::TASK_CAPACITY) {
+		const TaskLink& task = _plan._planData.taskLinks[_curr];
+
+		return task.next;
+	} else {
+		HFSM_ASSERT(_curr == INVALID_LONG_INDEX);
+
+		return INVALID_LONG_INDEX;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+ConstPlanT<TArgs>::ConstPlanT(const PlanData& planData,
+							  const RegionID regionId)
+
+	: _planData{planData}
+	, _bounds{planData.tasksBounds[regionId]}
+{}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+ConstPlanT<TArgs>::operator bool() const {
+	if (_bounds.first < TASK_CAPACITY) {
+		HFSM_ASSERT(_bounds.last < TASK_CAPACITY);
+		return true;
+	} else {
+		HFSM_ASSERT(_bounds.last == INVALID_LONG_INDEX);
+		return false;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+PlanT<TArgs>::Iterator::Iterator(PlanT& plan)
+	: _plan{plan}
+	, _curr{plan._bounds.first}
+{
+	_next = next();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+PlanT<TArgs>::Iterator::operator bool() const {
+	HFSM_ASSERT(_curr < PlanT::TASK_CAPACITY || _curr == INVALID_LONG_INDEX);
+
+	return _curr < PlanT::TASK_CAPACITY;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+PlanT<TArgs>::Iterator::operator ++() {
+	_curr = _next;
+	_next = next();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+PlanT<TArgs>::Iterator::remove() {
+	_plan.remove(_curr);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+LongIndex
+PlanT<TArgs>::Iterator::next() const {
+	if (_curr < PlanT::TASK_CAPACITY) {
+		const TaskLink& task = _plan._planData.taskLinks[_curr];
+
+		return task.next;
+	} else {
+		HFSM_ASSERT(_curr == INVALID_LONG_INDEX);
+
+		return INVALID_LONG_INDEX;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+PlanT<TArgs>::PlanT(PlanData& planData,
+					PlanStats& planStats,
+					const RegionID regionId,
+					SpinLock* const serial)
+
+	: _planData{planData}
+	, _planStats{planStats}
+	, _regionId{regionId}
+	, _bounds{planData.tasksBounds[regionId]}
+	, _serial{serial}
+{}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+PlanT<TArgs>::operator bool() const {
+	if (_bounds.first < TASK_CAPACITY) {
+		HFSM_ASSERT(_bounds.last < TASK_CAPACITY);
+		return true;
+	} else {
+		HFSM_ASSERT(_bounds.last == INVALID_LONG_INDEX);
+		return false;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+bool
+PlanT<TArgs>::append(const Transition transition,
+					 const StateID origin,
+					 const StateID destination)
+{
+	SpinGuard guard{_serial};
+
+	const TaskIndex index = _planData.taskLinks.emplace(transition, origin, destination);
+	if (index == TaskLinks::INVALID) {
+		// counted, not a fault: raise 'ConfigT<>::TaskCapacityN<>' above 'taskHighWater()'
+		++_planStats.overflows;
+
+		return false;
+	}
+
+	_planData.planExists.set(_regionId);
+
+	LongIndex& count = _planData.taskCounts[_regionId];
+	++count;
+
+	if (_planStats.highWaters[_regionId] < count)
+		_planStats.highWaters[_regionId] = count;
+
+	if (_planStats.highWater < _planData.taskLinks.count())
+		_planStats.highWater = _planData.taskLinks.count();
+
+	if (_bounds.first < TaskLinks::CAPACITY) {
+		HFSM_ASSERT(_bounds.last < TaskLinks::CAPACITY);
+
+		auto& last  = _planData.taskLinks[_bounds.last];
+		last.next = index;
+
+		auto& next = _planData.taskLinks[index];
+		next.prev  = _bounds.last;
+
+		_bounds.last = index;
+	} else {
+		HFSM_ASSERT(_bounds.first == INVALID_LONG_INDEX &&
+					_bounds.last  == INVALID_LONG_INDEX);
+
+		_bounds.first = index;
+		_bounds.last  = index;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+PlanT<TArgs>::clear() {
+	SpinGuard guard{_serial};
+
+	if (_bounds.first < TaskLinks::CAPACITY) {
+		HFSM_ASSERT(_bounds.last < TaskLinks::CAPACITY);
+
+		for (LongIndex index = _bounds.first;
+			 index != INVALID_LONG_INDEX;
+			 )
+		{
+			HFSM_ASSERT(index < TaskLinks::CAPACITY);
+
+			const auto& task = _planData.taskLinks[index];
+			HFSM_ASSERT(index == _bounds.first ?
+				   task.prev == INVALID_LONG_INDEX :
+				   task.prev <  TaskLinks::CAPACITY);
+
+			const LongIndex next = task.next;
+
+			_planData.taskLinks.remove(index);
+
+			index = next;
+		}
+
+		_bounds.first = INVALID_LONG_INDEX;
+		_bounds.last  = INVALID_LONG_INDEX;
+
+		_planData.taskCounts[_regionId] = 0;
+	} else
+		HFSM_ASSERT(_bounds.first == INVALID_LONG_INDEX &&
+			   _bounds.last  == INVALID_LONG_INDEX);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+PlanT<TArgs>::remove(const LongIndex task) {
+	SpinGuard guard{_serial};
+
+	HFSM_ASSERT(_planData.planExists.get(_regionId) &&
+				_bounds.first < TaskLinks::CAPACITY &&
+				_bounds.last  < TaskLinks::CAPACITY);
+
+	HFSM_ASSERT(task < TaskLinks::CAPACITY);
+
+	const TaskLink& curr = _planData.taskLinks[task];
+
+	if (curr.prev < TaskLinks::CAPACITY) {
+		TaskLink& prev = _planData.taskLinks[curr.prev];
+		prev.next = curr.next;
+	} else {
+		HFSM_ASSERT(_bounds.first == task);
+		_bounds.first = curr.next;
+	}
+
+	if (curr.next < TaskLinks::CAPACITY) {
+		TaskLink& next = _planData.taskLinks[curr.next];
+		next.prev = curr.prev;
+	} else {
+		HFSM_ASSERT(_bounds.last == task);
+		_bounds.last = curr.prev;
+	}
+
+	_planData.taskLinks.remove(task);
+
+	HFSM_ASSERT(_planData.taskCounts[_regionId] > 0);
+	--_planData.taskCounts[_regionId];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+//------------------------------------------------------------------------------
+
+enum Strategy {
+	Composite,
+	Resumable,
+	Utilitarian,
+	RandomUtil,
+};
+
+// how orthogonal regions run their prongs' update()
+enum Execution {
+	Sequential,
+	Parallel,
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma pack(push, 1)
+
+struct alignas(2 * sizeof(ShortIndex)) Parent {
+	HFSM_INLINE Parent() = default;
+
+	HFSM_INLINE constexpr Parent(const ForkID forkId_)
+		: forkId{forkId_}
+	{}
+
+	HFSM_INLINE constexpr Parent(const ForkID forkId_,
+								 const ShortIndex prong_)
+		: forkId{forkId_}
+		, prong{prong_}
+	{}
+
+	HFSM_INLINE constexpr explicit operator bool() const {
+		return forkId != INVALID_FORK_ID &&
+			   prong  != INVALID_SHORT_INDEX;
+	}
+
+	ForkID	   forkId = INVALID_FORK_ID;
+	ShortIndex prong  = INVALID_SHORT_INDEX;
+};
+
+#pragma pack(pop)
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 'payload' is a handle into the machine's 'PayloadPoolT<>',
+// INVALID_SHORT_INDEX for transitions without one
+
+template <typename TPayload>
+struct RequestT {
+	using Payload = TPayload;
+
+	enum Type : ShortIndex {
+		REMAIN,
+		CHANGE,
+		RESTART,
+		RESUME,
+		UTILIZE,
+		RANDOMIZE,
+		SCHEDULE,
+
+		COUNT
+	};
+
+	HFSM_INLINE RequestT() = default;
+
+	HFSM_INLINE RequestT(const Type type_,
+						 const StateID stateId_,
+						 const ShortIndex payload_ = INVALID_SHORT_INDEX)
+		: type{type_}
+		, payload{payload_}
+		, stateId{stateId_}
+	{
+		HFSM_ASSERT(type_ < Type::COUNT);
+	}
+
+	Type type = CHANGE;
+	ShortIndex payload = INVALID_SHORT_INDEX;
+	StateID stateId = INVALID_STATE_ID;
+};
+
+template <typename TPayload, ShortIndex NCount>
+using RequestsT = Array<RequestT<TPayload>, NCount>;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// the batch being collected and the one before it, for guards to inspect
+// while their own requests are collected; swapped by index, never copied
+
+template <typename TPayload, ShortIndex NCount>
+class RequestBuffersT final {
+public:
+	using Requests = RequestsT<TPayload, NCount>;
+
+	HFSM_INLINE		  Requests& current()						{ return _buffers[_current];		}
+	HFSM_INLINE const Requests& current() const					{ return _buffers[_current];		}
+
+	HFSM_INLINE const Requests& previous() const				{ return _buffers[_current ^ 1];	}
+
+	// the current batch becomes the previous one, a new empty batch is started
+	HFSM_INLINE void advance()									{ _current ^= 1; _buffers[_current].clear();	}
+
+	// drops the current batch, making the previous one current again
+	HFSM_INLINE void restore()									{ _current ^= 1;					}
+
+private:
+	Requests _buffers[2];
+	ShortIndex _current = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NCompoCount, LongIndex NOrthoCount, LongIndex NOrthoUnits>
+struct AllForksT {
+	static constexpr ShortIndex COMPO_REGIONS = NCompoCount;
+	static constexpr ShortIndex ORTHO_REGIONS = NOrthoCount;
+	static constexpr ShortIndex ORTHO_UNITS	  = NOrthoUnits;
+
+	using Compo = StaticArray<ShortIndex, COMPO_REGIONS>;
+	using Ortho = BitArray<ShortIndex, ORTHO_UNITS * 8>;
+
+	Compo compo{INVALID_SHORT_INDEX};
+	Ortho ortho;
+
+	HFSM_INLINE void clear();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename,
+		  typename,
+		  typename,
+		  typename,
+		  LongIndex,
+		  LongIndex,
+		  LongIndex,
+		  typename,
+		  LongIndex,
+		  typename>
+struct ArgsT;
+
+//------------------------------------------------------------------------------
+// parent tables, generated from the apex info at compile time
+// (each table ends with a spare entry, so none of them are empty)
+
+template <typename TApex>
+constexpr Parent
+nearestCompo(const Parent parent) {
+	return !parent || parent.forkId > 0 ?
+		parent : nearestCompo<TApex>(TApex::orthoParent(-parent.forkId - 1, 0, 0, Parent{}));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TApex, typename, typename, typename>
+struct TopologyT;
+
+template <typename TApex,
+		  LongIndex... NStates,
+		  LongIndex... NCompos,
+		  LongIndex... NOrthos>
+struct TopologyT<TApex,
+				 IndexSequence<NStates...>,
+				 IndexSequence<NCompos...>,
+				 IndexSequence<NOrthos...>>
+{
+	using Apex = TApex;
+
+	static constexpr Parent STATE_PARENTS[sizeof...(NStates) + 1] = {
+		Apex::stateParent(NStates, 0, 0, 0, Parent{})..., Parent{}
+	};
+
+	static constexpr Parent STATE_COMPOS [sizeof...(NStates) + 1] = {
+		nearestCompo<Apex>(Apex::stateParent(NStates, 0, 0, 0, Parent{}))..., Parent{}
+	};
+
+	static constexpr Parent COMPO_PARENTS[sizeof...(NCompos) + 1] = {
+		Apex::compoParent(NCompos, 0, 0, Parent{})..., Parent{}
+	};
+
+	static constexpr Parent ORTHO_PARENTS[sizeof...(NOrthos) + 1] = {
+		Apex::orthoParent(NOrthos, 0, 0, Parent{})..., Parent{}
+	};
+
+	static constexpr Units  ORTHO_UNITS	 [sizeof...(NOrthos) + 1] = {
+		Apex::orthoUnits (NOrthos, 0, 0)..., Units{}
+	};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// folds a parent table into 'seed', for signatures of machine layouts
+
+constexpr uint32_t
+hashParents(const Parent* const parents,
+			const LongIndex count,
+			const uint32_t seed)
+{
+	return count == 0 ?
+		seed : hashParents(parents + 1,
+						   count - 1,
+						   (seed * 31u + (ShortIndex) parents->forkId) * 31u + parents->prong);
+}
+
+template <typename>
+struct StateRegistryT;
+
+//------------------------------------------------------------------------------
+
+template <typename TContext,
+		  typename TConfig,
+		  typename TStateList,
+		  typename TRegionList,
+		  LongIndex NCompoCount,
+		  LongIndex NOrthoCount,
+		  LongIndex NOrthoUnits,
+		  typename TPayload,
+		  LongIndex NTaskCapacity,
+		  typename TApex>
+struct StateRegistryT<ArgsT<TContext,
+							TConfig,
+							TStateList,
+							TRegionList,
+							NCompoCount,
+							NOrthoCount,
+							NOrthoUnits,
+							TPayload,
+							NTaskCapacity,
+							TApex>>
+{
+	using StateList		= TStateList;
+	using RegionList	= TRegionList;
+	using Payload		= TPayload;
+
+	using Request		= RequestT<Payload>;
+
+	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
+	static constexpr ShortIndex COMPO_REGIONS = NCompoCount;
+	static constexpr ShortIndex ORTHO_REGIONS = NOrthoCount;
+	static constexpr ShortIndex ORTHO_UNITS	  = NOrthoUnits;
+
+	using Topology		= TopologyT<TApex,
+									MakeIndexSequence<STATE_COUNT>,
+									MakeIndexSequence<COMPO_REGIONS>,
+									MakeIndexSequence<ORTHO_REGIONS>>;
+
+	using CompoForks	= StaticArray<ShortIndex, COMPO_REGIONS>;
+	using AllForks		= AllForksT<COMPO_REGIONS, ORTHO_REGIONS, ORTHO_UNITS>;
+	using OrthoBits		= typename AllForks::Ortho::Bits;
+
+	using CompoRemains	= BitArray<ShortIndex, COMPO_REGIONS>;
+	using CompoChanges	= BitArray<ShortIndex, COMPO_REGIONS>;
+	using ActiveStates	= BitArray<StateID, STATE_COUNT>;
+
+	HFSM_INLINE bool isActive	(const StateID stateId) const;
+	HFSM_INLINE bool isResumable(const StateID stateId) const;
+
+	HFSM_INLINE bool isPendingChange(const StateID stateId) const;
+	HFSM_INLINE bool isPendingEnter	(const StateID stateId) const;
+	HFSM_INLINE bool isPendingExit	(const StateID stateId) const;
+
+	HFSM_INLINE const Parent&	  forkParent(const ForkID forkId) const;
+
+	HFSM_INLINE OrthoBits resumableOrthoFork(const ForkID forkId);
+	HFSM_INLINE OrthoBits requestedOrthoFork(const ForkID forkId);
+
+	bool requestImmediate(const Request request);
+	void requestScheduled(const StateID stateId);
+
+	void clearRequests();
+
+	ActiveStates activeStates;
+
+	CompoForks compoActive{INVALID_SHORT_INDEX};
+	AllForks resumable;
+
+	AllForks requested;
+	CompoRemains compoRemains;
+
+	CompoChanges compoChanges;
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TContext,
+		  typename TConfig,
+		  typename TStateList,
+		  typename TRegionList,
+		  LongIndex NCompoCount,
+		  typename TPayload,
+		  LongIndex NTaskCapacity,
+		  typename TApex>
+struct StateRegistryT<ArgsT<TContext,
+							TConfig,
+							TStateList,
+							TRegionList,
+							NCompoCount,
+							0,
+							0,
+							TPayload,
+							NTaskCapacity,
+							TApex>>
+{
+	using StateList		= TStateList;
+	using RegionList	= TRegionList;
+	using Payload		= TPayload;
+	using Request		= RequestT<Payload>;
+
+	static constexpr LongIndex  STATE_COUNT = StateList::SIZE;
+	static constexpr ShortIndex COMPO_REGIONS = NCompoCount;
+
+	using Topology		= TopologyT<TApex,
+									MakeIndexSequence<STATE_COUNT>,
+									MakeIndexSequence<COMPO_REGIONS>,
+									MakeIndexSequence<0>>;
+
+	using CompoForks	= StaticArray<ShortIndex, COMPO_REGIONS>;
+	using AllForks		= AllForksT<COMPO_REGIONS, 0, 0>;
+	using CompoRemains	= BitArray<ShortIndex, COMPO_REGIONS>;
+	using CompoChanges	= BitArray<ShortIndex, COMPO_REGIONS>;
+	using ActiveStates	= BitArray<StateID, STATE_COUNT>;
+
+	HFSM_INLINE bool isActive	(const StateID stateId) const;
+	HFSM_INLINE bool isResumable(const StateID stateId) const;
+
+	HFSM_INLINE bool isPendingChange(const StateID stateId) const;
+	HFSM_INLINE bool isPendingEnter	(const StateID stateId) const;
+	HFSM_INLINE bool isPendingExit	(const StateID stateId) const;
+
+	HFSM_INLINE const Parent& forkParent(const ForkID forkId) const;
+
+	bool requestImmediate(const Request request);
+	void requestScheduled(const StateID stateId);
+
+	void clearRequests();
+
+	ActiveStates activeStates;
+
+	CompoForks compoActive{INVALID_SHORT_INDEX};
+	AllForks resumable;
+
+	AllForks requested;
+	CompoRemains compoRemains;
+
+	CompoChanges compoChanges;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NCC, LongIndex NOC, LongIndex NOU>
+void
+AllForksT<NCC, NOC, NOU>::clear() {
+	compo.fill(INVALID_SHORT_INDEX);
+	ortho.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TA, LongIndex... NS, LongIndex... NC, LongIndex... NO>
+constexpr Parent TopologyT<TA, IndexSequence<NS...>, IndexSequence<NC...>, IndexSequence<NO...>>::STATE_PARENTS[];
+
+template <typename TA, LongIndex... NS, LongIndex... NC, LongIndex... NO>
+constexpr Parent TopologyT<TA, IndexSequence<NS...>, IndexSequence<NC...>, IndexSequence<NO...>>::STATE_COMPOS[];
+
+template <typename TA, LongIndex... NS, LongIndex... NC, LongIndex... NO>
+constexpr Parent TopologyT<TA, IndexSequence<NS...>, IndexSequence<NC...>, IndexSequence<NO...>>::COMPO_PARENTS[];
+
+template <typename TA, LongIndex... NS, LongIndex... NC, LongIndex... NO>
+constexpr Parent TopologyT<TA, IndexSequence<NS...>, IndexSequence<NC...>, IndexSequence<NO...>>::ORTHO_PARENTS[];
+
+template <typename TA, LongIndex... NS, LongIndex... NC, LongIndex... NO>
+constexpr Units  TopologyT<TA, IndexSequence<NS...>, IndexSequence<NC...>, IndexSequence<NO...>>::ORTHO_UNITS[];
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::isActive(const StateID stateId) const {
+	return HFSM_CHECKED(stateId < STATE_COUNT) &&
+		activeStates.get(stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::isResumable(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (const Parent parent = Topology::STATE_COMPOS[stateId])
+			return parent.prong == resumable.compo[parent.forkId - 1];
+
+	return false;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::isPendingChange(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (const Parent parent = Topology::STATE_COMPOS[stateId])
+			return requested.compo[parent.forkId - 1] !=
+					   compoActive[parent.forkId - 1];
+
+	return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::isPendingEnter(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (const Parent parent = Topology::STATE_COMPOS[stateId])
+			return parent.prong !=	   compoActive[parent.forkId - 1] &&
+				   parent.prong == requested.compo[parent.forkId - 1];
+
+	return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::isPendingExit(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (const Parent parent = Topology::STATE_COMPOS[stateId])
+			return parent.prong ==	   compoActive[parent.forkId - 1] &&
+				   parent.prong != requested.compo[parent.forkId - 1];
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+const Parent&
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::forkParent(const ForkID forkId) const {
+	HFSM_ASSERT(forkId != 0);
+
+	return forkId > 0 ?
+		Topology::COMPO_PARENTS[ forkId - 1] :
+		Topology::ORTHO_PARENTS[-forkId - 1];
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+typename StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::OrthoBits
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::resumableOrthoFork(const ForkID forkId) {
+	HFSM_ASSERT(forkId < 0);
+	const Units& units = Topology::ORTHO_UNITS[-forkId - 1];
+
+	return resumable.ortho.bits(units);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+typename StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::OrthoBits
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::requestedOrthoFork(const ForkID forkId) {
+	HFSM_ASSERT(forkId < 0);
+	const Units& units = Topology::ORTHO_UNITS[-forkId - 1];
+
+	return requested.ortho.bits(units);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::requestImmediate(const Request request) {
+	if (request.stateId == 0)
+		return false;
+	else if (HFSM_CHECKED(request.stateId < STATE_COUNT)) {
+		Parent parent;
+
+		for (parent = Topology::STATE_PARENTS[request.stateId];
+			 parent;
+			 parent = forkParent(parent.forkId))
+		{
+			if (parent.forkId > 0) {
+				requested.compo[parent.forkId - 1] = parent.prong;
+				parent = forkParent(parent.forkId);
+
+				break;
+			} else if (parent.forkId < 0)
+				requestedOrthoFork(parent.forkId).set(parent.prong);
+			else
+				HFSM_BREAK();
+		}
+
+		for (; parent; parent = forkParent(parent.forkId)) {
+			if (parent.forkId > 0) {
+				compoRemains.set(parent.forkId - 1);
+
+				if (	compoActive[parent.forkId - 1] != parent.prong)
+					requested.compo[parent.forkId - 1]  = parent.prong;
+				else {
+					parent = forkParent(parent.forkId);
+					break;
+				}
+			} else if (parent.forkId < 0)
+				requestedOrthoFork(parent.forkId).set(parent.prong);
+			else
+				HFSM_BREAK();
+		}
+
+		for (; parent; parent = forkParent(parent.forkId)) {
+			if (parent.forkId > 0)
+				compoRemains.set(parent.forkId - 1);
+			else if (parent.forkId < 0)
+				requestedOrthoFork(parent.forkId).set(parent.prong);
+			else
+				HFSM_BREAK();
+		}
+	}
+
+	return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+void
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::requestScheduled(const StateID stateId) {
+	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
+		const Parent parent = Topology::STATE_PARENTS[stateId];
+
+		if (parent.forkId > 0) {
+			resumable.compo[parent.forkId - 1] = parent.prong;
+			compoChanges.set(parent.forkId - 1);
+		} else if (parent.forkId < 0)
+			resumableOrthoFork(parent.forkId).set(parent.prong);
+		else
+			HFSM_BREAK();
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, typename TPL, LongIndex NTC, typename TA>
+void
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, TPL, NTC, TA>>::clearRequests() {
+	compoRemains.clear();
+	requested.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::isActive(const StateID stateId) const {
+	return HFSM_CHECKED(stateId < STATE_COUNT) &&
+		activeStates.get(stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::isResumable(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (Parent parent = Topology::STATE_PARENTS[stateId]) {
+			HFSM_ASSERT(parent.forkId > 0);
+
+			return parent.prong == resumable.compo[parent.forkId - 1];
+		}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::isPendingChange(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (Parent parent = Topology::STATE_PARENTS[stateId]) {
+			HFSM_ASSERT(parent.forkId > 0);
+
+			return requested.compo[parent.forkId - 1] !=
+					   compoActive[parent.forkId - 1];
+		}
+
+	return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::isPendingEnter(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (Parent parent = Topology::STATE_PARENTS[stateId]) {
+			HFSM_ASSERT(parent.forkId > 0);
+
+			return parent.prong !=	   compoActive[parent.forkId - 1] &&
+				   parent.prong == requested.compo[parent.forkId - 1];
+		}
+
+	return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::isPendingExit(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (Parent parent = Topology::STATE_PARENTS[stateId]) {
+			HFSM_ASSERT(parent.forkId > 0);
+
+			return parent.prong ==	   compoActive[parent.forkId - 1] &&
+				   parent.prong != requested.compo[parent.forkId - 1];
+		}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
+const Parent&
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::forkParent(const ForkID forkId) const {
+	HFSM_ASSERT(forkId > 0);
+
+	return Topology::COMPO_PARENTS[forkId - 1];
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
+bool
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::requestImmediate(const Request request) {
+	if (request.stateId == 0)
+		return false;
+	else if (HFSM_CHECKED(request.stateId < STATE_COUNT)) {
+		Parent parent = Topology::STATE_PARENTS[request.stateId];
+
+		if (HFSM_CHECKED(parent)) {
+			HFSM_ASSERT(parent.forkId > 0);
+
+			requested.compo[parent.forkId - 1] = parent.prong;
+
+			for (parent = forkParent(parent.forkId);
+				 parent;
+				 parent = forkParent(parent.forkId))
+			{
+				HFSM_ASSERT(parent.forkId > 0);
+				compoRemains.set(parent.forkId - 1);
+
+				if (	compoActive[parent.forkId - 1] != parent.prong)
+					requested.compo[parent.forkId - 1]  = parent.prong;
+				else {
+					parent = forkParent(parent.forkId);
+					break;
+				}
+			}
+
+			for (; parent; parent = forkParent(parent.forkId)) {
+				HFSM_ASSERT(parent.forkId > 0);
+				compoRemains.set(parent.forkId - 1);
+			}
+		}
+	}
+
+	return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
+void
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::requestScheduled(const StateID stateId) {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	if (stateId < STATE_COUNT) {
+		const Parent parent = Topology::STATE_PARENTS[stateId];
+
+		if (HFSM_CHECKED(parent.forkId > 0)) {
+			resumable.compo[parent.forkId - 1] = parent.prong;
+			compoChanges.set(parent.forkId - 1);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, typename TPL, LongIndex NTC, typename TA>
+void
+StateRegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, TPL, NTC, TA>>::clearRequests() {
+	compoRemains.clear();
+	requested.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+// copy of the machine's active and resumable states, safe to query from other
+// threads while the owning thread runs transitions;
+// the machine writes the older of two buffers after every transition pass,
+// then makes it the latest one; single state queries are one atomic load,
+// full copies are retried only if the machine publishes twice during one
+
+template <typename TArgs>
+class PublishedStatesT final {
+	template <typename, typename>
+	friend class R_;
+
+	using Args				= TArgs;
+	using StateRegistry		= StateRegistryT<Args>;
+	using StateList			= typename StateRegistry::StateList;
+	using Topology			= typename StateRegistry::Topology;
+
+	static constexpr LongIndex  STATE_COUNT	  = StateRegistry::STATE_COUNT;
+	static constexpr ShortIndex COMPO_REGIONS = StateRegistry::COMPO_REGIONS;
+
+public:
+	using ActiveStates		= typename StateRegistry::ActiveStates;
+
+private:
+	using Word				= typename ActiveStates::Word;
+
+	static constexpr LongIndex ACTIVE_WORDS	   = ActiveStates::WORD_COUNT;
+
+	// resumable prongs of composite regions, one byte each
+	static constexpr LongIndex RESUMABLE_WORDS = (COMPO_REGIONS + sizeof(Word) - 1) / sizeof(Word);
+
+	struct Buffer {
+		// odd while being written
+		std::atomic<uint32_t> sequence;
+
+		std::atomic<Word> active[ACTIVE_WORDS];
+		std::atomic<Word> resumable[RESUMABLE_WORDS];
+	};
+
+public:
+	PublishedStatesT();
+
+	PublishedStatesT(const PublishedStatesT&) = delete;
+	PublishedStatesT& operator = (const PublishedStatesT&) = delete;
+
+	template <typename T>
+	static constexpr StateID stateId()							{ return StateList::template index<T>();	}
+
+	HFSM_INLINE bool isActive   (const StateID stateId) const;
+	HFSM_INLINE bool isResumable(const StateID stateId) const;
+
+	template <typename TState>
+	HFSM_INLINE bool isActive   () const						{ return isActive	(stateId<TState>());	}
+
+	template <typename TState>
+	HFSM_INLINE bool isResumable() const						{ return isResumable(stateId<TState>());	}
+
+	// all states from the same transition pass
+	void copyActiveStates(ActiveStates& states) const;
+
+private:
+	// called by the owning machine only
+	void publish(const StateRegistry& stateRegistry);
+
+	HFSM_INLINE const Buffer& latest() const	{ return _buffers[_latest.load(std::memory_order_acquire)];	}
+
+private:
+	Buffer _buffers[2];
+	std::atomic<ShortIndex> _latest;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TA>
+PublishedStatesT<TA>::PublishedStatesT() {
+	for (Buffer& buffer : _buffers) {
+		buffer.sequence.store(0, std::memory_order_relaxed);
+
+		for (auto& word : buffer.active)
+			word.store(0, std::memory_order_relaxed);
+
+		for (auto& word : buffer.resumable)
+			word.store(~Word{0}, std::memory_order_relaxed);
+	}
+
+	_latest.store(0, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+bool
+PublishedStatesT<TA>::isActive(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
+		const Word word = latest().active[stateId / ActiveStates::WORD_BITS].load(std::memory_order_relaxed);
+
+		return (word >> (stateId % ActiveStates::WORD_BITS) & 1) != 0;
+	}
+
+	return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+bool
+PublishedStatesT<TA>::isResumable(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (const Parent parent = Topology::STATE_COMPOS[stateId]) {
+			const LongIndex compo = parent.forkId - 1;
+			const Word word = latest().resumable[compo / sizeof(Word)].load(std::memory_order_relaxed);
+
+			return parent.prong == (ShortIndex) (word >> compo % sizeof(Word) * 8);
+		}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+void
+PublishedStatesT<TA>::copyActiveStates(ActiveStates& states) const {
+	for (;;) {
+		const Buffer& buffer = latest();
+
+		const uint32_t sequence = buffer.sequence.load(std::memory_order_acquire);
+		if (sequence & 1)
+			continue;
+
+		for (LongIndex i = 0; i < ACTIVE_WORDS; ++i)
+			states.setWord(i, buffer.active[i].load(std::memory_order_relaxed));
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (buffer.sequence.load(std::memory_order_relaxed) == sequence)
+			return;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+void
+PublishedStatesT<TA>::publish(const StateRegistry& stateRegistry) {
+	const ShortIndex next = _latest.load(std::memory_order_relaxed) ^ 1;
+	Buffer& buffer = _buffers[next];
+
+	const uint32_t sequence = buffer.sequence.load(std::memory_order_relaxed);
+	buffer.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	for (LongIndex i = 0; i < ACTIVE_WORDS; ++i)
+		buffer.active[i].store(stateRegistry.activeStates.word(i), std::memory_order_relaxed);
+
+	for (LongIndex i = 0; i < RESUMABLE_WORDS; ++i) {
+		Word word = 0;
+
+		for (LongIndex b = 0; b < sizeof(Word); ++b) {
+			const LongIndex compo = i * sizeof(Word) + b;
+			const ShortIndex prong = compo < COMPO_REGIONS ?
+				stateRegistry.resumable.compo[compo] : INVALID_SHORT_INDEX;
+
+			word |= (Word) prong << b * 8;
+		}
+
+		buffer.resumable[i].store(word, std::memory_order_relaxed);
+	}
+
+	buffer.sequence.store(sequence + 2, std::memory_order_release);
+	_latest.store(next, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HFSM_ENABLE_COROUTINES
+template <typename>
+class RoutinesT;
+#endif
+
+template <typename TArgs>
+class ControlT
+	: protected ProfilerLinkT<typename TArgs::Config_::Clock, TArgs::STATE_COUNT>
+{
+	template <typename, typename, typename>
+	friend struct S_;
+
+	template <typename, typename, Strategy, typename, typename...>
+	friend struct C_;
+
+	template <typename, typename, Execution, typename, typename...>
+	friend struct O_;
+
+	template <typename, typename>
+	friend class R_;
+
+	HFSM_IF_COROUTINES(template <typename> friend class RoutinesT);
+
+	using Args			= TArgs;
+	using Logger		= typename Args::Logger;
+	using Context		= typename Args::Context;
+	using Utility		= typename Args::Utility;
+	using Random_		= typename Args::Random_;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
+
+	using Recorder		= ReplayRecorderT<typename Args::Config_::Events,
+										  typename Args::Payload,
+										  Utility>;
+
+	using ProfilerLink	= ProfilerLinkT<typename Args::Config_::Clock,
+										Args::STATE_COUNT>;
+	using Profiler		= typename ProfilerLink::Profiler;
+
+public:
+	using StateRegistry	= StateRegistryT<Args>;
+
+	using PlanData		= PlanDataT<Args>;
+	using PlanStats		= typename PlanData::Stats;
+	using ConstPlan		= ConstPlanT<Args>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct Region {
+		HFSM_INLINE Region(ControlT& control,
+						   const RegionID id);
+
+		HFSM_INLINE ~Region();
+
+		ControlT& control;
+		const RegionID prevId;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+protected:
+	HFSM_INLINE ControlT(Context& context,
+						 Random_& random,
+						 StateRegistry& stateRegistry,
+						 PlanData& planData,
+						 Profiler* const profiler,
+						 Logger* const HFSM_IF_LOGGER(logger))
+		: ProfilerLink{profiler}
+		, _context{context}
+		, _random{random}
+		, _stateRegistry{stateRegistry}
+		, _planData{planData}
+		HFSM_IF_LOGGER(, _logger{logger})
+	{}
+
+
+	HFSM_INLINE void setRegion(const RegionID id);
+	HFSM_INLINE void resetRegion(const RegionID id);
+
+	HFSM_INLINE Utility random();
+
+public:
+	template <typename T>
+	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
+
+	template <typename T>
+	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
+
+	HFSM_INLINE Context& _()										{ return _context;							}
+	HFSM_INLINE Context& context()									{ return _context;							}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE bool isActive   (const StateID id) const			{ return _stateRegistry.isActive   (id);	}
+	HFSM_INLINE bool isResumable(const StateID id) const			{ return _stateRegistry.isResumable(id);	}
+
+	HFSM_INLINE bool isScheduled(const StateID id) const			{ return isResumable(id);					}
+
+	template <typename TState>
+	HFSM_INLINE bool isActive() const								{ return isActive	(stateId<TState>());	}
+
+	template <typename TState>
+	HFSM_INLINE bool isResumable() const							{ return isResumable(stateId<TState>());	}
+
+	template <typename TState>
+	HFSM_INLINE bool isScheduled() const							{ return isResumable(stateId<TState>());	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE const ConstPlan plan() const						{ return ConstPlan{_planData, _regionId};	}
+	HFSM_INLINE const ConstPlan plan(const RegionID id) const		{ return ConstPlan{_planData, id};			}
+
+protected:
+#if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
+	HFSM_INLINE Logger* logger()									{ return _logger;							}
+#endif
+
+protected:
+	Context& _context;
+	Random_& _random;
+	StateRegistry& _stateRegistry;
+	PlanData& _planData;
+	PlanStats* _planStats = nullptr;
+	RegionID _regionId = 0;
+	Recorder* _recorder = nullptr;
+	using ProfilerLink::_profiler;
+	HFSM_IF_COROUTINES(RoutinesT<Args>* _routines = nullptr);
+	HFSM_IF_LOGGER(Logger* _logger);
+
+	// set for prongs of parallel orthogonal regions
+	SpinLock* _serial = nullptr;
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+class PlanControlT
+	: public ControlT<TArgs>
+{
+	template <typename, typename, typename>
+	friend struct S_;
+
+	template <typename, typename, Strategy, typename, typename...>
+	friend struct C_;
+
+	template <typename, typename, Execution, typename, typename...>
+	friend struct O_;
+
+	template <typename, typename>
+	friend class R_;
+
+	HFSM_IF_COROUTINES(template <typename> friend class RoutinesT);
+
+	using Args			= TArgs;
+	using Context		= typename Args::Context;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
+
+	using Control		= ControlT<Args>;
+	using StateRegistry	= StateRegistryT<Args>;
+
+	using PlanData		= PlanDataT<Args>;
+
+public:
+	using Plan			= PlanT<Args>;
+	using ConstPlan		= ConstPlanT<Args>;
+
+protected:
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct Origin {
+		HFSM_INLINE Origin(PlanControlT& control_,
+						   const StateID id);
+
+		HFSM_INLINE ~Origin();
+
+		PlanControlT& control;
+		const StateID prevId;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct Region {
+		HFSM_INLINE Region(PlanControlT& control,
+						   const RegionID id,
+						   const StateID index,
+						   const LongIndex size);
+
+		HFSM_INLINE ~Region();
+
+		PlanControlT& control;
+		const RegionID prevId;
+		const LongIndex prevIndex;
+		const LongIndex prevSize;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	using Control::Control;
+
+	HFSM_INLINE void setOrigin  (const StateID id);
+	HFSM_INLINE void resetOrigin(const StateID id);
+
+	HFSM_INLINE void setRegion  (const RegionID id, const StateID index, const LongIndex size);
+	HFSM_INLINE void resetRegion(const RegionID id, const StateID index, const LongIndex size);
+
+public:
+	using Control::isActive;
+	using Control::isResumable;
+	using Control::isScheduled;
+
+	using Control::plan;
+
+	using Control::_;
+	using Control::context;
+
+	template <typename T>
+	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
+
+	template <typename T>
+	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE Plan plan()								{ return Plan{_planData, *_planStats, _regionId, _serial};			}
+	HFSM_INLINE Plan plan(const RegionID id)			{ return Plan{_planData, *_planStats, id, _serial};					}
+
+	template <typename TRegion>
+	HFSM_INLINE Plan plan()								{ return Plan{_planData, *_planStats, regionId<TRegion>(), _serial};	}
+
+	template <typename TRegion>
+	HFSM_INLINE Plan plan() const						{ return Plan{_planData, *_planStats, regionId<TRegion>(), _serial};	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+protected:
+	HFSM_INLINE		  PlanData&	planData()				{ return _planData;										}
+	HFSM_INLINE const PlanData&	planData() const		{ return _planData;										}
+
+protected:
+	using Control::_planData;
+	using Control::_planStats;
+	using Control::_regionId;
+	using Control::_serial;
+	HFSM_IF_LOGGER(using Control::_logger);
+
+	StateID _originId = 0;
+	StateID _regionIndex = 0;
+	LongIndex _regionSize = StateList::SIZE;
+	Status _status;
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+class FullControlT
+	: public PlanControlT<TArgs>
+{
+	template <typename, typename, typename>
+	friend struct S_;
+
+	template <typename, typename, Strategy, typename, typename...>
+	friend struct C_;
+
+	template <typename, typename, Execution, typename, typename...>
+	friend struct O_;
+
+	template <typename, typename>
+	friend class R_;
+
+	HFSM_IF_COROUTINES(template <typename> friend class RoutinesT);
+
+	using Args			= TArgs;
+	using Logger		= typename Args::Logger;
+	using Context		= typename Args::Context;
+	using Random_		= typename Args::Random_;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
+	using Payload		= typename Args::Payload;
+
+	using Control		= ControlT<Args>;
+	using StateRegistry	= StateRegistryT<Args>;
+	using Profiler		= ProfilerT<typename Args::Config_::Clock, Args::STATE_COUNT>;
+
+	using PlanControl	= PlanControlT<Args>;
+	using Origin		= typename PlanControl::Origin;
+	using Plan			= typename PlanControl::Plan;
+	using PlanData		= PlanDataT<Args>;
+
+	using Request		= RequestT <Payload>;
+	using Requests		= RequestsT<Payload, Args::COMPO_REGIONS>;
+	using PayloadPool	= PayloadPoolT<Payload, Args::PAYLOAD_CAPACITY>;
+
+protected:
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct Lock {
+		HFSM_INLINE Lock(FullControlT& control_);
+		HFSM_INLINE ~Lock();
+
+		FullControlT* const control;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+protected:
+	HFSM_INLINE FullControlT(Context& context,
+							 Random_& random,
+							 StateRegistry& stateRegistry,
+							 PlanData& planData,
+							 Requests& requests,
+							 PayloadPool& payloadPool,
+							 Profiler* const profiler,
+							 Logger* const logger)
+		: PlanControl{context, random, stateRegistry, planData, profiler, logger}
+		, _requests{requests}
+		, _payloadPool{payloadPool}
+	{}
+
+	// control of one prong of a parallel region, collecting its own requests
+	HFSM_INLINE FullControlT(FullControlT& parent,
+							 Requests& requests,
+							 SpinLock& serial);
+
+	template <typename TPayload>
+	HFSM_INLINE ShortIndex stagePayload(TPayload&& payload);
+
+	template <typename TState>
+	Status updatePlan(TState& headState, const Status subStatus);
+
+	template <typename TState>
+	Status buildPlanStatus();
+
+public:
+	using Control::isActive;
+	using Control::isResumable;
+	using Control::isScheduled;
+
+	using PlanControl::plan;
+
+	using Control::_;
+	using Control::context;
+
+	template <typename T>
+	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
+
+	template <typename T>
+	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void changeTo (const StateID id);
+	HFSM_INLINE void changeTo (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void changeTo (const StateID stateId, Payload&& payload);
+
+	HFSM_INLINE void restart  (const StateID id);
+	HFSM_INLINE void restart  (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void restart  (const StateID stateId, Payload&& payload);
+
+	HFSM_INLINE void resume	  (const StateID id);
+	HFSM_INLINE void resume   (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void resume   (const StateID stateId, Payload&& payload);
+
+	HFSM_INLINE void utilize  (const StateID id);
+	HFSM_INLINE void utilize  (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void utilize  (const StateID stateId, Payload&& payload);
+
+	HFSM_INLINE void randomize(const StateID id);
+	HFSM_INLINE void randomize(const StateID stateId, const Payload& payload);
+	HFSM_INLINE void randomize(const StateID stateId, Payload&& payload);
+
+	HFSM_INLINE void schedule (const StateID id);
+	HFSM_INLINE void schedule (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void schedule (const StateID stateId, Payload&& payload);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	template <typename TState>
+	HFSM_INLINE void changeTo ()								{ changeTo (stateId<TState>());					}
+
+	template <typename TState>
+	HFSM_INLINE void changeTo (const Payload& payload)			{ changeTo (stateId<TState>(), payload);		}
+
+	template <typename TState>
+	HFSM_INLINE void changeTo (Payload&& payload)				{ changeTo (stateId<TState>(), std::move(payload));	}
+
+	template <typename TState>
+	HFSM_INLINE void restart  ()								{ restart  (stateId<TState>());					}
+
+	template <typename TState>
+	HFSM_INLINE void restart  (const Payload& payload)			{ restart  (stateId<TState>(), payload);		}
+
+	template <typename TState>
+	HFSM_INLINE void restart  (Payload&& payload)				{ restart  (stateId<TState>(), std::move(payload));	}
+
+	template <typename TState>
+	HFSM_INLINE void resume   ()								{ resume   (stateId<TState>());					}
+
+	template <typename TState>
+	HFSM_INLINE void resume	  (const Payload& payload)			{ resume   (stateId<TState>(), payload);		}
+
+	template <typename TState>
+	HFSM_INLINE void resume	  (Payload&& payload)				{ resume   (stateId<TState>(), std::move(payload));	}
+
+	template <typename TState>
+	HFSM_INLINE void utilize  ()								{ utilize  (stateId<TState>());					}
+
+	template <typename TState>
+	HFSM_INLINE void utilize  (const Payload& payload)			{ utilize  (stateId<TState>(), payload);		}
+
+	template <typename TState>
+	HFSM_INLINE void utilize  (Payload&& payload)				{ utilize  (stateId<TState>(), std::move(payload));	}
+
+	template <typename TState>
+	HFSM_INLINE void randomize()								{ randomize(stateId<TState>());					}
+
+	template <typename TState>
+	HFSM_INLINE void randomize(const Payload& payload)			{ randomize(stateId<TState>(), payload);		}
+
+	template <typename TState>
+	HFSM_INLINE void randomize(Payload&& payload)				{ randomize(stateId<TState>(), std::move(payload));	}
+
+	template <typename TState>
+	HFSM_INLINE void schedule ()								{ schedule (stateId<TState>());					}
+
+	template <typename TState>
+	HFSM_INLINE void schedule (const Payload& payload)			{ schedule (stateId<TState>(), payload);		}
+
+	template <typename TState>
+	HFSM_INLINE void schedule (Payload&& payload)				{ schedule (stateId<TState>(), std::move(payload));	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void succeed();
+	HFSM_INLINE void fail();
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+protected:
+	using PlanControl::_planData;
+	using PlanControl::_planStats;
+	using PlanControl::_originId;
+	using PlanControl::_regionId;
+	using PlanControl::_regionIndex;
+	using PlanControl::_regionSize;
+	using PlanControl::_status;
+	HFSM_IF_LOGGER(using Control::_logger);
+
+	using Control::_context;
+	using Control::_random;
+	using Control::_stateRegistry;
+	using Control::_recorder;
+	using Control::_profiler;
+	HFSM_IF_COROUTINES(using Control::_routines);
+	using Control::_serial;
+
+	Requests& _requests;
+	PayloadPool& _payloadPool;
+	bool _locked = false;
+	ExecutorInterface* _executor = nullptr;
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+class GuardControlT
+	: public FullControlT<TArgs>
+{
+	template <typename, typename, typename>
+	friend struct S_;
+
+	template <typename, typename>
+	friend class R_;
+
+	using Args			= TArgs;
+	using Logger		= typename Args::Logger;
+	using Context		= typename Args::Context;
+	using Random_		= typename Args::Random_;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
+	using Payload		= typename Args::Payload;
+
+	using Control		= ControlT<Args>;
+	using StateRegistry	= StateRegistryT<Args>;
+	using Profiler		= ProfilerT<typename Args::Config_::Clock, Args::STATE_COUNT>;
+
+	using PlanControl	= PlanControlT<Args>;
+	using PlanData		= PlanDataT<Args>;
+
+	using FullControl	= FullControlT<Args>;
+
+	using PayloadPool	= PayloadPoolT<Payload, Args::PAYLOAD_CAPACITY>;
+
+public:
+	using Request		= RequestT <Payload>;
+	using Requests		= RequestsT<Payload, Args::COMPO_REGIONS>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+private:
+	HFSM_INLINE GuardControlT(Context& context,
+							  Random_& random,
+							  StateRegistry& stateRegistry,
+							  PlanData& planData,
+							  Requests& requests,
+							  const Requests& pendingChanges,
+							  PayloadPool& payloadPool,
+							  Profiler* const profiler,
+							  Logger* const logger)
+		: FullControl{context, random, stateRegistry, planData, requests, payloadPool, profiler, logger}
+		, _pending{pendingChanges}
+	{}
+
+	HFSM_INLINE bool cancelled() const							{ return _cancelled;							}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+public:
+	using Control::isActive;
+	using Control::isResumable;
+	using Control::isScheduled;
+
+	using PlanControl::plan;
+
+	using Control::_;
+	using Control::context;
+
+	template <typename T>
+	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
+
+	template <typename T>
+	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE bool isPendingChange(const StateID id) const	{ return _stateRegistry.isPendingChange(id);	}
+	HFSM_INLINE bool isPendingEnter	(const StateID id) const	{ return _stateRegistry.isPendingEnter (id);	}
+	HFSM_INLINE bool isPendingExit	(const StateID id) const	{ return _stateRegistry.isPendingExit  (id);	}
+
+	template <typename TState>
+	HFSM_INLINE bool isPendingChange()							{ return isPendingChange(stateId<TState>());	}
+
+	template <typename TState>
+	HFSM_INLINE bool isPendingEnter()							{ return isPendingEnter (stateId<TState>());	}
+
+	template <typename TState>
+	HFSM_INLINE bool isPendingExit()							{ return isPendingExit  (stateId<TState>());	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void cancelPendingTransitions();
+
+	HFSM_INLINE const Requests& pendingTransitions() const		{ return _pending;								}
+
+	// payload passed with a pending transition, nullptr if there was none
+	HFSM_INLINE const Payload* pendingPayload(const Request& request) const;
+
+private:
+	using FullControl::_stateRegistry;
+	using FullControl::_payloadPool;
+	using FullControl::_originId;
+	HFSM_IF_LOGGER(using FullControl::_logger);
+
+	bool _cancelled = false;
+	const Requests& _pending;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TA>
+ControlT<TA>::Region::Region(ControlT& control_,
+							 const RegionID id)
+	: control{control_}
+	, prevId{control._regionId}
+{
+	control.setRegion(id);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+ControlT<TA>::Region::~Region() {
+	control.resetRegion(prevId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TA>
+void
+ControlT<TA>::setRegion(const RegionID id) {
+	HFSM_ASSERT(_regionId <= id && id < RegionList::SIZE);
+
+	_regionId = id;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+void
+ControlT<TA>::resetRegion(const RegionID id) { //-V524
+	HFSM_ASSERT(id <= _regionId && _regionId < RegionList::SIZE);
+
+	_regionId = id;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+typename ControlT<TA>::Utility
+ControlT<TA>::random() {
+	// prongs of parallel regions share the generator and the recorder,
+	// the order of their draws is not deterministic
+	SpinGuard guard{_serial};
+
+	return _recorder ? _recorder->draw(_random) : _random.next();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TA>
+PlanControlT<TA>::Origin::Origin(PlanControlT& control_,
+								 const StateID id)
+	: control{control_}
+	, prevId{control._originId}
+{
+	control.setOrigin(id);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+PlanControlT<TA>::Origin::~Origin() {
+	control.resetOrigin(prevId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TA>
+PlanControlT<TA>::Region::Region(PlanControlT& control_,
+								 const RegionID id,
+								 const StateID index,
+								 const LongIndex size)
+	: control{control_}
+	, prevId{control._regionId}
+	, prevIndex{control._regionIndex}
+	, prevSize{control._regionSize}
+{
+	control.setRegion(id, index, size);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+PlanControlT<TA>::Region::~Region() {
+	control.resetRegion(prevId, prevIndex, prevSize);
+
+	control._status.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TA>
+void
+PlanControlT<TA>::setOrigin(const StateID id) {
+	HFSM_ASSERT(_regionId + _regionSize <= StateList::SIZE);
+	HFSM_ASSERT(_originId <= id && id < StateList::SIZE);
+
+	_originId = id;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+PlanControlT<TA>::resetOrigin(const StateID id) { //-V524
+	HFSM_ASSERT(_regionId + _regionSize <= StateList::SIZE);
+	HFSM_ASSERT(id <= _originId && _originId < StateList::SIZE);
+
+	_originId = id;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+void
+PlanControlT<TA>::setRegion(const RegionID id,
+							const StateID index,
+							const LongIndex size)
+{
+	HFSM_ASSERT(_regionId <= id && id <  RegionList::SIZE);
+	HFSM_ASSERT(_regionIndex <= index && index + size <= _regionIndex + _regionSize);
+
+	_regionId	 = id;
+	_regionIndex = index;
+	_regionSize	 = size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+PlanControlT<TA>::resetRegion(const RegionID id, //-V524
+							  const StateID index,
+							  const LongIndex size)
+{
+	HFSM_ASSERT(id <= _regionId && _regionId < RegionList::SIZE);
+	HFSM_ASSERT(index <= _regionIndex && _regionIndex + _regionSize <= index + size);
+
+	_regionId	 = id;
+	_regionIndex = index;
+	_regionSize	 = size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TA>
+FullControlT<TA>::FullControlT(FullControlT& parent,
+							   Requests& requests,
+							   SpinLock& serial)
+	: PlanControl{parent._context,
+				  parent._random,
+				  parent._stateRegistry,
+				  parent._planData,
+				  parent._profiler,
+				  HFSM_LOGGER_OR(parent._logger, nullptr)}
+	, _requests{requests}
+	, _payloadPool{parent._payloadPool}
+	, _locked{parent._locked}
+{
+	_serial		 = &serial;
+	_planStats	 = parent._planStats;
+	_recorder	 = parent._recorder;
+	_originId	 = parent._originId;
+	_regionId	 = parent._regionId;
+	_regionIndex = parent._regionIndex;
+	_regionSize	 = parent._regionSize;
+	HFSM_IF_COROUTINES(_routines = parent._routines);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+template <typename TPayload>
+ShortIndex
+FullControlT<TA>::stagePayload(TPayload&& payload) {
+	SpinGuard guard{_serial};
+
+	return _payloadPool.stage(std::forward<TPayload>(payload));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TA>
+FullControlT<TA>::Lock::Lock(FullControlT& control_)
+	: control(!control_._locked ? &control_ : nullptr)
+{
+	if (control)
+		control->_locked = true;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+FullControlT<TA>::Lock::~Lock() {
+	if (control)
+		control->_locked = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TA>
+template <typename TState>
+Status
+FullControlT<TA>::updatePlan(TState& headState,
+							 const Status subStatus)
+{
+	using State = TState;
+	static constexpr StateID STATE_ID = State::STATE_ID;
+
+	HFSM_ASSERT(subStatus);
+
+	if (subStatus.result == Status::FAILURE) {
+		_status.result = Status::FAILURE;
+		headState.wrapPlanFailed(*this);
+
+		if (Plan p = plan(_regionId))
+			p.clear();
+
+		return buildPlanStatus<State>();
+	} else if (subStatus.result == Status::SUCCESS) {
+		bool planned;
+
+		{
+			// other prongs of a parallel region may be reporting task statuses
+			// or editing their own plans, the plan here doesn't lock again
+			SpinGuard guard{_serial};
+
+			Plan p{_planData, *_planStats, _regionId, nullptr};
+			planned = (bool) p;
+
+			for (auto it = p.first(); it; ++it) {
+				if (isActive(it->origin) &&
+					_planData.tasksSuccesses.get(it->origin))
+				{
+					Origin origin{*this, STATE_ID};
+
+					changeTo(it->destination);
+
+					it.remove();
+				} else
+					break;
+			}
+		}
+
+		if (planned)
+			return Status{};
+		else {
+			_status.result = Status::SUCCESS;
+			headState.wrapPlanSucceeded(*this);
+
+			return buildPlanStatus<State>();
+		}
+	} else
+		return Status{};
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+template <typename TState>
+Status
+FullControlT<TA>::buildPlanStatus() {
+	using State = TState;
+	static constexpr StateID STATE_ID = State::STATE_ID;
+
+	SpinGuard guard{_serial};
+
+	switch (_status.result) {
+	case Status::NONE:
+		HFSM_BREAK();
+		break;
+
+	case Status::SUCCESS:
+		_planData.tasksSuccesses.template set<STATE_ID>();
+
+		HFSM_LOG_PLAN_STATUS(_regionId, StatusEvent::SUCCEEDED);
+		break;
+
+	case Status::FAILURE:
+		_planData.tasksFailures.template set<STATE_ID>();
+
+		HFSM_LOG_PLAN_STATUS(_regionId, StatusEvent::FAILED);
+		break;
+
+	default:
+		HFSM_BREAK();
+	}
+
+	return {_status.result};
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+void
+FullControlT<TA>::changeTo(const StateID stateId) {
+	if (!_locked) {
+		const Request request{Request::Type::CHANGE, stateId};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::CHANGE, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+FullControlT<TA>::changeTo(const StateID stateId,
+						   const Payload& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::CHANGE, stateId, stagePayload(payload)};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::CHANGE, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+FullControlT<TA>::changeTo(const StateID stateId,
+						   Payload&& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::CHANGE, stateId, stagePayload(std::move(payload))};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::CHANGE, stateId);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+void
+FullControlT<TA>::restart(const StateID stateId) {
+	if (!_locked) {
+		const Request request{Request::Type::RESTART, stateId};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::RESTART, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+FullControlT<TA>::restart(const StateID stateId,
+						  const Payload& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::RESTART, stateId, stagePayload(payload)};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::RESTART, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+FullControlT<TA>::restart(const StateID stateId,
+						  Payload&& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::RESTART, stateId, stagePayload(std::move(payload))};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::RESTART, stateId);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+void
+FullControlT<TA>::resume(const StateID stateId) {
+	if (!_locked) {
+		const Request request{Request::Type::RESUME, stateId};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::RESUME, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+FullControlT<TA>::resume(const StateID stateId,
+						 const Payload& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::RESUME, stateId, stagePayload(payload)};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::RESUME, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+void
+FullControlT<TA>::resume(const StateID stateId,
+						 Payload&& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::RESUME, stateId, stagePayload(std::move(payload))};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::RESUME, stateId);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TA>
+void
+FullControlT<TA>::utilize(const StateID stateId) {
+	if (!_locked) {
+		const Request request{Request::Type::UTILIZE, stateId};
+		_requests << request;
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
 
-	HFSM_INLINE void randomize(const StateID id);
-	HFSM_INLINE void randomize(const StateID stateId, const Payload& payload);
+		HFSM_LOG_TRANSITION(_originId, Transition::UTILIZE, stateId);
+	}
+}
 
-	HFSM_INLINE void schedule (const StateID id);
-	HFSM_INLINE void schedule (const StateID stateId, const Payload& payload);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TA>
+void
+FullControlT<TA>::utilize(const StateID stateId,
+						  const Payload& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::UTILIZE, stateId, stagePayload(payload)};
+		_requests << request;
 
-	template <typename TState>
-	HFSM_INLINE void changeTo ()								{ changeTo (stateId<TState>());					}
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
 
-	template <typename TState>
-	HFSM_INLINE void changeTo (const Payload& payload)			{ changeTo (stateId<TState>(), payload);		}
+		HFSM_LOG_TRANSITION(_originId, Transition::UTILIZE, stateId);
+	}
+}
 
-	template <typename TState>
-	HFSM_INLINE void restart  ()								{ restart  (stateId<TState>());					}
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <typename TState>
-	HFSM_INLINE void restart  (const Payload& payload)			{ restart  (stateId<TState>(), payload);		}
+template <typename TA>
+void
+FullControlT<TA>::utilize(const StateID stateId,
+						  Payload&& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::UTILIZE, stateId, stagePayload(std::move(payload))};
+		_requests << request;
 
-	template <typename TState>
-	HFSM_INLINE void resume   ()								{ resume   (stateId<TState>());					}
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
 
-	template <typename TState>
-	HFSM_INLINE void resume	  (const Payload& payload)			{ resume   (stateId<TState>(), payload);		}
+		HFSM_LOG_TRANSITION(_originId, Transition::UTILIZE, stateId);
+	}
+}
 
-	template <typename TState>
-	HFSM_INLINE void utilize  ()								{ utilize  (stateId<TState>());					}
+//------------------------------------------------------------------------------
 
-	template <typename TState>
-	HFSM_INLINE void utilize  (const Payload& payload)			{ utilize  (stateId<TState>(), payload);		}
+template <typename TA>
+void
+FullControlT<TA>::randomize(const StateID stateId) {
+	if (!_locked) {
+		const Request request{Request::Type::RANDOMIZE, stateId};
+		_requests << request;
 
-	template <typename TState>
-	HFSM_INLINE void randomize()								{ randomize(stateId<TState>());					}
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
 
-	template <typename TState>
-	HFSM_INLINE void randomize(const Payload& payload)			{ randomize(stateId<TState>(), payload);		}
+		HFSM_LOG_TRANSITION(_originId, Transition::RANDOMIZE, stateId);
+	}
+}
 
-	template <typename TState>
-	HFSM_INLINE void schedule ()								{ schedule (stateId<TState>());					}
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <typename TState>
-	HFSM_INLINE void schedule (const Payload& payload)			{ schedule (stateId<TState>(), payload);		}
+template <typename TA>
+void
+FullControlT<TA>::randomize(const StateID stateId,
+							const Payload& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::RANDOMIZE, stateId, stagePayload(payload)};
+		_requests << request;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
 
-	HFSM_INLINE void succeed();
-	HFSM_INLINE void fail();
+		HFSM_LOG_TRANSITION(_originId, Transition::RANDOMIZE, stateId);
+	}
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-protected:
-	using PlanControl::_planData;
-	using PlanControl::_originId;
-	using PlanControl::_regionId;
-	using PlanControl::_regionIndex;
-	using PlanControl::_regionSize;
-	using PlanControl::_status;
-	HFSM_IF_LOGGER(using Control::_logger);
+template <typename TA>
+void
+FullControlT<TA>::randomize(const StateID stateId,
+							Payload&& payload)
+{
+	if (!_locked) {
+		const Request request{Request::Type::RANDOMIZE, stateId, stagePayload(std::move(payload))};
+		_requests << request;
 
-	Requests& _requests;
-	bool _locked = false;
-};
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(_originId, Transition::RANDOMIZE, stateId);
+	}
+}
 
 //------------------------------------------------------------------------------
 
-template <typename TArgs>
-class GuardControlT
-	: public FullControlT<TArgs>
-{
-	template <typename, typename, typename>
-	friend struct S_;
+template <typename TA>
+void
+FullControlT<TA>::schedule(const StateID stateId) {
+	const Request transition{Request::Type::SCHEDULE, stateId};
+	_requests << transition;
 
-	template <typename, typename>
-	friend class R_;
+	HFSM_LOG_TRANSITION(_originId, Transition::SCHEDULE, stateId);
+}
 
-	using Args			= TArgs;
-	using Logger		= typename Args::Logger;
-	using Context		= typename Args::Context;
-	using Random_		= typename Args::Random_;
-	using StateList		= typename Args::StateList;
-	using RegionList	= typename Args::RegionList;
-	using Payload		= typename Args::Payload;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	using Control		= ControlT<Args>;
-	using StateRegistry	= StateRegistryT<Args>;
+template <typename TA>
+void
+FullControlT<TA>::schedule(const StateID stateId,
+						   const Payload& payload)
+{
+	const Request transition{Request::Type::SCHEDULE, stateId, stagePayload(payload)};
+	_requests << transition;
 
-	using PlanControl	= PlanControlT<Args>;
-	using PlanData		= PlanDataT<Args>;
+	HFSM_LOG_TRANSITION(_originId, Transition::SCHEDULE, stateId);
+}
 
-	using FullControl	= FullControlT<Args>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-public:
-	using Requests		= RequestsT<Payload, Args::COMPO_REGIONS>;
+template <typename TA>
+void
+FullControlT<TA>::schedule(const StateID stateId,
+						   Payload&& payload)
+{
+	const Request transition{Request::Type::SCHEDULE, stateId, stagePayload(std::move(payload))};
+	_requests << transition;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_LOG_TRANSITION(_originId, Transition::SCHEDULE, stateId);
+}
 
-private:
-	HFSM_INLINE GuardControlT(Context& context,
-							  Random_& random,
-							  StateRegistry& stateRegistry,
-							  PlanData& planData,
-							  Requests& requests,
-							  const Requests& pendingChanges,
-							  Logger* const logger)
-		: FullControl{context, random, stateRegistry, planData, requests, logger}
-		, _pending{pendingChanges}
-	{}
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE bool cancelled() const							{ return _cancelled;							}
+template <typename TA>
+void
+FullControlT<TA>::succeed() {
+	_status.result = Status::SUCCESS;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	SpinGuard guard{_serial};
 
-public:
-	using Control::isActive;
-	using Control::isResumable;
-	using Control::isScheduled;
+	_planData.tasksSuccesses.set(_originId);
 
-	using PlanControl::plan;
+	// TODO: promote taskSuccess all the way up for all regions without plans
+	if (_regionId < RegionList::SIZE && !_planData.planExists.get(_regionId)) {
+		HFSM_ASSERT(_regionIndex < StateList::SIZE);
 
-	using Control::_;
-	using Control::context;
+		_planData.tasksSuccesses.set(_regionIndex);
+	}
 
-	template <typename T>
-	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
+	HFSM_LOG_TASK_STATUS(_regionId, _originId, StatusEvent::SUCCEEDED);
+}
 
-	template <typename T>
-	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TA>
+void
+FullControlT<TA>::fail() {
+	_status.result = Status::FAILURE;
 
-	HFSM_INLINE bool isPendingChange(const StateID id) const	{ return _stateRegistry.isPendingChange(id);	}
-	HFSM_INLINE bool isPendingEnter	(const StateID id) const	{ return _stateRegistry.isPendingEnter (id);	}
-	HFSM_INLINE bool isPendingExit	(const StateID id) const	{ return _stateRegistry.isPendingExit  (id);	}
+	SpinGuard guard{_serial};
 
-	template <typename TState>
-	HFSM_INLINE bool isPendingChange()							{ return isPendingChange(stateId<TState>());	}
+	_planData.tasksFailures.set(_originId);
 
-	template <typename TState>
-	HFSM_INLINE bool isPendingEnter()							{ return isPendingEnter (stateId<TState>());	}
+	// TODO: promote taskFailure all the way up for all regions without plans
+	if (_regionId < RegionList::SIZE && !_planData.planExists.get(_regionId)) {
+		HFSM_ASSERT(_regionIndex < StateList::SIZE);
 
-	template <typename TState>
-	HFSM_INLINE bool isPendingExit()							{ return isPendingExit  (stateId<TState>());	}
+		_planData.tasksFailures.set(_regionIndex);
+	}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_LOG_TASK_STATUS(_regionId, _originId, StatusEvent::FAILED);
+}
 
-	HFSM_INLINE void cancelPendingTransitions();
+////////////////////////////////////////////////////////////////////////////////
 
-	HFSM_INLINE const Requests& pendingTransitions() const		{ return _pending;								}
+template <typename TA>
+void
+GuardControlT<TA>::cancelPendingTransitions() {
+	_cancelled = true;
 
-private:
-	using FullControl::_stateRegistry;
-	using FullControl::_originId;
-	HFSM_IF_LOGGER(using FullControl::_logger);
+	HFSM_LOG_CANCELLED_PENDING(_originId);
+}
 
-	bool _cancelled = false;
-	const Requests& _pending;
-};
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TA>
+const typename GuardControlT<TA>::Payload*
+GuardControlT<TA>::pendingPayload(const Request& request) const {
+	return request.payload != INVALID_SHORT_INDEX ?
+		&_payloadPool[request.payload] : nullptr;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 }
 }
+#ifdef HFSM_ENABLE_COROUTINES
 
 namespace hfsm2 {
 namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
+// coroutine frames are prefixed with the allocator they came from,
+// so they can be released from the promise's 'operator delete';
+// the machine scopes its allocator around calls to 'routine()'
 
-template <typename TA>
-ControlT<TA>::Region::Region(ControlT& control_,
-							 const RegionID id)
-	: control{control_}
-	, prevId{control._regionId}
-{
-	control.setRegion(id);
-}
+class RoutineAllocator {
+public:
+	static constexpr std::size_t HEADER = alignof(std::max_align_t);
 
-//------------------------------------------------------------------------------
+	struct Scope {
+		HFSM_INLINE Scope(RoutineAllocator& allocator)
+			: previous{current()}
+		{
+			current() = &allocator;
+		}
 
-template <typename TA>
-ControlT<TA>::Region::~Region() {
-	control.resetRegion(prevId);
-}
+		HFSM_INLINE ~Scope()									{ current() = previous;	}
+
+		RoutineAllocator* const previous;
+	};
+
+	static void* acquire(const std::size_t size) {
+		RoutineAllocator* const allocator = current();
+		HFSM_ASSERT(allocator);
 
-////////////////////////////////////////////////////////////////////////////////
+		return allocator ? allocator->allocate(size) : nullptr;
+	}
 
-template <typename TA>
-void
-ControlT<TA>::setRegion(const RegionID id) {
-	HFSM_ASSERT(_regionId <= id && id < RegionList::SIZE);
+	static void release(void* const frame) {
+		unsigned char* const header = static_cast<unsigned char*>(frame) - HEADER;
 
-	_regionId = id;
-}
+		(*reinterpret_cast<RoutineAllocator**>(header))->deallocate(frame);
+	}
 
-//------------------------------------------------------------------------------
+protected:
+	virtual void* allocate(const std::size_t size) = 0;
+	virtual void deallocate(void* const frame) = 0;
 
-template <typename TA>
-void
-ControlT<TA>::resetRegion(const RegionID id) { //-V524
-	HFSM_ASSERT(id <= _regionId && _regionId < RegionList::SIZE);
+private:
+	static RoutineAllocator*& current() {
+		static thread_local RoutineAllocator* allocator = nullptr;
 
-	_regionId = id;
-}
+		return allocator;
+	}
+};
 
-////////////////////////////////////////////////////////////////////////////////
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// fixed number of fixed-size frames, no heap allocations
 
-template <typename TA>
-PlanControlT<TA>::Origin::Origin(PlanControlT& control_,
-								 const StateID id)
-	: control{control_}
-	, prevId{control._originId}
+template <LongIndex NCapacity, LongIndex NFrameSize>
+class RoutineArenaT final
+	: public RoutineAllocator
 {
-	control.setOrigin(id);
-}
+public:
+	static constexpr LongIndex CAPACITY	  = NCapacity > 0 ? NCapacity : 1;
+	static constexpr LongIndex FRAME_SIZE = NFrameSize;
 
-//------------------------------------------------------------------------------
+private:
+	static constexpr std::size_t STRIDE = HEADER + (FRAME_SIZE + HEADER - 1) / HEADER * HEADER;
 
-template <typename TA>
-PlanControlT<TA>::Origin::~Origin() {
-	control.resetOrigin(prevId);
-}
+	using Used = BitArray<LongIndex, CAPACITY>;
+
+public:
+	HFSM_INLINE LongIndex count() const						{ return _used.count();	}
+
+protected:
+	// nullptr if the frame doesn't fit, see 'ConfigT<>::RoutineFrameSizeN<>'
+	void* allocate(const std::size_t size) override;
+	void deallocate(void* const frame) override;
+
+private:
+	alignas(HEADER) unsigned char _storage[CAPACITY * STRIDE];
+	Used _used;
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TA>
-PlanControlT<TA>::Region::Region(PlanControlT& control_,
-								 const RegionID id,
-								 const StateID index,
-								 const LongIndex size)
-	: control{control_}
-	, prevId{control._regionId}
-	, prevIndex{control._regionIndex}
-	, prevSize{control._regionSize}
-{
-	control.setRegion(id, index, size);
-}
+// unique address per event type, to match awaited events without RTTI
+template <typename TEvent>
+struct EventTag {
+	static constexpr char ID = 0;
+};
 
 //------------------------------------------------------------------------------
 
-template <typename TA>
-PlanControlT<TA>::Region::~Region() {
-	control.resetRegion(prevId, prevIndex, prevSize);
+template <typename>
+class RoutineT;
 
-	control._status.clear();
-}
+template <typename>
+class RoutinesT;
 
-////////////////////////////////////////////////////////////////////////////////
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// handed to the state's 'routine()', outlives the coroutine;
+// control() is only valid while the routine runs, i.e. between two co_await's
 
-template <typename TA>
-void
-PlanControlT<TA>::setOrigin(const StateID id) {
-	HFSM_ASSERT(_regionId + _regionSize <= StateList::SIZE);
-	HFSM_ASSERT(_originId <= id && id < StateList::SIZE);
+template <typename TArgs>
+class RoutineControlT final {
+	template <typename>
+	friend class RoutinesT;
 
-	_originId = id;
-}
+	using Args			= TArgs;
+	using Context		= typename Args::Context;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	using FullControl	= FullControlT<Args>;
+	using Plan			= PlanT<Args>;
 
-template <typename TA>
-void
-PlanControlT<TA>::resetOrigin(const StateID id) { //-V524
-	HFSM_ASSERT(_regionId + _regionSize <= StateList::SIZE);
-	HFSM_ASSERT(id <= _originId && _originId < StateList::SIZE);
+	enum class Wait : ShortIndex {
+		FRAMES,
+		EVENT,
+		PLAN,
+	};
 
-	_originId = id;
-}
+public:
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//------------------------------------------------------------------------------
+	struct Frames {
+		HFSM_INLINE bool await_ready() const noexcept						{ return count == 0;		}
+		HFSM_INLINE void await_suspend(std::coroutine_handle<>) noexcept	{ routine.waitFrames(count);	}
+		HFSM_INLINE void await_resume() const noexcept						{}
 
-template <typename TA>
-void
-PlanControlT<TA>::setRegion(const RegionID id,
-							const StateID index,
-							const LongIndex size)
-{
-	HFSM_ASSERT(_regionId <= id && id <  RegionList::SIZE);
-	HFSM_ASSERT(_regionIndex <= index && index + size <= _regionIndex + _regionSize);
+		RoutineControlT& routine;
+		const LongIndex count;
+	};
 
-	_regionId	 = id;
-	_regionIndex = index;
-	_regionSize	 = size;
-}
+	template <typename TEvent>
+	struct Event {
+		HFSM_INLINE bool await_ready() const noexcept						{ return false;				}
+		HFSM_INLINE void await_suspend(std::coroutine_handle<>) noexcept	{ routine.waitEvent(&EventTag<TEvent>::ID);	}
+		HFSM_INLINE const TEvent& await_resume() const noexcept				{ return *static_cast<const TEvent*>(routine._event);	}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		RoutineControlT& routine;
+	};
 
-template <typename TA>
-void
-PlanControlT<TA>::resetRegion(const RegionID id, //-V524
-							  const StateID index,
-							  const LongIndex size)
-{
-	HFSM_ASSERT(id <= _regionId && _regionId < RegionList::SIZE);
-	HFSM_ASSERT(index <= _regionIndex && _regionIndex + _regionSize <= index + size);
+	struct PlanCompletion {
+		HFSM_INLINE bool await_ready() noexcept								{ return !routine.plan();	}
+		HFSM_INLINE void await_suspend(std::coroutine_handle<>) noexcept	{ routine._wait = Wait::PLAN;	}
+		HFSM_INLINE void await_resume() const noexcept						{}
 
-	_regionId	 = id;
-	_regionIndex = index;
-	_regionSize	 = size;
-}
+		RoutineControlT& routine;
+	};
 
-////////////////////////////////////////////////////////////////////////////////
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TA>
-FullControlT<TA>::Lock::Lock(FullControlT& control_)
-	: control(!control_._locked ? &control_ : nullptr)
-{
-	if (control)
-		control->_locked = true;
-}
+	template <typename T>
+	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
 
-//------------------------------------------------------------------------------
+	template <typename T>
+	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
 
-template <typename TA>
-FullControlT<TA>::Lock::~Lock() {
-	if (control)
-		control->_locked = false;
-}
+	HFSM_INLINE FullControl& control()					{ HFSM_ASSERT(_control); return *_control;				}
 
-////////////////////////////////////////////////////////////////////////////////
+	HFSM_INLINE Context& _()							{ return control()._();									}
+	HFSM_INLINE Context& context()						{ return control().context();							}
 
-template <typename TA>
-template <typename TState>
-Status
-FullControlT<TA>::updatePlan(TState& headState,
-							 const Status subStatus)
-{
-	using State = TState;
-	static constexpr StateID STATE_ID = State::STATE_ID;
+	// plan of the region the routine's state is in
+	HFSM_INLINE Plan plan()								{ return control().plan();								}
 
-	HFSM_ASSERT(subStatus);
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	if (subStatus.result == Status::FAILURE) {
-		_status.result = Status::FAILURE;
-		headState.wrapPlanFailed(*this);
+	// resumes on the next update()
+	HFSM_INLINE Frames nextFrame()						{ return Frames{*this, 1};								}
 
-		if (Plan p = plan(_regionId))
-			p.clear();
+	// resumes on the 'count'-th update() from now
+	HFSM_INLINE Frames frames(const LongIndex count)	{ return Frames{*this, count};							}
 
-		return buildPlanStatus<State>();
-	} else if (subStatus.result == Status::SUCCESS) {
-		if (Plan p = plan(_regionId)) {
-			for (auto it = p.first(); it; ++it) {
-				if (isActive(it->origin) &&
-					_planData.tasksSuccesses.get(it->origin))
-				{
-					Origin origin{*this, STATE_ID};
+	// resumes on the next react() to 'TEvent', returns the event
+	template <typename TEvent>
+	HFSM_INLINE Event<TEvent> event()					{ return Event<TEvent>{*this};							}
 
-					changeTo(it->destination);
+	// resumes on the first update() without a plan in the routine's region
+	HFSM_INLINE PlanCompletion planCompletion()			{ return PlanCompletion{*this};							}
 
-					it.remove();
-				} else
-					break;
-			}
+private:
+	HFSM_INLINE void waitFrames(const LongIndex count)	{ _wait = Wait::FRAMES; _frames = count;				}
+	HFSM_INLINE void waitEvent (const char* const type)	{ _wait = Wait::EVENT;  _eventType = type;				}
 
-			return Status{};
-		} else {
-			_status.result = Status::SUCCESS;
-			headState.wrapPlanSucceeded(*this);
+private:
+	FullControl* _control = nullptr;
+	std::coroutine_handle<> _handle;
 
-			return buildPlanStatus<State>();
-		}
-	} else
-		return Status{};
-}
+	Wait _wait = Wait::FRAMES;
+	LongIndex _frames = 0;
+	const char* _eventType = nullptr;
+	const void* _event = nullptr;
+
+	StateID _stateId = INVALID_STATE_ID;
+};
 
 //------------------------------------------------------------------------------
+// return type of state routines:
+//
+//	Routine routine(RoutineControl& routine) {
+//		co_await routine.frames(3);
+//		routine.control().changeTo<Next>();
+//	}
+//
+// started suspended after the state's enter(), first resumed on the next
+// update(), destroyed before its exit(); frames come from the machine's arena
 
-template <typename TA>
-template <typename TState>
-Status
-FullControlT<TA>::buildPlanStatus() {
-	using State = TState;
-	static constexpr StateID STATE_ID = State::STATE_ID;
+template <typename TArgs>
+class RoutineT final {
+	template <typename>
+	friend class RoutinesT;
 
-	switch (_status.result) {
-	case Status::NONE:
-		HFSM_BREAK();
-		break;
+public:
+	struct promise_type {
+		static void* operator new(const std::size_t size) noexcept	{ return RoutineAllocator::acquire(size);		}
+		static void operator delete(void* const frame) noexcept		{ RoutineAllocator::release(frame);				}
 
-	case Status::SUCCESS:
-		_planData.tasksSuccesses.template set<STATE_ID>();
+		static RoutineT get_return_object_on_allocation_failure() noexcept	{ return RoutineT{};					}
 
-		HFSM_LOG_PLAN_STATUS(_regionId, StatusEvent::SUCCEEDED);
-		break;
+		RoutineT get_return_object() noexcept						{ return RoutineT{Handle::from_promise(*this)};	}
 
-	case Status::FAILURE:
-		_planData.tasksFailures.template set<STATE_ID>();
+		std::suspend_always initial_suspend() const noexcept		{ return {};									}
+		std::suspend_always final_suspend() const noexcept			{ return {};									}
 
-		HFSM_LOG_PLAN_STATUS(_regionId, StatusEvent::FAILED);
-		break;
+		void return_void() const noexcept							{}
+		void unhandled_exception() const noexcept					{ std::terminate();								}
+	};
 
-	default:
-		HFSM_BREAK();
+	using Handle = std::coroutine_handle<promise_type>;
+
+	HFSM_INLINE RoutineT() = default;
+
+	HFSM_INLINE RoutineT(RoutineT&& other) noexcept
+		: _handle{other._handle}
+	{
+		other._handle = nullptr;
 	}
 
-	return {_status.result};
-}
+	RoutineT(const RoutineT&) = delete;
+	RoutineT& operator = (const RoutineT&) = delete;
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE ~RoutineT()										{ if (_handle) _handle.destroy();				}
 
-template <typename TA>
-void
-FullControlT<TA>::changeTo(const StateID stateId) {
-	if (!_locked) {
-		const Request request{Request::Type::CHANGE, stateId};
-		_requests << request;
+	// false if the frame didn't fit into the arena
+	HFSM_INLINE explicit operator bool() const					{ return (bool) _handle;						}
 
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+private:
+	HFSM_INLINE explicit RoutineT(const Handle handle)
+		: _handle{handle}
+	{}
 
-		HFSM_LOG_TRANSITION(_originId, Transition::CHANGE, stateId);
-	}
-}
+private:
+	Handle _handle;
+};
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-template <typename TA>
-void
-FullControlT<TA>::changeTo(const StateID stateId,
-						   const Payload& payload)
-{
-	if (!_locked) {
-		const Request request{Request::Type::CHANGE, stateId, payload};
-		_requests << request;
+template <typename TState, typename TRoutineControl, typename = void>
+struct HasRoutine
+	: std::false_type
+{};
 
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+template <typename TState, typename TRoutineControl>
+struct HasRoutine<TState,
+				  TRoutineControl,
+				  decltype((void) std::declval<TState&>().routine(std::declval<TRoutineControl&>()))>
+	: std::true_type
+{};
 
-		HFSM_LOG_TRANSITION(_originId, Transition::CHANGE, stateId);
-	}
-}
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//------------------------------------------------------------------------------
+template <typename TArgs, typename TStateList>
+struct RoutineCountT;
 
-template <typename TA>
-void
-FullControlT<TA>::restart(const StateID stateId) {
-	if (!_locked) {
-		const Request request{Request::Type::RESTART, stateId};
-		_requests << request;
+template <typename TArgs, typename... TStates>
+struct RoutineCountT<TArgs, ITL_<TStates...>> {
+	static constexpr LongIndex VALUE = (0 + ... + (LongIndex) HasRoutine<TStates, RoutineControlT<TArgs>>::value);
+};
+
+//------------------------------------------------------------------------------
+// routines of the active states, owned by the machine;
+// each one is resumed from its state's update() / react()
 
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+template <typename TArgs>
+class RoutinesT final {
+	using Args				= TArgs;
+	using StateList			= typename Args::StateList;
 
-		HFSM_LOG_TRANSITION(_originId, Transition::RESTART, stateId);
-	}
-}
+	static constexpr LongIndex STATE_COUNT = Args::STATE_COUNT;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	using FullControl		= FullControlT<Args>;
+	using RoutineControl	= RoutineControlT<Args>;
+	using Routine			= RoutineT<Args>;
 
-template <typename TA>
-void
-FullControlT<TA>::restart(const StateID stateId,
-						  const Payload& payload)
-{
-	if (!_locked) {
-		const Request request{Request::Type::RESTART, stateId, payload};
-		_requests << request;
+public:
+	static constexpr LongIndex CAPACITY	= RoutineCountT<Args, StateList>::VALUE;
 
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+	using Arena				= RoutineArenaT<CAPACITY, Args::Config_::ROUTINE_FRAME_SIZE>;
 
-		HFSM_LOG_TRANSITION(_originId, Transition::RESTART, stateId);
-	}
-}
+public:
+	RoutinesT();
+	~RoutinesT();
 
-//------------------------------------------------------------------------------
+	RoutinesT(const RoutinesT&) = delete;
+	RoutinesT& operator = (const RoutinesT&) = delete;
 
-template <typename TA>
-void
-FullControlT<TA>::resume(const StateID stateId) {
-	if (!_locked) {
-		const Request request{Request::Type::RESUME, stateId};
-		_requests << request;
+	// frames in use
+	HFSM_INLINE LongIndex count() const							{ return _arena.count();	}
 
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+	// calls 'state.routine()' with the frame allocated from the arena
+	template <typename TState>
+	void start(const StateID stateId, TState& state);
+	void stop (const StateID stateId);
 
-		HFSM_LOG_TRANSITION(_originId, Transition::RESUME, stateId);
-	}
-}
+	void update(const StateID stateId, FullControl& control);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <typename TEvent>
+	void react(const StateID stateId, FullControl& control, const TEvent& event);
 
-template <typename TA>
-void
-FullControlT<TA>::resume(const StateID stateId,
-						 const Payload& payload)
-{
-	if (!_locked) {
-		const Request request{Request::Type::RESUME, stateId, payload};
-		_requests << request;
+private:
+	void resume(RoutineControl& routine, FullControl& control);
 
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+private:
+	RoutineControl _controls[STATE_COUNT];
+	Arena _arena;
+};
 
-		HFSM_LOG_TRANSITION(_originId, Transition::RESUME, stateId);
-	}
+////////////////////////////////////////////////////////////////////////////////
+
+}
 }
 
-//------------------------------------------------------------------------------
+namespace hfsm2 {
+namespace detail {
 
-template <typename TA>
-void
-FullControlT<TA>::utilize(const StateID stateId) {
-	if (!_locked) {
-		const Request request{Request::Type::UTILIZE, stateId};
-		_requests << request;
+////////////////////////////////////////////////////////////////////////////////
 
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+template <LongIndex NC, LongIndex NF>
+void*
+RoutineArenaT<NC, NF>::allocate(const std::size_t size) {
+	if (size <= FRAME_SIZE)
+		for (LongIndex i = 0; i < CAPACITY; ++i)
+			if (!_used.get(i)) {
+				_used.set(i);
 
-		HFSM_LOG_TRANSITION(_originId, Transition::UTILIZE, stateId);
-	}
+				unsigned char* const header = _storage + i * STRIDE;
+				*reinterpret_cast<RoutineAllocator**>(header) = this;
+
+				return header + HEADER;
+			}
+
+	HFSM_BREAK();
+
+	return nullptr;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TA>
+template <LongIndex NC, LongIndex NF>
 void
-FullControlT<TA>::utilize(const StateID stateId,
-						  const Payload& payload)
-{
-	if (!_locked) {
-		const Request request{Request::Type::UTILIZE, stateId, payload};
-		_requests << request;
-
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+RoutineArenaT<NC, NF>::deallocate(void* const frame) {
+	const std::size_t offset = static_cast<unsigned char*>(frame) - HEADER - _storage;
+	HFSM_ASSERT(offset % STRIDE == 0 && offset / STRIDE < CAPACITY);
 
-		HFSM_LOG_TRANSITION(_originId, Transition::UTILIZE, stateId);
-	}
+	_used.reset((LongIndex) (offset / STRIDE));
 }
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
 template <typename TA>
-void
-FullControlT<TA>::randomize(const StateID stateId) {
-	if (!_locked) {
-		const Request request{Request::Type::RANDOMIZE, stateId};
-		_requests << request;
-
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
-
-		HFSM_LOG_TRANSITION(_originId, Transition::RANDOMIZE, stateId);
-	}
+RoutinesT<TA>::RoutinesT() {
+	for (StateID i = 0; i < STATE_COUNT; ++i)
+		_controls[i]._stateId = i;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 template <typename TA>
-void
-FullControlT<TA>::randomize(const StateID stateId,
-							const Payload& payload)
-{
-	if (!_locked) {
-		const Request request{Request::Type::RANDOMIZE, stateId, payload};
-		_requests << request;
-
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
-
-		HFSM_LOG_TRANSITION(_originId, Transition::RANDOMIZE, stateId);
-	}
+RoutinesT<TA>::~RoutinesT() {
+	for (StateID i = 0; i < STATE_COUNT; ++i)
+		stop(i);
 }
 
 //------------------------------------------------------------------------------
 
 template <typename TA>
+template <typename TState>
 void
-FullControlT<TA>::schedule(const StateID stateId) {
-	const Request transition{Request::Type::SCHEDULE, stateId};
-	_requests << transition;
+RoutinesT<TA>::start(const StateID stateId,
+					 TState& state)
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+	RoutineControl& target = _controls[stateId];
+	HFSM_ASSERT(!target._handle);
 
-	HFSM_LOG_TRANSITION(_originId, Transition::SCHEDULE, stateId);
+	RoutineAllocator::Scope scope{_arena};
+	Routine routine = state.routine(target);
+
+	if (routine) {
+		target._handle	= routine._handle;
+		routine._handle	= nullptr;
+
+		target.waitFrames(1);
+	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 template <typename TA>
 void
-FullControlT<TA>::schedule(const StateID stateId,
-						   const Payload& payload)
-{
-	const Request transition{Request::Type::SCHEDULE, stateId, payload};
-	_requests << transition;
+RoutinesT<TA>::stop(const StateID stateId) {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+	RoutineControl& target = _controls[stateId];
 
-	HFSM_LOG_TRANSITION(_originId, Transition::SCHEDULE, stateId);
+	if (target._handle) {
+		target._handle.destroy();
+		target._handle = nullptr;
+	}
 }
 
 //------------------------------------------------------------------------------
 
 template <typename TA>
 void
-FullControlT<TA>::succeed() {
-	_status.result = Status::SUCCESS;
-
-	_planData.tasksSuccesses.set(_originId);
-
-	// TODO: promote taskSuccess all the way up for all regions without plans
-	if (_regionId < RegionList::SIZE && !_planData.planExists.get(_regionId)) {
-		HFSM_ASSERT(_regionIndex < StateList::SIZE);
+RoutinesT<TA>::update(const StateID stateId,
+					  FullControl& control)
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+	RoutineControl& routine = _controls[stateId];
 
-		_planData.tasksSuccesses.set(_regionIndex);
+	if (routine._handle &&
+		(routine._wait == RoutineControl::Wait::FRAMES ?
+			--routine._frames == 0 :
+		 routine._wait == RoutineControl::Wait::PLAN &&
+			!control.plan()))
+	{
+		resume(routine, control);
 	}
-
-	HFSM_LOG_TASK_STATUS(_regionId, _originId, StatusEvent::SUCCEEDED);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 template <typename TA>
+template <typename TEvent>
 void
-FullControlT<TA>::fail() {
-	_status.result = Status::FAILURE;
-
-	_planData.tasksFailures.set(_originId);
-
-	// TODO: promote taskFailure all the way up for all regions without plans
-	if (_regionId < RegionList::SIZE && !_planData.planExists.get(_regionId)) {
-		HFSM_ASSERT(_regionIndex < StateList::SIZE);
+RoutinesT<TA>::react(const StateID stateId,
+					 FullControl& control,
+					 const TEvent& event)
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+	RoutineControl& routine = _controls[stateId];
 
-		_planData.tasksFailures.set(_regionIndex);
+	if (routine._handle &&
+		routine._wait == RoutineControl::Wait::EVENT &&
+		routine._eventType == &EventTag<TEvent>::ID)
+	{
+		routine._event = &event;
+		resume(routine, control);
+		routine._event = nullptr;
 	}
-
-	HFSM_LOG_TASK_STATUS(_regionId, _originId, StatusEvent::FAILED);
 }
 
-////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
 
 template <typename TA>
 void
-GuardControlT<TA>::cancelPendingTransitions() {
-	_cancelled = true;
+RoutinesT<TA>::resume(RoutineControl& routine,
+					  FullControl& control)
+{
+	routine._control = &control;
+	routine._handle.resume();
+	routine._control = nullptr;
 
-	HFSM_LOG_CANCELLED_PENDING(_originId);
+	// prongs of parallel regions share the arena
+	if (routine._handle.done()) {
+		SpinGuard guard{control._serial};
+
+		stop(routine._stateId);
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -4332,6 +7393,8 @@ GuardControlT<TA>::cancelPendingTransitions() {
 }
 }
 
+#endif
+
 #ifdef HFSM_ENABLE_STRUCTURE_REPORT
 
 namespace hfsm2 {
@@ -4467,6 +7530,11 @@ protected:
 	using FullControl	= FullControlT <TArgs>;
 	using GuardControl	= GuardControlT<TArgs>;
 
+#ifdef HFSM_ENABLE_COROUTINES
+	using RoutineControl = RoutineControlT<TArgs>;
+	using Routine		= RoutineT<TArgs>;
+#endif
+
 public:
 	HFSM_INLINE void preEntryGuard(Context&)									{}
 
@@ -4730,7 +7798,7 @@ struct CSI_<TInitial>;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename, typename...>
+template <Execution, typename, typename...>
 struct OI_;
 
 template <typename...>
@@ -4757,9 +7825,9 @@ struct WrapT<	 CI_<TG, TH, TS...>> {
 	using Type = CI_<TG, TH, TS...>;
 };
 
-template <typename... TS>
-struct WrapT<	 OI_<TS...>> {
-	using Type = OI_<TS...>;
+template <Execution TX, typename TH, typename... TS>
+struct WrapT<	 OI_<TX, TH, TS...>> {
+	using Type = OI_<TX, TH, TS...>;
 };
 
 template <typename... TS>
@@ -4782,6 +7850,14 @@ struct SI_ final {
 
 	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
 	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
+
+	static constexpr Parent stateParent(const StateID, const StateID, const ShortIndex, const ShortIndex, const Parent parent) {
+		return std::is_same<Head, void>::value ? Parent{} : parent;
+	}
+
+	static constexpr Parent compoParent(const ShortIndex, const ShortIndex, const ShortIndex, const Parent)	{ return Parent{};	}
+	static constexpr Parent orthoParent(const ShortIndex, const ShortIndex, const ShortIndex, const Parent)	{ return Parent{};	}
+	static constexpr Units  orthoUnits (const ShortIndex, const ShortIndex, const ShortIndex)					{ return Units{};	}
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -4801,6 +7877,29 @@ struct CSI_<TInitial, TRemaining...> {
 
 	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
 	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
+	static constexpr Parent stateParent(const StateID id, const StateID first, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return id < first + Initial::STATE_COUNT ?
+			Initial  ::stateParent(id, first, compo, ortho, Parent{forkId, prong}) :
+			Remaining::stateParent(id, first + Initial::STATE_COUNT, compo + Initial::COMPO_REGIONS, ortho + Initial::ORTHO_REGIONS, forkId, prong + 1);
+	}
+
+	static constexpr Parent compoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return index < compo + Initial::COMPO_REGIONS ?
+			Initial  ::compoParent(index, compo, ortho, Parent{forkId, prong}) :
+			Remaining::compoParent(index, compo + Initial::COMPO_REGIONS, ortho + Initial::ORTHO_REGIONS, forkId, prong + 1);
+	}
+
+	static constexpr Parent orthoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return index < ortho + Initial::ORTHO_REGIONS ?
+			Initial  ::orthoParent(index, compo, ortho, Parent{forkId, prong}) :
+			Remaining::orthoParent(index, compo + Initial::COMPO_REGIONS, ortho + Initial::ORTHO_REGIONS, forkId, prong + 1);
+	}
+
+	static constexpr Units orthoUnits(const ShortIndex index, const ShortIndex ortho, const ShortIndex unit) {
+		return index < ortho + Initial::ORTHO_REGIONS ?
+			Initial  ::orthoUnits(index, ortho, unit) :
+			Remaining::orthoUnits(index, ortho + Initial::ORTHO_REGIONS, unit + Initial::ORTHO_UNITS);
+	}
 };
 
 template <typename TInitial>
@@ -4817,6 +7916,21 @@ struct CSI_<TInitial> {
 
 	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
 	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
+	static constexpr Parent stateParent(const StateID id, const StateID first, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return Initial::stateParent(id, first, compo, ortho, Parent{forkId, prong});
+	}
+
+	static constexpr Parent compoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return Initial::compoParent(index, compo, ortho, Parent{forkId, prong});
+	}
+
+	static constexpr Parent orthoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return Initial::orthoParent(index, compo, ortho, Parent{forkId, prong});
+	}
+
+	static constexpr Units orthoUnits(const ShortIndex index, const ShortIndex ortho, const ShortIndex unit) {
+		return Initial::orthoUnits(index, ortho, unit);
+	}
 };
 
 template <Strategy TStrategy, typename THead, typename... TSubStates>
@@ -4838,6 +7952,25 @@ struct CI_ final {
 
 	static constexpr LongIndex	STATE_COUNT	  = StateList::SIZE;
 	static constexpr ShortIndex	REGION_COUNT  = RegionList::SIZE;
+	static constexpr Parent stateParent(const StateID id, const StateID first, const ShortIndex compo, const ShortIndex ortho, const Parent parent) {
+		return id == first ?
+			HeadInfo ::stateParent(id, first, compo, ortho, parent) :
+			SubStates::stateParent(id, first + 1, compo + 1, ortho, (ForkID) (compo + 1), 0);
+	}
+
+	static constexpr Parent compoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const Parent parent) {
+		return index == compo ?
+			parent :
+			SubStates::compoParent(index, compo + 1, ortho, (ForkID) (compo + 1), 0);
+	}
+
+	static constexpr Parent orthoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const Parent) {
+		return SubStates::orthoParent(index, compo + 1, ortho, (ForkID) (compo + 1), 0);
+	}
+
+	static constexpr Units orthoUnits(const ShortIndex index, const ShortIndex ortho, const ShortIndex unit) {
+		return SubStates::orthoUnits(index, ortho, unit);
+	}
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -4854,6 +7987,30 @@ struct OSI_<TInitial, TRemaining...> {
 	static constexpr LongIndex  COMPO_PRONGS  =		Initial::COMPO_PRONGS  + Remaining::COMPO_PRONGS;
 	static constexpr ShortIndex ORTHO_REGIONS =		Initial::ORTHO_REGIONS + Remaining::ORTHO_REGIONS;
 	static constexpr ShortIndex ORTHO_UNITS	  =		Initial::ORTHO_UNITS   + Remaining::ORTHO_UNITS;
+
+	static constexpr Parent stateParent(const StateID id, const StateID first, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return id < first + Initial::STATE_COUNT ?
+			Initial  ::stateParent(id, first, compo, ortho, Parent{forkId, prong}) :
+			Remaining::stateParent(id, first + Initial::STATE_COUNT, compo + Initial::COMPO_REGIONS, ortho + Initial::ORTHO_REGIONS, forkId, prong + 1);
+	}
+
+	static constexpr Parent compoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return index < compo + Initial::COMPO_REGIONS ?
+			Initial  ::compoParent(index, compo, ortho, Parent{forkId, prong}) :
+			Remaining::compoParent(index, compo + Initial::COMPO_REGIONS, ortho + Initial::ORTHO_REGIONS, forkId, prong + 1);
+	}
+
+	static constexpr Parent orthoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return index < ortho + Initial::ORTHO_REGIONS ?
+			Initial  ::orthoParent(index, compo, ortho, Parent{forkId, prong}) :
+			Remaining::orthoParent(index, compo + Initial::COMPO_REGIONS, ortho + Initial::ORTHO_REGIONS, forkId, prong + 1);
+	}
+
+	static constexpr Units orthoUnits(const ShortIndex index, const ShortIndex ortho, const ShortIndex unit) {
+		return index < ortho + Initial::ORTHO_REGIONS ?
+			Initial  ::orthoUnits(index, ortho, unit) :
+			Remaining::orthoUnits(index, ortho + Initial::ORTHO_REGIONS, unit + Initial::ORTHO_UNITS);
+	}
 };
 
 template <typename TInitial>
@@ -4867,10 +8024,28 @@ struct OSI_<TInitial> {
 	static constexpr LongIndex  COMPO_PRONGS  = Initial::COMPO_PRONGS;
 	static constexpr ShortIndex ORTHO_REGIONS = Initial::ORTHO_REGIONS;
 	static constexpr ShortIndex ORTHO_UNITS	  = Initial::ORTHO_UNITS;
+
+	static constexpr Parent stateParent(const StateID id, const StateID first, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return Initial::stateParent(id, first, compo, ortho, Parent{forkId, prong});
+	}
+
+	static constexpr Parent compoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return Initial::compoParent(index, compo, ortho, Parent{forkId, prong});
+	}
+
+	static constexpr Parent orthoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const ForkID forkId, const ShortIndex prong) {
+		return Initial::orthoParent(index, compo, ortho, Parent{forkId, prong});
+	}
+
+	static constexpr Units orthoUnits(const ShortIndex index, const ShortIndex ortho, const ShortIndex unit) {
+		return Initial::orthoUnits(index, ortho, unit);
+	}
 };
 
-template <typename THead, typename... TSubStates>
+template <Execution TExecution, typename THead, typename... TSubStates>
 struct OI_ final {
+	static constexpr Execution EXECUTION = TExecution;
+
 	using Head				= THead;
 	using HeadInfo			= SI_<Head>;
 	using SubStates			= OSI_<TSubStates...>;
@@ -4878,14 +8053,36 @@ struct OI_ final {
 	using RegionList		= Merge<typename HeadInfo::StateList, typename SubStates::RegionList>;
 
 	static constexpr ShortIndex WIDTH		  = sizeof...(TSubStates);
+	static constexpr ShortIndex WIDTH_UNITS	  = (WIDTH + 7) / 8;
 	static constexpr LongIndex  REVERSE_DEPTH = SubStates::REVERSE_DEPTH + 1;
 	static constexpr ShortIndex COMPO_REGIONS = SubStates::COMPO_REGIONS;
 	static constexpr LongIndex  COMPO_PRONGS  = SubStates::COMPO_PRONGS;
 	static constexpr ShortIndex ORTHO_REGIONS = SubStates::ORTHO_REGIONS + 1;
-	static constexpr ShortIndex ORTHO_UNITS	  = SubStates::ORTHO_UNITS + (WIDTH + 7) / 8;
+	static constexpr ShortIndex ORTHO_UNITS	  = SubStates::ORTHO_UNITS + WIDTH_UNITS;
 
 	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
 	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
+	static constexpr Parent stateParent(const StateID id, const StateID first, const ShortIndex compo, const ShortIndex ortho, const Parent parent) {
+		return id == first ?
+			HeadInfo ::stateParent(id, first, compo, ortho, parent) :
+			SubStates::stateParent(id, first + 1, compo, ortho + 1, (ForkID) -ortho - 1, 0);
+	}
+
+	static constexpr Parent compoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const Parent) {
+		return SubStates::compoParent(index, compo, ortho + 1, (ForkID) -ortho - 1, 0);
+	}
+
+	static constexpr Parent orthoParent(const ShortIndex index, const ShortIndex compo, const ShortIndex ortho, const Parent parent) {
+		return index == ortho ?
+			parent :
+			SubStates::orthoParent(index, compo, ortho + 1, (ForkID) -ortho - 1, 0);
+	}
+
+	static constexpr Units orthoUnits(const ShortIndex index, const ShortIndex ortho, const ShortIndex unit) {
+		return index == ortho ?
+			Units{unit, WIDTH} :
+			SubStates::orthoUnits(index, ortho + 1, unit + WIDTH_UNITS);
+	}
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -4898,7 +8095,8 @@ template <typename TContext,
 		  LongIndex NOrthoCount,
 		  LongIndex NOrthoUnits,
 		  typename TPayload,
-		  LongIndex NTaskCapacity>
+		  LongIndex NTaskCapacity,
+		  typename TApex>
 struct ArgsT final {
 	using Context	 = TContext;
 
@@ -4912,6 +8110,7 @@ struct ArgsT final {
 	using StateList	 = TStateList;
 	using RegionList = TRegionList;
 	using Payload	 = TPayload;
+	using Apex		 = TApex;
 
 	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
 	static constexpr ShortIndex COMPO_REGIONS = NCompoCount;
@@ -4919,6 +8118,13 @@ struct ArgsT final {
 	static constexpr ShortIndex ORTHO_UNITS	  = NOrthoUnits;
 	static constexpr LongIndex  TASK_CAPACITY = NTaskCapacity;
 
+	static constexpr LongIndex  PAYLOAD_SLOTS = STATE_COUNT + COMPO_REGIONS * 2;
+
+	static constexpr LongIndex  PAYLOAD_CAPACITY = Config_::PAYLOAD_CAPACITY != INVALID_LONG_INDEX ?
+													   Config_::PAYLOAD_CAPACITY :
+												   PAYLOAD_SLOTS < INVALID_SHORT_INDEX ?
+													   PAYLOAD_SLOTS : INVALID_SHORT_INDEX - 1;
+
 	HFSM_IF_STRUCTURE(using StructureStateInfos = Array<StructureStateInfo, STATE_COUNT>);
 };
 
@@ -4946,12 +8152,18 @@ struct C_;
 template <typename, typename, Strategy, ShortIndex, typename...>
 struct CS_;
 
-template <typename, typename, typename, typename...>
+template <typename, typename, Execution, typename, typename...>
 struct O_;
 
 template <typename, typename>
 class RW_;
 
+template <typename, LongIndex>
+class MB_;
+
+template <typename, LongIndex, LongIndex>
+class MS_;
+
 //------------------------------------------------------------------------------
 
 template <typename, typename...>
@@ -4972,14 +8184,14 @@ struct MaterialT   <TN, TA, CI_<TG, TH,	TS...>> {
 	using Type = C_<TN, TA,		TG, TH,	TS...>;
 };
 
-template <typename TN, typename TA,			  typename... TS>
-struct MaterialT   <TN, TA, OI_<void,	   TS...>> {
-	using Type = O_<TN, TA,		Empty<TA>, TS...>;
+template <typename TN, typename TA, Execution TX,			 typename... TS>
+struct MaterialT   <TN, TA, OI_<TX, void,	   TS...>> {
+	using Type = O_<TN, TA,		TX, Empty<TA>, TS...>;
 };
 
-template <typename TN, typename TA, typename TH, typename... TS>
-struct MaterialT   <TN, TA, OI_<TH,	 TS...>> {
-	using Type = O_<TN, TA,		TH,	 TS...>;
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
+struct MaterialT   <TN, TA, OI_<TX, TH,	TS...>> {
+	using Type = O_<TN, TA,		TX, TH,	TS...>;
 };
 
 template <typename TN, typename... TS>
@@ -5017,16 +8229,27 @@ struct RF_ final {
 								ORTHO_REGIONS,
 								ORTHO_UNITS,
 								Payload,
-								TASK_CAPACITY>;
+								TASK_CAPACITY,
+								Apex>;
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	using Instance		= RW_<Config_, Apex>;
 
+	template <LongIndex NCapacity>
+	using Batch			= MB_<Instance, NCapacity>;
+
+	using Published		= PublishedStatesT<Args>;
+
 	using Control		= ControlT	   <Args>;
 	using FullControl	= FullControlT <Args>;
 	using GuardControl	= GuardControlT<Args>;
 
+#ifdef HFSM_ENABLE_COROUTINES
+	using RoutineControl = RoutineControlT<Args>;
+	using Routine		= RoutineT<Args>;
+#endif
+
 	using Injection		= InjectionT<Args>;
 
 	using State			= Empty<Args>;
@@ -5081,9 +8304,9 @@ struct InfoT<C_<TN, TA, TG, TH, TS...>> {
 	using Type = CI_<	   TG, TH, TS...>;
 };
 
-template <typename TN, typename TA, typename TH, typename... TS>
-struct InfoT<O_<TN, TA, TH, TS...>> {
-	using Type = OI_<			   TH, TS...>;
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
+struct InfoT<O_<TN, TA, TX, TH, TS...>> {
+	using Type = OI_<	   TX, TH, TS...>;
 };
 
 template <typename TN, typename TA, Strategy TG, ShortIndex NI, typename... TS>
@@ -5109,40 +8332,88 @@ template <typename TC = EmptyContext,
 		  typename TG = ::hfsm2::RandomT<TU>,
 		  typename TP = EmptyPayload,
 		  LongIndex NS = 4,
-		  LongIndex NT = INVALID_LONG_INDEX>
+		  LongIndex NT = INVALID_LONG_INDEX,
+		  typename TE = detail::TL_<>,
+		  LongIndex NJ = INVALID_LONG_INDEX,
+		  typename TK = void,
+		  typename TL = void,
+		  LongIndex NP = INVALID_LONG_INDEX,
+		  LongIndex NF = 256>
 struct ConfigT {
 	using Context = TC;
 
 	using Rank	  = TN;
 	using Utility = TU;
 	using Random_ = TG;
-	using Logger  = LoggerInterfaceT<Utility>;
+
+	// 'void' selects the virtual 'LoggerInterfaceT<>', any type
+	// with the same methods is called directly, see 'StaticLoggerT<>'
+	using Logger  = typename std::conditional<std::is_same<TL, void>::value,
+											  LoggerInterfaceT<Utility>,
+											  TL>::type;
 
 	using Payload = TP;
+	using Events  = TE;
+
+	// clock sampled around state methods, 'void' disables profiling
+	using Clock	  = TK;
 
 	static constexpr LongIndex SUBSTITUTION_LIMIT = NS;
+
+	// plan tasks shared by all regions, defaults to two per composite prong;
+	// size from the machine's 'taskHighWater()' to trim plan storage
 	static constexpr LongIndex TASK_CAPACITY	  = NT;
 
+	// composite regions at least this wide dispatch to the active prong
+	// through a flat table instead of a binary search over the sub-states
+	static constexpr LongIndex JUMP_TABLE_WIDTH	  = NJ;
+
+	// payload slots shared by state data and transitions in flight,
+	// defaults to one per state and two per composite region
+	static constexpr LongIndex PAYLOAD_CAPACITY	  = NP;
+
+	// bytes available to the coroutine frame of each state routine,
+	// with 'HFSM_ENABLE_COROUTINES'
+	static constexpr LongIndex ROUTINE_FRAME_SIZE = NF;
+
 	template <typename T>
-	using ContextT			 = ConfigT< T, TN, TU, TG, TP, NS, NT>;
+	using ContextT			 = ConfigT< T, TN, TU, TG, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
 
 	template <typename T>
-	using RankT				 = ConfigT<TC,  T, TU, TG, TP, NS, NT>;
+	using RankT				 = ConfigT<TC,  T, TU, TG, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
 
 	template <typename T>
-	using UtilityT			 = ConfigT<TC, TN,  T, TG, TP, NS, NT>;
+	using UtilityT			 = ConfigT<TC, TN,  T, TG, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
 
 	template <typename T>
-	using RandomT			 = ConfigT<TC, TN, TU,  T, TP, NS, NT>;
+	using RandomT			 = ConfigT<TC, TN, TU,  T, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
+
+	template <typename T>
+	using PayloadT			 = ConfigT<TC, TN, TU, TG,  T, NS, NT, TE, NJ, TK, TL, NP, NF>;
+
+	template <LongIndex N>
+	using SubstitutionLimitN = ConfigT<TC, TN, TU, TG, TP,  N, NT, TE, NJ, TK, TL, NP, NF>;
+
+	template <LongIndex N>
+	using TaskCapacityN		 = ConfigT<TC, TN, TU, TG, TP, NS,  N, TE, NJ, TK, TL, NP, NF>;
+
+	template <typename... Ts>
+	using EventsT			 = ConfigT<TC, TN, TU, TG, TP, NS, NT, detail::TL_<Ts...>, NJ, TK, TL, NP, NF>;
+
+	template <LongIndex N>
+	using JumpTableN		 = ConfigT<TC, TN, TU, TG, TP, NS, NT, TE,  N, TK, TL, NP, NF>;
+
+	template <typename T = CycleClock>
+	using ProfilerT			 = ConfigT<TC, TN, TU, TG, TP, NS, NT, TE, NJ,  T, TL, NP, NF>;
 
 	template <typename T>
-	using PayloadT			 = ConfigT<TC, TN, TU, TG,  T, NS, NT>;
+	using LoggerT			 = ConfigT<TC, TN, TU, TG, TP, NS, NT, TE, NJ, TK,  T, NP, NF>;
 
 	template <LongIndex N>
-	using SubstitutionLimitN = ConfigT<TC, TN, TU, TG, TP,  N, NS>;
+	using PayloadCapacityN	 = ConfigT<TC, TN, TU, TG, TP, NS, NT, TE, NJ, TK, TL,  N, NF>;
 
 	template <LongIndex N>
-	using TaskCapacityN		 = ConfigT<TC, TN, TU, TG, TP, NT,  N>;
+	using RoutineFrameSizeN	 = ConfigT<TC, TN, TU, TG, TP, NS, NT, TE, NJ, TK, TL, NP,  N>;
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -5207,10 +8478,19 @@ struct M_ {
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	template <typename THead, typename... TSubStates>
-	using Orthogonal		  = OI_<THead, TSubStates...>;
+	using Orthogonal		  = OI_<Execution::Sequential, THead, TSubStates...>;
+
+	template <				  typename... TSubStates>
+	using OrthogonalPeers	  = OI_<Execution::Sequential, void,  TSubStates...>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	// prongs update() on the executor attached with 'attachExecutor()'
+	template <typename THead, typename... TSubStates>
+	using ParallelOrthogonal	  = OI_<Execution::Parallel,   THead, TSubStates...>;
 
 	template <				  typename... TSubStates>
-	using OrthogonalPeers	  = OI_<void,  TSubStates...>;
+	using ParallelOrthogonalPeers = OI_<Execution::Parallel,   void,  TSubStates...>;
 
 	//----------------------------------------------------------------------
 
@@ -5242,15 +8522,23 @@ struct M_ {
 	using RandomRoot		  = RF_<Config_, Random		<THead, TSubStates...>>;
 
 	template <				  typename... TSubStates>
-	using RandomPeerRoot	  = RF_<Config_, RandomPeers	 <  TSubStates...>>;
+	using RandomPeerRoot	  = RF_<Config_, RandomPeers	 <  TSubStates...>>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	template <typename THead, typename... TSubStates>
+	using OrthogonalRoot	  = RF_<Config_, Orthogonal <THead, TSubStates...>>;
+
+	template <				  typename... TSubStates>
+	using OrthogonalPeerRoot  = RF_<Config_, OrthogonalPeers <  TSubStates...>>;
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	template <typename THead, typename... TSubStates>
-	using OrthogonalRoot	  = RF_<Config_, Orthogonal <THead, TSubStates...>>;
+	using ParallelOrthogonalRoot	 = RF_<Config_, ParallelOrthogonal	   <THead, TSubStates...>>;
 
 	template <				  typename... TSubStates>
-	using OrthogonalPeerRoot  = RF_<Config_, OrthogonalPeers <  TSubStates...>>;
+	using ParallelOrthogonalPeerRoot = RF_<Config_, ParallelOrthogonalPeers<	  TSubStates...>>;
 
 	//----------------------------------------------------------------------
 };
@@ -5264,6 +8552,15 @@ using Machine = detail::M_<Config>;
 template <typename TConfig>
 using MachineT = detail::M_<TConfig>;
 
+template <typename TInstance, LongIndex NCapacity>
+using MachineBatch = detail::MB_<TInstance, NCapacity>;
+
+template <typename TContext, LongIndex NShards, LongIndex NCapacity>
+using MachineScheduler = detail::MS_<TContext, NShards, NCapacity>;
+
+template <typename TEvent, LongIndex NCapacity>
+using EventQueue = detail::EventQueueT<TEvent, NCapacity>;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 }
@@ -5294,8 +8591,9 @@ struct S_ {
 	using RequestType	= typename Request::Type;
 
 	using Control		= ControlT<Args>;
+	using Sample		= typename Control::Profiler::Sample;
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
+	using Topology		= typename StateRegistry::Topology;
 
 	using PlanControl	= PlanControlT<Args>;
 	using ScopedOrigin	= typename PlanControl::Origin;
@@ -5305,9 +8603,11 @@ struct S_ {
 
 	using Empty			= ::hfsm2::detail::Empty<Args>;
 
-	HFSM_INLINE Parent	stateParent			 (Control& control)	{ return control._stateRegistry.stateParents[STATE_ID]; }
+#ifdef HFSM_ENABLE_COROUTINES
+	using RoutineControl = RoutineControlT<Args>;
 
-	HFSM_INLINE void	deepRegister		 (StateRegistry& stateRegistry, const Parent parent);
+	static constexpr bool HAS_ROUTINE = HasRoutine<Head, RoutineControl>::value;
+#endif
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -5327,6 +8627,16 @@ struct S_ {
 
 	HFSM_INLINE void	deepExit			 (PlanControl&	control);
 
+#ifdef HFSM_ENABLE_COROUTINES
+	HFSM_INLINE void	startRoutine		 (PlanControl&	control);
+	HFSM_INLINE void	stopRoutine			 (PlanControl&	control);
+
+	HFSM_INLINE void	updateRoutine		 (FullControl&	control);
+
+	template <typename TEvent>
+	HFSM_INLINE void	reactRoutine		 (FullControl&	control, const TEvent& event);
+#endif
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	HFSM_INLINE void	wrapPlanSucceeded	 (FullControl&	control);
@@ -5355,7 +8665,7 @@ struct S_ {
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void   deepEnterRequested	(Control&)										{}
+	HFSM_INLINE void   deepEnterRequested	(Control& control)		{ control._stateRegistry.activeStates.template set<STATE_ID>();	}
 	HFSM_INLINE void   deepChangeToRequested(Control&)										{}
 
 #if defined _DEBUG || defined HFSM_ENABLE_STRUCTURE_REPORT || defined HFSM_ENABLE_LOG_INTERFACE
@@ -5413,59 +8723,13 @@ struct S_ {
 namespace hfsm2 {
 namespace detail {
 
-//------------------------------------------------------------------------------
-
-namespace {
-
-template <StateID NS, typename TA, typename TH>
-struct RegisterT {
-	using StateParents	= StaticArray<Parent, TA::STATE_COUNT>;
-	using StateList		= typename TA::StateList;
-
-	static constexpr StateID STATE_ID = NS;
-
-	static HFSM_INLINE
-	void
-	execute(StateParents& stateParents,
-			const Parent parent)
-	{
-		static constexpr auto HEAD_ID = StateList::template index<TH>();
-		StaticAssertEquality<STATE_ID, HEAD_ID>();
-
-		stateParents[STATE_ID] = parent;
-	}
-};
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-template <StateID NS, typename TA>
-struct RegisterT<NS, TA, Empty<TA>> {
-	using StateParents	= StaticArray<Parent, TA::STATE_COUNT>;
-
-	static HFSM_INLINE
-	void
-	execute(StateParents&, const Parent) {}
-};
-
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, typename TH>
-void
-S_<TN, TA, TH>::deepRegister(StateRegistry& stateRegistry,
-							 const Parent parent)
-{
-	using Register = RegisterT<STATE_ID, TA, Head>;
-	Register::execute(stateRegistry.stateParents, parent);
-}
-
-//------------------------------------------------------------------------------
-
 template <typename TN, typename TA, typename TH>
 bool
 S_<TN, TA, TH>::deepEntryGuard(GuardControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::entryGuard, Method::ENTRY_GUARD);
+	const Sample sample{control._profiler, STATE_ID, Method::ENTRY_GUARD};
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -5486,11 +8750,16 @@ S_<TN, TA, TH>::deepEnter(PlanControl& control) {
 	HFSM_ASSERT(!control.planData().tasksFailures .template get<STATE_ID>());
 
 	HFSM_LOG_STATE_METHOD(&Head::enter, Method::ENTER);
+	const Sample sample{control._profiler, STATE_ID, Method::ENTER};
 
 	ScopedOrigin origin{control, STATE_ID};
 
+	control._stateRegistry.activeStates.template set<STATE_ID>();
+
 	_head.widePreEnter(control.context());
 	_head.enter(control);
+
+	HFSM_IF_COROUTINES(startRoutine(control));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -5502,11 +8771,16 @@ S_<TN, TA, TH>::deepReenter(PlanControl& control) {
 	HFSM_ASSERT(!control.planData().tasksFailures .template get<STATE_ID>());
 
 	HFSM_LOG_STATE_METHOD(&Head::reenter, Method::REENTER);
+	const Sample sample{control._profiler, STATE_ID, Method::REENTER};
 
 	ScopedOrigin origin{control, STATE_ID};
 
+	HFSM_IF_COROUTINES(stopRoutine(control));
+
 	_head.widePreReenter(control.context());
 	_head.reenter(control);
+
+	HFSM_IF_COROUTINES(startRoutine(control));
 }
 
 //------------------------------------------------------------------------------
@@ -5515,12 +8789,15 @@ template <typename TN, typename TA, typename TH>
 Status
 S_<TN, TA, TH>::deepUpdate(FullControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::update, Method::UPDATE);
+	const Sample sample{control._profiler, STATE_ID, Method::UPDATE};
 
 	ScopedOrigin origin{control, STATE_ID};
 
 	_head.widePreUpdate(control.context());
 	_head.update(control);
 
+	HFSM_IF_COROUTINES(updateRoutine(control));
+
 	return control._status;
 }
 
@@ -5534,12 +8811,15 @@ S_<TN, TA, TH>::deepReact(FullControl& control,
 {
 	auto reaction = static_cast<void(Head::*)(const TEvent&, FullControl&)>(&Head::react);
 	HFSM_LOG_STATE_METHOD(reaction, Method::REACT);
+	const Sample sample{control._profiler, STATE_ID, Method::REACT};
 
 	ScopedOrigin origin{control, STATE_ID};
 
 	_head.widePreReact(event, control.context());
 	(_head.*reaction)(event, control);				//_head.react(event, control);
 
+	HFSM_IF_COROUTINES(reactRoutine(control, event));
+
 	return control._status;
 }
 
@@ -5549,6 +8829,7 @@ template <typename TN, typename TA, typename TH>
 bool
 S_<TN, TA, TH>::deepExitGuard(GuardControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::exitGuard, Method::EXIT_GUARD);
+	const Sample sample{control._profiler, STATE_ID, Method::EXIT_GUARD};
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -5566,9 +8847,12 @@ template <typename TN, typename TA, typename TH>
 void
 S_<TN, TA, TH>::deepExit(PlanControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::exit, Method::EXIT);
+	const Sample sample{control._profiler, STATE_ID, Method::EXIT};
 
 	ScopedOrigin origin{control, STATE_ID};
 
+	HFSM_IF_COROUTINES(stopRoutine(control));
+
 	// if you see..
 	// VS	 - error C2039:  'exit': is not a member of 'Blah'
 	// Clang - error : no member named 'exit' in 'Blah'
@@ -5577,16 +8861,66 @@ S_<TN, TA, TH>::deepExit(PlanControl& control) {
 	_head.exit(control);
 	_head.widePostExit(control.context());
 
+	control._stateRegistry.activeStates.template reset<STATE_ID>();
+
 	control.planData().tasksSuccesses.template reset<STATE_ID>();
 	control.planData().tasksFailures .template reset<STATE_ID>();
 }
 
 //------------------------------------------------------------------------------
 
+#ifdef HFSM_ENABLE_COROUTINES
+
+template <typename TN, typename TA, typename TH>
+void
+S_<TN, TA, TH>::startRoutine(PlanControl& control) {
+	if constexpr (HAS_ROUTINE)
+		if (auto* const routines = control._routines)
+			routines->start(STATE_ID, _head);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, typename TH>
+void
+S_<TN, TA, TH>::stopRoutine(PlanControl& control) {
+	if constexpr (HAS_ROUTINE)
+		if (auto* const routines = control._routines)
+			routines->stop(STATE_ID);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, typename TH>
+void
+S_<TN, TA, TH>::updateRoutine(FullControl& control) {
+	if constexpr (HAS_ROUTINE)
+		if (auto* const routines = control._routines)
+			routines->update(STATE_ID, control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, typename TH>
+template <typename TEvent>
+void
+S_<TN, TA, TH>::reactRoutine(FullControl& control,
+							 const TEvent& event)
+{
+	if constexpr (HAS_ROUTINE)
+		if (auto* const routines = control._routines)
+			routines->react(STATE_ID, control, event);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
 template <typename TN, typename TA, typename TH>
 void
 S_<TN, TA, TH>::wrapPlanSucceeded(FullControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::planSucceeded, Method::PLAN_SUCCEEDED);
+	const Sample sample{control._profiler, STATE_ID, Method::PLAN_SUCCEEDED};
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -5599,6 +8933,7 @@ template <typename TN, typename TA, typename TH>
 void
 S_<TN, TA, TH>::wrapPlanFailed(FullControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::planFailed, Method::PLAN_FAILED);
+	const Sample sample{control._profiler, STATE_ID, Method::PLAN_FAILED};
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -5611,6 +8946,7 @@ template <typename TN, typename TA, typename TH>
 typename TA::Rank
 S_<TN, TA, TH>::wrapRank(Control& control) {
 	HFSM_LOG_STATE_METHOD(&Head::rank, Method::RANK);
+	const Sample sample{control._profiler, STATE_ID, Method::RANK};
 
 	return _head.rank(static_cast<const Control&>(control));
 }
@@ -5621,6 +8957,7 @@ template <typename TN, typename TA, typename TH>
 typename TA::Utility
 S_<TN, TA, TH>::wrapUtility(Control& control) {
 	HFSM_LOG_STATE_METHOD(&Head::utility, Method::UTILITY);
+	const Sample sample{control._profiler, STATE_ID, Method::UTILITY};
 
 	return _head.utility(static_cast<const Control&>(control));
 }
@@ -5632,7 +8969,7 @@ typename TA::UP
 S_<TN, TA, TH>::deepReportChange(Control& control) {
 	const Utility utility = wrapUtility(control);
 
-	const Parent parent = stateParent(control);
+	const Parent parent = Topology::STATE_PARENTS[STATE_ID];
 
 	return {utility, parent.prong};
 }
@@ -5643,7 +8980,7 @@ template <typename TN, typename TA, typename TH>
 typename TA::UP
 S_<TN, TA, TH>::deepReportUtilize(Control& control) {
 	const Utility utility = wrapUtility(control);
-	const Parent  parent  = stateParent(control);
+	const Parent  parent  = Topology::STATE_PARENTS[STATE_ID];
 
 	return {utility, parent.prong};
 }
@@ -5756,7 +9093,6 @@ struct CS_ {
 	using RequestType	= typename Request::Type;
 
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
 
 	using Control		= ControlT	   <Args>;
 	using PlanControl	= PlanControlT <Args>;
@@ -5790,7 +9126,6 @@ struct CS_ {
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	wideRegister				  (StateRegistry& stateRegistry, const Parent parent);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -5812,6 +9147,17 @@ struct CS_ {
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+	template <ShortIndex NProng, typename TFunctor>
+	HFSM_INLINE typename TFunctor::Result wideVisit(TFunctor& functor)						{ return wideVisit<NProng>(functor, std::integral_constant<bool, (NProng < R_PRONG)>{});	}
+
+	template <ShortIndex NProng, typename TFunctor>
+	HFSM_INLINE typename TFunctor::Result wideVisit(TFunctor& functor, std::true_type)		{ return lHalf.template wideVisit<NProng>(functor);	}
+
+	template <ShortIndex NProng, typename TFunctor>
+	HFSM_INLINE typename TFunctor::Result wideVisit(TFunctor& functor, std::false_type)	{ return rHalf.template wideVisit<NProng>(functor);	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 	HFSM_INLINE void	wideForwardActive			  (Control& control,	 const RequestType request,	const ShortIndex prong);
 	HFSM_INLINE void	wideForwardRequest			  (Control& control,	 const RequestType request,	const ShortIndex prong);
 
@@ -5908,7 +9254,6 @@ struct CS_<TIndices, TArgs, TStrategy, NIndex, TState> {
 	using RequestType	= typename Request::Type;
 
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
 
 	using Control		= ControlT	   <Args>;
 	using PlanControl	= PlanControlT <Args>;
@@ -5924,7 +9269,6 @@ struct CS_<TIndices, TArgs, TStrategy, NIndex, TState> {
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	wideRegister				  (StateRegistry& stateRegistry, const Parent parent);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -5946,6 +9290,15 @@ struct CS_<TIndices, TArgs, TStrategy, NIndex, TState> {
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+	template <ShortIndex NProng, typename TFunctor>
+	HFSM_INLINE typename TFunctor::Result wideVisit(TFunctor& functor) {
+		static_assert(NProng == PRONG_INDEX, "");
+
+		return functor(state);
+	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 	HFSM_INLINE void	wideForwardActive			  (Control& control,	 const RequestType request,	const ShortIndex prong);
 	HFSM_INLINE void	wideForwardRequest			  (Control& control,	 const RequestType request,	const ShortIndex prong);
 
@@ -6003,17 +9356,6 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, Strategy TG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, TG, NI, TS...>::wideRegister(StateRegistry& stateRegistry,
-										 const Parent parent)
-{
-	lHalf.wideRegister(stateRegistry, Parent{parent.forkId, L_PRONG});
-	rHalf.wideRegister(stateRegistry, Parent{parent.forkId, R_PRONG});
-}
-
-//------------------------------------------------------------------------------
-
 template <typename TN, typename TA, Strategy TG, ShortIndex NI, typename... TS>
 bool
 CS_<TN, TA, TG, NI, TS...>::wideForwardEntryGuard(GuardControl& control,
@@ -6386,16 +9728,6 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, Strategy TG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, TG, NI, T>::wideRegister(StateRegistry& stateRegistry,
-									 const Parent parent)
-{
-	state.deepRegister(stateRegistry, Parent{parent.forkId, PRONG_INDEX});
-}
-
-//------------------------------------------------------------------------------
-
 template <typename TN, typename TA, Strategy TG, ShortIndex NI, typename T>
 bool
 CS_<TN, TA, TG, NI, T>::wideForwardEntryGuard(GuardControl& control,
@@ -6740,7 +10072,6 @@ struct C_ {
 	using RequestType	= typename Request::Type;
 
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
 
 	using Control		= ControlT<Args>;
 
@@ -6769,6 +10100,12 @@ struct C_ {
 	using Info			= CI_<STRATEGY, Head, TSubStates...>;
 	static constexpr ShortIndex REGION_SIZE	= Info::STATE_COUNT;
 
+	static constexpr bool JUMP_TABLE = Info::WIDTH >= Args::Config_::JUMP_TABLE_WIDTH;
+
+	using Dispatch		= typename std::conditional<JUMP_TABLE,
+													MakeIndexSequence<Info::WIDTH>,
+													std::false_type>::type;
+
 	HFSM_INLINE ShortIndex& compoActive   (StateRegistry& stateRegistry)	{ return stateRegistry.compoActive	  [COMPO_INDEX]; }
 	HFSM_INLINE ShortIndex& compoResumable(StateRegistry& stateRegistry)	{ return stateRegistry.resumable.compo[COMPO_INDEX]; }
 	HFSM_INLINE ShortIndex& compoRequested(StateRegistry& stateRegistry)	{ return stateRegistry.requested.compo[COMPO_INDEX]; }
@@ -6782,8 +10119,68 @@ struct C_ {
 										   const Rank	(& ranks)  [Info::WIDTH], const Rank	top);
 
 	HFSM_INLINE bool	compoRemain		  (Control& control)				{ return control._stateRegistry.compoRemains.template get<COMPO_INDEX>(); }
+	HFSM_INLINE void	compoChanged	  (Control& control)				{ control._stateRegistry.compoChanges.template set<COMPO_INDEX>();		 }
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct Enterer {
+		using Result = void;
+
+		HFSM_INLINE void operator () (SubStates& subStates, const ShortIndex prong)	{ subStates.wideEnter(control, prong);	}
+
+		template <typename TState>
+		HFSM_INLINE void operator () (TState& state)								{ state.deepEnter(control);				}
+
+		PlanControl& control;
+	};
+
+	struct Exiter {
+		using Result = void;
+
+		HFSM_INLINE void operator () (SubStates& subStates, const ShortIndex prong)	{ subStates.wideExit(control, prong);	}
+
+		template <typename TState>
+		HFSM_INLINE void operator () (TState& state)								{ state.deepExit(control);				}
+
+		PlanControl& control;
+	};
+
+	struct Updater {
+		using Result = Status;
+
+		HFSM_INLINE Status operator () (SubStates& subStates, const ShortIndex prong)	{ return subStates.wideUpdate(control, prong);	}
+
+		template <typename TState>
+		HFSM_INLINE Status operator () (TState& state)									{ return state.deepUpdate(control);				}
+
+		FullControl& control;
+	};
+
+	template <typename TEvent>
+	struct Reactor {
+		using Result = Status;
+
+		HFSM_INLINE Status operator () (SubStates& subStates, const ShortIndex prong)	{ return subStates.wideReact(control, event, prong);	}
+
+		template <typename TState>
+		HFSM_INLINE Status operator () (TState& state)									{ return state.deepReact(control, event);				}
+
+		FullControl& control;
+		const TEvent& event;
+	};
+
+	template <typename TFunctor>
+	HFSM_INLINE typename TFunctor::Result wideDispatch(TFunctor&& functor, const ShortIndex prong)		{ return wideDispatch(functor, prong, Dispatch{});	}
+
+	template <typename TFunctor>
+	HFSM_INLINE typename TFunctor::Result wideDispatch(TFunctor& functor, const ShortIndex prong, std::false_type)	{ return functor(_subStates, prong);	}
+
+	template <typename TFunctor, LongIndex... NProngs>
+	HFSM_INLINE typename TFunctor::Result wideDispatch(TFunctor& functor, const ShortIndex prong, IndexSequence<NProngs...>);
+
+	template <typename TFunctor, LongIndex NProng>
+	static typename TFunctor::Result wideDispatchProng(SubStates& subStates, TFunctor& functor)	{ return subStates.template wideVisit<(ShortIndex) NProng>(functor);	}
 
-	HFSM_INLINE void	deepRegister				  (StateRegistry& stateRegistry, const Parent parent);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -6915,6 +10312,24 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename TN, typename TA, Strategy TG, typename TH, typename... TS>
+template <typename TFunctor, LongIndex... NProngs>
+typename TFunctor::Result
+C_<TN, TA, TG, TH, TS...>::wideDispatch(TFunctor& functor,
+										const ShortIndex prong,
+										IndexSequence<NProngs...>)
+{
+	using Thunk = typename TFunctor::Result (*)(SubStates&, TFunctor&);
+
+	static const Thunk THUNKS[] = { &wideDispatchProng<TFunctor, NProngs>... };
+
+	HFSM_ASSERT(prong < Info::WIDTH);
+
+	return THUNKS[prong](_subStates, functor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 template <typename TN, typename TA, Strategy TG, typename TH, typename... TS>
 ShortIndex
 C_<TN, TA, TG, TH, TS...>::resolveRandom(Control& control,
@@ -6923,7 +10338,7 @@ C_<TN, TA, TG, TH, TS...>::resolveRandom(Control& control,
 										 const Rank(& ranks)[Info::WIDTH],
 										 const Rank top)
 {
-	const Utility random = control._random.next();
+	const Utility random = control.random();
 	HFSM_ASSERT(0.0f <= random && random < 1.0f);
 
 	Utility cursor = random * sum;
@@ -6947,19 +10362,6 @@ C_<TN, TA, TG, TH, TS...>::resolveRandom(Control& control,
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy TG, typename TH, typename... TS>
-void
-C_<TN, TA, TG, TH, TS...>::deepRegister(StateRegistry& stateRegistry,
-										const Parent parent)
-{
-	stateRegistry.compoParents[COMPO_INDEX] = parent;
-
-	_headState.deepRegister(stateRegistry, parent);
-	_subStates.wideRegister(stateRegistry, Parent{COMPO_ID});
-}
-
-//------------------------------------------------------------------------------
-
 template <typename TN, typename TA, Strategy TG, typename TH, typename... TS>
 bool
 C_<TN, TA, TG, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
@@ -7012,8 +10414,9 @@ C_<TN, TA, TG, TH, TS...>::deepEnter(PlanControl& control) {
 		resumable = INVALID_SHORT_INDEX;
 
 	requested = INVALID_SHORT_INDEX;
+	compoChanged(control);
 
-	_subStates.wideEnter(control, active);
+	wideDispatch(Enterer{control}, active);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -7035,14 +10438,16 @@ C_<TN, TA, TG, TH, TS...>::deepReenter(PlanControl& control) {
 	if (active == requested)
 		_subStates.wideReenter(control, active);
 	else {
-		_subStates.wideExit	  (control, active);
+		wideDispatch(Exiter {control}, active);
 
 		active	  = requested;
 
 		if (requested == resumable)
 			resumable = INVALID_SHORT_INDEX;
 
-		_subStates.wideEnter  (control, active);
+		compoChanged(control);
+
+		wideDispatch(Enterer{control}, active);
 	}
 
 	requested = INVALID_SHORT_INDEX;
@@ -7060,11 +10465,11 @@ C_<TN, TA, TG, TH, TS...>::deepUpdate(FullControl& control) {
 
 	if (const Status headStatus = _headState.deepUpdate(control)) {
 		ControlLock lock{control};
-		_subStates.wideUpdate(control, active);
+		wideDispatch(Updater{control}, active);
 
 		return headStatus;
 	} else {
-		const Status subStatus = _subStates.wideUpdate(control, active);
+		const Status subStatus = wideDispatch(Updater{control}, active);
 
 		if (subStatus.outerTransition)
 			return Status{Status::NONE, true};
@@ -7091,11 +10496,11 @@ C_<TN, TA, TG, TH, TS...>::deepReact(FullControl& control,
 
 	if (const Status headStatus = _headState.deepReact(control, event)) {
 		ControlLock lock{control};
-		_subStates.wideReact(control, event, active);
+		wideDispatch(Reactor<TEvent>{control, event}, active);
 
 		return headStatus;
 	} else {
-		const Status subStatus = _subStates.wideReact(control, event, active);
+		const Status subStatus = wideDispatch(Reactor<TEvent>{control, event}, active);
 
 		if (subStatus.outerTransition)
 			return subStatus;
@@ -7147,11 +10552,12 @@ C_<TN, TA, TG, TH, TS...>::deepExit(PlanControl& control) {
 
 	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
 
-	_subStates.wideExit(control, active);
+	wideDispatch(Exiter {control}, active);
 	_headState.deepExit(control);
 
 	resumable = active;
 	active	  = INVALID_SHORT_INDEX;
+	compoChanged(control);
 
 	auto plan = control.plan(REGION_ID);
 	plan.clear();
@@ -7552,9 +10958,10 @@ C_<TN, TA, TG, TH, TS...>::deepEnterRequested(PlanControl& control) {
 
 	active	  = requested;
 	requested = INVALID_SHORT_INDEX;
+	compoChanged(control);
 
 	_headState.deepEnter(control);
-	_subStates.wideEnter(control, active);
+	wideDispatch(Enterer{control}, active);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -7571,19 +10978,20 @@ C_<TN, TA, TG, TH, TS...>::deepChangeToRequested(PlanControl& control) {
 	if (requested == INVALID_SHORT_INDEX)
 		_subStates.wideChangeToRequested(control, active);
 	else if (requested != active) {
-		_subStates.wideExit	  (control, active);
+		wideDispatch(Exiter {control}, active);
 
 		resumable = active;
 		active	  = requested;
 		requested = INVALID_SHORT_INDEX;
+		compoChanged(control);
 
-		_subStates.wideEnter  (control, active);
+		wideDispatch(Enterer{control}, active);
 	} else if (compoRemain(control)) {
-		_subStates.wideExit	  (control, active);
+		wideDispatch(Exiter {control}, active);
 
 		requested = INVALID_SHORT_INDEX;
 
-		_subStates.wideEnter  (control, active);
+		wideDispatch(Enterer{control}, active);
 	} else {
 		requested = INVALID_SHORT_INDEX;
 
@@ -7647,7 +11055,6 @@ struct OS_<TIndices, TArgs, NIndex, TInitial, TRemaining...> {
 	using RequestType	= typename Request::Type;
 
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
 	using OrthoForks	= typename StateRegistry::AllForks::Ortho;
 	using ProngBits		= typename OrthoForks::Bits;
 	using ProngConstBits= typename OrthoForks::ConstBits;
@@ -7676,7 +11083,6 @@ struct OS_<TIndices, TArgs, NIndex, TInitial, TRemaining...> {
 
 	using Info	= OSI_<TInitial, TRemaining...>;
 
-	HFSM_INLINE void	wideRegister		 (StateRegistry& stateRegistry, const ForkID forkId);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -7688,6 +11094,7 @@ struct OS_<TIndices, TArgs, NIndex, TInitial, TRemaining...> {
 	HFSM_INLINE void	wideReenter			 (PlanControl& control);
 
 	HFSM_INLINE Status	wideUpdate			 (FullControl& control);
+	HFSM_INLINE Status	wideUpdate			 (FullControl& control, const ShortIndex prong);
 
 	template <typename TEvent>
 	HFSM_INLINE Status	wideReact			 (FullControl& control, const TEvent& event);
@@ -7761,7 +11168,6 @@ struct OS_<TIndices, TArgs, NIndex, TInitial> {
 	using RequestType	= typename Request::Type;
 
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
 	using OrthoForks	= typename StateRegistry::AllForks::Ortho;
 	using ProngBits		= typename OrthoForks::Bits;
 	using ProngConstBits= typename OrthoForks::ConstBits;
@@ -7780,7 +11186,6 @@ struct OS_<TIndices, TArgs, NIndex, TInitial> {
 
 	using Info	= OSI_<TInitial>;
 
-	HFSM_INLINE void	wideRegister		 (StateRegistry& stateRegistry, const ForkID forkId);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -7792,6 +11197,7 @@ struct OS_<TIndices, TArgs, NIndex, TInitial> {
 	HFSM_INLINE void	wideReenter			 (PlanControl& control);
 
 	HFSM_INLINE Status	wideUpdate			 (FullControl& control);
+	HFSM_INLINE Status	wideUpdate			 (FullControl& control, const ShortIndex prong);
 
 	template <typename TEvent>
 	HFSM_INLINE Status	wideReact			 (FullControl& control, const TEvent& event);
@@ -7848,17 +11254,6 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideRegister(StateRegistry& stateRegistry,
-										 const ForkID forkId)
-{
-	initial  .deepRegister(stateRegistry, Parent{forkId, PRONG_INDEX});
-	remaining.wideRegister(stateRegistry, forkId);
-}
-
-//------------------------------------------------------------------------------
-
 template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
 bool
 OS_<TN, TA, NI, TI, TR...>::wideForwardEntryGuard(GuardControl& control,
@@ -7921,6 +11316,18 @@ OS_<TN, TA, NI, TI, TR...>::wideUpdate(FullControl& control) {
 	return combine(status, remaining.wideUpdate(control));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+Status
+OS_<TN, TA, NI, TI, TR...>::wideUpdate(FullControl& control,
+									   const ShortIndex prong)
+{
+	return prong == PRONG_INDEX ?
+		initial	 .deepUpdate(control) :
+		remaining.wideUpdate(control, prong);
+}
+
 //------------------------------------------------------------------------------
 
 template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
@@ -8139,16 +11546,6 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideRegister(StateRegistry& stateRegistry,
-								  const ForkID forkId)
-{
-	initial.deepRegister(stateRegistry, Parent{forkId, PRONG_INDEX});
-}
-
-//------------------------------------------------------------------------------
-
 template <typename TN, typename TA, ShortIndex NI, typename TI>
 bool
 OS_<TN, TA, NI, TI>::wideForwardEntryGuard(GuardControl& control,
@@ -8198,6 +11595,18 @@ OS_<TN, TA, NI, TI>::wideUpdate(FullControl& control) {
 	return initial.deepUpdate(control);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+Status
+OS_<TN, TA, NI, TI>::wideUpdate(FullControl& control,
+								const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	return initial.deepUpdate(control);
+}
+
 //------------------------------------------------------------------------------
 
 template <typename TN, typename TA, ShortIndex NI, typename TI>
@@ -8392,6 +11801,7 @@ namespace detail {
 
 template <typename TIndices,
 		  typename TArgs,
+		  Execution TExecution,
 		  typename THead,
 		  typename... TSubStates>
 struct O_ final {
@@ -8404,6 +11814,8 @@ struct O_ final {
 	static constexpr ShortIndex REGION_ID	= COMPO_INDEX + ORTHO_INDEX;
 	static constexpr ForkID		ORTHO_ID	= (ForkID) -ORTHO_INDEX - 1;
 
+	static constexpr Execution	EXECUTION	= TExecution;
+
 	using Args			= TArgs;
 	using Rank			= typename Args::Rank;
 	using Utility		= typename Args::Utility;
@@ -8414,16 +11826,16 @@ struct O_ final {
 
 	using Head			= THead;
 
-	using Info			= OI_<Head, TSubStates...>;
+	using Info			= OI_<EXECUTION, Head, TSubStates...>;
 	static constexpr ShortIndex WIDTH		= Info::WIDTH;
 	static constexpr ShortIndex REGION_SIZE	= Info::STATE_COUNT;
-	static constexpr ShortIndex ORTHO_UNITS	= Info::ORTHO_UNITS;
+	static constexpr ShortIndex WIDTH_UNITS	= Info::WIDTH_UNITS;
 
 	using Request		= RequestT<Payload>;
 	using RequestType	= typename Request::Type;
+	using Requests		= RequestsT<Payload, Args::COMPO_REGIONS>;
 
 	using StateRegistry	= StateRegistryT<Args>;
-	using StateParents	= typename StateRegistry::StateParents;
 	using OrthoForks	= typename StateRegistry::AllForks::Ortho;
 	using ProngBits		= typename OrthoForks::Bits;
 	using ProngConstBits= typename OrthoForks::ConstBits;
@@ -8443,11 +11855,27 @@ struct O_ final {
 	using SubStates		= OS_<I_<HEAD_ID + 1,
 								 COMPO_INDEX,
 								 ORTHO_INDEX + 1,
-								 ORTHO_UNIT + ORTHO_UNITS>,
+								 ORTHO_UNIT + WIDTH_UNITS>,
 							  Args,
 							  0,
 							  TSubStates...>;
 
+	using IsParallel	= std::integral_constant<bool, EXECUTION == Execution::Parallel>;
+
+	// requests of the prongs updated in parallel, merged in prong order after the join
+	struct Fork {
+		HFSM_INLINE Fork(O_& region_, FullControl& control_)
+			: region{region_}
+			, control{control_}
+		{}
+
+		O_& region;
+		FullControl& control;
+		SpinLock serial;
+		Requests requests[WIDTH];
+		Status statuses[WIDTH];
+	};
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	HFSM_INLINE ProngBits	   orthoRequested(		StateRegistry& stateRegistry)		{ return stateRegistry.requested.ortho.template bits<ORTHO_UNIT, WIDTH>();	}
@@ -8456,7 +11884,6 @@ struct O_ final {
 	HFSM_INLINE ProngBits	   orthoRequested(		Control& control)					{ return orthoRequested(control._stateRegistry);							}
 	HFSM_INLINE ProngConstBits orthoRequested(const Control& control) const				{ return orthoRequested(control._stateRegistry);							}
 
-	HFSM_INLINE void	deepRegister		 (StateRegistry& stateRegistry, const Parent parent);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -8468,6 +11895,11 @@ struct O_ final {
 
 	HFSM_INLINE Status	deepUpdate			 (FullControl&	control);
 
+	HFSM_INLINE Status	wideUpdate			 (FullControl&	control, std::false_type);
+	HFSM_INLINE Status	wideUpdate			 (FullControl&	control, std::true_type);
+
+	static void			updateProng			 (void* const fork, const LongIndex prong);
+
 	template <typename TEvent>
 	HFSM_INLINE Status	deepReact			 (FullControl&	control, const TEvent& event);
 
@@ -8528,23 +11960,9 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepRegister(StateRegistry& stateRegistry,
-									const Parent parent)
-{
-	stateRegistry.orthoParents[ORTHO_INDEX] = parent;
-	stateRegistry.orthoUnits[ORTHO_INDEX] = Units{ORTHO_UNIT, WIDTH};
-
-	_headState.deepRegister(stateRegistry, parent);
-	_subStates.wideRegister(stateRegistry, ORTHO_ID);
-}
-
-//------------------------------------------------------------------------------
-
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 bool
-O_<TN, TA, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
 	const ProngConstBits requested = orthoRequested(static_cast<const GuardControl&>(control));
 
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
@@ -8557,9 +11975,9 @@ O_<TN, TA, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 bool
-O_<TN, TA, TH, TS...>::deepEntryGuard(GuardControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepEntryGuard(GuardControl& control) {
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
 	return _headState.deepEntryGuard(control) ||
@@ -8568,9 +11986,9 @@ O_<TN, TA, TH, TS...>::deepEntryGuard(GuardControl& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepEnter(PlanControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepEnter(PlanControl& control) {
 	ProngBits requested = orthoRequested(control);
 	requested.clear();
 
@@ -8582,9 +12000,9 @@ O_<TN, TA, TH, TS...>::deepEnter(PlanControl& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepReenter(PlanControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepReenter(PlanControl& control) {
 	ProngBits requested = orthoRequested(control);
 	requested.clear();
 
@@ -8596,18 +12014,18 @@ O_<TN, TA, TH, TS...>::deepReenter(PlanControl& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 Status
-O_<TN, TA, TH, TS...>::deepUpdate(FullControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepUpdate(FullControl& control) {
 	ScopedRegion outer{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
 	if (const auto headStatus = _headState.deepUpdate(control)) {
 		ControlLock lock{control};
-		_subStates.wideUpdate(control);
+		wideUpdate(control, IsParallel{});
 
 		return headStatus;
 	} else {
-		const Status subStatus = _subStates.wideUpdate(control);
+		const Status subStatus = wideUpdate(control, IsParallel{});
 
 		if (subStatus.outerTransition)
 			return subStatus;
@@ -8619,12 +12037,61 @@ O_<TN, TA, TH, TS...>::deepUpdate(FullControl& control) {
 	}
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
+Status
+O_<TN, TA, TX, TH, TS...>::wideUpdate(FullControl& control,
+									  std::false_type)
+{
+	return _subStates.wideUpdate(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
+Status
+O_<TN, TA, TX, TH, TS...>::wideUpdate(FullControl& control,
+									  std::true_type)
+{
+	if (!control._executor)
+		return _subStates.wideUpdate(control);
+
+	Fork fork{*this, control};
+	control._executor->run(WIDTH, &updateProng, &fork);
+
+	Status status;
+
+	for (ShortIndex prong = 0; prong < WIDTH; ++prong) {
+		for (const Request& request : fork.requests[prong])
+			control._requests << request;
+
+		status = combine(status, fork.statuses[prong]);
+	}
+
+	return status;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
+void
+O_<TN, TA, TX, TH, TS...>::updateProng(void* const fork_,
+									   const LongIndex prong)
+{
+	Fork& fork = *static_cast<Fork*>(fork_);
+
+	FullControl control{fork.control, fork.requests[prong], fork.serial};
+
+	fork.statuses[prong] = fork.region._subStates.wideUpdate(control, (ShortIndex) prong);
+}
+
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 template <typename TEvent>
 Status
-O_<TN, TA, TH, TS...>::deepReact(FullControl& control,
+O_<TN, TA, TX, TH, TS...>::deepReact(FullControl& control,
 								 const TEvent& event)
 {
 	ScopedRegion outer{control, REGION_ID, HEAD_ID, REGION_SIZE};
@@ -8649,9 +12116,9 @@ O_<TN, TA, TH, TS...>::deepReact(FullControl& control,
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 bool
-O_<TN, TA, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
 	const ProngConstBits requested = orthoRequested(static_cast<const GuardControl&>(control));
 
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
@@ -8664,9 +12131,9 @@ O_<TN, TA, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 bool
-O_<TN, TA, TH, TS...>::deepExitGuard(GuardControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepExitGuard(GuardControl& control) {
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
 	return _headState.deepExitGuard(control) ||
@@ -8675,18 +12142,18 @@ O_<TN, TA, TH, TS...>::deepExitGuard(GuardControl& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepExit(PlanControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepExit(PlanControl& control) {
 	_subStates.wideExit(control);
 	_headState.deepExit(control);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepForwardActive(Control& control,
+O_<TN, TA, TX, TH, TS...>::deepForwardActive(Control& control,
 										 const RequestType request)
 {
 	HFSM_ASSERT(control._stateRegistry.isActive(HEAD_ID));
@@ -8699,9 +12166,9 @@ O_<TN, TA, TH, TS...>::deepForwardActive(Control& control,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepForwardRequest(Control& control,
+O_<TN, TA, TX, TH, TS...>::deepForwardRequest(Control& control,
 										  const RequestType request)
 {
 	const ProngConstBits requested = orthoRequested(static_cast<const Control&>(control));
@@ -8714,9 +12181,9 @@ O_<TN, TA, TH, TS...>::deepForwardRequest(Control& control,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequest(Control& control,
+O_<TN, TA, TX, TH, TS...>::deepRequest(Control& control,
 								   const RequestType request)
 {
 	switch (request) {
@@ -8751,57 +12218,57 @@ O_<TN, TA, TH, TS...>::deepRequest(Control& control,
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestChange(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepRequestChange(Control& control) {
 	_subStates.wideRequestChange(control);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestRemain(StateRegistry& stateRegistry) {
+O_<TN, TA, TX, TH, TS...>::deepRequestRemain(StateRegistry& stateRegistry) {
 	_subStates.wideRequestRemain(stateRegistry);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestRestart(StateRegistry& stateRegistry) {
+O_<TN, TA, TX, TH, TS...>::deepRequestRestart(StateRegistry& stateRegistry) {
 	_subStates.wideRequestRestart(stateRegistry);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestResume(StateRegistry& stateRegistry) {
+O_<TN, TA, TX, TH, TS...>::deepRequestResume(StateRegistry& stateRegistry) {
 	_subStates.wideRequestResume(stateRegistry);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestUtilize(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepRequestUtilize(Control& control) {
 	_subStates.wideRequestUtilize(control);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestRandomize(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepRequestRandomize(Control& control) {
 	_subStates.wideRequestRandomize(control);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 typename TA::UP
-O_<TN, TA, TH, TS...>::deepReportChange(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepReportChange(Control& control) {
 	const UP	  h = _headState.deepReportChange(control);
 	const Utility s = _subStates.wideReportChange(control);
 
@@ -8817,9 +12284,9 @@ O_<TN, TA, TH, TS...>::deepReportChange(Control& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 typename TA::UP
-O_<TN, TA, TH, TS...>::deepReportUtilize(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepReportUtilize(Control& control) {
 	const UP	  h = _headState.deepReportUtilize(control);
 	const Utility s = _subStates.wideReportUtilize(control);
 
@@ -8835,17 +12302,17 @@ O_<TN, TA, TH, TS...>::deepReportUtilize(Control& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 typename TA::Rank
-O_<TN, TA, TH, TS...>::deepReportRank(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepReportRank(Control& control) {
 	return _headState.wrapRank(control);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 typename TA::Utility
-O_<TN, TA, TH, TS...>::deepReportRandomize(Control& control) {
+O_<TN, TA, TX, TH, TS...>::deepReportRandomize(Control& control) {
 	const Utility h = _headState.wrapUtility(control);
 	const Utility s = _subStates.wideReportRandomize(control);
 
@@ -8858,18 +12325,18 @@ O_<TN, TA, TH, TS...>::deepReportRandomize(Control& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepEnterRequested(PlanControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepEnterRequested(PlanControl& control) {
 	_headState.deepEnter		 (control);
 	_subStates.wideEnterRequested(control);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepChangeToRequested(PlanControl& control) {
+O_<TN, TA, TX, TH, TS...>::deepChangeToRequested(PlanControl& control) {
 	_subStates.wideChangeToRequested(control);
 }
 
@@ -8877,9 +12344,9 @@ O_<TN, TA, TH, TS...>::deepChangeToRequested(PlanControl& control) {
 
 #ifdef HFSM_ENABLE_STRUCTURE_REPORT
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution TX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepGetNames(const LongIndex parent,
+O_<TN, TA, TX, TH, TS...>::deepGetNames(const LongIndex parent,
 									const RegionType region,
 									const ShortIndex depth,
 									StructureStateInfos& _stateInfos) const
@@ -8901,7 +12368,15 @@ namespace detail {
 
 template <typename TConfig,
 		  typename TApex>
-class R_ {
+class R_
+	: protected ProfilerHostT<typename TConfig::Clock, Wrap<TApex>::STATE_COUNT>
+{
+	template <typename, LongIndex>
+	friend class MB_;
+
+	template <typename, LongIndex, LongIndex>
+	friend class MS_;
+
 	using Config_				= TConfig;
 	using Context				= typename Config_::Context;
 	using Rank					= typename Config_::Rank;
@@ -8909,6 +12384,7 @@ class R_ {
 	using Random_				= typename Config_::Random_;
 	using Logger				= typename Config_::Logger;
 	using Payload				= typename Config_::Payload;
+	using Events				= typename Config_::Events;
 
 	using Apex					= TApex;
 
@@ -8918,9 +12394,10 @@ class R_ {
 	using RegionList			= typename Info::RegionList;
 
 	static constexpr LongIndex SUBSTITUTION_LIMIT = Info::SUBSTITUTION_LIMIT;
-	static constexpr LongIndex TASK_CAPACITY	  = Info::TASK_CAPACITY;
 
 public:
+	static constexpr LongIndex  TASK_CAPACITY	  = Info::TASK_CAPACITY;
+
 	static constexpr LongIndex  REVERSE_DEPTH	  = ApexInfo::REVERSE_DEPTH;
 	static constexpr ShortIndex COMPO_REGIONS	  = ApexInfo::COMPO_REGIONS;
 	static constexpr LongIndex  COMPO_PRONGS	  = ApexInfo::COMPO_PRONGS;
@@ -8933,28 +12410,50 @@ public:
 	static_assert(STATE_COUNT <  (ShortIndex) -1, "Too many states in the hierarchy. Change 'ShortIndex' type.");
 	static_assert(STATE_COUNT == (ShortIndex) StateList::SIZE, "STATE_COUNT != StateList::SIZE");
 
+	using ActiveStates			= BitArray<StateID, STATE_COUNT>;
+
+	template <LongIndex NCapacity>
+	using EventBuffer			= EventBufferT<Events, NCapacity>;
+
+	using Recorder				= ReplayRecorderT<Events, Payload, Utility>;
+
+	template <LongIndex NCapacity>
+	using ReplayLog				= ReplayLogT<Events, Payload, Utility, NCapacity>;
+
+	using Published				= PublishedStatesT<typename Info::Args>;
+
 private:
 	using Args					= typename Info::Args;
 
 	using StateRegistry			= StateRegistryT<Args>;
+	using Topology				= typename StateRegistry::Topology;
 	using AllForks				= typename StateRegistry::AllForks;
 
 	using Control				= ControlT<Args>;
 
 	using PlanControl			= PlanControlT<Args>;
 	using PlanData				= PlanDataT   <Args>;
+	using PlanStats				= typename PlanData::Stats;
 
 	using FullControl			= FullControlT<Args>;
 	using Request				= typename FullControl::Request;
 	using Requests				= typename FullControl::Requests;
+	using RequestBuffers		= RequestBuffersT<Payload, COMPO_REGIONS>;
 
 	using GuardControl			= GuardControlT<Args>;
 
-	using Payloads				= Array<Payload, STATE_COUNT>;
+	using ProfilerHost			= ProfilerHostT<typename Config_::Clock, STATE_COUNT>;
+	using Profiler				= typename ProfilerHost::Profiler;
+	using ProfilerHost::profiler;
+
+	using PayloadPool			= typename FullControl::PayloadPool;
+	using PayloadSlots			= StaticArray<ShortIndex, STATE_COUNT>;
 	using PayloadsSet			= BitArray<LongIndex, STATE_COUNT>;
 
 	using MaterialApex			= Material<I_<0, 0, 0, 0>, Args, Apex>;
 
+	HFSM_IF_COROUTINES(using Routines = RoutinesT<Args>);
+
 public:
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -8974,6 +12473,81 @@ public:
 #endif
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// binary image of the mutable machine state, without the constant topology,
+	// restored without calling enter() / exit(); data held by the states
+	// themselves is not included, pending requests are dropped
+	//
+	// wire format: signature and epoch, active states, active and resumable
+	// prongs, plans task by task, then the payloads held as state data;
+	// payloads are copied bytewise and have to be trivially copyable
+
+	static constexpr uint32_t SNAPSHOT_VERSION = 4;
+
+	// hashes the parent tables, machines of a different shape don't match
+	static constexpr uint32_t SNAPSHOT_SIGNATURE =
+		hashParents(Topology::ORTHO_PARENTS, ORTHO_REGIONS,
+		hashParents(Topology::COMPO_PARENTS, COMPO_REGIONS,
+		hashParents(Topology::STATE_PARENTS, STATE_COUNT,
+					((SNAPSHOT_VERSION * 31u + (uint32_t) TASK_CAPACITY) * 31u
+					  + (uint32_t) sizeof(Payload)) * 31u
+					  + (uint32_t) PayloadPool::CAPACITY)));
+
+	static constexpr std::size_t SNAPSHOT_CAPACITY =
+		sizeof(uint32_t) * 2
+		+ bitsSize<ActiveStates>()
+		+ COMPO_REGIONS * 2
+		+ bitsSize<typename AllForks::Ortho>()
+		+ PlanData::WIRE_CAPACITY
+		+ bitsSize<PayloadsSet>()
+		+ (STATE_COUNT < PayloadPool::CAPACITY ? STATE_COUNT : PayloadPool::CAPACITY) * sizeof(Payload);
+
+	// buffer large enough for any image of the machine
+	struct Snapshot {
+		std::size_t size = 0;
+		unsigned char bytes[SNAPSHOT_CAPACITY];
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// changes since the previous takeDelta(), for replicas at 'epoch';
+	// 'prongs' and 'payloads' are packed, one entry per set bit
+	// of 'compos' and 'payloadsSet & payloadSlots' respectively;
+	// plans and pending requests are not replicated
+
+	using CompoChanges			= typename StateRegistry::CompoChanges;
+
+	struct Prongs {
+		ShortIndex active;
+		ShortIndex resumable;
+	};
+
+	struct Delta {
+		uint32_t signature;
+		uint32_t epoch;
+
+		ActiveStates toggled;
+
+		CompoChanges compos;
+		StaticArray<Prongs, COMPO_REGIONS> prongs;
+
+		typename AllForks::Ortho orthoResumable;
+
+		PayloadsSet payloadSlots;
+		PayloadsSet payloadsSet;
+		StaticArray<Payload, STATE_COUNT> payloads;
+
+		// wire format: bit sets take a bit per state or region,
+		// prongs and payloads only as many entries as have changed;
+		// payloads are copied bytewise and have to be trivially copyable
+		std::size_t size() const;
+
+		// bytes used, 0 if 'capacity' is too small
+		std::size_t write(void* const buffer, const std::size_t capacity) const;
+
+		// false if 'buffer' doesn't hold exactly one well-formed delta
+		bool read(const void* const buffer, const std::size_t size);
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 public:
 	explicit R_(Context& context,
@@ -8993,6 +12567,26 @@ public:
 	template <typename TEvent>
 	HFSM_INLINE void react(const TEvent& event);
 
+	// deferred reactions: queue() dispatches the event right away, but the
+	// transitions it requests are processed once, on flush();
+	// the last request into each composite region wins;
+	// false if a pending request had to be dropped for lack of room
+	template <typename TEvent>
+	HFSM_INLINE bool queue(const TEvent& event);
+
+	HFSM_INLINE void flush();
+
+	// requests dropped by queue() because more than 'COMPO_REGIONS'
+	// independent ones were pending
+	HFSM_INLINE LongIndex requestOverflows() const				{ return _requestOverflows;						}
+
+	// replay a buffer of events declared with 'Config::EventsT<>', in order
+	template <LongIndex NCapacity>
+	HFSM_INLINE void react(const EventBuffer<NCapacity>& events);
+
+	template <LongIndex NCapacity>
+	HFSM_INLINE bool queue(const EventBuffer<NCapacity>& events);
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	HFSM_INLINE bool isActive   (const StateID stateId) const	{ return _stateRegistry.isActive   (stateId);	}
@@ -9009,25 +12603,67 @@ public:
 	template <typename TState>
 	HFSM_INLINE bool isScheduled() const						{ return isResumable<TState>();					}
 
+	HFSM_INLINE void copyActiveStates(ActiveStates& states) const	{ states = _stateRegistry.activeStates;		}
+
+	// most tasks planned at once since construction, in total and per region;
+	// a profiling run's total is a safe 'Config::TaskCapacityN<>'
+	HFSM_INLINE LongIndex taskHighWater() const					{ return _planStats.highWater;					}
+	HFSM_INLINE LongIndex taskHighWater(const RegionID regionId) const	{ return _planStats.highWaters[regionId];	}
+
+	template <typename TRegion>
+	HFSM_INLINE LongIndex taskHighWater() const					{ return taskHighWater(regionId<TRegion>());	}
+
+	// tasks dropped by plans because 'TASK_CAPACITY' was exhausted
+	HFSM_INLINE LongIndex taskOverflows() const					{ return _planStats.overflows;					}
+
+	// most payload slots used at once since construction, for
+	// 'Config::PayloadCapacityN<>', and payloads dropped for lack of slots
+	HFSM_INLINE LongIndex payloadPeak() const					{ return _payloadPool.peak();					}
+	HFSM_INLINE LongIndex payloadOverflows() const				{ return _payloadPool.overflows();				}
+
+	// bytes save() currently needs, up to 'SNAPSHOT_CAPACITY'
+	std::size_t snapshotSize() const;
+
+	// bytes used, 0 if 'capacity' is too small
+	std::size_t save(void* const buffer, const std::size_t capacity) const;
+
+	// false and nothing changed if 'buffer' doesn't hold exactly one image
+	// of this machine
+	bool load(const void* const buffer, const std::size_t size);
+
+	HFSM_INLINE void save(Snapshot& snapshot) const				{ snapshot.size = save(snapshot.bytes, SNAPSHOT_CAPACITY);	}
+	HFSM_INLINE bool load(const Snapshot& snapshot)				{ return load(snapshot.bytes, snapshot.size);				}
+
+	// replicas start from the same initial state or a snapshot
+	// saved right after takeDelta(), state methods are not called
+	void takeDelta(Delta& delta);
+	bool applyDelta(const Delta& delta);
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	HFSM_INLINE void changeTo (const StateID stateId);
-	HFSM_INLINE void changeTo (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void changeTo (const StateID stateId, const Payload& payload)	{ requestTransition(Request::Type::CHANGE, Transition::CHANGE, stateId, payload);				}
+	HFSM_INLINE void changeTo (const StateID stateId, Payload&& payload)		{ requestTransition(Request::Type::CHANGE, Transition::CHANGE, stateId, std::move(payload));	}
 
 	HFSM_INLINE void restart  (const StateID stateId);
-	HFSM_INLINE void restart  (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void restart  (const StateID stateId, const Payload& payload)	{ requestTransition(Request::Type::RESTART, Transition::RESTART, stateId, payload);				}
+	HFSM_INLINE void restart  (const StateID stateId, Payload&& payload)		{ requestTransition(Request::Type::RESTART, Transition::RESTART, stateId, std::move(payload));	}
 
 	HFSM_INLINE void resume	  (const StateID stateId);
-	HFSM_INLINE void resume   (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void resume   (const StateID stateId, const Payload& payload)	{ requestTransition(Request::Type::RESUME, Transition::RESUME, stateId, payload);				}
+	HFSM_INLINE void resume   (const StateID stateId, Payload&& payload)		{ requestTransition(Request::Type::RESUME, Transition::RESUME, stateId, std::move(payload));	}
 
 	HFSM_INLINE void utilize  (const StateID stateId);
-	HFSM_INLINE void utilize  (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void utilize  (const StateID stateId, const Payload& payload)	{ requestTransition(Request::Type::UTILIZE, Transition::UTILIZE, stateId, payload);				}
+	HFSM_INLINE void utilize  (const StateID stateId, Payload&& payload)		{ requestTransition(Request::Type::UTILIZE, Transition::UTILIZE, stateId, std::move(payload));	}
 
 	HFSM_INLINE void randomize(const StateID stateId);
-	HFSM_INLINE void randomize(const StateID stateId, const Payload& payload);
+	HFSM_INLINE void randomize(const StateID stateId, const Payload& payload)	{ requestTransition(Request::Type::RANDOMIZE, Transition::RANDOMIZE, stateId, payload);				}
+	HFSM_INLINE void randomize(const StateID stateId, Payload&& payload)		{ requestTransition(Request::Type::RANDOMIZE, Transition::RANDOMIZE, stateId, std::move(payload));	}
 
 	HFSM_INLINE void schedule (const StateID stateId);
-	HFSM_INLINE void schedule (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void schedule (const StateID stateId, const Payload& payload)	{ requestTransition(Request::Type::SCHEDULE, Transition::SCHEDULE, stateId, payload);				}
+	HFSM_INLINE void schedule (const StateID stateId, Payload&& payload)		{ requestTransition(Request::Type::SCHEDULE, Transition::SCHEDULE, stateId, std::move(payload));	}
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -9037,40 +12673,59 @@ public:
 	template <typename TState>
 	HFSM_INLINE void changeTo (const Payload& payload)			{ changeTo (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void changeTo (Payload&& payload)				{ changeTo (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void restart  ()								{ restart  (stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void restart  (const Payload& payload)			{ restart  (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void restart  (Payload&& payload)				{ restart  (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void resume	  ()								{ resume   (stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void resume	  (const Payload& payload)			{ resume   (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void resume	  (Payload&& payload)				{ resume   (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void utilize  ()								{ utilize  (stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void utilize  (const Payload& payload)			{ utilize  (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void utilize  (Payload&& payload)				{ utilize  (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void randomize()								{ randomize(stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void randomize(const Payload& payload)			{ randomize(stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void randomize(Payload&& payload)				{ randomize(stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE void schedule ()								{ schedule (stateId<TState>());					}
 
 	template <typename TState>
 	HFSM_INLINE void schedule (const Payload& payload)			{ schedule (stateId<TState>(), payload);		}
 
+	template <typename TState>
+	HFSM_INLINE void schedule (Payload&& payload)				{ schedule (stateId<TState>(), std::move(payload));	}
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	HFSM_INLINE void resetStateData(const StateID stateId);
-	HFSM_INLINE void setStateData  (const StateID stateId, const Payload& payload);
+	HFSM_INLINE void setStateData  (const StateID stateId, const Payload& payload)	{ assignStateData(stateId, payload);				}
+	HFSM_INLINE void setStateData  (const StateID stateId, Payload&& payload)		{ assignStateData(stateId, std::move(payload));	}
 	HFSM_INLINE bool isStateDataSet(const StateID stateId) const;
 
 	HFSM_INLINE const Payload* getStateData(const StateID stateId) const;
@@ -9081,6 +12736,9 @@ public:
 	template <typename TState>
 	HFSM_INLINE void setStateData  (const Payload& payload)		{ setStateData  (stateId<TState>(), payload);	}
 
+	template <typename TState>
+	HFSM_INLINE void setStateData  (Payload&& payload)			{ setStateData  (stateId<TState>(), std::move(payload));	}
+
 	template <typename TState>
 	HFSM_INLINE bool isStateDataSet() const						{ return isStateDataSet(stateId<TState>());		}
 
@@ -9092,16 +12750,103 @@ public:
 #ifdef HFSM_ENABLE_STRUCTURE_REPORT
 	const Structure&	   structure()		 const				{ return _structure;							}
 	const ActivityHistory& activityHistory() const				{ return _activityHistory;						}
+
+	// empty for bare states, e.g. the heads of peer regions
+	const char* stateName(const StateID stateId) const			{ return _stateInfos[stateId].name;				}
 #endif
 
 #if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
 	void attachLogger(Logger* const logger)						{ _logger = logger;								}
 #endif
 
+	// per-state method statistics, with 'Config::ProfilerT<>'
+	HFSM_INLINE const MethodProfile& profile(const StateID stateId,
+											 const Method method) const	{ return this->_profiler.get(stateId, method);	}
+
+	template <typename TState>
+	HFSM_INLINE const MethodProfile& profile(const Method method) const	{ return profile(stateId<TState>(), method);	}
+
+	// calls 'receiver(stateId, method, profile)' for every method called
+	template <typename TReceiver>
+	HFSM_INLINE void reportProfile(TReceiver& receiver) const			{ this->_profiler.report(receiver);				}
+
+	HFSM_INLINE void resetProfile()										{ this->_profiler.clear();						}
+
+	// records calls into the machine for a later Recorder::replay()
+	void attachRecorder(Recorder* const recorder)				{ _recorder = recorder;							}
+
+	// runs update() of parallel orthogonal regions' prongs,
+	// nullptr updates them one after another on the calling thread
+	void attachExecutor(ExecutorInterface* const executor)		{ _executor = executor;							}
+
+	// keeps 'published' up to date after every transition pass,
+	// for other threads to query
+	void attachPublished(Published* const published)			{ _published = published; publish();			}
+
 private:
+
 	void initialEnter();
 	void processTransitions();
 
+	// batches and schedulers drive machines through these,
+	// recording happens here rather than in update() / react()
+	HFSM_INLINE bool dispatchUpdate();
+
+	template <typename TEvent>
+	HFSM_INLINE bool dispatchReact(const TEvent& event,
+								   const typename Recorder::Kind kind = Recorder::Kind::REACT);
+
+	HFSM_INLINE void finalizeRequests();
+
+	HFSM_INLINE void sealRecord();
+
+	HFSM_INLINE void recordTransition(const Transition transition, const StateID stateId);
+	HFSM_INLINE void recordTransition(const Transition transition, const StateID stateId, const Payload& payload);
+
+	// both payload overloads of the transition methods and 'setStateData()'
+	template <typename TPayload>
+	HFSM_INLINE void requestTransition(const typename Request::Type type,
+									   const Transition transition,
+									   const StateID stateId,
+									   TPayload&& payload);
+
+	template <typename TPayload>
+	HFSM_INLINE void assignStateData(const StateID stateId, TPayload&& payload);
+
+	void resetReplication();
+
+	// load() and applyDelta() deactivate states without exiting them
+	HFSM_IF_COROUTINES(void stopInactiveRoutines());
+
+	PayloadsSet heldStateData() const;
+
+	HFSM_INLINE void publish()									{ if (_published) _published->publish(_stateRegistry);	}
+
+	template <typename TPayload>
+	HFSM_INLINE void holdStateData(const StateID stateId, TPayload&& payload);
+	HFSM_INLINE void releaseStateData(const StateID stateId);
+
+	struct Reactor {
+		template <typename TEvent>
+		HFSM_INLINE void operator () (const TEvent& event)			{ machine.react(event);	}
+
+		R_& machine;
+	};
+
+	struct Queuer {
+		template <typename TEvent>
+		HFSM_INLINE void operator () (const TEvent& event)			{ kept &= machine.queue(event);	}
+
+		R_& machine;
+		bool kept;
+	};
+
+	bool coalesceRequests(const Requests& pending);
+	bool keepRequest(Requests& coalesced, const Request& request);
+	void dropRequest(const Request& request);
+	bool superseded(const Request& request, const Requests& later, const LongIndex from) const;
+	bool overrides(const StateID later, const StateID earlier) const;
+
 	bool applyRequests(Control& control);
 
 	bool cancelledByEntryGuards(const Requests& pendingChanges);
@@ -9119,14 +12864,27 @@ private:
 
 	StateRegistry _stateRegistry;
 	PlanData _planData;
+	PlanStats _planStats;
+
+	PayloadPool _payloadPool;
+	PayloadSlots _payloadSlots{INVALID_SHORT_INDEX};
 
-	Payloads _payloads;
-	PayloadsSet _payloadsSet;
+	uint32_t _epoch = 0;
+	ActiveStates _replicatedStates;
+	PayloadsSet _payloadChanges;
 
-	Requests _requests;
+	RequestBuffers _requests;
+	LongIndex _requestOverflows = 0;
 
 	MaterialApex _apex;
 
+	Recorder* _recorder = nullptr;
+	typename Recorder::Record* _record = nullptr;
+	ExecutorInterface* _executor = nullptr;
+	Published* _published = nullptr;
+
+	HFSM_IF_COROUTINES(Routines _routines);
+
 #ifdef HFSM_ENABLE_STRUCTURE_REPORT
 	Prefixes _prefixes;
 	StructureStateInfos _stateInfos;
@@ -9159,12 +12917,18 @@ template <typename TN,
 		  typename TP,
 		  LongIndex NS,
 		  LongIndex NT,
+		  typename TE,
+		  LongIndex NJ,
+		  typename TK,
+		  typename TL,
+		  LongIndex NP,
+		  LongIndex NF,
 		  typename TApex>
-class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, TR, TP, NS, NT>, TApex> final
-	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, TR, TP, NS, NT>, TApex>
+class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, TR, TP, NS, NT, TE, NJ, TK, TL, NP, NF>, TApex> final
+	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, TR, TP, NS, NT, TE, NJ, TK, TL, NP, NF>, TApex>
 	, ::hfsm2::EmptyContext
 {
-	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, TR, TP, NS, NT>;
+	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, TR, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
 	using Context	= typename Config_::Context;
 	using Random_	= typename Config_::Random_;
 	using Logger	= typename Config_::Logger;
@@ -9188,12 +12952,18 @@ template <typename TC,
 		  typename TP,
 		  LongIndex NS,
 		  LongIndex NT,
+		  typename TE,
+		  LongIndex NJ,
+		  typename TK,
+		  typename TL,
+		  LongIndex NP,
+		  LongIndex NF,
 		  typename TApex>
-class RW_	   <::hfsm2::ConfigT<TC, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT>, TApex> final
-	: public R_<::hfsm2::ConfigT<TC, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT>, TApex>
+class RW_	   <::hfsm2::ConfigT<TC, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT, TE, NJ, TK, TL, NP, NF>, TApex> final
+	: public R_<::hfsm2::ConfigT<TC, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT, TE, NJ, TK, TL, NP, NF>, TApex>
 	, ::hfsm2::RandomT<TU>
 {
-	using Config_	= ::hfsm2::ConfigT<TC, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT>;
+	using Config_	= ::hfsm2::ConfigT<TC, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
 	using Context	= typename Config_::Context;
 	using Random_	= typename Config_::Random_;
 	using Logger	= typename Config_::Logger;
@@ -9217,13 +12987,19 @@ template <typename TN,
 		  typename TP,
 		  LongIndex NS,
 		  LongIndex NT,
+		  typename TE,
+		  LongIndex NJ,
+		  typename TK,
+		  typename TL,
+		  LongIndex NP,
+		  LongIndex NF,
 		  typename TApex>
-class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT>, TApex> final
-	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT>, TApex>
+class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT, TE, NJ, TK, TL, NP, NF>, TApex> final
+	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT, TE, NJ, TK, TL, NP, NF>, TApex>
 	, ::hfsm2::EmptyContext
 	, ::hfsm2::RandomT<TU>
 {
-	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT>;
+	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN, TU, ::hfsm2::RandomT<TU>, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
 	using Context	= typename Config_::Context;
 	using Random_	= typename Config_::Random_;
 	using Logger	= typename Config_::Logger;
@@ -9249,6 +13025,14 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename TG, typename TA>
+constexpr uint32_t R_<TG, TA>::SNAPSHOT_SIGNATURE;
+
+template <typename TG, typename TA>
+constexpr std::size_t R_<TG, TA>::SNAPSHOT_CAPACITY;
+
+//------------------------------------------------------------------------------
+
 template <typename TG, typename TA>
 R_<TG, TA>::R_(Context& context,
 			   Random_& random
@@ -9257,11 +13041,10 @@ R_<TG, TA>::R_(Context& context,
 	, _random{random}
 	HFSM_IF_LOGGER(, _logger{logger})
 {
-	_apex.deepRegister(_stateRegistry, Parent{});
-
 	HFSM_IF_STRUCTURE(getStateNames());
 
 	initialEnter();
+	resetReplication();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -9272,7 +13055,11 @@ R_<TG, TA>::~R_() {
 						_random,
 						_stateRegistry,
 						_planData,
+						profiler(),
 						HFSM_LOGGER_OR(_logger, nullptr)};
+	control._planStats = &_planStats;
+	HFSM_IF_COROUTINES(control._routines = &_routines);
+
 	_apex.deepExit(control);
 
 	HFSM_IF_ASSERT(_planData.verifyPlans());
@@ -9283,42 +13070,419 @@ R_<TG, TA>::~R_() {
 template <typename TG, typename TA>
 void
 R_<TG, TA>::update() {
-	FullControl control(_context,
-						_random,
-						_stateRegistry,
-						_planData,
-						_requests,
-						HFSM_LOGGER_OR(_logger, nullptr));
-	_apex.deepUpdate(control);
+	if (dispatchUpdate())
+		finalizeRequests();
+}
 
-	HFSM_IF_ASSERT(_planData.verifyPlans());
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+template <typename TEvent>
+void
+R_<TG, TA>::react(const TEvent& event) {
+	if (dispatchReact(event))
+		finalizeRequests();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TG, typename TA>
+template <typename TEvent>
+bool
+R_<TG, TA>::queue(const TEvent& event) {
+	_requests.advance();
+
+	if (dispatchReact(event, Recorder::Kind::QUEUE)) {
+		const bool kept = coalesceRequests(_requests.previous());
+		sealRecord();
+
+		return kept;
+	} else {
+		_requests.restore();
+
+		return true;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::flush() {
+	_record = _recorder ? _recorder->recordFlush() : nullptr;
+
+	if (_requests.current().count())
+		finalizeRequests();
+	else
+		sealRecord();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+template <LongIndex NCapacity>
+void
+R_<TG, TA>::react(const EventBuffer<NCapacity>& events) {
+	Reactor reactor{*this};
+	events.dispatch(reactor);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+template <LongIndex NCapacity>
+bool
+R_<TG, TA>::queue(const EventBuffer<NCapacity>& events) {
+	Queuer queuer{*this, true};
+	events.dispatch(queuer);
+
+	return queuer.kept;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TG, typename TA>
+std::size_t
+R_<TG, TA>::snapshotSize() const {
+	return SNAPSHOT_CAPACITY
+		 - PlanData::WIRE_CAPACITY + _planData.wireSize()
+		 - (STATE_COUNT < PayloadPool::CAPACITY ? STATE_COUNT : PayloadPool::CAPACITY) * sizeof(Payload)
+		 + heldStateData().count() * sizeof(Payload);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+std::size_t
+R_<TG, TA>::save(void* const buffer,
+				 const std::size_t capacity) const
+{
+	static_assert(std::is_trivially_copyable<Payload>::value, "save() copies payloads bytewise");
+
+	const std::size_t used = snapshotSize();
+	if (capacity < used)
+		return 0;
+
+	unsigned char* cursor = static_cast<unsigned char*>(buffer);
+
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		*cursor++ = (unsigned char) (SNAPSHOT_SIGNATURE >> b * 8);
+
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		*cursor++ = (unsigned char) (_epoch				>> b * 8);
+
+	writeBits(cursor, _stateRegistry.activeStates);
+
+	for (LongIndex i = 0; i < COMPO_REGIONS; ++i)
+		*cursor++ = _stateRegistry.compoActive[i];
+
+	for (LongIndex i = 0; i < COMPO_REGIONS; ++i)
+		*cursor++ = _stateRegistry.resumable.compo[i];
+
+	writeBits(cursor, _stateRegistry.resumable.ortho);
+
+	_planData.write(cursor);
+
+	const PayloadsSet held = heldStateData();
+	writeBits(cursor, held);
+
+	for (LongIndex i = held.first(); i < PayloadsSet::CAPACITY; i = held.next(i)) {
+		std::memcpy(cursor, &_payloadPool[_payloadSlots[i]], sizeof(Payload));
+		cursor += sizeof(Payload);
+	}
+
+	HFSM_ASSERT(cursor == static_cast<unsigned char*>(buffer) + used);
+
+	return used;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::load(const void* const buffer,
+				 const std::size_t size)
+{
+	static_assert(std::is_trivially_copyable<Payload>::value, "load() copies payloads bytewise");
+
+	const std::size_t fixed = sizeof(uint32_t) * 2
+							+ bitsSize<ActiveStates>()
+							+ COMPO_REGIONS * 2
+							+ bitsSize<typename AllForks::Ortho>();
+	if (size < fixed)
+		return false;
+
+	const unsigned char* cursor = static_cast<const unsigned char*>(buffer);
+	const unsigned char* const end = cursor + size;
+
+	uint32_t signature = 0;
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		signature |= (uint32_t) *cursor++ << b * 8;
+
+	if (signature != SNAPSHOT_SIGNATURE)
+		return false;
+
+	uint32_t epoch = 0;
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		epoch	  |= (uint32_t) *cursor++ << b * 8;
+
+	// everything is decoded before any of it is applied
+	ActiveStates activeStates;
+	typename StateRegistry::CompoForks compoActive;
+	AllForks resumable;
+
+	if (!readBits(cursor, activeStates))
+		return false;
+
+	for (LongIndex i = 0; i < COMPO_REGIONS; ++i)
+		compoActive[i] = *cursor++;
+
+	for (LongIndex i = 0; i < COMPO_REGIONS; ++i)
+		resumable.compo[i] = *cursor++;
+
+	PlanData planData;
+	PayloadsSet held;
+
+	if (!readBits(cursor, resumable.ortho) ||
+		!planData.read(cursor, end) ||
+		(std::size_t) (end - cursor) < bitsSize<PayloadsSet>() ||
+		!readBits(cursor, held) ||
+		held.count() > PayloadPool::CAPACITY ||
+		(std::size_t) (end - cursor) != held.count() * sizeof(Payload))
+	{
+		return false;
+	}
+
+	_stateRegistry.activeStates = activeStates;
+	_stateRegistry.compoActive	= compoActive;
+	_stateRegistry.resumable	= resumable;
+	_stateRegistry.clearRequests();
+	HFSM_IF_COROUTINES(stopInactiveRoutines());
+
+	_planData = planData;
+
+	_requests.current().clear();
+	_payloadPool.releaseStaged();
+
+	for (StateID i = 0; i < STATE_COUNT; ++i)
+		releaseStateData(i);
+
+	for (LongIndex i = held.first(); i < PayloadsSet::CAPACITY; i = held.next(i)) {
+		Payload payload;
+		std::memcpy(&payload, cursor, sizeof(Payload));
+		cursor += sizeof(Payload);
+
+		holdStateData(i, payload);
+	}
+
+	_epoch = epoch;
+	resetReplication();
+
+	HFSM_IF_STRUCTURE(_lastTransitions.clear());
+	HFSM_IF_STRUCTURE(udpateActivity());
+
+	publish();
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::takeDelta(Delta& delta) {
+	delta.signature	= SNAPSHOT_SIGNATURE;
+	delta.epoch		= _epoch++;
+
+	delta.toggled	= _stateRegistry.activeStates;
+	delta.toggled  ^= _replicatedStates;
+
+	const CompoChanges& compos = _stateRegistry.compoChanges;
+	delta.compos	= compos;
+
+	LongIndex p = 0;
+	for (LongIndex i = compos.first(); i < CompoChanges::CAPACITY; i = compos.next(i))
+		delta.prongs[p++] = Prongs{_stateRegistry.compoActive[i],
+								   _stateRegistry.resumable.compo[i]};
+
+	delta.orthoResumable = _stateRegistry.resumable.ortho;
+
+	delta.payloadSlots	 = _payloadChanges;
+	delta.payloadsSet.clear();
+
+	p = 0;
+	for (LongIndex i = _payloadChanges.first(); i < PayloadsSet::CAPACITY; i = _payloadChanges.next(i))
+		if (_payloadSlots[i] != INVALID_SHORT_INDEX) {
+			delta.payloadsSet.set(i);
+			delta.payloads[p++] = _payloadPool[_payloadSlots[i]];
+		}
+
+	resetReplication();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::applyDelta(const Delta& delta) {
+	if (delta.signature != SNAPSHOT_SIGNATURE ||
+		delta.epoch		!= _epoch)
+	{
+		return false;
+	}
+
+	_stateRegistry.activeStates ^= delta.toggled;
+
+	LongIndex p = 0;
+	for (LongIndex i = delta.compos.first(); i < CompoChanges::CAPACITY; i = delta.compos.next(i)) {
+		_stateRegistry.compoActive[i]	  = delta.prongs[p].active;
+		_stateRegistry.resumable.compo[i] = delta.prongs[p].resumable;
+		++p;
+	}
+
+	_stateRegistry.resumable.ortho = delta.orthoResumable;
+	_stateRegistry.clearRequests();
+	HFSM_IF_COROUTINES(stopInactiveRoutines());
+
+	p = 0;
+	for (LongIndex i = delta.payloadSlots.first(); i < PayloadsSet::CAPACITY; i = delta.payloadSlots.next(i))
+		if (delta.payloadsSet.get(i))
+			holdStateData(i, delta.payloads[p++]);
+		else
+			releaseStateData(i);
+
+	_requests.current().clear();
+	_payloadPool.releaseStaged();
+
+	++_epoch;
+	resetReplication();
+
+	HFSM_IF_STRUCTURE(_lastTransitions.clear());
+	HFSM_IF_STRUCTURE(udpateActivity());
+
+	publish();
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TG, typename TA>
+std::size_t
+R_<TG, TA>::Delta::size() const {
+	return sizeof(signature) + sizeof(epoch)
+		 + bitsSize<ActiveStates>()
+		 + bitsSize<CompoChanges>() + compos.count() * 2
+		 + bitsSize<typename AllForks::Ortho>()
+		 + bitsSize<PayloadsSet>() * 2 + payloadsSet.count() * sizeof(Payload);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+std::size_t
+R_<TG, TA>::Delta::write(void* const buffer,
+						 const std::size_t capacity) const
+{
+	static_assert(std::is_trivially_copyable<Payload>::value, "Delta::write() copies payloads bytewise");
+
+	const std::size_t used = size();
+	if (capacity < used)
+		return 0;
+
+	unsigned char* cursor = static_cast<unsigned char*>(buffer);
+
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		*cursor++ = (unsigned char) (signature >> b * 8);
+
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		*cursor++ = (unsigned char) (epoch	   >> b * 8);
+
+	writeBits(cursor, toggled);
+
+	writeBits(cursor, compos);
+	for (LongIndex p = 0; p < compos.count(); ++p) {
+		*cursor++ = prongs[p].active;
+		*cursor++ = prongs[p].resumable;
+	}
+
+	writeBits(cursor, orthoResumable);
+
+	writeBits(cursor, payloadSlots);
+	writeBits(cursor, payloadsSet);
+	for (LongIndex p = 0; p < payloadsSet.count(); ++p) {
+		std::memcpy(cursor, &payloads[p], sizeof(Payload));
+		cursor += sizeof(Payload);
+	}
+
+	HFSM_ASSERT(cursor == static_cast<unsigned char*>(buffer) + used);
+
+	return used;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::Delta::read(const void* const buffer,
+						const std::size_t size_)
+{
+	static_assert(std::is_trivially_copyable<Payload>::value, "Delta::read() copies payloads bytewise");
+
+	const std::size_t fixed = sizeof(signature) + sizeof(epoch)
+							+ bitsSize<ActiveStates>()
+							+ bitsSize<CompoChanges>()
+							+ bitsSize<typename AllForks::Ortho>()
+							+ bitsSize<PayloadsSet>() * 2;
+	if (size_ < fixed)
+		return false;
+
+	const unsigned char* cursor = static_cast<const unsigned char*>(buffer);
+
+	signature = 0;
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		signature |= (uint32_t) *cursor++ << b * 8;
+
+	epoch = 0;
+	for (unsigned b = 0; b < sizeof(uint32_t); ++b)
+		epoch	  |= (uint32_t) *cursor++ << b * 8;
+
+	if (!readBits(cursor, toggled) ||
+		!readBits(cursor, compos))
+	{
+		return false;
+	}
 
-	if (_requests.count())
-		processTransitions();
+	// prongs follow the bits they belong to
+	const unsigned char* const prongsBytes = cursor;
+	cursor += compos.count() * 2;
 
-	_requests.clear();
-}
+	if (size_ < fixed + compos.count() * 2 ||
+		!readBits(cursor, orthoResumable) ||
+		!readBits(cursor, payloadSlots) ||
+		!readBits(cursor, payloadsSet))
+	{
+		return false;
+	}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	for (LongIndex i = payloadsSet.first(); i < PayloadsSet::CAPACITY; i = payloadsSet.next(i))
+		if (!payloadSlots.get(i))
+			return false;
 
-template <typename TG, typename TA>
-template <typename TEvent>
-void
-R_<TG, TA>::react(const TEvent& event) {
-	FullControl control(_context,
-						_random,
-						_stateRegistry,
-						_planData,
-						_requests,
-						HFSM_LOGGER_OR(_logger, nullptr));
-	_apex.deepReact(control, event);
+	if (size_ != size())
+		return false;
 
-	HFSM_IF_ASSERT(_planData.verifyPlans());
+	for (LongIndex p = 0; p < compos.count(); ++p) {
+		prongs[p].active	= prongsBytes[p * 2];
+		prongs[p].resumable	= prongsBytes[p * 2 + 1];
+	}
 
-	if (_requests.count())
-		processTransitions();
+	for (LongIndex p = 0; p < payloadsSet.count(); ++p) {
+		std::memcpy(&payloads[p], cursor, sizeof(Payload));
+		cursor += sizeof(Payload);
+	}
 
-	_requests.clear();
+	return true;
 }
 
 //------------------------------------------------------------------------------
@@ -9327,21 +13491,9 @@ template <typename TG, typename TA>
 void
 R_<TG, TA>::changeTo(const StateID stateId) {
 	const Request request{Request::Type::CHANGE, stateId};
-	_requests << request;
-
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::CHANGE, stateId);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-template <typename TG, typename TA>
-void
-R_<TG, TA>::changeTo(const StateID stateId,
-					 const Payload& payload)
-{
-	const Request request{Request::Type::CHANGE, stateId, payload};
-	_requests << request;
+	_requests.current() << request;
 
+	recordTransition(Transition::CHANGE, stateId);
 	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::CHANGE, stateId);
 }
 
@@ -9351,21 +13503,9 @@ template <typename TG, typename TA>
 void
 R_<TG, TA>::restart(const StateID stateId) {
 	const Request request{Request::Type::RESTART, stateId};
-	_requests << request;
-
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RESTART, stateId);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-template <typename TG, typename TA>
-void
-R_<TG, TA>::restart(const StateID stateId,
-					const Payload& payload)
-{
-	const Request request{Request::Type::RESTART, stateId, payload};
-	_requests << request;
+	_requests.current() << request;
 
+	recordTransition(Transition::RESTART, stateId);
 	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RESTART, stateId);
 }
 
@@ -9375,21 +13515,9 @@ template <typename TG, typename TA>
 void
 R_<TG, TA>::resume(const StateID stateId) {
 	const Request request{Request::Type::RESUME, stateId};
-	_requests << request;
-
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RESUME, stateId);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-template <typename TG, typename TA>
-void
-R_<TG, TA>::resume(const StateID stateId,
-				   const Payload& payload)
-{
-	const Request request{Request::Type::RESUME, stateId, payload};
-	_requests << request;
+	_requests.current() << request;
 
+	recordTransition(Transition::RESUME, stateId);
 	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RESUME, stateId);
 }
 
@@ -9399,21 +13527,9 @@ template <typename TG, typename TA>
 void
 R_<TG, TA>::utilize(const StateID stateId) {
 	const Request request{Request::Type::UTILIZE, stateId};
-	_requests << request;
-
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::UTILIZE, stateId);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-template <typename TG, typename TA>
-void
-R_<TG, TA>::utilize(const StateID stateId,
-					const Payload& payload)
-{
-	const Request request{Request::Type::UTILIZE, stateId, payload};
-	_requests << request;
+	_requests.current() << request;
 
+	recordTransition(Transition::UTILIZE, stateId);
 	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::UTILIZE, stateId);
 }
 
@@ -9423,21 +13539,9 @@ template <typename TG, typename TA>
 void
 R_<TG, TA>::randomize(const StateID stateId) {
 	const Request request{Request::Type::RANDOMIZE, stateId};
-	_requests << request;
-
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RANDOMIZE, stateId);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-template <typename TG, typename TA>
-void
-R_<TG, TA>::randomize(const StateID stateId,
-					  const Payload& payload)
-{
-	const Request request{Request::Type::RANDOMIZE, stateId, payload};
-	_requests << request;
+	_requests.current() << request;
 
+	recordTransition(Transition::RANDOMIZE, stateId);
 	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::RANDOMIZE, stateId);
 }
 
@@ -9447,22 +13551,29 @@ template <typename TG, typename TA>
 void
 R_<TG, TA>::schedule(const StateID stateId) {
 	const Request request{Request::Type::SCHEDULE, stateId};
-	_requests << request;
+	_requests.current() << request;
 
+	recordTransition(Transition::SCHEDULE, stateId);
 	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::SCHEDULE, stateId);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 template <typename TG, typename TA>
+template <typename TPayload>
 void
-R_<TG, TA>::schedule(const StateID stateId,
-					 const Payload& payload)
+R_<TG, TA>::requestTransition(const typename Request::Type type,
+							  const Transition transition,
+							  const StateID stateId,
+							  TPayload&& payload)
 {
-	const Request request{Request::Type::SCHEDULE, stateId, payload};
-	_requests << request;
+	// recorded before the payload is moved into the pool
+	recordTransition(transition, stateId, payload);
 
-	HFSM_LOG_TRANSITION(INVALID_STATE_ID, Transition::SCHEDULE, stateId);
+	const Request request{type, stateId, _payloadPool.stage(std::forward<TPayload>(payload))};
+	_requests.current() << request;
+
+	HFSM_LOG_TRANSITION(INVALID_STATE_ID, transition, stateId);
 }
 
 //------------------------------------------------------------------------------
@@ -9470,24 +13581,27 @@ R_<TG, TA>::schedule(const StateID stateId,
 template <typename TG, typename TA>
 void
 R_<TG, TA>::resetStateData(const StateID stateId) {
-	HFSM_ASSERT(stateId < Payloads::CAPACITY);
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-	if (stateId < Payloads::CAPACITY)
-		_payloadsSet.reset(stateId);
+	if (stateId < STATE_COUNT) {
+		releaseStateData(stateId);
+		_payloadChanges.set(stateId);
+	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 template <typename TG, typename TA>
+template <typename TPayload>
 void
-R_<TG, TA>::setStateData(const StateID stateId,
-						 const Payload& payload)
+R_<TG, TA>::assignStateData(const StateID stateId,
+							TPayload&& payload)
 {
-	HFSM_ASSERT(stateId < Payloads::CAPACITY);
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-	if (stateId < Payloads::CAPACITY) {
-		_payloads[stateId] = payload;
-		_payloadsSet.set(stateId);
+	if (stateId < STATE_COUNT) {
+		holdStateData(stateId, std::forward<TPayload>(payload));
+		_payloadChanges.set(stateId);
 	}
 }
 
@@ -9496,10 +13610,10 @@ R_<TG, TA>::setStateData(const StateID stateId,
 template <typename TG, typename TA>
 bool
 R_<TG, TA>::isStateDataSet(const StateID stateId) const {
-	HFSM_ASSERT(stateId < Payloads::CAPACITY);
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-	return stateId < Payloads::CAPACITY ?
-		_payloadsSet.get(stateId) : false;
+	return stateId < STATE_COUNT ?
+		_payloadSlots[stateId] != INVALID_SHORT_INDEX : false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -9507,10 +13621,10 @@ R_<TG, TA>::isStateDataSet(const StateID stateId) const {
 template <typename TG, typename TA>
 const typename R_<TG, TA>::Payload*
 R_<TG, TA>::getStateData(const StateID stateId) const {
-	HFSM_ASSERT(stateId < Payloads::CAPACITY);
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-	return stateId < Payloads::CAPACITY && _payloadsSet.get(stateId) ?
-		&_payloads[stateId] : nullptr;
+	return stateId < STATE_COUNT && _payloadSlots[stateId] != INVALID_SHORT_INDEX ?
+		&_payloadPool[_payloadSlots[stateId]] : nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -9522,100 +13636,388 @@ R_<TG, TA>::initialEnter() {
 					_random,
 					_stateRegistry,
 					_planData,
+					profiler(),
 					HFSM_LOGGER_OR(_logger, nullptr));
 
 	AllForks undoRequested = _stateRegistry.requested;
 
 	_apex.deepRequestChange(control);
 
-	Requests lastRequests = _requests;
-	_requests.clear();
+	_requests.advance();
 
-	if (cancelledByEntryGuards(lastRequests))
+	if (cancelledByEntryGuards(_requests.previous()))
 		_stateRegistry.requested = undoRequested;
 
 	for (LongIndex i = 0;
-		 i < SUBSTITUTION_LIMIT && _requests.count();
+		 i < SUBSTITUTION_LIMIT && _requests.current().count();
 		 ++i)
 	{
 		undoRequested = _stateRegistry.requested;
 
 		if (applyRequests(control)) {
-			lastRequests = _requests;
-			_requests.clear();
+			_requests.advance();
 
-			if (cancelledByEntryGuards(lastRequests))
+			if (cancelledByEntryGuards(_requests.previous()))
 				_stateRegistry.requested = undoRequested;
 		}
 
-		_requests.clear();
+		_requests.current().clear();
+	}
+	HFSM_ASSERT(_requests.current().count() == 0);
+	_payloadPool.releaseStaged();
+
+	{
+		PlanControl planControl{_context,
+								_random,
+								_stateRegistry,
+								_planData,
+								profiler(),
+								HFSM_LOGGER_OR(_logger, nullptr)};
+		planControl._planStats = &_planStats;
+		HFSM_IF_COROUTINES(planControl._routines = &_routines);
+
+		_apex.deepEnterRequested(planControl);
+		_stateRegistry.clearRequests();
+
+		HFSM_IF_ASSERT(_planData.verifyPlans());
+	}
+
+	HFSM_IF_STRUCTURE(udpateActivity());
+
+	publish();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::processTransitions() {
+	HFSM_ASSERT(_requests.current().count());
+
+	HFSM_IF_STRUCTURE(_lastTransitions.clear());
+
+	AllForks undoRequested;
+
+	Control control(_context,
+					_random,
+					_stateRegistry,
+					_planData,
+					profiler(),
+					HFSM_LOGGER_OR(_logger, nullptr));
+	control._recorder = _recorder;
+
+	for (LongIndex i = 0;
+		i < SUBSTITUTION_LIMIT && _requests.current().count();
+		++i)
+	{
+		undoRequested = _stateRegistry.requested;
+
+		if (applyRequests(control)) {
+			_requests.advance();
+
+			if (cancelledByGuards(_requests.previous()))
+				_stateRegistry.requested = undoRequested;
+		} else
+			_requests.current().clear();
 	}
-	HFSM_ASSERT(_requests.count() == 0);
 
 	{
 		PlanControl planControl{_context,
 								_random,
 								_stateRegistry,
 								_planData,
+								profiler(),
 								HFSM_LOGGER_OR(_logger, nullptr)};
+		planControl._planStats = &_planStats;
+		HFSM_IF_COROUTINES(planControl._routines = &_routines);
+
+		_apex.deepChangeToRequested(planControl);
+		_stateRegistry.clearRequests();
+
+		HFSM_IF_ASSERT(_planData.verifyPlans());
+	}
+
+	HFSM_IF_STRUCTURE(udpateActivity());
+
+	publish();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::dispatchUpdate() {
+	_record = _recorder ? _recorder->recordUpdate() : nullptr;
+
+	FullControl control(_context,
+						_random,
+						_stateRegistry,
+						_planData,
+						_requests.current(),
+						_payloadPool,
+						profiler(),
+						HFSM_LOGGER_OR(_logger, nullptr));
+	control._executor = _executor;
+	control._planStats = &_planStats;
+	HFSM_IF_COROUTINES(control._routines = &_routines);
+
+	_apex.deepUpdate(control);
+
+	HFSM_IF_ASSERT(_planData.verifyPlans());
+
+	if (_requests.current().count())
+		return true;
+	else {
+		sealRecord();
+
+		return false;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+template <typename TEvent>
+bool
+R_<TG, TA>::dispatchReact(const TEvent& event,
+						  const typename Recorder::Kind kind)
+{
+	_record = _recorder ? _recorder->recordEvent(kind, event) : nullptr;
+
+	FullControl control(_context,
+						_random,
+						_stateRegistry,
+						_planData,
+						_requests.current(),
+						_payloadPool,
+						profiler(),
+						HFSM_LOGGER_OR(_logger, nullptr));
+	control._planStats = &_planStats;
+	HFSM_IF_COROUTINES(control._routines = &_routines);
+
+	_apex.deepReact(control, event);
+
+	HFSM_IF_ASSERT(_planData.verifyPlans());
+
+	if (_requests.current().count())
+		return true;
+	else {
+		sealRecord();
+
+		return false;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::finalizeRequests() {
+	processTransitions();
+
+	_requests.current().clear();
+	_payloadPool.releaseStaged();
+
+	sealRecord();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// records are sealed with the states active once the call is fully processed
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::sealRecord() {
+	if (_record) {
+		_recorder->seal(_record, _stateRegistry.activeStates);
+		_record = nullptr;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::recordTransition(const Transition transition,
+							 const StateID stateId)
+{
+	if (_recorder)
+		_recorder->recordTransition(transition, stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::recordTransition(const Transition transition,
+							 const StateID stateId,
+							 const Payload& payload)
+{
+	if (_recorder)
+		_recorder->recordTransition(transition, stateId, payload);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::resetReplication() {
+	_replicatedStates = _stateRegistry.activeStates;
+	_stateRegistry.compoChanges.clear();
+	_payloadChanges.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_COROUTINES
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::stopInactiveRoutines() {
+	for (StateID i = 0; i < STATE_COUNT; ++i)
+		if (!_stateRegistry.isActive(i))
+			_routines.stop(i);
+}
+
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+typename R_<TG, TA>::PayloadsSet
+R_<TG, TA>::heldStateData() const {
+	PayloadsSet held;
+
+	for (StateID i = 0; i < STATE_COUNT; ++i)
+		if (_payloadSlots[i] != INVALID_SHORT_INDEX)
+			held.set(i);
+
+	return held;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+template <typename TPayload>
+void
+R_<TG, TA>::holdStateData(const StateID stateId,
+						  TPayload&& payload)
+{
+	ShortIndex& slot = _payloadSlots[stateId];
+
+	if (slot != INVALID_SHORT_INDEX)
+		_payloadPool[slot] = std::forward<TPayload>(payload);
+	else
+		slot = _payloadPool.hold(std::forward<TPayload>(payload));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::releaseStateData(const StateID stateId) {
+	ShortIndex& slot = _payloadSlots[stateId];
+
+	if (slot != INVALID_SHORT_INDEX) {
+		_payloadPool.release(slot);
+		slot = INVALID_SHORT_INDEX;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::coalesceRequests(const Requests& pending) {
+	Requests coalesced;
+	bool kept = true;
+
+	for (LongIndex i = 0; i < pending.count(); ++i)
+		if (!superseded(pending[i], _requests.current(), 0))
+			kept &= keepRequest(coalesced, pending[i]);
+		else
+			dropRequest(pending[i]);
 
-		_apex.deepEnterRequested(planControl);
-		_stateRegistry.clearRequests();
+	for (LongIndex i = 0; i < _requests.current().count(); ++i)
+		if (!superseded(_requests.current()[i], _requests.current(), i + 1))
+			kept &= keepRequest(coalesced, _requests.current()[i]);
+		else
+			dropRequest(_requests.current()[i]);
 
-		HFSM_IF_ASSERT(_planData.verifyPlans());
-	}
+	_requests.current() = coalesced;
 
-	HFSM_IF_STRUCTURE(udpateActivity());
+	return kept;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// independent requests can pile up past 'COMPO_REGIONS' between flushes,
+// the newest ones are dropped, counted and reported as cancelled
 
 template <typename TG, typename TA>
-void
-R_<TG, TA>::processTransitions() {
-	HFSM_ASSERT(_requests.count());
+bool
+R_<TG, TA>::keepRequest(Requests& coalesced,
+						const Request& request)
+{
+	if (coalesced.count() < Requests::CAPACITY) {
+		coalesced << request;
 
-	HFSM_IF_STRUCTURE(_lastTransitions.clear());
+		return true;
+	} else {
+		++_requestOverflows;
+		HFSM_LOG_CANCELLED_PENDING(request.stateId);
 
-	AllForks undoRequested;
-	Requests lastRequests;
+		dropRequest(request);
 
-	Control control(_context,
-					_random,
-					_stateRegistry,
-					_planData,
-					HFSM_LOGGER_OR(_logger, nullptr));
+		return false;
+	}
+}
 
-	for (LongIndex i = 0;
-		i < SUBSTITUTION_LIMIT && _requests.count();
-		++i)
-	{
-		undoRequested = _stateRegistry.requested;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// staged payloads are otherwise only released on flush()
 
-		if (applyRequests(control)) {
-			lastRequests = _requests;
-			_requests.clear();
+template <typename TG, typename TA>
+void
+R_<TG, TA>::dropRequest(const Request& request) {
+	if (request.payload != INVALID_SHORT_INDEX)
+		_payloadPool.release(request.payload);
+}
 
-			if (cancelledByGuards(lastRequests))
-				_stateRegistry.requested = undoRequested;
-		} else
-			_requests.clear();
-	}
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	{
-		PlanControl planControl{_context,
-								_random,
-								_stateRegistry,
-								_planData,
-								HFSM_LOGGER_OR(_logger, nullptr)};
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::superseded(const Request& request,
+					   const Requests& later,
+					   const LongIndex from) const
+{
+	// schedules are only replaced by identical ones
+	for (LongIndex i = from; i < later.count(); ++i)
+		if (request.type == Request::SCHEDULE ?
+				later[i].type == Request::SCHEDULE &&
+				later[i].stateId == request.stateId :
+				later[i].type != Request::SCHEDULE &&
+				overrides(later[i].stateId, request.stateId))
+			return true;
 
-		_apex.deepChangeToRequested(planControl);
-		_stateRegistry.clearRequests();
+	return false;
+}
 
-		HFSM_IF_ASSERT(_planData.verifyPlans());
-	}
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// transitions into different prongs of an orthogonal region are independent,
+// anything else branching off a common composite region is replaced
 
-	HFSM_IF_STRUCTURE(udpateActivity());
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::overrides(const StateID later,
+					  const StateID earlier) const
+{
+	using Topology = typename StateRegistry::Topology;
+
+	for (Parent l = Topology::STATE_PARENTS[later]; l; l = _stateRegistry.forkParent(l.forkId))
+		for (Parent e = Topology::STATE_PARENTS[earlier]; e; e = _stateRegistry.forkParent(e.forkId))
+			if (l.forkId == e.forkId)
+				return l.forkId > 0 || l.prong == e.prong;
+
+	return false;
 }
 
 //------------------------------------------------------------------------------
@@ -9625,7 +14027,7 @@ bool
 R_<TG, TA>::applyRequests(Control& control) {
 	bool changesMade = false;
 
-	for (const Request& request : _requests) {
+	for (const Request& request : _requests.current()) {
 		HFSM_IF_STRUCTURE(_lastTransitions << TransitionInfo(request, Method::UPDATE));
 
 		switch (request.type) {
@@ -9663,9 +14065,12 @@ R_<TG, TA>::cancelledByEntryGuards(const Requests& pendingRequests) {
 							  _random,
 							  _stateRegistry,
 							  _planData,
-							  _requests,
+							  _requests.current(),
 							  pendingRequests,
+							  _payloadPool,
+							  profiler(),
 		HFSM_LOGGER_OR(_logger, nullptr)};
+	guardControl._planStats = &_planStats;
 
 	if (_apex.deepEntryGuard(guardControl)) {
 		HFSM_IF_STRUCTURE(recordRequestsAs(Method::ENTRY_GUARD));
@@ -9684,9 +14089,12 @@ R_<TG, TA>::cancelledByGuards(const Requests& pendingRequests) {
 							  _random,
 							  _stateRegistry,
 							  _planData,
-							  _requests,
+							  _requests.current(),
 							  pendingRequests,
+							  _payloadPool,
+							  profiler(),
 							  HFSM_LOGGER_OR(_logger, nullptr)};
+	guardControl._planStats = &_planStats;
 
 	if (_apex.deepForwardExitGuard(guardControl)) {
 		HFSM_IF_STRUCTURE(recordRequestsAs(Method::EXIT_GUARD));
@@ -9812,7 +14220,7 @@ R_<TG, TA>::udpateActivity() {
 template <typename TG, typename TA>
 void
 R_<TG, TA>::recordRequestsAs(const Method method) {
-	for (const auto& request : _requests)
+	for (const auto& request : _requests.current())
 		_lastTransitions << TransitionInfo(request, method);
 }
 
@@ -9820,6 +14228,368 @@ R_<TG, TA>::recordRequestsAs(const Method method) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+}
+}
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+// all instances are dispatched first, transitions are processed in a second
+// pass over the instances that made requests
+
+template <typename TInstance,
+		  LongIndex NCapacity>
+class MB_ final {
+public:
+	using Instance	= TInstance;
+	using Index		= LongIndex;
+
+	static constexpr Index CAPACITY = NCapacity;
+	static constexpr Index INVALID	= INVALID_LONG_INDEX;
+
+	static_assert(CAPACITY < INVALID, "Batch capacity is too large");
+
+public:
+	HFSM_INLINE MB_() = default;
+	HFSM_INLINE ~MB_()												{ clear();							}
+
+	MB_(const MB_&) = delete;
+	MB_& operator = (const MB_&) = delete;
+
+	template <typename... TArgs>
+	Index emplace(TArgs&&... args);
+
+	void clear();
+
+	HFSM_INLINE		  Instance& operator[] (const Index i);
+	HFSM_INLINE const Instance& operator[] (const Index i) const;
+
+	HFSM_INLINE Index count() const									{ return _count;					}
+
+	HFSM_INLINE Index pendingCount() const							{ return _pendingCount;				}
+
+	void updateAll();
+
+	template <typename TEvent>
+	void reactAll(const TEvent& event);
+
+private:
+	HFSM_INLINE		  Instance& instance(const Index i)				{ return reinterpret_cast<	   Instance&>(_storage[i]);	}
+	HFSM_INLINE const Instance& instance(const Index i) const		{ return reinterpret_cast<const Instance&>(_storage[i]);	}
+
+	HFSM_INLINE void finalizePending();
+
+private:
+	struct alignas(Instance) Cell {
+		unsigned char bytes[sizeof(Instance)];
+	};
+
+	Cell _storage[CAPACITY];
+	Index _pending[CAPACITY];
+
+	Index _count = 0;
+	Index _pendingCount = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TI, LongIndex NC>
+template <typename... TArgs>
+LongIndex
+MB_<TI, NC>::emplace(TArgs&&... args) {
+	if (_count < CAPACITY) {
+		new (&_storage[_count]) Instance{std::forward<TArgs>(args)...};
+
+		return _count++;
+	} else {
+		HFSM_BREAK();
+
+		return INVALID;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TI, LongIndex NC>
+void
+MB_<TI, NC>::clear() {
+	while (_count)
+		instance(--_count).~Instance();
+
+	_pendingCount = 0;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TI, LongIndex NC>
+typename MB_<TI, NC>::Instance&
+MB_<TI, NC>::operator[] (const Index i) {
+	HFSM_ASSERT(i < _count);
+
+	return instance(i);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, LongIndex NC>
+const typename MB_<TI, NC>::Instance&
+MB_<TI, NC>::operator[] (const Index i) const {
+	HFSM_ASSERT(i < _count);
+
+	return instance(i);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TI, LongIndex NC>
+void
+MB_<TI, NC>::updateAll() {
+	_pendingCount = 0;
+
+	for (Index i = 0; i < _count; ++i)
+		if (instance(i).dispatchUpdate())
+			_pending[_pendingCount++] = i;
+
+	finalizePending();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, LongIndex NC>
+template <typename TEvent>
+void
+MB_<TI, NC>::reactAll(const TEvent& event) {
+	_pendingCount = 0;
+
+	for (Index i = 0; i < _count; ++i)
+		if (instance(i).dispatchReact(event))
+			_pending[_pendingCount++] = i;
+
+	finalizePending();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TI, LongIndex NC>
+void
+MB_<TI, NC>::finalizePending() {
+	for (Index p = 0; p < _pendingCount; ++p)
+		instance(_pending[p]).finalizeRequests();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+// machines of any type, split into shards with a context of their own;
+// updateAll() hands one shard per task to the attached executor and returns
+// once all of them are done, so shard contexts can be merged right after it;
+// within a shard machines are dispatched first, transitions processed second,
+// as in 'MB_'
+
+template <typename TContext,
+		  LongIndex NShards,
+		  LongIndex NCapacity>
+class MS_ final {
+public:
+	using Context	= TContext;
+	using Index		= LongIndex;
+
+	static constexpr Index SHARD_COUNT = NShards;
+	static constexpr Index CAPACITY	   = NCapacity;
+	static constexpr Index INVALID	   = INVALID_LONG_INDEX;
+
+	static_assert(SHARD_COUNT > 0,		"Scheduler needs at least one shard");
+	static_assert(CAPACITY < INVALID,	"Shard capacity is too large");
+
+private:
+	// 'R_' of any type, called through thunks
+	struct Entry {
+		void* instance;
+		bool (*dispatch)(void* const instance);
+		void (*finalize)(void* const instance);
+	};
+
+	struct Shard {
+		Context context;
+
+		Entry entries[CAPACITY];
+		Index pending[CAPACITY];
+
+		Index count = 0;
+		Index pendingCount = 0;
+	};
+
+public:
+	HFSM_INLINE MS_() = default;
+
+	MS_(const MS_&) = delete;
+	MS_& operator = (const MS_&) = delete;
+
+	// context of the machines to be added to 'shard'
+	HFSM_INLINE		  Context& context(const Index shard);
+	HFSM_INLINE const Context& context(const Index shard) const;
+
+	// 'instance' is not owned and has to outlive its entry
+	template <typename TInstance>
+	Index add(const Index shard, TInstance& instance);
+
+	void clear();
+
+	HFSM_INLINE Index count(const Index shard) const;
+	HFSM_INLINE Index pendingCount(const Index shard) const;
+
+	// nullptr updates the shards one after another on the calling thread
+	HFSM_INLINE void attachExecutor(ExecutorInterface* const executor)		{ _executor = executor;	}
+
+	void updateAll();
+
+private:
+	static void updateShard(void* const scheduler, const Index shard);
+
+	template <typename TInstance>
+	static bool dispatch(void* const instance)		{ return static_cast<TInstance*>(instance)->dispatchUpdate();	}
+
+	template <typename TInstance>
+	static void finalize(void* const instance)		{ static_cast<TInstance*>(instance)->finalizeRequests();		}
+
+private:
+	Shard _shards[SHARD_COUNT];
+
+	ExecutorInterface* _executor = nullptr;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TC, LongIndex NS, LongIndex NC>
+typename MS_<TC, NS, NC>::Context&
+MS_<TC, NS, NC>::context(const Index shard) {
+	HFSM_ASSERT(shard < SHARD_COUNT);
+
+	return _shards[shard].context;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, LongIndex NS, LongIndex NC>
+const typename MS_<TC, NS, NC>::Context&
+MS_<TC, NS, NC>::context(const Index shard) const {
+	HFSM_ASSERT(shard < SHARD_COUNT);
+
+	return _shards[shard].context;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, LongIndex NS, LongIndex NC>
+template <typename TInstance>
+LongIndex
+MS_<TC, NS, NC>::add(const Index shard,
+					 TInstance& instance)
+{
+	HFSM_ASSERT(shard < SHARD_COUNT);
+	Shard& target = _shards[shard];
+
+	if (target.count < CAPACITY) {
+		target.entries[target.count] = Entry{&instance,
+											 &dispatch<TInstance>,
+											 &finalize<TInstance>};
+
+		return target.count++;
+	} else {
+		HFSM_BREAK();
+
+		return INVALID;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, LongIndex NS, LongIndex NC>
+void
+MS_<TC, NS, NC>::clear() {
+	for (Shard& shard : _shards) {
+		shard.count		   = 0;
+		shard.pendingCount = 0;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, LongIndex NS, LongIndex NC>
+LongIndex
+MS_<TC, NS, NC>::count(const Index shard) const {
+	HFSM_ASSERT(shard < SHARD_COUNT);
+
+	return _shards[shard].count;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, LongIndex NS, LongIndex NC>
+LongIndex
+MS_<TC, NS, NC>::pendingCount(const Index shard) const {
+	HFSM_ASSERT(shard < SHARD_COUNT);
+
+	return _shards[shard].pendingCount;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, LongIndex NS, LongIndex NC>
+void
+MS_<TC, NS, NC>::updateAll() {
+	if (_executor)
+		_executor->run(SHARD_COUNT, &updateShard, this);
+	else
+		for (Index shard = 0; shard < SHARD_COUNT; ++shard)
+			updateShard(this, shard);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TC, LongIndex NS, LongIndex NC>
+void
+MS_<TC, NS, NC>::updateShard(void* const scheduler,
+							 const Index index)
+{
+	Shard& shard = static_cast<MS_*>(scheduler)->_shards[index];
+
+	shard.pendingCount = 0;
+
+	for (Index i = 0; i < shard.count; ++i)
+		if (shard.entries[i].dispatch(shard.entries[i].instance))
+			shard.pending[shard.pendingCount++] = i;
+
+	for (Index p = 0; p < shard.pendingCount; ++p) {
+		const Entry& entry = shard.entries[shard.pending[p]];
+
+		entry.finalize(entry.instance);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 }
 }
 
@@ -35,15 +35,31 @@
 #endif
 
 #include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
 #include <typeindex>
 
+#ifdef HFSM_ENABLE_COROUTINES
+	#include <coroutine>	// C++20
+	#include <exception>	// std::terminate()
+#endif
+
+#ifdef HFSM_ENABLE_THREADS
+	#include <condition_variable>
+	#include <mutex>
+	#include <thread>
+#endif
+
 #if _MSC_VER == 1900
 	#include <math.h>		// @VS14: ldexpf()
 	#include <new>			// @VS14: placement new with non-default ctor
 #endif
 
-#if defined _DEBUG && _MSC_VER
-	#include <intrin.h>		// __debugbreak()
+#ifdef _MSC_VER
+	#include <intrin.h>		// __debugbreak(), __rdtsc()
 #endif
 
 #ifdef __GNUC__
@@ -59,17 +75,26 @@
 #include "detail/shared/iterator.hpp"
 #include "detail/shared/array.hpp"
 #include "detail/shared/bit_array.hpp"
+#include "detail/shared/event_queue.hpp"
 #include "detail/shared/list.hpp"
 #include "detail/shared/random.hpp"
 #include "detail/shared/type_list.hpp"
+#include "detail/shared/event_buffer.hpp"
+#include "detail/shared/payload_pool.hpp"
+#include "detail/shared/executor.hpp"
 
 #include "detail/debug/shared.hpp"
 #include "detail/debug/logger_interface.hpp"
+#include "detail/debug/replay_log.hpp"
+#include "detail/debug/profiler.hpp"
+#include "detail/debug/trace_logger.hpp"
 
 #include "detail/plan_data.hpp"
 #include "detail/plan.hpp"
 #include "detail/state_registry.hpp"
+#include "detail/published_states.hpp"
 #include "detail/control.hpp"
+#include "detail/routine.hpp"
 #include "detail/debug/structure_report.hpp"
 #include "detail/injections.hpp"
 #include "detail/structure/forward.hpp"
@@ -87,40 +112,88 @@ template <typename TC = EmptyContext,
 		  typename TG = ::hfsm2::RandomT<TU>,
 		  typename TP = EmptyPayload,
 		  LongIndex NS = 4,
-		  LongIndex NT = INVALID_LONG_INDEX>
+		  LongIndex NT = INVALID_LONG_INDEX,
+		  typename TE = detail::TL_<>,
+		  LongIndex NJ = INVALID_LONG_INDEX,
+		  typename TK = void,
+		  typename TL = void,
+		  LongIndex NP = INVALID_LONG_INDEX,
+		  LongIndex NF = 256>
 struct ConfigT {
 	using Context = TC;
 
 	using Rank	  = TN;
 	using Utility = TU;
 	using Random_ = TG;
-	using Logger  = LoggerInterfaceT<Utility>;
+
+	// 'void' selects the virtual 'LoggerInterfaceT<>', any type
+	// with the same methods is called directly, see 'StaticLoggerT<>'
+	using Logger  = typename std::conditional<std::is_same<TL, void>::value,
+											  LoggerInterfaceT<Utility>,
+											  TL>::type;
 
 	using Payload = TP;
+	using Events  = TE;
+
+	// clock sampled around state methods, 'void' disables profiling
+	using Clock	  = TK;
 
 	static constexpr LongIndex SUBSTITUTION_LIMIT = NS;
+
+	// plan tasks shared by all regions, defaults to two per composite prong;
+	// size from the machine's 'taskHighWater()' to trim plan storage
 	static constexpr LongIndex TASK_CAPACITY	  = NT;
 
+	// composite regions at least this wide dispatch to the active prong
+	// through a flat table instead of a binary search over the sub-states
+	static constexpr LongIndex JUMP_TABLE_WIDTH	  = NJ;
+
+	// payload slots shared by state data and transitions in flight,
+	// defaults to one per state and two per composite region
+	static constexpr LongIndex PAYLOAD_CAPACITY	  = NP;
+
+	// bytes available to the coroutine frame of each state routine,
+	// with 'HFSM_ENABLE_COROUTINES'
+	static constexpr LongIndex ROUTINE_FRAME_SIZE = NF;
+
 	template <typename T>
-	using ContextT			 = ConfigT< T, TN, TU, TG, TP, NS, NT>;
+	using ContextT			 = ConfigT< T, TN, TU, TG, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
 
 	template <typename T>
-	using RankT				 = ConfigT<TC,  T, TU, TG, TP, NS, NT>;
+	using RankT				 = ConfigT<TC,  T, TU, TG, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
 
 	template <typename T>
-	using UtilityT			 = ConfigT<TC, TN,  T, TG, TP, NS, NT>;
+	using UtilityT			 = ConfigT<TC, TN,  T, TG, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
 
 	template <typename T>
-	using RandomT			 = ConfigT<TC, TN, TU,  T, TP, NS, NT>;
+	using RandomT			 = ConfigT<TC, TN, TU,  T, TP, NS, NT, TE, NJ, TK, TL, NP, NF>;
+
+	template <typename T>
+	using PayloadT			 = ConfigT<TC, TN, TU, TG,  T, NS, NT, TE, NJ, TK, TL, NP, NF>;
+
+	template <LongIndex N>
+	using SubstitutionLimitN = ConfigT<TC, TN, TU, TG, TP,  N, NT, TE, NJ, TK, TL, NP, NF>;
+
+	template <LongIndex N>
+	using TaskCapacityN		 = ConfigT<TC, TN, TU, TG, TP, NS,  N, TE, NJ, TK, TL, NP, NF>;
+
+	template <typename... Ts>
+	using EventsT			 = ConfigT<TC, TN, TU, TG, TP, NS, NT, detail::TL_<Ts...>, NJ, TK, TL, NP, NF>;
+
+	template <LongIndex N>
+	using JumpTableN		 = ConfigT<TC, TN, TU, TG, TP, NS, NT, TE,  N, TK, TL, NP, NF>;
+
+	template <typename T = CycleClock>
+	using ProfilerT			 = ConfigT<TC, TN, TU, TG, TP, NS, NT, TE, NJ,  T, TL, NP, NF>;
 
 	template <typename T>
-	using PayloadT			 = ConfigT<TC, TN, TU, TG,  T, NS, NT>;
+	using LoggerT			 = ConfigT<TC, TN, TU, TG, TP, NS, NT, TE, NJ, TK,  T, NP, NF>;
 
 	template <LongIndex N>
-	using SubstitutionLimitN = ConfigT<TC, TN, TU, TG, TP,  N, NS>;
+	using PayloadCapacityN	 = ConfigT<TC, TN, TU, TG, TP, NS, NT, TE, NJ, TK, TL,  N, NF>;
 
 	template <LongIndex N>
-	using TaskCapacityN		 = ConfigT<TC, TN, TU, TG, TP, NT,  N>;
+	using RoutineFrameSizeN	 = ConfigT<TC, TN, TU, TG, TP, NS, NT, TE, NJ, TK, TL, NP,  N>;
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -185,10 +258,19 @@ struct M_ {
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	template <typename THead, typename... TSubStates>
-	using Orthogonal		  = OI_<THead, TSubStates...>;
+	using Orthogonal		  = OI_<Execution::Sequential, THead, TSubStates...>;
+
+	template <				  typename... TSubStates>
+	using OrthogonalPeers	  = OI_<Execution::Sequential, void,  TSubStates...>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	// prongs update() on the executor attached with 'attachExecutor()'
+	template <typename THead, typename... TSubStates>
+	using ParallelOrthogonal	  = OI_<Execution::Parallel,   THead, TSubStates...>;
 
 	template <				  typename... TSubStates>
-	using OrthogonalPeers	  = OI_<void,  TSubStates...>;
+	using ParallelOrthogonalPeers = OI_<Execution::Parallel,   void,  TSubStates...>;
 
 	//----------------------------------------------------------------------
 
@@ -230,6 +312,14 @@ struct M_ {
 	template <				  typename... TSubStates>
 	using OrthogonalPeerRoot  = RF_<Config_, OrthogonalPeers <  TSubStates...>>;
 
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	template <typename THead, typename... TSubStates>
+	using ParallelOrthogonalRoot	 = RF_<Config_, ParallelOrthogonal	   <THead, TSubStates...>>;
+
+	template <				  typename... TSubStates>
+	using ParallelOrthogonalPeerRoot = RF_<Config_, ParallelOrthogonalPeers<	  TSubStates...>>;
+
 	//----------------------------------------------------------------------
 };
 
@@ -242,6 +332,15 @@ using Machine = detail::M_<Config>;
 template <typename TConfig>
 using MachineT = detail::M_<TConfig>;
 
+template <typename TInstance, LongIndex NCapacity>
+using MachineBatch = detail::MB_<TInstance, NCapacity>;
+
+template <typename TContext, LongIndex NShards, LongIndex NCapacity>
+using MachineScheduler = detail::MS_<TContext, NShards, NCapacity>;
+
+template <typename TEvent, LongIndex NCapacity>
+using EventQueue = detail::EventQueueT<TEvent, NCapacity>;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 }
@@ -252,6 +351,8 @@ using MachineT = detail::M_<TConfig>;
 #include "detail/structure/orthogonal_sub.hpp"
 #include "detail/structure/orthogonal.hpp"
 #include "detail/structure/root.hpp"
+#include "detail/structure/batch.hpp"
+#include "detail/structure/scheduler.hpp"
 
 #undef HFSM_INLINE
 #undef HFSM_IF_LOGGER
@@ -2,6 +2,12 @@
 
 #define HFSM_ENABLE_LOG_INTERFACE
 #define HFSM_ENABLE_ASSERT
+#define HFSM_ENABLE_THREADS
+
+#ifdef __cpp_impl_coroutine
+	#define HFSM_ENABLE_COROUTINES
+#endif
+
 #include <hfsm2/machine.hpp>
 
 #include <catch2/catch.hpp>
@@ -2,7 +2,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-using BitArray = hfsm2::detail::BitArray<hfsm2::ShortIndex, 6>;
+using BitArray = hfsm2::detail::BitArray<hfsm2::ShortIndex, 6 * 8>;
 using Bits		= typename BitArray::Bits;
 
 TEST_CASE("Shared.BitArray<>", "[shared]") {
@@ -119,6 +119,41 @@ TEST_CASE("Shared.BitArray<>", "[shared]") {
 			REQUIRE(!bits.get(6));
 		}
 	}
+
+	WHEN("Whole array methods") {
+		const hfsm2::LongIndex end = BitArray::CAPACITY;
+
+		REQUIRE(!bitArray);
+		REQUIRE(bitArray.count() == 0);
+		REQUIRE(bitArray.first() == end);
+
+		bitArray.set( 1);
+		bitArray.set(28);
+		bitArray.set(47);
+
+		REQUIRE(!!bitArray);
+		REQUIRE(bitArray.count() == 3);
+
+		REQUIRE(bitArray.first()	 ==  1);
+		REQUIRE(bitArray.next( 1)	 == 28);
+		REQUIRE(bitArray.next(28)	 == 47);
+		REQUIRE(bitArray.next(47)	 == end);
+
+		{
+			Bits bits = bitArray.bits<3, 7>();
+			REQUIRE(!!bits);
+
+			bits.clear();
+			REQUIRE(!bits);
+		}
+
+		REQUIRE(bitArray.count() == 2);
+		REQUIRE(bitArray.get( 1));
+		REQUIRE(bitArray.get(47));
+
+		bitArray.clear();
+		REQUIRE(!bitArray);
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,72 @@
+#include "test_batch.hpp"
+
+using namespace test_batch;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Batch", "[machine]") {
+	static constexpr hfsm2::LongIndex COUNT = 4;
+
+	Context contexts[COUNT];
+
+	FSM::Batch<8> batch;
+	REQUIRE(batch.count() == 0);
+
+	for (auto& context : contexts)
+		REQUIRE(batch.emplace(context) != hfsm2::INVALID_LONG_INDEX);
+
+	REQUIRE(batch.count() == COUNT);
+
+	for (hfsm2::LongIndex i = 0; i < COUNT; ++i)
+		REQUIRE(batch[i].isActive<A>());
+
+	//--------------------------------------------------------------------------
+
+	batch.updateAll();
+	REQUIRE(batch.pendingCount() == 0);
+
+	for (hfsm2::LongIndex i = 0; i < COUNT; ++i) {
+		REQUIRE(contexts[i].updates == 1);
+		REQUIRE(batch[i].isActive<A>());
+	}
+
+	//--------------------------------------------------------------------------
+
+	contexts[1].advance = true;
+	contexts[3].advance = true;
+
+	batch.updateAll();
+	REQUIRE(batch.pendingCount() == 2);
+
+	REQUIRE(batch[0].isActive<A>());
+	REQUIRE(batch[1].isActive<B>());
+	REQUIRE(batch[2].isActive<A>());
+	REQUIRE(batch[3].isActive<B>());
+
+	//--------------------------------------------------------------------------
+
+	batch[2].changeTo<B>();
+
+	batch.updateAll();
+	REQUIRE(batch.pendingCount() == 1);
+
+	REQUIRE(batch[0].isActive<A>());
+	REQUIRE(batch[2].isActive<B>());
+
+	//--------------------------------------------------------------------------
+
+	batch.reactAll(Advance{});
+	REQUIRE(batch.pendingCount() == 1);
+
+	for (hfsm2::LongIndex i = 0; i < COUNT; ++i) {
+		REQUIRE(contexts[i].updates == 3);
+		REQUIRE(batch[i].isActive<B>());
+	}
+
+	//--------------------------------------------------------------------------
+
+	batch.clear();
+	REQUIRE(batch.count() == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
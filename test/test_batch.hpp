@@ -0,0 +1,66 @@
+#include "shared.hpp"
+
+namespace test_batch {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	bool advance = false;
+	unsigned updates = 0;
+};
+
+struct Advance {};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				S(A),
+				S(B)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<Apex>()	== 0, "");
+static_assert(FSM::stateId<A>()		== 1, "");
+static_assert(FSM::stateId<B>()		== 2, "");
+
+//------------------------------------------------------------------------------
+
+struct Apex : FSM::State {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct A
+	: FSM::State
+{
+	void update(FullControl& control) {
+		++control.context().updates;
+
+		if (control.context().advance)
+			control.changeTo<B>();
+	}
+
+	void react(const Advance&, FullControl& control) {
+		control.changeTo<B>();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct B
+	: FSM::State
+{
+	void update(FullControl& control) {
+		++control.context().updates;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+static_assert(FSM::Instance::STATE_COUNT == 3, "STATE_COUNT");
+
+}
@@ -0,0 +1,86 @@
+#include "test_deferred.hpp"
+
+using namespace test_deferred;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Deferred", "[machine]") {
+	Context context;
+	FSM::Instance machine{context};
+	REQUIRE(machine.isActive<A1>());
+
+	context.enters = 0;
+
+	//--------------------------------------------------------------------------
+	// a burst within one region collapses into a single transition
+
+	machine.queue(Go{FSM::stateId<A2>()});
+	machine.queue(Go{FSM::stateId<A3>()});
+	machine.queue(Go{FSM::stateId<A2>()});
+
+	REQUIRE(context.reactions == 3);
+	REQUIRE(machine.isActive<A1>());
+
+	machine.flush();
+	REQUIRE(context.enters == 1);
+	REQUIRE(machine.isActive<A2>());
+
+	//--------------------------------------------------------------------------
+	// the latest request wins across regions as well
+
+	context.enters = 0;
+
+	machine.queue(Go{FSM::stateId<B2>()});
+	machine.queue(Go{FSM::stateId<A3>()});
+	machine.flush();
+
+	REQUIRE(context.enters == 1);
+	REQUIRE(machine.isActive<A3>());
+	REQUIRE(!machine.isActive<B>());
+
+	//--------------------------------------------------------------------------
+
+	context.enters = 0;
+
+	machine.flush();
+	REQUIRE(context.enters == 0);
+	REQUIRE(machine.isActive<A3>());
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.DeferredSchedules", "[machine]") {
+	Context context;
+	FSM::Instance machine{context};
+
+	//--------------------------------------------------------------------------
+	// repeated schedules of the same state are kept once
+
+	REQUIRE(machine.queue(Later{FSM::stateId<B2>()}));
+	REQUIRE(machine.queue(Later{FSM::stateId<B2>()}));
+	REQUIRE(machine.queue(Later{FSM::stateId<B2>()}));
+	machine.flush();
+
+	REQUIRE(machine.requestOverflows() == 0);
+	REQUIRE(machine.isActive<A1>());
+	REQUIRE(machine.isResumable<B2>());
+
+	//--------------------------------------------------------------------------
+	// distinct schedules are never superseded, past 'COMPO_REGIONS' they're dropped
+
+	REQUIRE( machine.queue(Later{FSM::stateId<A2>()}));
+	REQUIRE( machine.queue(Later{FSM::stateId<A3>()}));
+	REQUIRE( machine.queue(Later{FSM::stateId<B1>()}));
+	REQUIRE(!machine.queue(Later{FSM::stateId<B2>()}));
+	machine.flush();
+
+	REQUIRE(machine.requestOverflows() == 1);
+	REQUIRE(machine.isActive<A1>());
+	REQUIRE(machine.isResumable<B1>());
+
+	machine.queue(Go{FSM::stateId<B>()});
+	machine.flush();
+	REQUIRE(machine.isActive<B1>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
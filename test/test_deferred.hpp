@@ -0,0 +1,86 @@
+#include "shared.hpp"
+
+namespace test_deferred {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	unsigned enters = 0;
+	unsigned reactions = 0;
+};
+
+struct Go {
+	hfsm2::StateID target;
+};
+
+struct Later {
+	hfsm2::StateID target;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				M::Composite<S(A),
+					S(A1),
+					S(A2),
+					S(A3)
+				>,
+				M::Composite<S(B),
+					S(B1),
+					S(B2)
+				>
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<Apex>()	== 0, "");
+static_assert(FSM::stateId<A>()		== 1, "");
+static_assert(FSM::stateId<A1>()	== 2, "");
+static_assert(FSM::stateId<A2>()	== 3, "");
+static_assert(FSM::stateId<A3>()	== 4, "");
+static_assert(FSM::stateId<B>()		== 5, "");
+static_assert(FSM::stateId<B1>()	== 6, "");
+static_assert(FSM::stateId<B2>()	== 7, "");
+
+//------------------------------------------------------------------------------
+
+struct Apex
+	: FSM::State
+{
+	void react(const Go& event, FullControl& control) {
+		++control.context().reactions;
+		control.changeTo(event.target);
+	}
+
+	void react(const Later& event, FullControl& control) {
+		control.schedule(event.target);
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename T>
+struct Counted
+	: FSM::State
+{
+	void enter(Control& control) {
+		++control.context().enters;
+	}
+};
+
+struct A	: FSM::State {};
+struct A1	: Counted<A1> {};
+struct A2	: Counted<A2> {};
+struct A3	: Counted<A3> {};
+
+struct B	: FSM::State {};
+struct B1	: Counted<B1> {};
+struct B2	: Counted<B2> {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,47 @@
+#include "test_event_buffer.hpp"
+
+using namespace test_event_buffer;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.EventBuffer", "[machine]") {
+	Context context;
+	FSM::Instance machine{context};
+	REQUIRE(machine.isActive<A>());
+
+	Buffer buffer;
+	REQUIRE(buffer.push(Label{"x"}));
+	REQUIRE(buffer.push(Go{FSM::stateId<B>()}));
+	REQUIRE(buffer.push(Ping{}));
+	REQUIRE(buffer.push(Label{"y"}));
+	REQUIRE(!buffer.push(Ping{}));
+	REQUIRE(buffer.count() == 4);
+
+	//--------------------------------------------------------------------------
+	// events are delivered in order, of their own types
+
+	machine.react(buffer);
+	REQUIRE(machine.isActive<B>());
+	REQUIRE(context.pings == 1);
+	REQUIRE(context.labels == "xy");
+
+	//--------------------------------------------------------------------------
+	// the buffer can be replayed
+
+	buffer.clear();
+	REQUIRE(buffer.count() == 0);
+
+	REQUIRE(buffer.push(Go{FSM::stateId<C>()}));
+	REQUIRE(buffer.push(Go{FSM::stateId<A>()}));
+
+	machine.queue(buffer);
+	REQUIRE(machine.isActive<B>());
+
+	machine.flush();
+	REQUIRE(machine.isActive<A>());
+
+	machine.react(buffer);
+	REQUIRE(machine.isActive<A>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,73 @@
+#include "shared.hpp"
+
+#include <string>
+
+namespace test_event_buffer {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	unsigned pings = 0;
+	std::string labels;
+};
+
+struct Go {
+	hfsm2::StateID target;
+};
+
+struct Ping {};
+
+struct Label {
+	std::string text;
+};
+
+using Config = hfsm2::Config::ContextT<Context>::EventsT<Go, Ping, Label>;
+
+using M = hfsm2::MachineT<Config>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(A),
+				S(B),
+				S(C)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<A>() == 1, "");
+static_assert(FSM::stateId<B>() == 2, "");
+static_assert(FSM::stateId<C>() == 3, "");
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+struct Reacting
+	: FSM::State
+{
+	void react(const Go& event, FullControl& control) {
+		control.changeTo(event.target);
+	}
+
+	void react(const Ping&, FullControl& control) {
+		++control.context().pings;
+	}
+
+	void react(const Label& event, FullControl& control) {
+		control.context().labels += event.text;
+	}
+};
+
+struct A : Reacting<A> {};
+struct B : Reacting<B> {};
+struct C : Reacting<C> {};
+
+//------------------------------------------------------------------------------
+
+using Buffer = FSM::Instance::EventBuffer<4>;
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
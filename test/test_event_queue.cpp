@@ -0,0 +1,60 @@
+#include "test_event_queue.hpp"
+
+using namespace test_event_queue;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.EventQueue", "[machine]") {
+	using Queue = hfsm2::EventQueue<Message, 64>;
+
+	Context context;
+	FSM::Instance machine{context};
+	Queue queue;
+
+	//--------------------------------------------------------------------------
+
+	REQUIRE(queue.drain(machine) == 0);
+
+	for (unsigned i = 0; i < 64; ++i)
+		REQUIRE(queue.post(Message{0, i}));
+
+	REQUIRE(!queue.post(Message{0, 64}));
+
+	REQUIRE(queue.drain(machine) == 64);
+	REQUIRE(context.received[0] == 64);
+	REQUIRE(context.ordered);
+
+	context.received[0] = 0;
+
+	//--------------------------------------------------------------------------
+
+	std::vector<std::thread> producers;
+
+	for (unsigned p = 0; p < PRODUCERS; ++p)
+		producers.emplace_back([&queue, p] {
+			for (unsigned i = 0; i < EVENTS; )
+				if (queue.post(Message{p, i}))
+					++i;
+				else
+					std::this_thread::yield();
+		});
+
+	for (unsigned total = 0; total < PRODUCERS * EVENTS; )
+		total += queue.drain(machine);
+
+	for (auto& producer : producers)
+		producer.join();
+
+	for (unsigned p = 0; p < PRODUCERS; ++p)
+		REQUIRE(context.received[p] == EVENTS);
+
+	REQUIRE(context.ordered);
+	REQUIRE(queue.drain(machine) == 0);
+
+	//--------------------------------------------------------------------------
+
+	machine.react(Stop{});
+	REQUIRE(machine.isActive<Stopped>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,74 @@
+#include "shared.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace test_event_queue {
+
+////////////////////////////////////////////////////////////////////////////////
+
+static constexpr unsigned PRODUCERS = 4;
+static constexpr unsigned EVENTS	= 1000;
+
+struct Context {
+	unsigned received[PRODUCERS] = {};
+	bool ordered = true;
+};
+
+struct Message {
+	unsigned producer;
+	unsigned sequence;
+};
+
+struct Stop {};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				S(Running),
+				S(Stopped)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<Apex>()	  == 0, "");
+static_assert(FSM::stateId<Running>() == 1, "");
+static_assert(FSM::stateId<Stopped>() == 2, "");
+
+//------------------------------------------------------------------------------
+
+struct Apex : FSM::State {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Running
+	: FSM::State
+{
+	using FSM::State::react;
+
+	void react(const Message& message, FullControl& control) {
+		Context& context = control.context();
+		unsigned& received = context.received[message.producer];
+
+		if (message.sequence != received)
+			context.ordered = false;
+
+		++received;
+	}
+
+	void react(const Stop&, FullControl& control) {
+		control.changeTo<Stopped>();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Stopped : FSM::State {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,79 @@
+#include "test_jump_table.hpp"
+
+using namespace test_jump_table;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+void
+assertTallies(const Context& context,
+			  const hfsm2::StateID stateId,
+			  const unsigned enters,
+			  const unsigned updates,
+			  const unsigned reacts,
+			  const unsigned exits)
+{
+	const Tally& tally = context.tallies[stateId];
+
+	REQUIRE(tally.enters  == enters);
+	REQUIRE(tally.updates == updates);
+	REQUIRE(tally.reacts  == reacts);
+	REQUIRE(tally.exits	  == exits);
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.JumpTable", "[machine]") {
+	Context context;
+
+	{
+		FSM::Instance machine{context};
+		REQUIRE(machine.isActive<A1>());
+		assertTallies(context, FSM::stateId<A1>(), 1, 0, 0, 0);
+
+		//----------------------------------------------------------------------
+		// the table reaches every prong of a wide region
+
+		machine.changeTo<A4>();
+		machine.update();
+		REQUIRE(machine.isActive<A4>());
+		assertTallies(context, FSM::stateId<A1>(), 1, 1, 0, 1);
+		assertTallies(context, FSM::stateId<A4>(), 1, 0, 0, 0);
+
+		machine.react(Ping{});
+		assertTallies(context, FSM::stateId<A4>(), 1, 0, 1, 0);
+
+		machine.changeTo<A3>();
+		machine.update();
+		REQUIRE(machine.isActive<A3>());
+		assertTallies(context, FSM::stateId<A4>(), 1, 1, 1, 1);
+
+		//----------------------------------------------------------------------
+		// narrow regions keep the binary split
+
+		machine.changeTo<C2>();
+		machine.update();
+		REQUIRE(machine.isActive<C2>());
+		REQUIRE(!machine.isActive<A>());
+		assertTallies(context, FSM::stateId<A >(), 1, 3, 1, 1);
+		assertTallies(context, FSM::stateId<A3>(), 1, 1, 0, 1);
+		assertTallies(context, FSM::stateId<C2>(), 1, 0, 0, 0);
+
+		machine.react(Ping{});
+		assertTallies(context, FSM::stateId<C >(), 1, 0, 1, 0);
+		assertTallies(context, FSM::stateId<C2>(), 1, 0, 1, 0);
+
+		machine.changeTo<B>();
+		machine.update();
+		REQUIRE(machine.isActive<B>());
+		assertTallies(context, FSM::stateId<C2>(), 1, 1, 1, 1);
+	}
+
+	assertTallies(context, FSM::stateId<B>(), 1, 0, 0, 1);
+	assertTallies(context, FSM::stateId<Apex>(), 1, 4, 2, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
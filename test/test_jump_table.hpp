@@ -0,0 +1,85 @@
+#include "shared.hpp"
+
+namespace test_jump_table {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Tally {
+	unsigned enters  = 0;
+	unsigned updates = 0;
+	unsigned reacts  = 0;
+	unsigned exits	 = 0;
+};
+
+struct Context {
+	Tally tallies[10];
+};
+
+struct Ping {};
+
+using Config = hfsm2::Config::ContextT<Context>::JumpTableN<3>;
+
+using M = hfsm2::MachineT<Config>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				M::Composite<S(A),
+					S(A1),
+					S(A2),
+					S(A3),
+					S(A4)
+				>,
+				S(B),
+				M::Composite<S(C),
+					S(C1),
+					S(C2)
+				>
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<Apex>()	== 0, "");
+static_assert(FSM::stateId<A>()		== 1, "");
+static_assert(FSM::stateId<A1>()	== 2, "");
+static_assert(FSM::stateId<A2>()	== 3, "");
+static_assert(FSM::stateId<A3>()	== 4, "");
+static_assert(FSM::stateId<A4>()	== 5, "");
+static_assert(FSM::stateId<B>()		== 6, "");
+static_assert(FSM::stateId<C>()		== 7, "");
+static_assert(FSM::stateId<C1>()	== 8, "");
+static_assert(FSM::stateId<C2>()	== 9, "");
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+struct Tallied
+	: FSM::State
+{
+	static Tally& tally(Control& control)	{ return control.context().tallies[FSM::stateId<T>()];	}
+
+	void enter (Control& control)						{ ++tally(control).enters;	}
+	void update(FullControl& control)					{ ++tally(control).updates; }
+	void react (const Ping&, FullControl& control)		{ ++tally(control).reacts;	}
+	void exit  (Control& control)						{ ++tally(control).exits;	}
+};
+
+struct Apex : Tallied<Apex> {};
+
+struct A	: Tallied<A > {};
+struct A1	: Tallied<A1> {};
+struct A2	: Tallied<A2> {};
+struct A3	: Tallied<A3> {};
+struct A4	: Tallied<A4> {};
+
+struct B	: Tallied<B > {};
+
+struct C	: Tallied<C > {};
+struct C1	: Tallied<C1> {};
+struct C2	: Tallied<C2> {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
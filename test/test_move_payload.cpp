@@ -0,0 +1,87 @@
+#include "test_move_payload.hpp"
+
+namespace test_move_payload {
+
+int Parameters::copies = 0;
+int Parameters::moves  = 0;
+
+int B ::received = 0;
+int UB::received = 0;
+
+bool UA::moved = false;
+
+}
+
+using namespace test_move_payload;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.MovePayload", "[machine]") {
+	FSM::Instance machine;
+
+	machine.update();
+	REQUIRE(machine.isActive<B>());
+	REQUIRE(B::received == 3);
+
+	machine.changeTo<A>(Parameters{5});
+	machine.setStateData<A>(Parameters{7});
+	machine.update();
+	REQUIRE(machine.isActive<A>());
+	REQUIRE(machine.getStateData<A>()->value == 7);
+
+	machine.setStateData<A>(Parameters{9});
+	REQUIRE(machine.getStateData<A>()->value == 9);
+
+	REQUIRE(Parameters::copies == 0);
+	REQUIRE(Parameters::moves  == 4);
+
+	// lvalues are still copied
+	const Parameters parameters{11};
+	machine.changeTo<B>(parameters);
+	machine.update();
+	REQUIRE(B::received == 11);
+	REQUIRE(Parameters::copies == 1);
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.MoveOnlyPayload", "[machine]") {
+	UFSM::Instance machine;
+
+	machine.changeTo<UB>(Handle{new int{13}});
+	machine.update();
+	REQUIRE(machine.isActive<UB>());
+	REQUIRE(UB::received == 13);
+
+	machine.setStateData<UA>(Handle{new int{17}});
+	REQUIRE(**machine.getStateData<UA>() == 17);
+
+	machine.resetStateData<UA>();
+	REQUIRE(!machine.isStateDataSet<UA>());
+
+	//--------------------------------------------------------------------------
+	// named handles are moved from, by states and by the machine
+
+	machine.changeTo<UA>();
+	machine.update();
+	REQUIRE(machine.isActive<UA>());
+
+	machine.react(Pass{19});
+	REQUIRE(UA::moved);
+	REQUIRE(machine.isActive<UB>());
+	REQUIRE(UB::received == 19);
+
+	Handle handle{new int{23}};
+	machine.changeTo<UA>(std::move(handle));
+	REQUIRE(!handle);
+
+	machine.update();
+	REQUIRE(machine.isActive<UA>());
+
+	Handle data{new int{29}};
+	machine.setStateData<UB>(std::move(data));
+	REQUIRE(!data);
+	REQUIRE(**machine.getStateData<UB>() == 29);
+}
+
+////////////////////////////////////////////////////////////////////////////////
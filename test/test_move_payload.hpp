@@ -0,0 +1,128 @@
+#include "shared.hpp"
+
+#include <memory>
+
+namespace test_move_payload {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Parameters {
+	Parameters(const int value_ = 0)
+		: value{value_}
+	{}
+
+	Parameters(const Parameters& other)
+		: value{other.value}
+	{
+		++copies;
+	}
+
+	Parameters(Parameters&& other)
+		: value{other.value}
+	{
+		++moves;
+	}
+
+	Parameters& operator = (const Parameters& other) {
+		value = other.value;
+		++copies;
+		return *this;
+	}
+
+	Parameters& operator = (Parameters&& other) {
+		value = other.value;
+		++moves;
+		return *this;
+	}
+
+	int value;
+	float curves[64];
+
+	static int copies;
+	static int moves;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::PayloadT<Parameters>>;
+
+using Handle = std::unique_ptr<int>;
+
+using U = hfsm2::MachineT<hfsm2::Config::PayloadT<Handle>>;
+
+struct Pass {
+	int value;
+};
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(A),
+				S(B)
+			>;
+
+using UFSM = U::PeerRoot<
+				S(UA),
+				S(UB)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<A>()	  == 1, "");
+static_assert(FSM::stateId<B>()	  == 2, "");
+
+static_assert(UFSM::stateId<UA>() == 1, "");
+static_assert(UFSM::stateId<UB>() == 2, "");
+
+//------------------------------------------------------------------------------
+
+struct A
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.changeTo<B>(Parameters{3});
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct B
+	: FSM::State
+{
+	void entryGuard(GuardControl& control) {
+		received = control.pendingPayload(control.pendingTransitions()[0])->value;
+	}
+
+	static int received;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct UA
+	: UFSM::State
+{
+	void react(const Pass& event, FullControl& control) {
+		Handle handle{new int{event.value}};
+		control.changeTo<UB>(std::move(handle));
+
+		moved = !handle;
+	}
+
+	static bool moved;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct UB
+	: UFSM::State
+{
+	void entryGuard(GuardControl& control) {
+		received = **control.pendingPayload(control.pendingTransitions()[0]);
+	}
+
+	static int received;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,113 @@
+#include "test_parallel_orthogonal.hpp"
+
+using namespace test_parallel_orthogonal;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.ParallelOrthogonal", "[machine]") {
+	Context context;
+	ReverseExecutor executor;
+
+	FSM::Instance machine{context};
+	machine.attachExecutor(&executor);
+
+	REQUIRE(machine.isActive<Idle>());
+	REQUIRE(machine.isActive<Stand>());
+	REQUIRE(machine.isActive<Silent>());
+
+	machine.update();
+	REQUIRE(executor.runs == 1);
+
+	REQUIRE(machine.isActive<Scan>());
+	REQUIRE(machine.isActive<Walk>());
+	REQUIRE(machine.isActive<Talk>());
+	REQUIRE(context.payload == 42);
+
+	// merged in prong order, whatever order the prongs ran in
+	REQUIRE(context.pendingCount == 3);
+	REQUIRE(context.pending[0] == FSM::stateId<Scan>());
+	REQUIRE(context.pending[1] == FSM::stateId<Walk>());
+	REQUIRE(context.pending[2] == FSM::stateId<Talk>());
+
+	machine.update();
+	REQUIRE(context.scans == 1);
+	REQUIRE(context.steps == 1);
+	REQUIRE(context.lines == 1);
+
+	// without an executor, prongs update on the calling thread
+	machine.attachExecutor(nullptr);
+	machine.update();
+	REQUIRE(executor.runs == 2);
+	REQUIRE(context.scans == 2);
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.WorkStealingExecutor", "[machine]") {
+	using Executor = hfsm2::WorkStealingExecutorT<4>;
+
+	Executor executor;
+
+	SECTION("tasks") {
+		std::atomic<int> counts[1000];
+		for (auto& count : counts)
+			count = 0;
+
+		for (int i = 0; i < 10; ++i)
+			executor.run(1000,
+						 [](void* const context, const hfsm2::LongIndex index) {
+							 static_cast<std::atomic<int>*>(context)[index].fetch_add(1);
+						 },
+						 counts);
+
+		for (const auto& count : counts)
+			REQUIRE(count == 10);
+	}
+
+	SECTION("machine") {
+		Context context;
+
+		FSM::Instance machine{context};
+		machine.attachExecutor(&executor);
+
+		for (int i = 0; i < 101; ++i)
+			machine.update();
+
+		REQUIRE(context.payload == 42);
+		REQUIRE(context.steps == 100);
+		REQUIRE(context.scans == context.lines);
+		REQUIRE(machine.isActive<Done>());
+	}
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.ParallelPlans", "[machine]") {
+	namespace plans = test_parallel_plans;
+
+	hfsm2::WorkStealingExecutorT<4> executor;
+
+	plans::Context context;
+
+	plans::FSM::Instance machine{context};
+	machine.attachExecutor(&executor);
+
+	// every third update finishes a round trip and plans the next one
+	for (int i = 0; i < 300; ++i)
+		machine.update();
+
+	for (int n = 0; n < 4; ++n) {
+		REQUIRE(context.tasks[n]   == 300);
+		REQUIRE(context.replans[n] == 100);
+	}
+
+	REQUIRE(machine.isActive<plans::Fetch<0>>());
+	REQUIRE(machine.isActive<plans::Fetch<1>>());
+	REQUIRE(machine.isActive<plans::Fetch<2>>());
+	REQUIRE(machine.isActive<plans::Fetch<3>>());
+
+	REQUIRE(machine.taskHighWater() == 8);
+	REQUIRE(machine.taskOverflows() == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,268 @@
+#include "shared.hpp"
+
+namespace test_parallel_orthogonal {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// each prong only writes its own fields
+struct Context {
+	int scans	= 0;
+	int steps	= 0;
+	int lines	= 0;
+
+	int payload = 0;
+	hfsm2::StateID pending[4];
+	hfsm2::LongIndex pendingCount = 0;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>::PayloadT<int>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				M::ParallelOrthogonal<S(Agent),
+					M::Composite<S(Perception),
+						S(Idle),
+						S(Scan)
+					>,
+					M::Composite<S(Locomotion),
+						S(Stand),
+						S(Walk)
+					>,
+					M::Composite<S(Dialogue),
+						S(Silent),
+						S(Talk)
+					>
+				>,
+				S(Done)
+			>;
+
+#undef S
+
+static_assert(FSM::regionId<Agent>()	  ==  1, "");
+static_assert(FSM::regionId<Perception>() ==  2, "");
+static_assert(FSM::regionId<Locomotion>() ==  3, "");
+static_assert(FSM::regionId<Dialogue>()	  ==  4, "");
+
+static_assert(FSM::stateId<Agent>()		  ==  1, "");
+static_assert(FSM::stateId<Perception>()  ==  2, "");
+static_assert(FSM::stateId<Idle>()		  ==  3, "");
+static_assert(FSM::stateId<Scan>()		  ==  4, "");
+static_assert(FSM::stateId<Locomotion>()  ==  5, "");
+static_assert(FSM::stateId<Stand>()		  ==  6, "");
+static_assert(FSM::stateId<Walk>()		  ==  7, "");
+static_assert(FSM::stateId<Dialogue>()	  ==  8, "");
+static_assert(FSM::stateId<Silent>()	  ==  9, "");
+static_assert(FSM::stateId<Talk>()		  == 10, "");
+static_assert(FSM::stateId<Done>()		  == 11, "");
+
+//------------------------------------------------------------------------------
+
+struct Agent		: FSM::State {};
+struct Perception	: FSM::State {};
+struct Locomotion	: FSM::State {};
+struct Dialogue		: FSM::State {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Idle
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.changeTo<Scan>(42);
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Scan
+	: FSM::State
+{
+	void entryGuard(GuardControl& control) {
+		for (const auto& request : control.pendingTransitions())
+			if (request.stateId == FSM::stateId<Scan>())
+				control._().payload = *control.pendingPayload(request);
+	}
+
+	void update(FullControl& control) {
+		++control._().scans;
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Stand
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.changeTo<Walk>();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Walk
+	: FSM::State
+{
+	void update(FullControl& control) {
+		if (++control._().steps == 100)
+			control.changeTo<Done>();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Silent
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.changeTo<Talk>();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Talk
+	: FSM::State
+{
+	void entryGuard(GuardControl& control) {
+		Context& context = control._();
+
+		context.pendingCount = 0;
+		for (const auto& request : control.pendingTransitions())
+			context.pending[context.pendingCount++] = request.stateId;
+	}
+
+	void update(FullControl& control) {
+		++control._().lines;
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Done
+	: FSM::State
+{};
+
+//------------------------------------------------------------------------------
+
+// runs tasks last to first, to tell merge order from execution order
+struct ReverseExecutor
+	: hfsm2::ExecutorInterface
+{
+	void run(const hfsm2::LongIndex count,
+			 const Task task,
+			 void* const context) override
+	{
+		for (hfsm2::LongIndex i = count; i > 0; --i)
+			task(context, i - 1);
+
+		++runs;
+	}
+
+	int runs = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+namespace test_parallel_plans {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// each prong only writes its own slots
+struct Context {
+	int tasks[4]   = {};
+	int replans[4] = {};
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>>;
+
+//------------------------------------------------------------------------------
+
+template <int N> struct Worker;
+template <int N> struct Fetch;
+template <int N> struct Store;
+
+template <int N>
+using Crew = M::Composite<Worker<N>,
+				Fetch<N>,
+				Store<N>
+			>;
+
+using FSM = M::PeerRoot<
+				M::ParallelOrthogonal<struct Team,
+					Crew<0>,
+					Crew<1>,
+					Crew<2>,
+					Crew<3>
+				>
+			>;
+
+static_assert(FSM::regionId<Team>()		 == 1, "");
+static_assert(FSM::regionId<Worker<0>>() == 2, "");
+static_assert(FSM::regionId<Worker<3>>() == 5, "");
+
+static_assert(FSM::stateId<Team>()		 ==  1, "");
+static_assert(FSM::stateId<Worker<0>>()	 ==  2, "");
+static_assert(FSM::stateId<Fetch<0>>()	 ==  3, "");
+static_assert(FSM::stateId<Store<0>>()	 ==  4, "");
+static_assert(FSM::stateId<Store<3>>()	 == 13, "");
+
+//------------------------------------------------------------------------------
+
+struct Team : FSM::State {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// plans a round trip on entry, and again from its prong once it is done
+template <int N>
+struct Worker
+	: FSM::State
+{
+	void enter(PlanControl& control) {
+		roundTrip(control.plan());
+	}
+
+	void planSucceeded(FullControl& control) {
+		++control._().replans[N];
+
+		roundTrip(control.plan());
+	}
+
+	static void roundTrip(Plan plan) {
+		plan.change<Fetch<N>, Store<N>>();
+		plan.change<Store<N>, Fetch<N>>();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <int N>
+struct Fetch
+	: FSM::State
+{
+	void update(FullControl& control) {
+		++control._().tasks[N];
+		control.succeed();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <int N>
+struct Store
+	: FSM::State
+{
+	void update(FullControl& control) {
+		++control._().tasks[N];
+		control.succeed();
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,93 @@
+#include "test_payload_pool.hpp"
+
+namespace test_payload_pool {
+
+int Block::live = 0;
+int A::sent = 0;
+int B::received = 0;
+
+}
+
+using namespace test_payload_pool;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.PayloadPool", "[machine]") {
+	{
+		FSM::Instance machine;
+		REQUIRE(Block::live == 0);
+
+		// transition payloads live until the transition is processed
+		machine.update();
+		REQUIRE(machine.isActive<B>());
+		REQUIRE(B::received == 7);
+		REQUIRE(Block::live == 0);
+
+		machine.changeTo<C>(Block{3});
+		REQUIRE(Block::live == 1);
+
+		machine.flush();
+		REQUIRE(machine.isActive<C>());
+		REQUIRE(Block::live == 0);
+
+		//----------------------------------------------------------------------
+		// state data takes one slot per state
+
+		machine.setStateData<A>(Block{1});
+		machine.setStateData<B>(Block{2});
+		machine.setStateData<B>(Block{4});
+		REQUIRE(Block::live == 2);
+		REQUIRE(machine.getStateData<B>()->value == 4);
+
+		machine.resetStateData<A>();
+		REQUIRE(Block::live == 1);
+		REQUIRE(!machine.isStateDataSet<A>());
+
+		machine.setStateData<C>(Block{5});
+		REQUIRE(Block::live == 2);
+		REQUIRE(machine.getStateData<C>()->value == 5);
+	}
+
+	REQUIRE(Block::live == 0);
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.PayloadPoolQueued", "[machine]") {
+	{
+		FSM::Instance machine;
+
+		// superseded requests give their payloads back right away
+		for (int i = 0; i < 10; ++i)
+			machine.queue(Go{});
+
+		REQUIRE(A::sent == 10);
+		REQUIRE(Block::live == 1);
+		REQUIRE(machine.payloadPeak() == 2);
+
+		machine.flush();
+		REQUIRE(machine.isActive<B>());
+		REQUIRE(B::received == 10);
+		REQUIRE(machine.payloadOverflows() == 0);
+
+		//----------------------------------------------------------------------
+		// with every slot held by state data, transition payloads are dropped
+
+		machine.changeTo<A>();
+		machine.update();
+		REQUIRE(machine.isActive<A>());
+
+		for (hfsm2::StateID i = 0; i < FSM::Instance::STATE_COUNT; ++i)
+			machine.setStateData(i, Block{(int) i});
+
+		REQUIRE(machine.payloadPeak() == 4);
+
+		machine.queue(Go{});
+		REQUIRE(machine.payloadOverflows() == 1);
+		REQUIRE(Block::live == 4);
+	}
+
+	REQUIRE(Block::live == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,95 @@
+#include "shared.hpp"
+
+namespace test_payload_pool {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Block {
+	Block(const int value_ = 0)
+		: value{value_}
+	{
+		++live;
+	}
+
+	Block(const Block& other)
+		: value{other.value}
+	{
+		++live;
+	}
+
+	Block& operator = (const Block& other) = default;
+
+	~Block() {
+		--live;
+	}
+
+	int value;
+	char parameters[252];
+
+	static int live;
+};
+
+struct Go {};
+
+using M = hfsm2::MachineT<hfsm2::Config::PayloadT<Block>::PayloadCapacityN<4>>;
+
+static_assert(sizeof(hfsm2::detail::RequestT<Block>) == 4, "requests carry payload handles");
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(A),
+				S(B),
+				S(C)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<A>() == 1, "");
+static_assert(FSM::stateId<B>() == 2, "");
+static_assert(FSM::stateId<C>() == 3, "");
+
+//------------------------------------------------------------------------------
+
+struct A
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.changeTo<B>(Block{7});
+	}
+
+	void react(const Go&, FullControl& control) {
+		control.changeTo<B>(Block{++sent});
+	}
+
+	static int sent;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct B
+	: FSM::State
+{
+	void entryGuard(GuardControl& control) {
+		const auto& pending = control.pendingTransitions();
+		REQUIRE(pending.count() == 1);
+
+		const Block* const block = control.pendingPayload(pending[0]);
+		REQUIRE(block);
+		received = block->value;
+	}
+
+	static int received;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct C
+	: FSM::State
+{};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
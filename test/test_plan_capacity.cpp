@@ -0,0 +1,58 @@
+#include "test_plan_capacity.hpp"
+
+using namespace test_plan_capacity;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.PlanCapacity", "[machine]") {
+	FSM::Instance machine;
+	REQUIRE(machine.isActive<Step1>());
+
+	REQUIRE(machine.taskHighWater() == 3);
+	REQUIRE(machine.taskHighWater<Planned>() == 3);
+	REQUIRE(machine.taskHighWater<Apex>() == 0);
+	REQUIRE(machine.taskOverflows() == 1);
+
+	machine.update();
+	REQUIRE(machine.isActive<Step2>());
+
+	machine.update();
+	REQUIRE(machine.isActive<Step3>());
+
+	// high-water marks persist after the tasks complete
+	REQUIRE(machine.taskHighWater() == 3);
+	REQUIRE(machine.taskHighWater<Planned>() == 3);
+
+	machine.changeTo<Idle>();
+	machine.update();
+	REQUIRE(machine.isActive<Idle>());
+
+	// replanned from scratch on re-entry
+	machine.changeTo<Planned>();
+	machine.update();
+	REQUIRE(machine.isActive<Step1>());
+
+	REQUIRE(machine.taskHighWater() == 3);
+	REQUIRE(machine.taskOverflows() == 2);
+
+	// counters belong to the machine, snapshots don't carry them
+	FSM::Instance::Snapshot snapshot;
+	machine.save(snapshot);
+
+	FSM::Instance restored;
+	REQUIRE(restored.taskOverflows() == 1);
+
+	REQUIRE(restored.load(snapshot));
+	REQUIRE(restored.isActive<Step1>());
+	REQUIRE(restored.taskOverflows() == 1);
+
+	// the plan comes along
+	restored.update();
+	REQUIRE(restored.isActive<Step2>());
+
+	REQUIRE(machine.load(snapshot));
+	REQUIRE(machine.taskHighWater() == 3);
+	REQUIRE(machine.taskOverflows() == 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,94 @@
+#include "shared.hpp"
+
+namespace test_plan_capacity {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using Config = hfsm2::Config::TaskCapacityN<3>;
+
+using M = hfsm2::MachineT<Config>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				M::Composite<S(Planned),
+					S(Step1),
+					S(Step2),
+					S(Step3)
+				>,
+				S(Idle)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<Apex>()		== 0, "");
+static_assert(FSM::stateId<Planned>()	== 1, "");
+static_assert(FSM::stateId<Step1>()		== 2, "");
+static_assert(FSM::stateId<Step2>()		== 3, "");
+static_assert(FSM::stateId<Step3>()		== 4, "");
+static_assert(FSM::stateId<Idle>()		== 5, "");
+
+static_assert(FSM::regionId<Apex>()		== 0, "");
+static_assert(FSM::regionId<Planned>()	== 1, "");
+
+static_assert(FSM::TASK_CAPACITY == 3, "");
+
+// options compose in any order
+static_assert(hfsm2::Config::TaskCapacityN<3>::SubstitutionLimitN<7>::TASK_CAPACITY	  == 3, "");
+static_assert(hfsm2::Config::SubstitutionLimitN<7>::TaskCapacityN<3>::SUBSTITUTION_LIMIT == 7, "");
+
+//------------------------------------------------------------------------------
+
+struct Apex	: FSM::State {};
+struct Idle	: FSM::State {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Planned
+	: FSM::State
+{
+	void enter(PlanControl& control) {
+		auto plan = control.plan();
+		REQUIRE(!plan); //-V521
+
+		REQUIRE( plan.change<Step1, Step2>()); //-V521
+		REQUIRE( plan.change<Step2, Step3>()); //-V521
+		REQUIRE( plan.change<Step3, Step1>()); //-V521
+
+		// over 'TaskCapacityN<3>'
+		REQUIRE(!plan.change<Step1, Step3>()); //-V521
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Step1
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.succeed();
+	}
+};
+
+struct Step2
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.succeed();
+	}
+};
+
+struct Step3
+	: FSM::State
+{};
+
+//------------------------------------------------------------------------------
+
+// default is two tasks per composite prong
+static_assert(hfsm2::Machine::Root<Apex, Step1, Step2>::TASK_CAPACITY == 4, "");
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
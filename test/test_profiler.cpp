@@ -0,0 +1,69 @@
+#include "test_profiler.hpp"
+
+namespace test_profiler {
+
+uint64_t Clock::ticks = 0;
+
+}
+
+using namespace test_profiler;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct Report {
+	void operator () (const hfsm2::StateID, const hfsm2::Method, const hfsm2::MethodProfile& profile) {
+		++methods;
+		calls += profile.calls;
+	}
+
+	unsigned methods = 0;
+	uint64_t calls = 0;
+};
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Profiler", "[machine]") {
+	using Method = hfsm2::Method;
+
+	FSM::Instance machine;
+	REQUIRE(machine.profile<A>(Method::ENTER).calls == 1);
+	REQUIRE(machine.profile<B>(Method::ENTER).calls == 0);
+
+	machine.update();
+	REQUIRE(machine.isActive<B>());
+
+	REQUIRE(machine.profile<Apex>(Method::UPDATE).calls == 1);
+	REQUIRE(machine.profile<A>	 (Method::UPDATE).calls == 1);
+	REQUIRE(machine.profile<A>	 (Method::EXIT_GUARD).calls == 1);
+	REQUIRE(machine.profile<A>	 (Method::EXIT).calls == 1);
+	REQUIRE(machine.profile<B>	 (Method::ENTRY_GUARD).calls == 1);
+	REQUIRE(machine.profile<B>	 (Method::ENTER).calls == 1);
+
+	machine.react(Reset{});
+	REQUIRE(machine.isActive<A>());
+
+	REQUIRE(machine.profile<B>(Method::REACT).calls == 1);
+	REQUIRE(machine.profile<B>(Method::EXIT).calls == 1);
+	REQUIRE(machine.profile<A>(Method::ENTER).calls == 2);
+
+	// every sample spans exactly one tick of the test clock
+	REQUIRE(machine.profile<A>(Method::ENTER).ticks == 2);
+
+	Report report;
+	machine.reportProfile(report);
+	REQUIRE(report.methods > 0);
+	REQUIRE(report.calls == Clock::ticks / 2);
+
+	machine.resetProfile();
+	REQUIRE(machine.profile<A>(Method::ENTER).calls == 0);
+
+	Report empty;
+	machine.reportProfile(empty);
+	REQUIRE(empty.methods == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,54 @@
+#include "shared.hpp"
+
+namespace test_profiler {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Clock {
+	static uint64_t now()										{ return ++ticks;	}
+
+	static uint64_t ticks;
+};
+
+struct Reset {};
+
+using M = hfsm2::MachineT<hfsm2::Config::ProfilerT<Clock>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				S(A),
+				S(B)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<Apex>() == 0, "");
+static_assert(FSM::stateId<A>()	   == 1, "");
+static_assert(FSM::stateId<B>()	   == 2, "");
+
+//------------------------------------------------------------------------------
+
+struct Apex : FSM::State {};
+
+struct A
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.changeTo<B>();
+	}
+};
+
+struct B
+	: FSM::State
+{
+	void react(const Reset&, FullControl& control) {
+		control.changeTo<A>();
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,83 @@
+#include "test_published_states.hpp"
+
+using namespace test_published_states;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.PublishedStates", "[machine]") {
+	FSM::Published published;
+	REQUIRE(!published.isActive<Apex>());
+
+	FSM::Instance machine;
+	machine.attachPublished(&published);
+
+	REQUIRE(published.isActive<Apex>());
+	REQUIRE(published.isActive<Traffic>());
+	REQUIRE(published.isActive<Red>());
+	REQUIRE(!published.isActive<Green>());
+
+	machine.update();
+	REQUIRE(published.isActive<Green>());
+	REQUIRE(!published.isActive<Red>());
+	REQUIRE(published.isResumable<Red>());
+
+	machine.changeTo<Off>();
+	machine.update();
+	REQUIRE(published.isActive<Off>());
+	REQUIRE(!published.isActive<Traffic>());
+	REQUIRE(published.isResumable<Green>());
+	REQUIRE(published.isResumable<Traffic>());
+
+	FSM::Published::ActiveStates states;
+	published.copyActiveStates(states);
+	REQUIRE(states.count() == 2);
+	REQUIRE(states.get(FSM::stateId<Apex>()));
+	REQUIRE(states.get(FSM::stateId<Off>()));
+
+	// detached, stays as last published
+	machine.attachPublished(nullptr);
+	machine.changeTo<Red>();
+	machine.update();
+	REQUIRE(machine.isActive<Red>());
+	REQUIRE(published.isActive<Off>());
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.PublishedStatesConcurrent", "[machine]") {
+	FSM::Published published;
+
+	FSM::Instance machine;
+	machine.attachPublished(&published);
+
+	std::atomic<bool> done{false};
+	std::atomic<int> torn{0};
+	std::atomic<int> reads{0};
+
+	std::thread reader{[&] {
+		FSM::Published::ActiveStates states;
+
+		while (!done.load(std::memory_order_acquire)) {
+			published.copyActiveStates(states);
+
+			if (states.count() != 3 ||
+				states.get(FSM::stateId<Red>()) == states.get(FSM::stateId<Green>()))
+			{
+				torn.fetch_add(1);
+			}
+
+			reads.fetch_add(1);
+		}
+	}};
+
+	for (int i = 0; i < 20000 || reads.load() == 0; ++i)
+		machine.update();
+
+	done.store(true, std::memory_order_release);
+	reader.join();
+
+	REQUIRE(torn == 0);
+	REQUIRE(reads > 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
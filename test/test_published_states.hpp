@@ -0,0 +1,64 @@
+#include "shared.hpp"
+
+#include <thread>
+
+namespace test_published_states {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using M = hfsm2::Machine;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				M::Composite<S(Traffic),
+					S(Red),
+					S(Green)
+				>,
+				S(Off)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<Apex>()	  == 0, "");
+static_assert(FSM::stateId<Traffic>() == 1, "");
+static_assert(FSM::stateId<Red>()	  == 2, "");
+static_assert(FSM::stateId<Green>()	  == 3, "");
+static_assert(FSM::stateId<Off>()	  == 4, "");
+
+//------------------------------------------------------------------------------
+
+struct Apex		: FSM::State {};
+struct Traffic	: FSM::State {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Red
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.changeTo<Green>();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Green
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.changeTo<Red>();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Off
+	: FSM::State
+{};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
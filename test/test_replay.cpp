@@ -0,0 +1,142 @@
+#include "test_replay.hpp"
+
+using namespace test_replay;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+void
+record(FSM::Instance& machine) {
+	machine.update();
+	machine.changeTo<R>();
+	machine.update();
+	machine.react(Ping{});
+	machine.react(Go{FSM::stateId<B>()});
+	machine.update();
+	machine.queue(Go{FSM::stateId<A>()});
+	machine.queue(Go{FSM::stateId<R>()});
+	machine.flush();
+	machine.changeTo<R>(42);
+	machine.update();
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Replay", "[machine]") {
+	Log log;
+
+	Context sourceContext;
+	hfsm2::XoShiRo128Plus sourceRandom{1};
+	FSM::Instance source{sourceContext, sourceRandom};
+
+	source.attachRecorder(&log);
+	record(source);
+	source.attachRecorder(nullptr);
+
+	REQUIRE(log.count() > 12);
+	REQUIRE(log.dropped() == 0);
+	REQUIRE(log[0].kind == Log::Kind::UPDATE);
+	REQUIRE(log[1].kind == Log::Kind::TRANSITION);
+	REQUIRE(log[1].stateId == FSM::stateId<R>());
+	REQUIRE(log[3].kind == Log::Kind::RANDOM);
+	REQUIRE(sourceContext.pings == 2);
+
+	//--------------------------------------------------------------------------
+	// a differently seeded machine takes the recorded draws
+
+	Context replicaContext;
+	hfsm2::XoShiRo128Plus replicaRandom{12345};
+	FSM::Instance replica{replicaContext, replicaRandom};
+
+	REQUIRE(log.replay(replica) == log.count());
+	REQUIRE(replicaContext.pings == 2);
+
+	for (hfsm2::StateID stateId = 0; stateId < FSM::Instance::STATE_COUNT; ++stateId)
+		REQUIRE(replica.isActive(stateId) == source.isActive(stateId));
+
+	// replaying doesn't add to the log
+	const hfsm2::LongIndex count = log.count();
+	REQUIRE(log.replay(replica) < count);
+	REQUIRE(log.count() == count);
+
+	//--------------------------------------------------------------------------
+	// a machine out of sync is caught on the first diverging call
+
+	Context divergedContext;
+	hfsm2::XoShiRo128Plus divergedRandom{1};
+	FSM::Instance diverged{divergedContext, divergedRandom};
+
+	diverged.changeTo<B>();
+	diverged.update();
+	REQUIRE(diverged.isActive<B>());
+
+	REQUIRE(log.replay(diverged) == 0);
+
+	//--------------------------------------------------------------------------
+	// a wrapped log can't be replayed from the start
+
+	FSM::Instance::ReplayLog<4> shortLog;
+
+	Context wrappedContext;
+	hfsm2::XoShiRo128Plus wrappedRandom{1};
+	FSM::Instance wrapped{wrappedContext, wrappedRandom};
+
+	wrapped.attachRecorder(&shortLog);
+	record(wrapped);
+	wrapped.attachRecorder(nullptr);
+
+	REQUIRE(shortLog.count() == 4);
+	REQUIRE(shortLog.dropped() == log.count() - 4);
+	REQUIRE(shortLog.replay(replica) == 0);
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.ReplayBatch", "[machine]") {
+	Log log;
+
+	Context sourceContexts[2];
+	hfsm2::XoShiRo128Plus sourceRandom{1};
+
+	FSM::Batch<2> batch;
+	batch.emplace(sourceContexts[0], sourceRandom);
+	batch.emplace(sourceContexts[1], sourceRandom);
+
+	FSM::Instance& source = batch[1];
+	source.attachRecorder(&log);
+
+	// calls made through a batch are recorded like direct ones
+	batch.updateAll();
+	source.changeTo<R>();
+	batch.updateAll();
+	batch.reactAll(Ping{});
+	batch.reactAll(Go{FSM::stateId<B>()});
+	batch.updateAll();
+
+	source.attachRecorder(nullptr);
+
+	REQUIRE(log[0].kind == Log::Kind::UPDATE);
+	REQUIRE(log[1].kind == Log::Kind::TRANSITION);
+	REQUIRE(log[2].kind == Log::Kind::UPDATE);
+	REQUIRE(log[3].kind == Log::Kind::RANDOM);
+	REQUIRE(log[4].kind == Log::Kind::REACT);
+	REQUIRE(log[5].kind == Log::Kind::REACT);
+	REQUIRE(log[6].kind == Log::Kind::UPDATE);
+	REQUIRE(log[7].kind == Log::Kind::RANDOM);
+	REQUIRE(log.count() == 8);
+
+	Context replicaContext;
+	hfsm2::XoShiRo128Plus replicaRandom{12345};
+	FSM::Instance replica{replicaContext, replicaRandom};
+
+	REQUIRE(log.replay(replica) == log.count());
+	REQUIRE(replicaContext.pings == sourceContexts[1].pings);
+
+	for (hfsm2::StateID stateId = 0; stateId < FSM::Instance::STATE_COUNT; ++stateId)
+		REQUIRE(replica.isActive(stateId) == source.isActive(stateId));
+}
+
+////////////////////////////////////////////////////////////////////////////////
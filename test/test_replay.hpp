@@ -0,0 +1,82 @@
+#include "shared.hpp"
+
+namespace test_replay {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	unsigned pings = 0;
+};
+
+struct Go {
+	hfsm2::StateID target;
+};
+
+struct Ping {};
+
+using Config = hfsm2::Config::ContextT<Context>
+							::RandomT<hfsm2::XoShiRo128Plus>
+							::PayloadT<int>
+							::EventsT<Go, Ping>;
+
+using M = hfsm2::MachineT<Config>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(A),
+				M::Random<S(R),
+					S(R1),
+					S(R2),
+					S(R3),
+					S(R4)
+				>,
+				S(B)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<A>()  == 1, "");
+static_assert(FSM::stateId<R>()  == 2, "");
+static_assert(FSM::stateId<R1>() == 3, "");
+static_assert(FSM::stateId<B>()  == 7, "");
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+struct Reacting
+	: FSM::State
+{
+	void react(const Go& event, FullControl& control) {
+		control.changeTo(event.target);
+	}
+
+	void react(const Ping&, FullControl& control) {
+		++control.context().pings;
+	}
+};
+
+struct A  : Reacting<A>  {};
+struct R  : Reacting<R>  {};
+struct R1 : Reacting<R1> {};
+struct R2 : Reacting<R2> {};
+struct R3 : Reacting<R3> {};
+struct R4 : Reacting<R4> {};
+
+struct B
+	: Reacting<B>
+{
+	void update(FullControl& control) {
+		control.changeTo<R>();
+	}
+};
+
+//------------------------------------------------------------------------------
+
+using Log = FSM::Instance::ReplayLog<64>;
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,187 @@
+#include "test_replication.hpp"
+
+using namespace test_replication;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+void
+assertSameState(const FSM::Instance& expected,
+				const FSM::Instance& actual)
+{
+	for (hfsm2::StateID stateId = 0; stateId < FSM::Instance::STATE_COUNT; ++stateId) {
+		REQUIRE(actual.isActive   (stateId) == expected.isActive   (stateId));
+		REQUIRE(actual.isResumable(stateId) == expected.isResumable(stateId));
+
+		const int* const expectedData = expected.getStateData(stateId);
+		const int* const actualData	  = actual	.getStateData(stateId);
+
+		REQUIRE((actualData != nullptr) == (expectedData != nullptr));
+		if (expectedData)
+			REQUIRE(*actualData == *expectedData);
+	}
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Replication", "[machine]") {
+	Context sourceContext;
+	Context replicaContext;
+
+	FSM::Instance source {sourceContext};
+	FSM::Instance replica{replicaContext};
+
+	replicaContext = Context{};
+
+	FSM::Instance::Delta delta;
+
+	//--------------------------------------------------------------------------
+	// nothing changed yet
+
+	source.takeDelta(delta);
+	REQUIRE(delta.toggled.count() == 0);
+	REQUIRE(delta.compos .count() == 0);
+
+	REQUIRE(replica.applyDelta(delta));
+	assertSameState(source, replica);
+
+	//--------------------------------------------------------------------------
+	// leaving A and entering B, C and D touches every region
+
+	source.changeTo<B2>();
+	source.update();
+	source.changeTo<D2>();
+	source.update();
+
+	source.takeDelta(delta);
+	const auto compos = delta.compos.count();
+	REQUIRE(compos == 5);
+
+	REQUIRE(replica.applyDelta(delta));
+	REQUIRE(replica.isActive<D2>());
+	REQUIRE(replica.isResumable<B2>());
+	assertSameState(source, replica);
+
+	//--------------------------------------------------------------------------
+	// only C changed its prong, state data travels with the delta
+
+	source.setStateData<A1>(7);
+	source.setStateData<C2>(9);
+	source.changeTo<C2>();
+	source.update();
+
+	source.takeDelta(delta);
+	const auto changed = delta.compos.count();
+	REQUIRE(changed == 1);
+
+	const auto slots = delta.payloadSlots.count();
+	REQUIRE(slots == 2);
+
+	REQUIRE(replica.applyDelta(delta));
+	assertSameState(source, replica);
+
+	source.resetStateData<A1>();
+	source.changeTo<A>();
+	source.update();
+
+	source.takeDelta(delta);
+	REQUIRE(replica.applyDelta(delta));
+	REQUIRE(replica.isActive<A1>());
+	REQUIRE(!replica.isStateDataSet<A1>());
+	assertSameState(source, replica);
+
+	// replicas never run state methods
+	REQUIRE(replicaContext.enters == 0);
+	REQUIRE(replicaContext.exits  == 0);
+
+	//--------------------------------------------------------------------------
+	// deltas out of sequence are rejected
+
+	source.changeTo<O>();
+	source.update();
+
+	FSM::Instance::Delta skipped;
+	source.takeDelta(skipped);
+
+	source.changeTo<B>();
+	source.update();
+
+	source.takeDelta(delta);
+	REQUIRE(!replica.applyDelta(delta));
+	REQUIRE(replica.isActive<A1>());
+
+	REQUIRE(replica.applyDelta(skipped));
+	REQUIRE(replica.applyDelta(delta));
+	assertSameState(source, replica);
+
+	//--------------------------------------------------------------------------
+	// replicas continue from a snapshot taken at the current epoch
+
+	Context lateContext;
+	FSM::Instance late{lateContext};
+
+	FSM::Instance::Snapshot snapshot;
+	source.save(snapshot);
+	REQUIRE(late.load(snapshot));
+
+	source.changeTo<D1>();
+	source.update();
+
+	source.takeDelta(delta);
+	REQUIRE(late   .applyDelta(delta));
+	REQUIRE(replica.applyDelta(delta));
+	assertSameState(source, late);
+	assertSameState(source, replica);
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.ReplicationWire", "[machine]") {
+	Context sourceContext;
+	Context replicaContext;
+
+	FSM::Instance source {sourceContext};
+	FSM::Instance replica{replicaContext};
+
+	FSM::Instance::Delta delta;
+	unsigned char buffer[sizeof(FSM::Instance::Delta)];
+
+	//--------------------------------------------------------------------------
+	// an empty delta is only the header and the bit sets
+
+	source.takeDelta(delta);
+	const std::size_t empty = delta.write(buffer, sizeof(buffer));
+	REQUIRE(empty == delta.size());
+	REQUIRE(empty < sizeof(FSM::Instance::Delta));
+
+	FSM::Instance::Delta received;
+	REQUIRE(received.read(buffer, empty));
+	REQUIRE(replica.applyDelta(received));
+
+	//--------------------------------------------------------------------------
+	// entries only for the regions and payloads that changed
+
+	source.setStateData<C2>(9);
+	source.changeTo<C2>();
+	source.update();
+
+	source.takeDelta(delta);
+	const std::size_t used = delta.write(buffer, sizeof(buffer));
+	const auto payloads = delta.payloadsSet.count();
+	REQUIRE(payloads == 1);
+	REQUIRE(used == empty + delta.compos.count() * 2 + sizeof(int));
+
+	REQUIRE(delta.write(buffer, used - 1) == 0);
+	REQUIRE(!received.read(buffer, used - 1));
+	REQUIRE(!received.read(buffer, used + 1));
+
+	REQUIRE(received.read(buffer, used));
+	REQUIRE(replica.applyDelta(received));
+	assertSameState(source, replica);
+	REQUIRE(*replica.getStateData<C2>() == 9);
+}
+
+////////////////////////////////////////////////////////////////////////////////
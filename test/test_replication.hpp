@@ -0,0 +1,75 @@
+#include "shared.hpp"
+
+namespace test_replication {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	unsigned enters = 0;
+	unsigned exits	= 0;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>::PayloadT<int>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				M::Composite<S(A),
+					S(A1),
+					S(A2)
+				>,
+				M::Resumable<S(B),
+					S(B1),
+					S(B2)
+				>,
+				M::Orthogonal<S(O),
+					M::Composite<S(C),
+						S(C1),
+						S(C2)
+					>,
+					M::Resumable<S(D),
+						S(D1),
+						S(D2)
+					>
+				>
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+struct Counted
+	: FSM::State
+{
+	void enter(Control& control)	{ ++control.context().enters;	}
+	void exit (Control& control)	{ ++control.context().exits;	}
+};
+
+struct Apex	: Counted<Apex> {};
+
+struct A	: Counted<A > {};
+struct A1	: Counted<A1> {};
+struct A2	: Counted<A2> {};
+
+struct B	: Counted<B > {};
+struct B1	: Counted<B1> {};
+struct B2	: Counted<B2> {};
+
+struct O	: Counted<O > {};
+
+struct C	: Counted<C > {};
+struct C1	: Counted<C1> {};
+struct C2	: Counted<C2> {};
+
+struct D	: Counted<D > {};
+struct D1	: Counted<D1> {};
+struct D2	: Counted<D2> {};
+
+static_assert(FSM::Instance::STATE_COUNT == 14, "");
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
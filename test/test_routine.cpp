@@ -0,0 +1,113 @@
+#include "test_routine.hpp"
+
+#ifdef HFSM_ENABLE_COROUTINES
+
+using namespace test_routine;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Routine", "[machine]") {
+	Context context;
+
+	FSM::Instance machine{context};
+	REQUIRE(machine.isActive<Walk>());
+	REQUIRE(context.steps == 0);
+
+	// routines first run on the update() after their state's enter()
+	for (int i = 1; i <= 3; ++i) {
+		machine.update();
+		REQUIRE(context.steps == i);
+	}
+	REQUIRE(!context.planned);
+
+	// 'Walk' succeeded, plan task 'Walk -> Look' ran
+	machine.update();
+	REQUIRE(machine.isActive<Look>());
+	REQUIRE(!context.planned);
+
+	machine.update();
+	REQUIRE(context.planned);
+
+	machine.react(Reset{});
+	REQUIRE(machine.isActive<Look>());
+
+	machine.react(Alarm{7});
+	REQUIRE(context.level == 7);
+	REQUIRE(context.exits == 1);
+	REQUIRE(machine.isActive<Alert>());
+
+	// suspended routines are destroyed with their state,
+	// their frames go back to the arena
+	for (int i = 0; i < 10; ++i) {
+		machine.react(Reset{});
+		REQUIRE(machine.isActive<Walk>());
+
+		machine.changeTo<Alert>();
+		machine.update();
+		REQUIRE(machine.isActive<Alert>());
+	}
+	REQUIRE(context.steps == 13);
+}
+
+//------------------------------------------------------------------------------
+
+// the arena has a frame per routine, a routine left running
+// by a restore would starve its state's next one
+
+TEST_CASE("FSM.RoutineRestore", "[machine]") {
+	Context sourceContext;
+	FSM::Instance source{sourceContext};
+
+	Context context;
+	FSM::Instance machine{context};
+
+	SECTION("snapshot") {
+		source.changeTo<Alert>();
+		source.update();
+
+		FSM::Instance::Snapshot snapshot;
+		source.save(snapshot);
+
+		machine.changeTo<Look>();
+		machine.update();
+		REQUIRE(machine.isActive<Look>());
+
+		// first run, now waiting for 'Alarm'
+		machine.update();
+		REQUIRE(context.exits == 0);
+
+		// suspended in 'Look', torn down by the restore
+		REQUIRE(machine.load(snapshot));
+		REQUIRE(machine.isActive<Alert>());
+		REQUIRE(context.exits == 1);
+	}
+
+	SECTION("delta") {
+		FSM::Instance::Delta delta;
+
+		source.changeTo<Alert>();
+		source.update();
+		source.takeDelta(delta);
+
+		// routines of 'Patrol' and 'Walk', started on construction
+		REQUIRE(machine.applyDelta(delta));
+		REQUIRE(machine.isActive<Alert>());
+	}
+
+	// re-entered states start their routines afresh
+	machine.react(Reset{});
+	REQUIRE(machine.isActive<Walk>());
+
+	machine.changeTo<Look>();
+	machine.update();
+	REQUIRE(machine.isActive<Look>());
+
+	machine.update();
+	machine.react(Alarm{3});
+	REQUIRE(context.level == 3);
+	REQUIRE(machine.isActive<Alert>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,121 @@
+#include "shared.hpp"
+
+#ifdef HFSM_ENABLE_COROUTINES
+
+namespace test_routine {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	int steps	= 0;
+	int level	= 0;
+	int exits	= 0;
+
+	bool planned = false;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>>;
+
+//------------------------------------------------------------------------------
+
+struct Alarm {
+	int level;
+};
+
+struct Reset {};
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				M::Composite<S(Patrol),
+					S(Walk),
+					S(Look)
+				>,
+				S(Alert)
+			>;
+
+#undef S
+
+static_assert(FSM::regionId<Apex>()	  == 0, "");
+static_assert(FSM::regionId<Patrol>() == 1, "");
+
+static_assert(FSM::stateId<Apex>()	  == 0, "");
+static_assert(FSM::stateId<Patrol>()  == 1, "");
+static_assert(FSM::stateId<Walk>()	  == 2, "");
+static_assert(FSM::stateId<Look>()	  == 3, "");
+static_assert(FSM::stateId<Alert>()	  == 4, "");
+
+//------------------------------------------------------------------------------
+
+struct Apex : FSM::State {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Patrol
+	: FSM::State
+{
+	Routine routine(RoutineControl& routine) {
+		routine.plan().change<Walk, Look>();
+
+		co_await routine.planCompletion();
+		routine._().planned = true;
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Walk
+	: FSM::State
+{
+	Routine routine(RoutineControl& routine) {
+		for (int i = 0; i < 3; ++i) {
+			++routine._().steps;
+			co_await routine.nextFrame();
+		}
+
+		routine.control().succeed();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// counts exits of a suspended routine's scope
+struct Sentry {
+	~Sentry() { ++exits; }
+
+	int& exits;
+};
+
+struct Look
+	: FSM::State
+{
+	Routine routine(RoutineControl& routine) {
+		Sentry sentry{routine._().exits};
+
+		const Alarm& alarm = co_await routine.event<Alarm>();
+		routine._().level = alarm.level;
+
+		co_await routine.frames(0);
+		routine.control().changeTo<Alert>();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Alert
+	: FSM::State
+{
+	void react(const Reset&, FullControl& control) {
+		control.changeTo<Patrol>();
+	}
+
+	using FSM::State::react;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include "test_scheduler.hpp"
+
+#include <memory>
+
+using namespace test_scheduler;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using Scheduler = hfsm2::MachineScheduler<Context, 4, 64>;
+
+static constexpr hfsm2::LongIndex PER_SHARD = 48;
+
+//------------------------------------------------------------------------------
+
+void
+checkScheduler(Scheduler& scheduler) {
+	std::vector<std::unique_ptr<Walker ::Instance>> walkers;
+	std::vector<std::unique_ptr<Sleeper::Instance>> sleepers;
+
+	for (hfsm2::LongIndex shard = 0; shard < Scheduler::SHARD_COUNT; ++shard)
+		for (hfsm2::LongIndex i = 0; i < PER_SHARD; ++i)
+			if (i % 2) {
+				walkers.emplace_back(new Walker::Instance{scheduler.context(shard)});
+				REQUIRE(scheduler.add(shard, *walkers.back()) == i);
+			} else {
+				sleepers.emplace_back(new Sleeper::Instance{scheduler.context(shard)});
+				REQUIRE(scheduler.add(shard, *sleepers.back()) == i);
+			}
+
+	scheduler.updateAll();
+
+	for (hfsm2::LongIndex shard = 0; shard < Scheduler::SHARD_COUNT; ++shard) {
+		REQUIRE(scheduler.count(shard) == PER_SHARD);
+		REQUIRE(scheduler.pendingCount(shard) == PER_SHARD / 2);
+
+		REQUIRE(scheduler.context(shard).updates  == PER_SHARD);
+		REQUIRE(scheduler.context(shard).arrivals == PER_SHARD / 2);
+	}
+
+	for (const auto& walker : walkers)
+		REQUIRE(walker->isActive<Arrive>());
+
+	scheduler.updateAll();
+
+	for (hfsm2::LongIndex shard = 0; shard < Scheduler::SHARD_COUNT; ++shard) {
+		REQUIRE(scheduler.pendingCount(shard) == 0);
+		REQUIRE(scheduler.context(shard).updates == 2 * PER_SHARD);
+	}
+
+	scheduler.clear();
+	REQUIRE(scheduler.count(0) == 0);
+}
+
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Scheduler", "[machine]") {
+	std::unique_ptr<Scheduler> scheduler{new Scheduler};
+
+	SECTION("sequential") {
+		checkScheduler(*scheduler);
+	}
+
+	SECTION("work stealing") {
+		hfsm2::WorkStealingExecutorT<3> executor;
+		scheduler->attachExecutor(&executor);
+
+		checkScheduler(*scheduler);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
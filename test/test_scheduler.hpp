@@ -0,0 +1,71 @@
+#include "shared.hpp"
+
+namespace test_scheduler {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	unsigned updates = 0;
+	unsigned arrivals = 0;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using Walker = M::PeerRoot<
+				S(Walk),
+				S(Arrive)
+			>;
+
+using Sleeper = M::PeerRoot<
+				S(Sleep)
+			>;
+
+#undef S
+
+static_assert(Walker ::stateId<Walk>()	 == 1, "");
+static_assert(Walker ::stateId<Arrive>() == 2, "");
+static_assert(Sleeper::stateId<Sleep>()	 == 1, "");
+
+//------------------------------------------------------------------------------
+
+struct Walk
+	: Walker::State
+{
+	void update(FullControl& control) {
+		++control.context().updates;
+
+		control.changeTo<Arrive>();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Arrive
+	: Walker::State
+{
+	void enter(PlanControl& control) {
+		++control.context().arrivals;
+	}
+
+	void update(FullControl& control) {
+		++control.context().updates;
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Sleep
+	: Sleeper::State
+{
+	void update(FullControl& control) {
+		++control.context().updates;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,109 @@
+#include "test_snapshot.hpp"
+
+using namespace test_snapshot;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+void
+assertSameState(const FSM::Instance& expected,
+				const FSM::Instance& actual)
+{
+	for (hfsm2::StateID stateId = 0; stateId < FSM::Instance::STATE_COUNT; ++stateId) {
+		REQUIRE(actual.isActive   (stateId) == expected.isActive   (stateId));
+		REQUIRE(actual.isResumable(stateId) == expected.isResumable(stateId));
+	}
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Snapshot", "[machine]") {
+	Context sourceContext;
+	Context targetContext;
+
+	FSM::Instance source{sourceContext};
+	FSM::Instance target{targetContext};
+
+	source.changeTo<B2>();
+	source.update();
+	source.changeTo<D2>();
+	source.update();
+	source.changeTo<C2>();
+	source.update();
+
+	REQUIRE(source.isActive<C2>());
+	REQUIRE(source.isActive<D2>());
+	REQUIRE(source.isResumable<B2>());
+	REQUIRE(source.isResumable<B>());
+
+	source.setStateData<B2>(42);
+	target.setStateData<A1>(7);
+
+	//--------------------------------------------------------------------------
+	// restoring copies state without entering or exiting anything
+
+	FSM::Instance::Snapshot snapshot;
+	source.save(snapshot);
+
+	REQUIRE(snapshot.size == source.snapshotSize());
+	REQUIRE(snapshot.size <  FSM::Instance::SNAPSHOT_CAPACITY);
+
+	unsigned char small[FSM::Instance::SNAPSHOT_CAPACITY];
+	REQUIRE(source.save(small, snapshot.size - 1) == 0);
+
+	targetContext = Context{};
+
+	REQUIRE(target.load(snapshot));
+	REQUIRE(targetContext.enters == 0);
+	REQUIRE(targetContext.exits  == 0);
+
+	assertSameState(source, target);
+
+	REQUIRE(*target.getStateData<B2>() == 42);
+	REQUIRE(!target.isStateDataSet<A1>());
+
+	//--------------------------------------------------------------------------
+	// both machines carry on identically
+
+	source.changeTo<B>();
+	source.update();
+	target.changeTo<B>();
+	target.update();
+
+	REQUIRE(target.isActive<B2>());
+	assertSameState(source, target);
+
+	source.changeTo<D>();
+	source.update();
+	target.changeTo<D>();
+	target.update();
+
+	REQUIRE(target.isActive<D2>());
+	REQUIRE(target.isActive<C1>());
+	assertSameState(source, target);
+
+	//--------------------------------------------------------------------------
+	// truncated or damaged images are rejected
+
+	REQUIRE(!target.load(snapshot.bytes, snapshot.size - 1));
+	REQUIRE(target.isActive<D2>());
+
+	snapshot.bytes[0] ^= 1;
+	REQUIRE(!target.load(snapshot));
+	REQUIRE(target.isActive<D2>());
+	snapshot.bytes[0] ^= 1;
+
+	//--------------------------------------------------------------------------
+	// so are images of machines of a different shape
+
+	Context otherContext;
+	test_snapshot_shuffled::FSM::Instance other{otherContext};
+
+	REQUIRE(!other.load(snapshot.bytes, snapshot.size));
+	REQUIRE(other.isActive<test_snapshot_shuffled::A1>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
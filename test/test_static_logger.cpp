@@ -0,0 +1,60 @@
+#include "test_static_logger.hpp"
+
+using namespace test_static_logger;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.StaticLogger", "[machine]") {
+	using Kind		  = SelectiveLogger::Kind;
+	using Transition  = hfsm2::Transition;
+	using StatusEvent = hfsm2::StatusEvent;
+
+	SelectiveLogger logger;
+
+	// entry methods are not selected
+	FSM::Instance machine{&logger};
+	REQUIRE(machine.isActive<A>());
+	REQUIRE(logger.history.empty());
+
+	// update methods and task statuses are not selected
+	machine.update();
+	REQUIRE(machine.isActive<B>());
+
+	REQUIRE(logger.history.size() == 1);
+	REQUIRE(logger.history[0].kind		 == Kind::TRANSITION);
+	REQUIRE(logger.history[0].origin	 == FSM::stateId<Apex>());
+	REQUIRE(logger.history[0].transition == Transition::CHANGE);
+	REQUIRE(logger.history[0].target	 == FSM::stateId<B>());
+
+	machine.update();
+	REQUIRE(logger.history.size() == 2);
+	REQUIRE(logger.history[1].kind		 == Kind::PLAN_STATUS);
+	REQUIRE(logger.history[1].region	 == FSM::regionId<Apex>());
+	REQUIRE(logger.history[1].event		 == StatusEvent::SUCCEEDED);
+
+	// react and exit methods are not selected
+	machine.react(Reset{});
+	REQUIRE(machine.isActive<A>());
+
+	REQUIRE(logger.history.size() == 3);
+	REQUIRE(logger.history[2].kind		 == Kind::TRANSITION);
+	REQUIRE(logger.history[2].origin	 == FSM::stateId<B>());
+	REQUIRE(logger.history[2].transition == Transition::CHANGE);
+	REQUIRE(logger.history[2].target	 == FSM::stateId<A>());
+
+	machine.changeTo<B>();
+	REQUIRE(logger.history.size() == 4);
+	REQUIRE(logger.history[3].kind		 == Kind::TRANSITION);
+	REQUIRE(logger.history[3].origin	 == hfsm2::INVALID_STATE_ID);
+	REQUIRE(logger.history[3].target	 == FSM::stateId<B>());
+
+	machine.attachLogger(nullptr);
+	machine.react(Reset{});
+	REQUIRE(machine.isActive<B>());
+
+	machine.react(Reset{});
+	REQUIRE(machine.isActive<A>());
+	REQUIRE(logger.history.size() == 4);
+}
+
+////////////////////////////////////////////////////////////////////////////////
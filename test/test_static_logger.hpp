@@ -0,0 +1,119 @@
+#include "shared.hpp"
+
+namespace test_static_logger {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// hides transitions and plan statuses only,
+// methods, task statuses and resolutions go to the empty base
+struct SelectiveLogger
+	: hfsm2::StaticLogger
+{
+	enum class Kind {
+		TRANSITION,
+		PLAN_STATUS,
+	};
+
+	void recordTransition(const StateID origin,
+						  const Transition transition,
+						  const StateID target)
+	{
+		history.emplace_back(Kind::TRANSITION, origin, transition, target);
+	}
+
+	void recordPlanStatus(const RegionID region,
+						  const StatusEvent event)
+	{
+		history.emplace_back(Kind::PLAN_STATUS, region, event);
+	}
+
+	struct Entry {
+		Entry(const Kind kind_,
+			  const StateID origin_,
+			  const Transition transition_,
+			  const StateID target_)
+			: kind{kind_}
+			, origin{origin_}
+			, transition{transition_}
+			, target{target_}
+		{}
+
+		Entry(const Kind kind_,
+			  const RegionID region_,
+			  const StatusEvent event_)
+			: kind{kind_}
+			, region{region_}
+			, event{event_}
+		{}
+
+		Kind kind;
+		StateID origin = hfsm2::INVALID_STATE_ID;
+		Transition transition = Transition::COUNT;
+		StateID target = hfsm2::INVALID_STATE_ID;
+		RegionID region = hfsm2::INVALID_REGION_ID;
+		StatusEvent event = StatusEvent::COUNT;
+	};
+
+	std::vector<Entry> history;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::LoggerT<SelectiveLogger>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				S(A),
+				S(B)
+			>;
+
+#undef S
+
+static_assert(FSM::regionId<Apex>() == 0, "");
+
+static_assert(FSM::stateId<Apex>()  == 0, "");
+static_assert(FSM::stateId<A>()		== 1, "");
+static_assert(FSM::stateId<B>()		== 2, "");
+
+//------------------------------------------------------------------------------
+
+struct Reset {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Apex
+	: FSM::State
+{
+	void enter(PlanControl& control) {
+		control.plan().change<A, B>();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct A
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.succeed();
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct B
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.succeed();
+	}
+
+	void react(const Reset&, FullControl& control) {
+		control.changeTo<A>();
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,39 @@
+#include "test_topology.hpp"
+
+using namespace test_topology;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Topology", "[machine]") {
+	FSM::Instance machine;
+	REQUIRE(machine.isActive<A>());
+	REQUIRE(!machine.isActive<O>());
+
+	machine.changeTo<C2>();
+	machine.update();
+
+	REQUIRE(machine.isActive<O>());
+	REQUIRE(machine.isActive<C>());
+	REQUIRE(!machine.isActive<C1>());
+	REQUIRE(machine.isActive<C2>());
+	REQUIRE(machine.isActive<D>());
+	REQUIRE(!machine.isActive<E>());
+
+	machine.changeTo<E2>();
+	machine.update();
+
+	REQUIRE(!machine.isActive<O>());
+	REQUIRE(!machine.isActive<C2>());
+	REQUIRE(machine.isActive<E>());
+	REQUIRE(machine.isActive<E2>());
+	REQUIRE(machine.isResumable<O>());
+	REQUIRE(machine.isResumable<C2>());
+
+	FSM::Instance::ActiveStates activeStates;
+	machine.copyActiveStates(activeStates);
+
+	for (hfsm2::StateID i = 0; i < FSM::Instance::STATE_COUNT; ++i)
+		REQUIRE(activeStates.get(i) == machine.isActive(i));
+}
+
+////////////////////////////////////////////////////////////////////////////////
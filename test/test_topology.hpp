@@ -0,0 +1,87 @@
+#include "shared.hpp"
+
+namespace test_topology {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using M = hfsm2::Machine;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				S(A),
+				M::Orthogonal<S(O),
+					M::Composite<S(C),
+						S(C1),
+						S(C2)
+					>,
+					S(D)
+				>,
+				M::Composite<S(E),
+					S(E1),
+					S(E2)
+				>
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<Apex>()	==  0, "");
+static_assert(FSM::stateId<A>()		==  1, "");
+static_assert(FSM::stateId<O>()		==  2, "");
+static_assert(FSM::stateId<C>()		==  3, "");
+static_assert(FSM::stateId<C1>()	==  4, "");
+static_assert(FSM::stateId<C2>()	==  5, "");
+static_assert(FSM::stateId<D>()		==  6, "");
+static_assert(FSM::stateId<E>()		==  7, "");
+static_assert(FSM::stateId<E1>()	==  8, "");
+static_assert(FSM::stateId<E2>()	==  9, "");
+
+//------------------------------------------------------------------------------
+
+using Topology = hfsm2::detail::StateRegistryT<FSM::Args>::Topology;
+
+constexpr bool
+matches(const hfsm2::detail::Parent parent,
+		const hfsm2::ForkID forkId,
+		const hfsm2::ShortIndex prong)
+{
+	return parent.forkId == forkId && parent.prong == prong;
+}
+
+static_assert(!Topology::STATE_PARENTS[0], "");
+static_assert(matches(Topology::STATE_PARENTS[1],  1, 0), "");
+static_assert(matches(Topology::STATE_PARENTS[2],  1, 1), "");
+static_assert(matches(Topology::STATE_PARENTS[3], -1, 0), "");
+static_assert(matches(Topology::STATE_PARENTS[4],  2, 0), "");
+static_assert(matches(Topology::STATE_PARENTS[5],  2, 1), "");
+static_assert(matches(Topology::STATE_PARENTS[6], -1, 1), "");
+static_assert(matches(Topology::STATE_PARENTS[7],  1, 2), "");
+static_assert(matches(Topology::STATE_PARENTS[8],  3, 0), "");
+static_assert(matches(Topology::STATE_PARENTS[9],  3, 1), "");
+
+static_assert(!Topology::COMPO_PARENTS[0], "");
+static_assert(matches(Topology::COMPO_PARENTS[1], -1, 0), "");
+static_assert(matches(Topology::COMPO_PARENTS[2],  1, 2), "");
+
+static_assert(matches(Topology::ORTHO_PARENTS[0],  1, 1), "");
+static_assert(Topology::ORTHO_UNITS[0].unit  == 0, "");
+static_assert(Topology::ORTHO_UNITS[0].width == 2, "");
+
+//------------------------------------------------------------------------------
+
+struct Apex	: FSM::State {};
+struct A	: FSM::State {};
+struct O	: FSM::State {};
+struct C	: FSM::State {};
+struct C1	: FSM::State {};
+struct C2	: FSM::State {};
+struct D	: FSM::State {};
+struct E	: FSM::State {};
+struct E1	: FSM::State {};
+struct E2	: FSM::State {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,112 @@
+#include "test_trace_logger.hpp"
+
+namespace test_trace_logger {
+
+uint64_t Clock::ticks = 0;
+
+}
+
+using namespace test_trace_logger;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct Collector {
+	void operator () (const hfsm2::TraceRecord& record) {
+		records.push_back(record);
+	}
+
+	std::vector<hfsm2::TraceRecord> records;
+};
+
+struct Sequence {
+	void operator () (const hfsm2::TraceRecord& record) {
+		ordered &= record.timestamp == ++count;
+	}
+
+	uint64_t count = 0;
+	bool ordered = true;
+};
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.TraceLogger", "[machine]") {
+	using Kind = hfsm2::TraceRecord::Kind;
+
+	Trace trace;
+	trace.select(7);
+
+	FSM::Instance machine{&trace};
+
+	machine.update();
+	REQUIRE(machine.isActive<B>());
+
+	Collector collector;
+	trace.drain(collector);
+
+	bool method = false;
+	bool transition = false;
+
+	for (const auto& record : collector.records) {
+		REQUIRE(record.machineId == 7);
+
+		if (record.kind == Kind::METHOD) {
+			REQUIRE(record.stateId == FSM::stateId<A>());
+			REQUIRE(record.code	   == (uint8_t) hfsm2::Method::UPDATE);
+			method = true;
+		}
+		else if (record.kind == Kind::TRANSITION) {
+			REQUIRE(record.stateId == FSM::stateId<A>());
+			REQUIRE(record.target  == FSM::stateId<B>());
+			REQUIRE(record.code	   == (uint8_t) hfsm2::Transition::CHANGE);
+			transition = true;
+		}
+	}
+	REQUIRE(method);
+	REQUIRE(transition);
+
+	hfsm2::TraceRecord record;
+	REQUIRE(!trace.pop(record));
+
+	//--------------------------------------------------------------------------
+	// a full ring drops records instead of blocking
+
+	for (unsigned i = 0; i < 64; ++i)
+		machine.update();
+
+	REQUIRE(trace.dropped() > 0);
+
+	Collector full;
+	REQUIRE(trace.drain(full) == (hfsm2::LongIndex) Trace::CAPACITY);
+
+	//--------------------------------------------------------------------------
+	// records drained on another thread arrive complete and in order
+
+	Clock::ticks = 0;
+	const uint32_t dropped = trace.dropped();
+
+	Sequence sequence;
+	std::atomic<bool> done{false};
+
+	std::thread producer([&] {
+		for (unsigned i = 0; i < 2000; ++i)
+			machine.update();
+
+		done.store(true, std::memory_order_release);
+	});
+
+	while (!done.load(std::memory_order_acquire))
+		trace.drain(sequence);
+
+	producer.join();
+	trace.drain(sequence);
+
+	REQUIRE(sequence.ordered);
+	REQUIRE(sequence.count == Clock::ticks);
+	REQUIRE(sequence.count + trace.dropped() - dropped > 2000);
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,53 @@
+#include "shared.hpp"
+
+#include <thread>
+
+namespace test_trace_logger {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Clock {
+	static uint64_t now()										{ return ++ticks;	}
+
+	static uint64_t ticks;
+};
+
+using Trace = hfsm2::TraceLoggerT<64, Clock>;
+
+using M = hfsm2::MachineT<hfsm2::Config::LoggerT<Trace>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(A),
+				S(B)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<A>() == 1, "");
+static_assert(FSM::stateId<B>() == 2, "");
+
+//------------------------------------------------------------------------------
+
+struct A
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.changeTo<B>();
+	}
+};
+
+struct B
+	: FSM::State
+{
+	void update(FullControl& control) {
+		control.changeTo<A>();
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
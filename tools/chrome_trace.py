@@ -0,0 +1,167 @@
+# converts binary dumps of hfsm2::TraceLoggerT<> records into Chrome Trace Event
+# JSON, for chrome://tracing or ui.perfetto.dev
+#
+# usage: chrome_trace.py <records.bin> <trace.json> [options]
+#
+# -n, --names [MACHINE=]names.txt	- state names, one per line in StateID order,
+#									  for one machine id or for all of them
+# -t, --ticks-per-us N				- 'TraceLoggerT<>' clock ticks per microsecond
+# -m, --merge other.json			- append events from another trace,
+#									  e.g. engine spans captured with the same clock
+#
+# each machine becomes a process, each state a thread in it;
+# enter() / reenter() .. exit() become duration slices on the state's track,
+# transitions, task and plan statuses become instant events;
+# slices open at the end of the capture are closed at its last timestamp;
+# timestamps are not rebased, so spans merged from the same clock line up
+#
+# states record enter() / exit() only if they define them,
+# build with HFSM_ENABLE_VERBOSE_DEBUG_LOG to see every state
+
+import argparse
+import json
+
+from decode_trace import load, loadNames, lookup, state, KINDS, METHODS, TRANSITIONS, STATUSES, INVALID_STATE_ID
+
+################################################################################
+
+def instant(machineId, stateId, name, category, timestamp, args):
+	return {
+		"ph": "i",
+		"s": "t",
+		"name": name,
+		"cat": category,
+		"pid": machineId,
+		"tid": stateId,
+		"ts": timestamp,
+		"args": args,
+	}
+
+def duration(machineId, stateId, name, begin, end):
+	return {
+		"ph": "X",
+		"name": name,
+		"cat": "state",
+		"pid": machineId,
+		"tid": stateId,
+		"ts": begin,
+		"dur": end - begin,
+	}
+
+def metadata(name, args, machineId, stateId = 0):
+	return {
+		"ph": "M",
+		"name": name,
+		"pid": machineId,
+		"tid": stateId,
+		"args": args,
+	}
+
+#-------------------------------------------------------------------------------
+
+def convert(records, namesFor, ticksPerUs):
+	events = []
+	opened = {}
+	tracks = set()
+
+	first = min(record[0] for record in records) / ticksPerUs if records else 0.0
+	last  = first
+
+	for timestamp, machineId, stateId, target, kind, code in records:
+		names = namesFor(machineId)
+		ts = timestamp / ticksPerUs
+		last = max(last, ts)
+		kindName = lookup(KINDS, kind)
+
+		if stateId != INVALID_STATE_ID:
+			tracks.add((machineId, stateId))
+
+		if kindName == "method":
+			method = lookup(METHODS, code)
+			key = (machineId, stateId)
+
+			if method in ("enter", "reenter"):
+				if key in opened:
+					events.append(duration(machineId, stateId, state(names, stateId), opened[key], ts))
+
+				opened[key] = ts
+			elif method == "exit":
+				# exits without a recorded entry span from the start of the capture
+				events.append(duration(machineId, stateId, state(names, stateId), opened.pop(key, first), ts))
+
+		elif kindName == "transition":
+			events.append(instant(machineId, stateId,
+								  lookup(TRANSITIONS, code) + " " + state(names, target),
+								  "transition", ts,
+								  { "origin": state(names, stateId), "target": state(names, target) }))
+
+		elif kindName == "taskStatus":
+			events.append(instant(machineId, stateId,
+								  "task " + lookup(STATUSES, code),
+								  "plan", ts,
+								  { "region": target }))
+
+		elif kindName == "planStatus":
+			tracks.add((machineId, 0))
+			events.append(instant(machineId, 0,
+								  "plan " + lookup(STATUSES, code),
+								  "plan", ts,
+								  { "region": target }))
+
+	for (machineId, stateId), begin in opened.items():
+		events.append(duration(machineId, stateId, state(namesFor(machineId), stateId), begin, last))
+
+	for machineId in sorted(set(machineId for machineId, _ in tracks)):
+		events.append(metadata("process_name", { "name": "machine " + str(machineId) }, machineId))
+
+	for machineId, stateId in sorted(tracks):
+		events.append(metadata("thread_name", { "name": state(namesFor(machineId), stateId) }, machineId, stateId))
+		events.append(metadata("thread_sort_index", { "sort_index": stateId }, machineId, stateId))
+
+	return events
+
+#-------------------------------------------------------------------------------
+
+def parseNames(specs):
+	common = []
+	perMachine = {}
+
+	for spec in specs or []:
+		machine, separator, path = spec.partition("=")
+
+		if separator and machine.isdigit():
+			perMachine[int(machine)] = loadNames(path)
+		else:
+			common = loadNames(spec)
+
+	return lambda machineId: perMachine.get(machineId, common)
+
+def merged(paths):
+	events = []
+
+	for path in paths or []:
+		with open(path, 'r', encoding='utf-8') as input:
+			trace = json.load(input)
+
+		events += trace["traceEvents"] if isinstance(trace, dict) else trace
+
+	return events
+
+################################################################################
+
+if __name__ == "__main__":
+	parser = argparse.ArgumentParser(description="hfsm2 trace -> Chrome Trace Event JSON")
+	parser.add_argument("records")
+	parser.add_argument("output")
+	parser.add_argument("-n", "--names", action="append", metavar="[MACHINE=]FILE")
+	parser.add_argument("-t", "--ticks-per-us", type=float, default=1000.0, metavar="N")
+	parser.add_argument("-m", "--merge", action="append", metavar="FILE")
+	options = parser.parse_args()
+
+	events = convert(load(options.records), parseNames(options.names), options.ticks_per_us)
+	events += merged(options.merge)
+
+	with open(options.output, 'w', encoding='utf-8') as output:
+		json.dump({ "traceEvents": events, "displayTimeUnit": "ns" }, output, indent=1)
+
+################################################################################
@@ -0,0 +1,112 @@
+# decodes binary dumps of hfsm2::TraceLoggerT<> records
+#
+# usage: decode_trace.py <records.bin> [names.txt]
+#
+# 'records.bin' - TraceRecord structs as drained from the logger, back to back
+# 'names.txt'	- state names, one per line in StateID order,
+#				  e.g. written from machine.stateName() with HFSM_ENABLE_STRUCTURE_REPORT
+
+import struct
+import sys
+
+################################################################################
+
+RECORD = struct.Struct("<QHHHBB")
+
+KINDS = [
+	"method",
+	"transition",
+	"taskStatus",
+	"planStatus",
+	"cancelledPending",
+	"utilityResolution",
+	"randomResolution",
+]
+
+METHODS = [
+	"rank",
+	"utility",
+	"entryGuard",
+	"enter",
+	"reenter",
+	"update",
+	"react",
+	"exitGuard",
+	"exit",
+	"planSucceeded",
+	"planFailed",
+]
+
+TRANSITIONS = [
+	"changeTo",
+	"restart",
+	"resume",
+	"utilize",
+	"randomize",
+	"schedule",
+]
+
+STATUSES = [
+	"succeeded",
+	"failed",
+]
+
+INVALID_STATE_ID = 0xFFFF
+
+#-------------------------------------------------------------------------------
+
+def lookup(table, index):
+	return table[index] if index < len(table) else "?" + str(index)
+
+def state(names, stateId):
+	if stateId == INVALID_STATE_ID:
+		return "-"
+	elif stateId < len(names) and names[stateId]:
+		return names[stateId]
+	else:
+		return "#" + str(stateId)
+
+def decode(record, names):
+	timestamp, machineId, stateId, target, kind, code = record
+	kindName = lookup(KINDS, kind)
+
+	if kindName == "method":
+		details = state(names, stateId) + "::" + lookup(METHODS, code) + "()"
+	elif kindName == "transition":
+		details = state(names, stateId) + " " + lookup(TRANSITIONS, code) + " " + state(names, target)
+	elif kindName == "taskStatus":
+		details = "region " + str(target) + " " + state(names, stateId) + " " + lookup(STATUSES, code)
+	elif kindName == "planStatus":
+		details = "region " + str(target) + " " + lookup(STATUSES, code)
+	elif kindName == "cancelledPending":
+		details = state(names, stateId)
+	else:
+		details = state(names, stateId) + " -> " + state(names, target)
+
+	return "%20d  %5d  %-18s %s" % (timestamp, machineId, kindName, details)
+
+################################################################################
+
+def load(path):
+	with open(path, 'rb') as input:
+		data = input.read()
+
+	return [RECORD.unpack_from(data, offset) for offset in range(0, len(data) - RECORD.size + 1, RECORD.size)]
+
+def loadNames(path):
+	with open(path, 'r', encoding='utf-8') as input:
+		return [line.rstrip("\r\n") for line in input]
+
+################################################################################
+
+if __name__ == "__main__":
+	if len(sys.argv) < 2:
+		print("usage: " + sys.argv[0] + " <records.bin> [names.txt]")
+		sys.exit(1)
+
+	names = loadNames(sys.argv[2]) if len(sys.argv) > 2 else []
+
+	for record in load(sys.argv[1]):
+		print(decode(record, names))
+
+################################################################################